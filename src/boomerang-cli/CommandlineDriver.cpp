@@ -54,12 +54,18 @@ static void help()
 "Decoding/decompilation options\n"
 "  --decode-only    : Decode only, do not decompile\n"
 "  --ssl <file>     : Use <file> as SSL specification file\n"
+"  --proc-arenas    : Allocate statements and expressions from per-procedure memory arenas\n"
+"  --mmap           : Map the input file into memory instead of reading it\n"
+"  --cache <dir>    : Reuse results of unchanged procedures from the decompilation cache <dir>\n"
+"  --pass-stats <f> : Write timing statistics of all passes to <f> (JSON, or CSV if *.csv)\n"
 "  -e <addr>        : Decode or decompile the procedure beginning at addr, and callees\n"
 "  -E <addr>        : Equivalent to -nc -e <addr>\n"
 "  -ic              : Decode through type 0 Indirect Calls\n"
 "  -S <min>         : Stop decompilation after specified number of minutes\n"
 "  -t               : Trace (print address of) every instruction decoded\n"
 "  -a               : Assume ABI compliance\n"
+"  -j <num>         : Use <num> threads for decoding, CFG compression and code generation\n"
+"                     (0: one per core)\n"
 "\n"
 "Output\n"
 "  --version        : Print version information and exit\n"
@@ -87,6 +93,8 @@ static void help()
 "  -ds              : Stop at debug points for keypress\n"
 "  -dt              : Debug Type Analysis\n"
 "  -du              : Debug removal of unused statements etc.\n"
+"  -dv              : Verify the def-use index of procedures after each pass\n"
+"  -dw              : Check the well-formedness of all CFGs, not only modified ones\n"
 "\n"
 "Restrictions\n"
 "  -nc              : Do not decode callees of functions\n"
@@ -183,6 +191,23 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
 
         case 'r': m_project->getSettings()->printRTLs = true; break;
 
+        case 'j': {
+            if (++i == args.size()) {
+                usage();
+                return 1;
+            }
+
+            bool converted       = false;
+            const int numThreads = args[i].toInt(&converted);
+
+            if (!converted) {
+                LOG_ERROR("Bad number of threads: %1", args[i]);
+                return 2;
+            }
+
+            m_project->getSettings()->numThreads = numThreads;
+        } break;
+
         case 't': m_project->getSettings()->traceDecoder = true; break;
 
         case 'g':
@@ -228,6 +253,22 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
                 m_project->getSettings()->sslFileName = args[++i];
                 break;
             }
+            else if (arg == "--proc-arenas") {
+                m_project->getSettings()->useProcArenas = true;
+                break;
+            }
+            else if (arg == "--mmap") {
+                m_project->getSettings()->mapBinaryFiles = true;
+                break;
+            }
+            else if (arg == "--cache") {
+                m_project->getSettings()->decompilationCacheDir = args[++i];
+                break;
+            }
+            else if (arg == "--pass-stats") {
+                m_project->getSettings()->passStatsFile = args[++i];
+                break;
+            }
             break;
 
         case 'i':
@@ -331,6 +372,8 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
             case 's': m_project->getSettings()->stopAtDebugPoints = true; break;
             case 't': m_project->getSettings()->debugTA = true; break;
             case 'u': m_project->getSettings()->debugUnused = true; break;
+            case 'v': m_project->getSettings()->verifyDefUses = true; break;
+            case 'w': m_project->getSettings()->checkAllCFGs = true; break;
             default: help();
             }
 
@@ -16,6 +16,7 @@
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/db/signature/Signature.h"
+#include "boomerang/decomp/ProcScheduler.h"
 #include "boomerang/passes/PassManager.h"
 #include "boomerang/ssl/RTL.h"
 #include "boomerang/ssl/Register.h"
@@ -35,6 +36,15 @@
 #include "boomerang/ssl/type/PointerType.h"
 #include "boomerang/util/ByteUtil.h"
 #include "boomerang/util/log/Log.h"
+#include "boomerang/visitor/expvisitor/ConstFinder.h"
+#include "boomerang/visitor/stmtexpvisitor/StmtConstFinder.h"
+
+#include <QDir>
+#include <QFileInfo>
+
+#include <set>
+#include <unordered_map>
+#include <vector>
 
 
 CCodeGenerator::CCodeGenerator(Project *project)
@@ -49,20 +59,80 @@ void CCodeGenerator::generateCode(const Prog *prog, Module *cluster, UserProc *p
     const bool generate_all = cluster == nullptr || cluster == prog->getRootModule();
     bool all_procedures     = (proc == nullptr);
 
-    // First declare prototypes
+    // Procedures to generate code for, in output order
+    std::vector<std::pair<Module *, UserProc *>> procs;
+
     for (const auto &module : prog->getModuleList()) {
+        if (!generate_all && (module.get() != cluster)) {
+            continue;
+        }
+
         for (Function *func : *module) {
             if (func->isLib()) {
                 continue;
             }
 
             UserProc *_proc = static_cast<UserProc *>(func);
-            addPrototype(_proc); // May be the wrong signature if _proc has ellipsis
+
+            if (!_proc->isDecoded()) {
+                continue;
+            }
+
+            if (!all_procedures && (proc != _proc)) {
+                continue;
+            }
+
+            procs.push_back({ module.get(), _proc });
+        }
+    }
+
+    // Each source file includes the header of its own module and the headers of all modules
+    // it calls or takes the address of procedures of. Only these headers are (re-)written, so generating code
+    // for a single module or procedure does not need to declare the whole program.
+    std::vector<Module *> modules;
+    std::unordered_map<const Module *, std::size_t> moduleIndex;
+
+    for (const auto &module : prog->getModuleList()) {
+        moduleIndex[module.get()] = modules.size();
+        modules.push_back(module.get());
+    }
+
+    std::map<const Module *, std::set<std::size_t>> includedModules;
+    std::set<std::size_t> headerModules;
+
+    for (auto &[module, _proc] : procs) {
+        std::set<std::size_t> &included = includedModules[module];
+        included.insert(moduleIndex.at(module));
+
+        for (const Function *function : getReferencedFunctions(_proc)) {
+            if (function->isLib()) {
+                continue;
+            }
+
+            auto it = moduleIndex.find(function->getModule());
+            if (it != moduleIndex.end()) {
+                included.insert(it->second);
+            }
+        }
+
+        headerModules.insert(included.begin(), included.end());
+    }
+
+    for (std::size_t idx : headerModules) {
+        addModuleDeclarations(modules[idx]);
+        printHeader(modules[idx]);
+    }
+
+    std::map<const Module *, std::vector<const Module *>> includes;
+    for (auto &[module, included] : includedModules) {
+        for (std::size_t idx : included) {
+            includes[module].push_back(modules[idx]);
         }
-        appendLine("");
     }
 
     if (generate_all) {
+        addIncludes(prog->getRootModule(), includes[prog->getRootModule()]);
+
         if (proc == nullptr) {
             const bool global = !prog->getGlobals().empty();
 
@@ -78,33 +148,66 @@ void CCodeGenerator::generateCode(const Prog *prog, Module *cluster, UserProc *p
             }
         }
 
-        appendLine(""); // Separate prototype(s) from first proc
+        appendLine(""); // Separate includes from first proc
         print(prog->getRootModule());
     }
 
-    for (const auto &module : prog->getModuleList()) {
-        if (!generate_all && (module.get() != cluster)) {
-            continue;
+    for (auto &[module, headers] : includes) {
+        if (!generate_all || module != prog->getRootModule()) {
+            addIncludes(module, headers);
+            print(module);
         }
+    }
 
-        for (Function *func : *module) {
-            if (func->isLib()) {
-                continue;
+    // Some passes run during code generation (e.g. UnusedLocalRemoval) alert debug points.
+    const int numThreads = prog->getProject()->getSettings()->getNumDebuggableThreads();
+
+    if (numThreads == 1 || procs.size() <= 1) {
+        for (auto &[module, _proc] : procs) {
+            if (generateCode(_proc)) {
+                _proc->setStatus(ProcStatus::CodegenDone);
             }
 
-            UserProc *_proc = static_cast<UserProc *>(func);
+            print(module);
+        }
 
-            if (!_proc->isDecoded()) {
-                continue;
-            }
+        return;
+    }
 
-            if (!all_procedures && (proc != _proc)) {
-                continue;
-            }
+    // Generate the code of each procedure with a separate generator, then write
+    // the results in the same order as above, so the output does not depend
+    // on the number of threads.
+    std::unordered_map<const UserProc *, std::size_t> procIndex;
+    for (std::size_t i = 0; i < procs.size(); ++i) {
+        procIndex[procs[i].second] = i;
+    }
 
-            generateCode(_proc);
-            print(module.get());
+    struct ProcCode
+    {
+        bool generated = false;
+        QStringList lines;
+    };
+
+    std::vector<ProcCode> procCode(procs.size());
+
+    ProcScheduler(prog, numThreads).runUnordered([&](UserProc *p) {
+        auto it = procIndex.find(p);
+        if (it == procIndex.end()) {
+            return;
+        }
+
+        CCodeGenerator gen(p->getProg()->getProject());
+        procCode[it->second].generated = gen.generateCode(p);
+        procCode[it->second].lines     = std::move(gen.m_lines);
+    });
+
+    for (std::size_t i = 0; i < procs.size(); ++i) {
+        if (procCode[i].generated) {
+            procs[i].second->setStatus(ProcStatus::CodegenDone);
         }
+
+        m_lines = std::move(procCode[i].lines);
+        print(procs[i].first);
     }
 }
 
@@ -406,13 +509,90 @@ void CCodeGenerator::addPrototype(UserProc *proc)
 }
 
 
-void CCodeGenerator::generateCode(UserProc *proc)
+void CCodeGenerator::addModuleDeclarations(Module *module)
+{
+    appendLine("#pragma once");
+    appendLine("");
+
+    for (Function *func : *module) {
+        if (!func->isLib()) {
+            // May be the wrong signature if the procedure has ellipsis
+            addPrototype(static_cast<UserProc *>(func));
+        }
+    }
+}
+
+
+void CCodeGenerator::addIncludes(const Module *module, const std::vector<const Module *> &headers)
+{
+    const QDir sourceDir = QFileInfo(module->getOutPath("c")).absoluteDir();
+
+    for (const Module *header : headers) {
+        const QString headerPath = sourceDir.relativeFilePath(header->getOutPath("h"));
+        appendLine(QString("#include \"%1\"").arg(headerPath));
+    }
+
+    appendLine("");
+}
+
+
+std::set<const Function *> CCodeGenerator::getReferencedFunctions(UserProc *proc) const
+{
+    std::set<const Function *> referenced(proc->getCallees().begin(), proc->getCallees().end());
+
+    StatementList stmts;
+    proc->getStatements(stmts);
+
+    for (Statement *stmt : stmts) {
+        std::list<std::shared_ptr<Const>> constants;
+        ConstFinder finder(constants);
+        StmtConstFinder stmtFinder(&finder);
+        stmt->accept(&stmtFinder);
+
+        for (const std::shared_ptr<Const> &c : constants) {
+            if (c->getOper() == opFuncConst) {
+                referenced.insert(c->getFunc());
+            }
+        }
+
+        if (!stmt->isCall()) {
+            continue;
+        }
+
+        // Constant arguments of function pointer type are printed as the name of the function
+        // (see addCallStatement)
+        for (const Statement *arg : static_cast<const CallStatement *>(stmt)->getArguments()) {
+            const Assignment *argAssign = static_cast<const Assignment *>(arg);
+            SharedType ty               = argAssign->getType();
+            SharedConstExp rhs          = argAssign->getRight();
+
+            if (rhs->isIntConst() && ty && ty->isPointer() &&
+                ty->as<PointerType>()->getPointsTo()->isFunc()) {
+                const Function *function = proc->getProg()->getFunctionByAddr(
+                    rhs->access<Const>()->getAddr());
+
+                if (function) {
+                    referenced.insert(function);
+                }
+            }
+        }
+    }
+
+    return referenced;
+}
+
+
+bool CCodeGenerator::generateCode(UserProc *proc)
 {
     m_lines.clear();
-    m_proc = proc;
+    m_locals.clear();
+    m_usedLabels.clear();
+    m_generatedBBs.clear();
+    m_indent = 0;
+    m_proc   = proc;
 
     if (!proc->getCFG() || !proc->getEntryBB()) {
-        return;
+        return false;
     }
 
     m_analyzer.structureCFG(proc->getCFG());
@@ -455,7 +635,7 @@ void CCodeGenerator::generateCode(UserProc *proc)
         removeUnusedLabels();
     }
 
-    proc->setStatus(ProcStatus::CodegenDone);
+    return true;
 }
 
 
@@ -2464,7 +2644,22 @@ void CCodeGenerator::writeBB(const BasicBlock *bb)
 
 void CCodeGenerator::print(const Module *module)
 {
-    m_writer.writeCode(module, m_lines);
+    if (!m_writer.writeCode(module, m_lines)) {
+        LOG_ERROR("Cannot write code for module '%1' to '%2'", module->getName(),
+                  module->getOutPath("c"));
+    }
+
+    m_lines.clear();
+}
+
+
+void CCodeGenerator::printHeader(const Module *module)
+{
+    if (!m_writer.writeHeader(module, m_lines)) {
+        LOG_ERROR("Cannot write header for module '%1' to '%2'", module->getName(),
+                  module->getOutPath("h"));
+    }
+
     m_lines.clear();
 }
 
@@ -22,7 +22,9 @@
 
 #include <list>
 #include <map>
+#include <set>
 #include <unordered_set>
+#include <vector>
 
 
 class BasicBlock;
@@ -136,8 +138,24 @@ private:
     /// Add a prototype (for forward declaration)
     void addPrototype(UserProc *proc);
 
-    /// Generate code for a single procedure.
-    void generateCode(UserProc *proc);
+    /// Add the prototypes of all procedures of \p module (i.e. the contents of its header file)
+    void addModuleDeclarations(Module *module);
+
+    /// Add #include directives for the header files of \p headers
+    /// to the source file of \p module.
+    void addIncludes(const Module *module, const std::vector<const Module *> &headers);
+
+    /// \returns the functions called by \p proc, and the functions whose address is used
+    /// by \p proc (e.g. function pointers passed as arguments).
+    std::set<const Function *> getReferencedFunctions(UserProc *proc) const;
+
+    /**
+     * Generate code for a single procedure into m_lines.
+     * Only modifies \p proc and the state of this generator, so different procedures
+     * can be generated concurrently by different generators.
+     * \returns false if \p proc has no code to generate.
+     */
+    bool generateCode(UserProc *proc);
 
     /// Generate global variables from data sections.
     void generateDataSectionCode(const BinaryImage *image, QString sectionName,
@@ -319,6 +337,7 @@ private:
 
 private:
     void print(const Module *module);
+    void printHeader(const Module *module);
 
     /// Output 4 * \p indLevel spaces to \p str
     void indent(OStream &str, int indLevel);
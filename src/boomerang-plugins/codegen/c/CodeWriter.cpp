@@ -60,3 +60,23 @@ bool CodeWriter::writeCode(const Module *module, const QStringList &lines)
     it->second.m_os << lines.join('\n') << '\n';
     return true;
 }
+
+
+bool CodeWriter::writeHeader(const Module *module, const QStringList &lines)
+{
+    const QString outPath = module->getOutPath("h");
+    if (!QFile(outPath).exists()) {
+        // Headers are written before the source files, so the directory may not exist yet
+        module->makeDirs();
+    }
+
+    QFile outFile(outPath);
+    if (!outFile.open(QFile::WriteOnly | QFile::Text)) {
+        return false;
+    }
+
+    OStream os(&outFile);
+    os << lines.join('\n') << '\n';
+    os.flush();
+    return true;
+}
@@ -51,8 +51,14 @@ public:
     CodeWriter &operator=(CodeWriter &&) = default;
 
 public:
+    /// Append \p lines to the source file of \p module.
+    /// \returns false if the source file could not be opened.
     bool writeCode(const Module *module, const QStringList &lines);
 
+    /// Replace the header file of \p module by \p lines.
+    /// \returns false if the header file could not be opened.
+    bool writeHeader(const Module *module, const QStringList &lines);
+
 private:
     WriteDestMap m_dests;
 };
@@ -23,7 +23,7 @@
 CapstoneDecoder::CapstoneDecoder(Project *project, cs::cs_arch arch, cs::cs_mode mode,
                                  const QString &sslFileName)
     : IDecoder(project)
-    , m_dict(project->getSettings()->debugDecoder)
+    , m_dict(new RTLInstDict(project->getSettings()->debugDecoder))
     , m_debugMode(project->getSettings()->debugDecoder)
 {
     cs::cs_open(arch, mode, &m_handle);
@@ -39,18 +39,29 @@ CapstoneDecoder::CapstoneDecoder(Project *project, cs::cs_arch arch, cs::cs_mode
         realSSLFileName = settings->getDataDirectory().absoluteFilePath(sslFileName);
     }
 
-    if (!m_dict.readSSLFile(realSSLFileName)) {
+    if (!m_dict->readSSLFile(realSSLFileName)) {
         LOG_ERROR("Cannot read SSL file '%1'", realSSLFileName);
         throw std::runtime_error("Cannot read SSL file");
     }
 
     // check that all required registers are present
-    if (m_dict.getRegDB()->getRegNameByNum(REG_PENT_ESP).isEmpty()) {
+    if (m_dict->getRegDB()->getRegNameByNum(REG_PENT_ESP).isEmpty()) {
         throw std::runtime_error("Required register #28 (%esp) not present");
     }
 }
 
 
+CapstoneDecoder::CapstoneDecoder(Project *project, cs::cs_arch arch, cs::cs_mode mode,
+                                 const std::shared_ptr<RTLInstDict> &dict)
+    : IDecoder(project)
+    , m_dict(dict)
+    , m_debugMode(project->getSettings()->debugDecoder)
+{
+    cs::cs_open(arch, mode, &m_handle);
+    cs::cs_option(m_handle, cs::CS_OPT_DETAIL, cs::CS_OPT_ON);
+}
+
+
 CapstoneDecoder::~CapstoneDecoder()
 {
     cs::cs_close(&m_handle);
@@ -13,6 +13,8 @@
 #include "boomerang/ifc/IDecoder.h"
 #include "boomerang/ssl/RTLInstDict.h"
 
+#include <memory>
+
 
 namespace cs
 {
@@ -40,8 +42,16 @@ public:
                     const QString &sslFileName);
     virtual ~CapstoneDecoder();
 
+protected:
+    /// Create a decoder that shares the instruction dictionary \p dict with another decoder,
+    /// e.g. for worker decoders (see \ref IDecoder::createWorkerDecoder).
+    /// Instruction templates are not modified after the SSL file has been read,
+    /// so the dictionary can be used by several threads concurrently.
+    CapstoneDecoder(Project *project, cs::cs_arch arch, cs::cs_mode mode,
+                    const std::shared_ptr<RTLInstDict> &dict);
+
 public:
-    const RTLInstDict *getDict() const override { return &m_dict; }
+    const RTLInstDict *getDict() const override { return m_dict.get(); }
 
     /// \copydoc IDecoder::isSPARCRestore
     bool isSPARCRestore(Address pc, ptrdiff_t delta) const override;
@@ -54,6 +64,6 @@ protected:
 protected:
     cs::csh m_handle;
     Prog *m_prog = nullptr;
-    RTLInstDict m_dict;
+    std::shared_ptr<RTLInstDict> m_dict;
     bool m_debugMode = false;
 };
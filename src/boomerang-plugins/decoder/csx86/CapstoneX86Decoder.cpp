@@ -136,6 +136,13 @@ CapstoneX86Decoder::CapstoneX86Decoder(Project *project)
 }
 
 
+CapstoneX86Decoder::CapstoneX86Decoder(Project *project, const std::shared_ptr<RTLInstDict> &dict)
+    : CapstoneDecoder(project, cs::CS_ARCH_X86, cs::CS_MODE_32, dict)
+{
+    m_insn = cs::cs_malloc(m_handle);
+}
+
+
 CapstoneX86Decoder::~CapstoneX86Decoder()
 {
     cs::cs_free(m_insn, 1);
@@ -156,6 +163,9 @@ bool CapstoneX86Decoder::initialize(Project *project)
     default: break;
     }
 
+    m_templateCache.clear();
+    m_nopTemplate = lookupInstructionTemplate("NOP", 0);
+
     return true;
 }
 
@@ -202,13 +212,25 @@ RegNum CapstoneX86Decoder::getRegNumByName(const QString &name) const
 
 QString CapstoneX86Decoder::getRegNameByNum(RegNum regNum) const
 {
-    return m_dict.getRegDB()->getRegNameByNum(regNum);
+    return m_dict->getRegDB()->getRegNameByNum(regNum);
 }
 
 
 int CapstoneX86Decoder::getRegSizeByNum(RegNum regNum) const
 {
-    return m_dict.getRegDB()->getRegSizeByNum(regNum);
+    return m_dict->getRegDB()->getRegSizeByNum(regNum);
+}
+
+
+std::unique_ptr<IDecoder> CapstoneX86Decoder::createWorkerDecoder(Project *project) const
+{
+    std::unique_ptr<CapstoneX86Decoder> decoder(new CapstoneX86Decoder(project, m_dict));
+    if (!decoder->initialize(project)) {
+        return nullptr;
+    }
+
+    decoder->m_prog = nullptr; // must not create procedures for call destinations
+    return decoder;
 }
 
 
@@ -225,22 +247,8 @@ std::unique_ptr<RTL> CapstoneX86Decoder::createRTLForInstruction(Address pc,
     const int numOperands         = instruction->detail->x86.op_count;
     const cs::cs_x86_op *operands = instruction->detail->x86.operands;
 
-    QString insnID = cs::cs_insn_name(m_handle, instruction->id);
-
-    switch (instruction->detail->x86.prefix[0]) {
-    case cs::X86_PREFIX_REP: insnID = "REP" + insnID; break;
-    case cs::X86_PREFIX_REPNE: insnID = "REPNE" + insnID; break;
-    }
-
-    insnID = insnID.toUpper();
-
-    for (int i = 0; i < numOperands; i++) {
-        // example: ".imm8"
-        QString operandName = "." + operandNames[operands[i].type] +
-                              QString::number(operands[i].size * 8);
-
-        insnID += operandName;
-    }
+    const InstructionTemplate insnTemplate = getInstructionTemplate(instruction);
+    const QString &insnID                  = insnTemplate.name;
 
     std::unique_ptr<RTL> rtl;
 
@@ -248,15 +256,15 @@ std::unique_ptr<RTL> CapstoneX86Decoder::createRTLForInstruction(Address pc,
     if (instruction->id == cs::X86_INS_AND && operands[0].type == cs::X86_OP_REG &&
         operands[0].reg == cs::X86_REG_ESP && operands[1].type == cs::X86_OP_IMM &&
         operands[1].imm == 0xFFFFFFF0) {
-        return instantiateRTL(pc, "NOP", 0, nullptr);
+        return instantiateRTL(pc, m_nopTemplate, 0, nullptr);
     }
     else {
-        rtl = instantiateRTL(pc, qPrintable(insnID), numOperands, operands);
+        rtl = instantiateRTL(pc, insnTemplate, numOperands, operands);
         if (!rtl) {
             LOG_ERROR("Could not find semantics for instruction '%1', "
                       "treating instruction as NOP",
                       insnID);
-            return instantiateRTL(pc, "NOP", 0, nullptr);
+            return instantiateRTL(pc, m_nopTemplate, 0, nullptr);
         }
     }
 
@@ -294,7 +302,10 @@ std::unique_ptr<RTL> CapstoneX86Decoder::createRTLForInstruction(Address pc,
             call->setDest(callDest);
             rtl->append(call);
 
-            if (callDest->isConst()) {
+            if (!callDest->isConst()) {
+                call->setIsComputed(true);
+            }
+            else if (m_prog) {
                 Function *destProc = m_prog->getOrCreateFunction(
                     callDest->access<Const>()->getAddr());
 
@@ -304,9 +315,6 @@ std::unique_ptr<RTL> CapstoneX86Decoder::createRTLForInstruction(Address pc,
 
                 call->setDestProc(destProc);
             }
-            else {
-                call->setIsComputed(true);
-            }
         }
     }
     else if (isInstructionInGroup(instruction, cs::X86_GRP_JUMP)) {
@@ -414,12 +422,14 @@ std::unique_ptr<RTL> CapstoneX86Decoder::createRTLForInstruction(Address pc,
 }
 
 
-std::unique_ptr<RTL> CapstoneX86Decoder::instantiateRTL(Address pc, const char *instructionID,
+std::unique_ptr<RTL> CapstoneX86Decoder::instantiateRTL(Address pc,
+                                                        const InstructionTemplate &insnTemplate,
                                                         int numOperands,
                                                         const cs::cs_x86_op *operands)
 {
-    // Take the argument, convert it to upper case and remove any .'s
-    const QString sanitizedName = QString(instructionID).remove(".").toUpper();
+    if (insnTemplate.templateID == RTLInstDict::INVALID_TEMPLATE) {
+        return nullptr;
+    }
 
     std::vector<SharedExp> args(numOperands);
     for (int i = 0; i < numOperands; i++) {
@@ -435,10 +445,82 @@ std::unique_ptr<RTL> CapstoneX86Decoder::instantiateRTL(Address pc, const char *
             argNames += args[i]->toString();
         }
 
-        LOG_MSG("Instantiating RTL at %1: %2 %3", pc, instructionID, argNames);
+        LOG_MSG("Instantiating RTL at %1: %2 %3", pc, insnTemplate.name, argNames);
+    }
+
+    return m_dict->instantiateRTL(insnTemplate.templateID, pc, args);
+}
+
+
+CapstoneX86Decoder::InstructionTemplate
+CapstoneX86Decoder::getInstructionTemplate(const cs::cs_insn *instruction)
+{
+    const int numOperands         = instruction->detail->x86.op_count;
+    const cs::cs_x86_op *operands = instruction->detail->x86.operands;
+    const uint8_t prefix          = instruction->detail->x86.prefix[0];
+
+    // Key layout: 16 bits instruction ID, 2 bits prefix, 3 bits operand count,
+    // and 10 bits per operand (2 bits type, 8 bits size) for up to 4 operands.
+    const bool cacheable = numOperands <= 4 && instruction->id <= 0xFFFF;
+    uint64_t key         = 0;
+
+    if (cacheable) {
+        const uint64_t prefixKey = (prefix == cs::X86_PREFIX_REP)
+                                       ? 1
+                                       : (prefix == cs::X86_PREFIX_REPNE) ? 2 : 0;
+
+        key = instruction->id;
+        key = (key << 2) | prefixKey;
+        key = (key << 3) | numOperands;
+
+        for (int i = 0; i < numOperands; i++) {
+            key = (key << 10) | ((operands[i].type & 0x3) << 8) | operands[i].size;
+        }
+
+        auto it = m_templateCache.find(key);
+        if (it != m_templateCache.end()) {
+            return it->second;
+        }
     }
 
-    return m_dict.instantiateRTL(sanitizedName, pc, args);
+    QString insnID = cs::cs_insn_name(m_handle, instruction->id);
+
+    switch (prefix) {
+    case cs::X86_PREFIX_REP: insnID = "REP" + insnID; break;
+    case cs::X86_PREFIX_REPNE: insnID = "REPNE" + insnID; break;
+    }
+
+    insnID = insnID.toUpper();
+
+    for (int i = 0; i < numOperands; i++) {
+        // example: ".imm8"
+        QString operandName = "." + operandNames[operands[i].type] +
+                              QString::number(operands[i].size * 8);
+
+        insnID += operandName;
+    }
+
+    const InstructionTemplate insnTemplate = lookupInstructionTemplate(insnID, numOperands);
+
+    if (cacheable) {
+        m_templateCache.insert({ key, insnTemplate });
+    }
+
+    return insnTemplate;
+}
+
+
+CapstoneX86Decoder::InstructionTemplate
+CapstoneX86Decoder::lookupInstructionTemplate(const QString &name, int numOperands) const
+{
+    InstructionTemplate insnTemplate;
+    insnTemplate.name = name;
+
+    // Convert the name to upper case and remove any .'s
+    const QString sanitizedName = QString(name).remove(".").toUpper();
+    insnTemplate.templateID     = m_dict->getTemplateID(sanitizedName, numOperands);
+
+    return insnTemplate;
 }
 
 
@@ -15,6 +15,8 @@
 #include "boomerang/core/BoomerangAPI.h"
 #include "boomerang/ssl/exp/Operator.h"
 
+#include <unordered_map>
+
 
 /**
  * Instruction decoder using Capstone to decode
@@ -39,6 +41,21 @@ public:
     /// \copydoc IDecoder::getRegSize
     virtual int getRegSizeByNum(RegNum regNum) const override;
 
+    /// \copydoc IDecoder::createWorkerDecoder
+    virtual std::unique_ptr<IDecoder> createWorkerDecoder(Project *project) const override;
+
+private:
+    /// Create a worker decoder that shares the instruction dictionary \p dict.
+    CapstoneX86Decoder(Project *project, const std::shared_ptr<RTLInstDict> &dict);
+
+private:
+    /// Instruction template resolved from the instruction name
+    struct InstructionTemplate
+    {
+        int templateID = RTLInstDict::INVALID_TEMPLATE;
+        QString name; ///< unique name of the instruction (e.g. MOV.reg32.reg32)
+    };
+
 private:
     bool initialize(Project *project) override;
 
@@ -58,12 +75,23 @@ private:
      * arguments from \p operands.
      *
      * \param pc the address of the instruction.
-     * \param instructionID the unique name of the instruction (e.g. MOV.reg32.reg32)
+     * \param insnTemplate the template of the instruction (e.g. MOV.reg32.reg32)
      * \param numOperands number of instruction operands (e.g. 2 for MOV.reg32.reg32)
      * \param operands Array containing actual arguments containing \p numOperands elements.
      */
-    std::unique_ptr<RTL> instantiateRTL(Address pc, const char *instructionID, int numOperands,
-                                        const cs::cs_x86_op *operands);
+    std::unique_ptr<RTL> instantiateRTL(Address pc, const InstructionTemplate &insnTemplate,
+                                        int numOperands, const cs::cs_x86_op *operands);
+
+    /**
+     * Returns the instruction template for \p instruction (e.g. MOV.reg32.reg32).
+     * Templates are cached by instruction ID, prefix and operand signature,
+     * so the instruction name only has to be built once per signature.
+     */
+    InstructionTemplate getInstructionTemplate(const cs::cs_insn *instruction);
+
+    /// \returns the template of the instruction with sanitized name \p name.
+    /// The template ID is invalid if there is no such template.
+    InstructionTemplate lookupInstructionTemplate(const QString &name, int numOperands) const;
 
     /**
      * Generate statements for the BSF and BSR instructions (Bit Scan Forward/Reverse)
@@ -77,4 +105,8 @@ private:
 private:
     int m_bsfrState = 0; ///< State for state machine used in genBSFR()
     cs::cs_insn *m_insn; ///< decoded instruction;
+
+    /// Instruction templates by instruction ID, prefix and operand signature
+    std::unordered_map<uint64_t, InstructionTemplate> m_templateCache;
+    InstructionTemplate m_nopTemplate;
 };
@@ -67,6 +67,13 @@ CapstonePPCDecoder::CapstonePPCDecoder(Project *project)
 }
 
 
+CapstonePPCDecoder::CapstonePPCDecoder(Project *project, const std::shared_ptr<RTLInstDict> &dict)
+    : CapstoneDecoder(project, cs::CS_ARCH_PPC,
+                      (cs::cs_mode)(cs::CS_MODE_32 + cs::CS_MODE_BIG_ENDIAN), dict)
+{
+}
+
+
 bool CapstonePPCDecoder::decodeInstruction(Address pc, ptrdiff_t delta, DecodeResult &result)
 {
     const Byte *instructionData = reinterpret_cast<const Byte *>((HostAddress(delta) + pc).value());
@@ -111,13 +118,25 @@ RegNum CapstonePPCDecoder::getRegNumByName(const QString &name) const
 
 QString CapstonePPCDecoder::getRegNameByNum(RegNum regNum) const
 {
-    return m_dict.getRegDB()->getRegNameByNum(regNum);
+    return m_dict->getRegDB()->getRegNameByNum(regNum);
 }
 
 
 int CapstonePPCDecoder::getRegSizeByNum(RegNum regNum) const
 {
-    return m_dict.getRegDB()->getRegSizeByNum(regNum);
+    return m_dict->getRegDB()->getRegSizeByNum(regNum);
+}
+
+
+std::unique_ptr<IDecoder> CapstonePPCDecoder::createWorkerDecoder(Project *project) const
+{
+    std::unique_ptr<CapstonePPCDecoder> decoder(new CapstonePPCDecoder(project, m_dict));
+    if (!decoder->initialize(project)) {
+        return nullptr;
+    }
+
+    decoder->m_prog = nullptr; // must not create procedures for call destinations
+    return decoder;
 }
 
 
@@ -363,7 +382,7 @@ std::unique_ptr<RTL> CapstonePPCDecoder::instantiateRTL(Address pc, const char *
 
     // Take the argument, convert it to upper case and remove any .'s
     const QString sanitizedName = QString(instructionID).remove(".").toUpper();
-    return m_dict.instantiateRTL(sanitizedName, pc, args);
+    return m_dict->instantiateRTL(sanitizedName, pc, args);
 }
 
 
@@ -38,6 +38,13 @@ public:
     /// \copydoc IDecoder::getRegSizeByNum
     int getRegSizeByNum(RegNum regNum) const override;
 
+    /// \copydoc IDecoder::createWorkerDecoder
+    std::unique_ptr<IDecoder> createWorkerDecoder(Project *project) const override;
+
+private:
+    /// Create a worker decoder that shares the instruction dictionary \p dict.
+    CapstonePPCDecoder(Project *project, const std::shared_ptr<RTLInstDict> &dict);
+
 private:
     std::unique_ptr<RTL> createRTLForInstruction(Address pc, cs::cs_insn *instruction);
 
@@ -128,6 +128,12 @@ CapstoneSPARCDecoder::CapstoneSPARCDecoder(Project *project)
 }
 
 
+CapstoneSPARCDecoder::CapstoneSPARCDecoder(Project *project, const std::shared_ptr<RTLInstDict> &dict)
+    : CapstoneDecoder(project, cs::CS_ARCH_SPARC, cs::CS_MODE_BIG_ENDIAN, dict)
+{
+}
+
+
 bool CapstoneSPARCDecoder::decodeInstruction(Address pc, ptrdiff_t delta, DecodeResult &result)
 {
     const Byte *instructionData = reinterpret_cast<const Byte *>((HostAddress(delta) + pc).value());
@@ -189,13 +195,25 @@ RegNum CapstoneSPARCDecoder::getRegNumByName(const QString &name) const
 
 QString CapstoneSPARCDecoder::getRegNameByNum(RegNum regNum) const
 {
-    return m_dict.getRegDB()->getRegNameByNum(regNum);
+    return m_dict->getRegDB()->getRegNameByNum(regNum);
 }
 
 
 int CapstoneSPARCDecoder::getRegSizeByNum(RegNum regNum) const
 {
-    return m_dict.getRegDB()->getRegSizeByNum(regNum);
+    return m_dict->getRegDB()->getRegSizeByNum(regNum);
+}
+
+
+std::unique_ptr<IDecoder> CapstoneSPARCDecoder::createWorkerDecoder(Project *project) const
+{
+    std::unique_ptr<CapstoneSPARCDecoder> decoder(new CapstoneSPARCDecoder(project, m_dict));
+    if (!decoder->initialize(project)) {
+        return nullptr;
+    }
+
+    decoder->m_prog = nullptr; // must not create procedures for call destinations
+    return decoder;
 }
 
 
@@ -433,7 +451,7 @@ std::unique_ptr<RTL> CapstoneSPARCDecoder::instantiateRTL(Address pc, const char
 
     // Take the argument, convert it to upper case and remove any .'s
     const QString sanitizedName = QString(instructionID).remove(".").toUpper();
-    return m_dict.instantiateRTL(sanitizedName, pc, args);
+    return m_dict->instantiateRTL(sanitizedName, pc, args);
 }
 
 
@@ -57,7 +57,7 @@ bool SPARCFrontEnd::canOptimizeDelayCopy(Address src, Address dest, ptrdiff_t de
 
 
 BasicBlock *SPARCFrontEnd::optimizeCallReturn(CallStatement *call, const RTL *rtl, const RTL *delay,
-                                              UserProc *proc)
+                                              UserProc *proc, TargetQueue &tq)
 {
     if (call->isReturnAfterCall()) {
         // The only RTL in the basic block is a ReturnStatement
@@ -75,7 +75,7 @@ BasicBlock *SPARCFrontEnd::optimizeCallReturn(CallStatement *call, const RTL *rt
         // Constuct the RTLs for the new basic block
         std::unique_ptr<RTLList> rtls(new RTLList);
         BasicBlock *returnBB = createReturnBlock(
-            proc, std::move(rtls), std::unique_ptr<RTL>(new RTL(rtl->getAddress() + 1, ls)));
+            proc, std::move(rtls), std::unique_ptr<RTL>(new RTL(rtl->getAddress() + 1, ls)), tq);
         return returnBB;
     }
     else {
@@ -109,6 +109,7 @@ void SPARCFrontEnd::createCallToAddress(Address dest, Address address, BasicBloc
     }
 
     const Prog *prog = cfg->getProc()->getProg();
+    std::lock_guard<std::recursive_mutex> lock(m_programMutex);
 
     // If the destination address is the same as this very instruction,
     // we have a call with iDisp30 == 0. Don't treat this as the start of a real procedure.
@@ -136,7 +137,8 @@ void SPARCFrontEnd::case_unhandled_stub(Address addr)
 
 bool SPARCFrontEnd::case_CALL(Address &address, DecodeResult &inst, DecodeResult &delayInst,
                               std::unique_ptr<RTLList> &BB_rtls, UserProc *proc,
-                              std::list<CallStatement *> &callList, bool isPattern /* = false*/)
+                              std::list<CallStatement *> &callList, TargetQueue &tq,
+                              bool isPattern /* = false*/)
 {
     // Aliases for the call and delay RTLs
     CallStatement *callStmt = static_cast<CallStatement *>(inst.rtl->back());
@@ -150,7 +152,7 @@ bool SPARCFrontEnd::case_CALL(Address &address, DecodeResult &inst, DecodeResult
     }
 
     // Get the new return basic block for the special case where the delay instruction is a restore
-    BasicBlock *returnBB = optimizeCallReturn(callStmt, inst.rtl.get(), delayRTL, proc);
+    BasicBlock *returnBB = optimizeCallReturn(callStmt, inst.rtl.get(), delayRTL, proc, tq);
 
     int disp30 = (callStmt->getFixedDest().value() - address.value()) >> 2;
 
@@ -296,7 +298,7 @@ void SPARCFrontEnd::case_SD(Address &pc, ptrdiff_t delta, Interval<Address> text
 
 bool SPARCFrontEnd::case_DD(Address &address, ptrdiff_t, DecodeResult &inst,
                             DecodeResult &delay_inst, std::unique_ptr<RTLList> BB_rtls,
-                            TargetQueue &, UserProc *proc, std::list<CallStatement *> &callList)
+                            TargetQueue &tq, UserProc *proc, std::list<CallStatement *> &callList)
 {
     ProcCFG *cfg  = proc->getCFG();
     RTL *rtl      = inst.rtl.get();
@@ -324,7 +326,7 @@ bool SPARCFrontEnd::case_DD(Address &address, ptrdiff_t, DecodeResult &inst,
         break;
 
     case StmtType::Ret:
-        newBB       = createReturnBlock(proc, std::move(BB_rtls), std::move(inst.rtl));
+        newBB       = createReturnBlock(proc, std::move(BB_rtls), std::move(inst.rtl), tq);
         isRetOrCase = true;
         break;
 
@@ -358,7 +360,7 @@ bool SPARCFrontEnd::case_DD(Address &address, ptrdiff_t, DecodeResult &inst,
     if (last->getKind() == StmtType::Call) {
         // Attempt to add a return BB if the delay instruction is a RESTORE
         CallStatement *call_stmt = static_cast<CallStatement *>(last);
-        BasicBlock *returnBB     = optimizeCallReturn(call_stmt, rtl, delayRTL, proc);
+        BasicBlock *returnBB     = optimizeCallReturn(call_stmt, rtl, delayRTL, proc, tq);
 
         if (returnBB != nullptr) {
             cfg->addEdge(newBB, returnBB);
@@ -715,7 +717,7 @@ bool SPARCFrontEnd::processProc(UserProc *proc, Address pc)
                     // 142c8:  40 00 5b 91          call exit
                     // 142cc:  91 e8 3f ff          restore %g0, -1, %o0
                     const ptrdiff_t delta = m_program->getBinaryFile()->getImage()->getTextDelta();
-                    if (m_decoder->isSPARCRestore(pc + inst.numBytes, delta)) {
+                    if (getThreadDecoder()->isSPARCRestore(pc + inst.numBytes, delta)) {
                         // Give the address of the call; I think that this is actually important, if
                         // faintly annoying
                         delayInst.rtl->setAddress(pc);
@@ -725,7 +727,8 @@ bool SPARCFrontEnd::processProc(UserProc *proc, Address pc)
                         // resore semantics chop off one level of return address)
                         static_cast<CallStatement *>(last)->setReturnAfterCall(true);
                         sequentialDecode = false;
-                        case_CALL(pc, inst, nop_inst, BB_rtls, proc, callList, true);
+                        case_CALL(pc, inst, nop_inst, BB_rtls, proc, callList, _targetQueue,
+                                  true);
                         break;
                     }
 
@@ -757,7 +760,8 @@ bool SPARCFrontEnd::processProc(UserProc *proc, Address pc)
                                 *rhs->getSubExp1() == *o7) {
                                 // Get the constant
                                 const int K = rhs->access<Const, 2>()->getInt();
-                                case_CALL(pc, inst, delayInst, BB_rtls, proc, callList, true);
+                                case_CALL(pc, inst, delayInst, BB_rtls, proc, callList,
+                                          _targetQueue, true);
 
                                 // We don't generate a goto; instead, we just decode from the new
                                 // address Note: the call to case_CALL has already incremented
@@ -771,7 +775,8 @@ bool SPARCFrontEnd::processProc(UserProc *proc, Address pc)
                                 // after this call
                                 static_cast<CallStatement *>(last)->setReturnAfterCall(true);
                                 sequentialDecode = false;
-                                case_CALL(pc, inst, delayInst, BB_rtls, proc, callList, true);
+                                case_CALL(pc, inst, delayInst, BB_rtls, proc, callList,
+                                          _targetQueue, true);
                                 break;
                             }
                         }
@@ -788,7 +793,8 @@ bool SPARCFrontEnd::processProc(UserProc *proc, Address pc)
                     // we put the delay instruction before the jump or call
                     if (last->getKind() == StmtType::Call) {
                         // This is a call followed by an NCT/NOP
-                        sequentialDecode = case_CALL(pc, inst, delayInst, BB_rtls, proc, callList);
+                        sequentialDecode = case_CALL(pc, inst, delayInst, BB_rtls, proc, callList,
+                                                     _targetQueue);
                     }
                     else {
                         // This is a non-call followed by an NCT/NOP
@@ -1006,6 +1012,8 @@ bool SPARCFrontEnd::processProc(UserProc *proc, Address pc)
 
     // Add the callees to the set of CallStatements to proces for parameter recovery, and also to
     // the Prog object
+    std::lock_guard<std::recursive_mutex> lock(m_programMutex);
+
     for (CallStatement *call : callList) {
         Address dest = call->getFixedDest();
 
@@ -92,11 +92,12 @@ private:
      * \param      call  the RTL for the caller (e.g. "call ProcC" above)
      * \param      rtl   pointer to the RTL for the call instruction
      * \param      delay the RTL for the delay instruction (e.g. "restore")
+     * \param      tq    Object managing the target queue
      * \returns    The basic block containing the single return instruction
      *             if this optimisation applies, nullptr otherwise.
      */
     BasicBlock *optimizeCallReturn(CallStatement *call, const RTL *rtl, const RTL *delay,
-                                   UserProc *proc);
+                                   UserProc *proc, TargetQueue &tq);
 
     /**
      * Adds the destination of a branch to the queue of address
@@ -142,6 +143,7 @@ private:
      * \param BB_rtls the list of RTLs currently built for the BB under construction
      * \param proc the enclosing procedure
      * \param callList a list of pointers to CallStatements for procs yet to be processed
+     * \param tq Object managing the target queue
      * \param os output stream for rtls
      * \param isPattern true if the call is an idiomatic pattern (e.g. a move_call_move pattern)
      * SIDE EFFECTS: address may change; BB_rtls may be appended to or set nullptr
@@ -149,7 +151,8 @@ private:
      */
     bool case_CALL(Address &address, DecodeResult &inst, DecodeResult &delay_inst,
                    std::unique_ptr<RTLList> &BB_rtls, UserProc *proc,
-                   std::list<CallStatement *> &callList, bool isPattern = false);
+                   std::list<CallStatement *> &callList, TargetQueue &tq,
+                   bool isPattern = false);
 
     /**
      * Handles a non-call, static delayed (SD) instruction
@@ -98,13 +98,28 @@ void ElfBinaryLoader::init()
 }
 
 
+bool ElfBinaryLoader::loadFromFile(BinaryFile *file)
+{
+    initialize(file, file->getSymbols());
+
+    BinaryImage *image = file->getImage();
+    return loadFromBuffer(image->getRawBytes(), image->getRawSize());
+}
+
+
 bool ElfBinaryLoader::loadFromMemory(QByteArray &img)
 {
-    m_loadedImageSize = img.size();
+    return loadFromBuffer(reinterpret_cast<Byte *>(img.data()), img.size());
+}
+
+
+bool ElfBinaryLoader::loadFromBuffer(Byte *data, std::size_t size)
+{
+    m_loadedImageSize = size;
 
-    // Allocate memory to hold the file
-    m_loadedImage = reinterpret_cast<Byte *>(img.data());
-    m_elfHeader   = reinterpret_cast<Elf32_Ehdr *>(img.data()); // Save a lot of casts
+    // The image is used in place
+    m_loadedImage = data;
+    m_elfHeader   = reinterpret_cast<Elf32_Ehdr *>(data); // Save a lot of casts
 
     if (m_loadedImageSize < sizeof(Elf32_Ehdr)) {
         LOG_ERROR("Cannot load ELF file: File size too small");
@@ -44,6 +44,10 @@ public:
     /// \copydoc IFileLoader::canLoad
     int canLoad(QIODevice &fl) const override;
 
+    /// \copydoc IFileLoader::loadFromFile
+    /// The raw file contents are used in place, so memory-mapped files are not copied.
+    bool loadFromFile(BinaryFile *file) override;
+
     /// \copydoc IFileLoader::loadFromMemory
     /// Note that empty sections will not be added to the image.
     bool loadFromMemory(QByteArray &img) override;
@@ -71,6 +75,10 @@ public:
     bool isRelocationAt(Address addr) override;
 
 private:
+    /// Load the ELF file of \p size bytes at \p data.
+    /// Relocations are applied to \p data in place.
+    bool loadFromBuffer(Byte *data, std::size_t size);
+
     /// Reset internal state, except for those that keep track of which member
     /// we're up to
     void init();
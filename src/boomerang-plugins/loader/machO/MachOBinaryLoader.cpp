@@ -104,8 +104,9 @@ bool MachOBinaryLoader::loadFromMemory(QByteArray &img)
 
     unsigned int imgoffs = 0;
 
-    unsigned char *magic = reinterpret_cast<uint8_t *>(img.data());
-    struct mach_header *header; // The Mach-O header
+    // Only read the image through constData(), so a memory-mapped image is not copied
+    const unsigned char *magic = reinterpret_cast<const uint8_t *>(img.constData());
+    const struct mach_header *header; // The Mach-O header
 
     if (Util::testMagic(magic, { 0xca, 0xfe, 0xba, 0xbe })) {
         const int nimages = Util::readDWord(magic + 4, Endian::Big);
@@ -127,7 +128,7 @@ bool MachOBinaryLoader::loadFromMemory(QByteArray &img)
         }
     }
 
-    header = reinterpret_cast<mach_header *>(img.data() + imgoffs); // new mach_header;
+    header = reinterpret_cast<const mach_header *>(img.constData() + imgoffs);
     // fp.read((char *)header, sizeof(mach_header));
 
     if ((header->magic != MH_MAGIC) && (READ4_BE(header->magic) != MH_MAGIC)) {
@@ -618,6 +618,9 @@ bool Win32BinaryLoader::loadFromMemory(QByteArray &arr)
 
     const PEHeader *peHdr = reinterpret_cast<const PEHeader *>(fileData + peHeaderOffset);
 
+    // Unlike ELF, PE sections are laid out by their RVA in memory, but by their (usually
+    // smaller) file alignment in the file, and BSS parts have to be zero-filled.
+    // The image therefore has to be copied even if the file is memory-mapped.
     try {
         const DWord imageSize = READ4_LE(peHdr->ImageSize);
         m_image               = new char[imageSize];
@@ -11,6 +11,8 @@
 
 #include "parser/AnsiCParserDriver.h"
 
+#include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
 #include "boomerang/core/plugin/Plugin.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/binary/BinarySymbol.h"
@@ -20,10 +22,15 @@
 #include "boomerang/ifc/IFrontEnd.h"
 #include "boomerang/util/log/Log.h"
 
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
 #include <QTextStream>
 
+#include <algorithm>
+
 
 CSymbolProvider::CSymbolProvider(Project *project)
     : ISymbolProvider(project)
@@ -32,6 +39,52 @@ CSymbolProvider::CSymbolProvider(Project *project)
 
 
 bool CSymbolProvider::readLibraryCatalog(const Prog *prog, const QString &filePath)
+{
+    SignatureFileList sigFiles;
+    if (!readCatalogEntries(filePath, sigFiles)) {
+        return false;
+    }
+
+    const QByteArray key = computeDatabaseKey(prog, sigFiles);
+    const QString dbPath = getDatabasePath(prog, filePath);
+
+    if (!dbPath.isEmpty()) {
+        std::unique_ptr<SignatureDatabase> db = std::make_unique<SignatureDatabase>();
+
+        if (db->open(dbPath, key)) {
+            addDatabase(std::move(db), filePath);
+            return true;
+        }
+    }
+
+    // The database does not exist or is out of date; parse the signature files instead.
+    SignatureDatabase::SignatureMap signatures;
+    SignatureDatabase::NamedTypeList namedTypes;
+    bool ok = true;
+
+    for (const auto &[sigFilePath, cc] : sigFiles) {
+        if (!readLibrarySignatures(sigFilePath, prog, cc, signatures, namedTypes)) {
+            ok = false;
+            break;
+        }
+    }
+
+    if (ok && !dbPath.isEmpty() &&
+        !SignatureDatabase::write(dbPath, key, signatures, namedTypes)) {
+        LOG_WARN("Cannot write signature database '%1'", dbPath);
+    }
+
+    std::unique_ptr<SignatureDatabase> db = std::make_unique<SignatureDatabase>();
+    for (const auto &[name, signature] : signatures) {
+        db->addSignature(signature);
+    }
+
+    addDatabase(std::move(db), filePath);
+    return ok;
+}
+
+
+bool CSymbolProvider::readCatalogEntries(const QString &filePath, SignatureFileList &sigFiles)
 {
     // TODO: this is a work for generic semantics provider plugin : HeaderReader
     QFile file(filePath);
@@ -67,9 +120,7 @@ bool CSymbolProvider::readLibraryCatalog(const Prog *prog, const QString &filePa
         }
 
         const QString sig_path = QFileInfo(filePath).absoluteDir().absoluteFilePath(sigFilePath);
-        if (!readLibrarySignatures(qPrintable(sig_path), prog, cc)) {
-            return false;
-        }
+        sigFiles.push_back({ sig_path, cc });
     }
 
     return true;
@@ -77,7 +128,9 @@ bool CSymbolProvider::readLibraryCatalog(const Prog *prog, const QString &filePa
 
 
 bool CSymbolProvider::readLibrarySignatures(const QString &signatureFile, const Prog *prog,
-                                            CallConv cc)
+                                            CallConv cc,
+                                            SignatureDatabase::SignatureMap &signatures,
+                                            SignatureDatabase::NamedTypeList &namedTypes)
 {
     AnsiCParserDriver driver;
     if (driver.parse(signatureFile, prog->getMachine(), cc) != 0) {
@@ -86,14 +139,72 @@ bool CSymbolProvider::readLibrarySignatures(const QString &signatureFile, const
     }
 
     for (std::shared_ptr<Signature> &signature : driver.signatures) {
-        m_librarySignatures[signature->getName()] = signature;
+        signatures[signature->getName()] = signature;
         signature->setSigFilePath(signatureFile);
     }
 
+    namedTypes.insert(namedTypes.end(), driver.namedTypes.begin(), driver.namedTypes.end());
     return true;
 }
 
 
+QByteArray CSymbolProvider::computeDatabaseKey(const Prog *prog,
+                                               const SignatureFileList &sigFiles) const
+{
+    QByteArray data;
+    QDataStream os(&data, QIODevice::WriteOnly);
+
+    os << QString(prog->getProject()->getVersionStr()) << static_cast<qint32>(prog->getMachine());
+
+    // Checking modification times is much faster than hashing the contents of the files
+    for (const auto &[sigFilePath, cc] : sigFiles) {
+        const QFileInfo info(sigFilePath);
+        os << info.absoluteFilePath() << static_cast<qint32>(cc) << info.size()
+           << info.lastModified().toMSecsSinceEpoch();
+    }
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+
+QString CSymbolProvider::getDatabasePath(const Prog *prog, const QString &catalogPath) const
+{
+    const QString &cacheDir = prog->getProject()->getSettings()->signatureCacheDir;
+    if (cacheDir.isEmpty()) {
+        return QString();
+    }
+
+    QDir dbDir(cacheDir);
+    if (!dbDir.mkpath(".")) {
+        return QString();
+    }
+
+    // The same catalog is parsed differently for different machines
+    const QFileInfo catalog(catalogPath);
+    const QString id = QString("%1:%2")
+                           .arg(catalog.absoluteFilePath())
+                           .arg(static_cast<int>(prog->getMachine()));
+    const QByteArray idHash = QCryptographicHash::hash(id.toUtf8(), QCryptographicHash::Sha1);
+
+    return dbDir.absoluteFilePath(QString("%1-%2.sigdb")
+                                      .arg(catalog.completeBaseName())
+                                      .arg(QString::fromLatin1(idHash.toHex().left(16))));
+}
+
+
+void CSymbolProvider::addDatabase(std::unique_ptr<SignatureDatabase> db, const QString &catalogPath)
+{
+    // Reading a catalog again gives its signatures the highest precedence
+    m_databases.erase(std::remove_if(m_databases.begin(), m_databases.end(),
+                                     [&catalogPath](const auto &entry) {
+                                         return entry.first == catalogPath;
+                                     }),
+                      m_databases.end());
+
+    m_databases.push_back({ catalogPath, std::move(db) });
+}
+
+
 bool CSymbolProvider::addSymbolsFromSymbolFile(Prog *prog, const QString &fname)
 {
     AnsiCParserDriver driver;
@@ -141,8 +252,14 @@ bool CSymbolProvider::addSymbolsFromSymbolFile(Prog *prog, const QString &fname)
 
 std::shared_ptr<Signature> CSymbolProvider::getSignatureByName(const QString &functionName) const
 {
-    auto it = m_librarySignatures.find(functionName);
-    return it != m_librarySignatures.end() ? it.value() : nullptr;
+    for (auto it = m_databases.rbegin(); it != m_databases.rend(); ++it) {
+        std::shared_ptr<Signature> signature = it->second->getSignature(functionName);
+        if (signature) {
+            return signature;
+        }
+    }
+
+    return nullptr;
 }
 
 
@@ -10,18 +10,27 @@
 #pragma once
 
 
+#include "SignatureDatabase.h"
+
 #include "boomerang/core/BoomerangAPI.h"
 #include "boomerang/frontend/SigEnum.h"
 #include "boomerang/ifc/ISymbolProvider.h"
 
-#include <QMap>
+#include <memory>
+#include <vector>
 
 
 class Prog;
 
 
-/// Symbol provider for reading signatures and symbols from C-like headers.
-/// (cf. also the files in data/signature/)
+/**
+ * Symbol provider for reading signatures and symbols from C-like headers.
+ * (cf. also the files in data/signature/)
+ *
+ * Parsing all signature files of a library catalog is slow, so the signatures of each catalog
+ * are compiled into a SignatureDatabase in the user's cache directory when the catalog is first
+ * read. Later reads of the catalog use the database, unless one of its signature files changed.
+ */
 class BOOMERANG_PLUGIN_API CSymbolProvider : public ISymbolProvider
 {
 public:
@@ -39,8 +48,28 @@ public:
     std::shared_ptr<Signature> getSignatureByName(const QString &functionName) const override;
 
 private:
-    bool readLibrarySignatures(const QString &signatureFile, const Prog *prog, CallConv cc);
+    typedef std::vector<std::pair<QString, CallConv>> SignatureFileList;
+
+    /// Read the paths and calling conventions of the signature files of a catalog.
+    bool readCatalogEntries(const QString &catalogPath, SignatureFileList &sigFiles);
+
+    bool readLibrarySignatures(const QString &signatureFile, const Prog *prog, CallConv cc,
+                               SignatureDatabase::SignatureMap &signatures,
+                               SignatureDatabase::NamedTypeList &namedTypes);
+
+    /// \returns the key of the signature database for \p sigFiles,
+    /// which changes whenever one of the signature files changes.
+    QByteArray computeDatabaseKey(const Prog *prog, const SignatureFileList &sigFiles) const;
+
+    /// \returns the path of the signature database for the catalog at \p catalogPath,
+    /// or an empty string if there is no cache directory (see Settings::signatureCacheDir).
+    QString getDatabasePath(const Prog *prog, const QString &catalogPath) const;
+
+    /// Add \p db as the database with the highest precedence.
+    void addDatabase(std::unique_ptr<SignatureDatabase> db, const QString &catalogPath);
 
 private:
-    QMap<QString, std::shared_ptr<Signature>> m_librarySignatures;
+    /// Signatures of all catalogs that were read, in the order they were read.
+    /// Signatures of later catalogs replace signatures of earlier catalogs.
+    std::vector<std::pair<QString, std::unique_ptr<SignatureDatabase>>> m_databases;
 };
@@ -0,0 +1,275 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "SignatureDatabase.h"
+
+#include "boomerang/db/serialization/SaveFileFormat.h"
+#include "boomerang/db/serialization/SaveFileWriter.h"
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/util/ByteUtil.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QDataStream>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <vector>
+
+
+/// "BSDB" in little endian
+static constexpr quint32 DB_MAGIC = 0x42445342;
+
+/// Must be incremented on every incompatible change of the database format.
+static constexpr quint32 DB_VERSION = 1;
+
+/// Size of an entry of the signature index:
+/// Offset and length of the name, offset and length of the signature (relative to the strings)
+static constexpr quint64 INDEX_ENTRY_SIZE = 4 * sizeof(DWord);
+
+
+static void initStream(QDataStream &stream)
+{
+    stream.setVersion(SaveFileFormat::STREAM_VERSION);
+    stream.setByteOrder(QDataStream::LittleEndian);
+}
+
+
+static void appendIndexValue(QByteArray &index, quint32 value)
+{
+    char buf[sizeof(DWord)];
+    Util::writeDWord(buf, value, Endian::Little);
+    index.append(buf, sizeof(buf));
+}
+
+
+SignatureDatabase::SignatureDatabase()
+{
+}
+
+
+SignatureDatabase::~SignatureDatabase()
+{
+    if (m_mappedData) {
+        m_file.unmap(const_cast<uchar *>(m_mappedData));
+    }
+}
+
+
+bool SignatureDatabase::write(const QString &filePath, const QByteArray &key,
+                              const SignatureMap &signatures, const NamedTypeList &namedTypes)
+{
+    SaveFileWriter writer;
+
+    QByteArray typeData;
+    QDataStream typeStream(&typeData, QIODevice::WriteOnly);
+    initStream(typeStream);
+
+    typeStream << static_cast<quint32>(namedTypes.size());
+    for (const auto &[name, ty] : namedTypes) {
+        typeStream << name << writer.writeType(ty);
+    }
+
+    // Sort by the UTF-8 encoded names, which are compared when looking up signatures.
+    std::vector<std::pair<QByteArray, QByteArray>> entries;
+    for (const auto &[name, sig] : signatures) {
+        entries.push_back({ name.toUtf8(), writer.writeSignature(sig.get()) });
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const std::pair<QByteArray, QByteArray> &a,
+                 const std::pair<QByteArray, QByteArray> &b) { return a.first < b.first; });
+
+    QByteArray index;
+    QByteArray strings;
+
+    for (const auto &[name, sigData] : entries) {
+        appendIndexValue(index, static_cast<quint32>(strings.size()));
+        appendIndexValue(index, static_cast<quint32>(name.size()));
+        strings.append(name);
+
+        appendIndexValue(index, static_cast<quint32>(strings.size()));
+        appendIndexValue(index, static_cast<quint32>(sigData.size()));
+        strings.append(sigData);
+    }
+
+    QSaveFile file(filePath);
+    if (!file.open(QFile::WriteOnly)) {
+        return false;
+    }
+
+    QDataStream os(&file);
+    initStream(os);
+
+    os << DB_MAGIC << DB_VERSION << SaveFileFormat::VERSION << key << typeData;
+    os << static_cast<quint32>(entries.size()) << static_cast<quint64>(strings.size());
+    os.writeRawData(index.constData(), index.size());
+    os.writeRawData(strings.constData(), strings.size());
+
+    return os.status() == QDataStream::Ok && file.commit();
+}
+
+
+bool SignatureDatabase::open(const QString &filePath, const QByteArray &key)
+{
+    m_file.setFileName(filePath);
+    if (!m_file.open(QFile::ReadOnly)) {
+        return false;
+    }
+
+    m_mappedData = m_file.map(0, m_file.size());
+    if (m_mappedData) {
+        m_dataSize = static_cast<quint64>(m_file.size());
+    }
+    else {
+        m_data     = m_file.readAll();
+        m_dataSize = static_cast<quint64>(m_data.size());
+    }
+
+    QDataStream is(getData(0, m_dataSize));
+    initStream(is);
+
+    quint32 magic = 0, version = 0, saveFileVersion = 0;
+    QByteArray fileKey, typeData;
+    is >> magic >> version >> saveFileVersion >> fileKey >> typeData;
+    is >> m_numSignatures >> m_stringsLength;
+
+    if (is.status() != QDataStream::Ok || magic != DB_MAGIC || version != DB_VERSION ||
+        saveFileVersion != SaveFileFormat::VERSION || fileKey != key) {
+        return false;
+    }
+
+    m_indexOffset   = static_cast<quint64>(is.device()->pos());
+    m_stringsOffset = m_indexOffset + m_numSignatures * INDEX_ENTRY_SIZE;
+
+    if (m_stringsOffset + m_stringsLength != m_dataSize) {
+        LOG_WARN("Signature database '%1' is truncated", filePath);
+        return false;
+    }
+
+    if (!readNamedTypes(typeData)) {
+        LOG_WARN("Cannot read types of signature database '%1'", filePath);
+        return false;
+    }
+
+    return true;
+}
+
+
+void SignatureDatabase::addSignature(const std::shared_ptr<Signature> &sig)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_signatures[sig->getName()] = sig;
+}
+
+
+std::shared_ptr<Signature> SignatureDatabase::getSignature(const QString &name) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_signatures.find(name);
+    if (it != m_signatures.end()) {
+        return it->second;
+    }
+
+    const QByteArray sigData = findSignatureData(name);
+    if (sigData.isEmpty()) {
+        return nullptr;
+    }
+
+    std::shared_ptr<Signature> sig = m_reader.readSignature(sigData);
+    if (!sig) {
+        LOG_WARN("Cannot read signature of '%1' from signature database '%2'", name,
+                 m_file.fileName());
+        return nullptr;
+    }
+
+    m_signatures[name] = sig;
+    return sig;
+}
+
+
+QByteArray SignatureDatabase::findSignatureData(const QString &name) const
+{
+    const QByteArray utf8Name = name.toUtf8();
+
+    auto getEntryValue = [this](quint32 entryIdx, int valueIdx) {
+        const QByteArray value = getData(m_indexOffset + entryIdx * INDEX_ENTRY_SIZE +
+                                             valueIdx * sizeof(DWord),
+                                         sizeof(DWord));
+        return value.isEmpty() ? 0 : Util::readDWord(value.constData(), Endian::Little);
+    };
+
+    // Binary search for the first entry that is not less than the name
+    quint32 lo = 0, hi = m_numSignatures;
+    while (lo < hi) {
+        const quint32 mid = lo + (hi - lo) / 2;
+        if (getData(m_stringsOffset + getEntryValue(mid, 0), getEntryValue(mid, 1)) < utf8Name) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+
+    if (lo == m_numSignatures ||
+        getData(m_stringsOffset + getEntryValue(lo, 0), getEntryValue(lo, 1)) != utf8Name) {
+        return QByteArray();
+    }
+
+    return getData(m_stringsOffset + getEntryValue(lo, 2), getEntryValue(lo, 3));
+}
+
+
+QByteArray SignatureDatabase::getData(quint64 offset, quint64 length) const
+{
+    if (offset + length > m_dataSize) {
+        return QByteArray();
+    }
+
+    const char *data = m_mappedData ? reinterpret_cast<const char *>(m_mappedData)
+                                    : m_data.constData();
+
+    // Does not copy the data
+    return QByteArray::fromRawData(data + offset, static_cast<int>(length));
+}
+
+
+bool SignatureDatabase::readNamedTypes(const QByteArray &data)
+{
+    QDataStream is(data);
+    initStream(is);
+
+    quint32 numTypes = 0;
+    is >> numTypes;
+
+    NamedTypeList namedTypes;
+    for (quint32 i = 0; i < numTypes && is.status() == QDataStream::Ok; ++i) {
+        QString name;
+        QByteArray tyData;
+        is >> name >> tyData;
+
+        SharedType ty = m_reader.readType(tyData);
+        if (!ty) {
+            return false;
+        }
+
+        namedTypes.push_back({ name, ty });
+    }
+
+    if (is.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    // Declare the types in the same order as the parser did when compiling the database
+    for (const auto &[name, ty] : namedTypes) {
+        Type::addNamedType(name, ty);
+    }
+
+    return true;
+}
@@ -0,0 +1,104 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/db/serialization/SaveFileReader.h"
+#include "boomerang/ssl/type/Type.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+
+
+class Signature;
+
+
+/**
+ * Library signatures of a signature catalog, precompiled into a binary file.
+ *
+ * The file contains the serialized signatures, sorted by name, and the types declared
+ * by the signature files of the catalog. It is mapped into memory when it is opened;
+ * signatures are only deserialized when they are looked up.
+ *
+ * Each database file is tagged with a key describing the signature files it was
+ * compiled from; files with a different key are rejected and must be compiled again.
+ *
+ * Signatures that are not backed by a file can be added by addSignature().
+ * They take precedence over the signatures of the file.
+ */
+class BOOMERANG_PLUGIN_API SignatureDatabase
+{
+public:
+    typedef std::map<QString, std::shared_ptr<Signature>> SignatureMap;
+    typedef std::list<std::pair<QString, SharedType>> NamedTypeList;
+
+public:
+    SignatureDatabase();
+    SignatureDatabase(const SignatureDatabase &other) = delete;
+    SignatureDatabase(SignatureDatabase &&other)      = delete;
+
+    ~SignatureDatabase();
+
+    SignatureDatabase &operator=(const SignatureDatabase &other) = delete;
+    SignatureDatabase &operator=(SignatureDatabase &&other) = delete;
+
+public:
+    /**
+     * Compile \p signatures and \p namedTypes into the database file at \p filePath.
+     * \returns true on success.
+     */
+    static bool write(const QString &filePath, const QByteArray &key,
+                      const SignatureMap &signatures, const NamedTypeList &namedTypes);
+
+    /**
+     * Open the database file at \p filePath and declare all types of the database
+     * (see Type::addNamedType).
+     * \returns false if the file does not exist, is invalid or was not compiled with key \p key.
+     */
+    bool open(const QString &filePath, const QByteArray &key);
+
+    /// Add a signature that is not contained in the database file.
+    void addSignature(const std::shared_ptr<Signature> &sig);
+
+    /// \returns the signature of the function \p name, or nullptr if there is none.
+    std::shared_ptr<Signature> getSignature(const QString &name) const;
+
+private:
+    /// \returns the serialized signature of the function \p name from the database file,
+    /// or an empty array if the file does not contain it.
+    QByteArray findSignatureData(const QString &name) const;
+
+    /// \returns the part of the database file at \p offset without copying it.
+    QByteArray getData(quint64 offset, quint64 length) const;
+
+    bool readNamedTypes(const QByteArray &data);
+
+private:
+    QFile m_file;
+    const uchar *m_mappedData = nullptr;
+    QByteArray m_data; ///< Contents of the database file if it cannot be mapped
+    quint64 m_dataSize = 0;
+
+    quint32 m_numSignatures  = 0;
+    quint64 m_indexOffset    = 0;
+    quint64 m_stringsOffset  = 0;
+    quint64 m_stringsLength  = 0;
+
+    mutable std::mutex m_mutex; ///< Protects the members below
+    mutable SaveFileReader m_reader;
+    mutable SignatureMap m_signatures; ///< Signatures that were already deserialized
+};
@@ -32,6 +32,9 @@ public:
     /// Parse the file with name. return 0 on success.
     int parse(const QString &fileName, Machine machine, CallConv cc);
 
+    /// Declare the type \p name (see Type::addNamedType) and record it in \ref namedTypes.
+    void addNamedType(const QString &name, SharedType type);
+
 public:
     // The token's location used by the scanner.
     AnsiC::location location;
@@ -43,6 +46,9 @@ public:
     std::list<std::shared_ptr<Symbol>> symbols;
     std::list<std::shared_ptr<SymbolRef>> refs;
 
+    /// Types declared by typedef or struct declarations, in order of declaration.
+    std::list<std::pair<QString, SharedType>> namedTypes;
+
 private:
     // Handling the scanner.
     bool scanBegin();
@@ -198,6 +198,9 @@ void DFATypeAnalyzer::visit(CallStatement *callStmt, bool &visitChildren)
                         tyt->as<PointerType>()->getPointsTo()->as<ArrayType>()->isUnbounded()) {
                         tyt->as<PointerType>()->getPointsTo()->as<ArrayType>()->setLength(
                             boundArg->getRight()->access<Const>()->getInt());
+
+                        // The type might be shared with the definition of the argument
+                        m_changed = true;
                     }
 
                     break;
@@ -226,8 +229,13 @@ void DFATypeAnalyzer::visit(CallStatement *callStmt, bool &visitChildren)
         if (callStmt->getDest()->isSubscript()) {
             std::shared_ptr<RefExp> ref = callStmt->getDest()->access<RefExp>();
             Statement *def              = ref->getDef();
-            def->setTypeForExp(ref->getSubExp1(),
-                               PointerType::get(FuncType::get(callStmt->getSignature())));
+
+            SharedType destType = PointerType::get(FuncType::get(callStmt->getSignature()));
+            SharedType oldType  = def->getTypeForExp(ref->getSubExp1());
+
+            // This changes the type of the definition directly, so report the change explicitly
+            def->setTypeForExp(ref->getSubExp1(), destType);
+            m_changed |= !oldType || *oldType != *destType;
         }
     }
 
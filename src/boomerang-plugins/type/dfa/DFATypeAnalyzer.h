@@ -10,6 +10,7 @@
 #pragma once
 
 
+#include "boomerang/core/BoomerangAPI.h"
 #include "boomerang/visitor/stmtmodifier/StmtModifier.h"
 
 
@@ -20,7 +21,7 @@ class Assignment;
  * This modifier traverses all statements
  * and propagates type information about them.
  */
-class DFATypeAnalyzer : public StmtModifier
+class BOOMERANG_PLUGIN_API DFATypeAnalyzer : public StmtModifier
 {
 public:
     DFATypeAnalyzer();
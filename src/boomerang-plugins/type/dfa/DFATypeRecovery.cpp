@@ -14,11 +14,13 @@
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/DefUseIndex.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/db/signature/Signature.h"
 #include "boomerang/passes/PassManager.h"
 #include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/ExpPatternMatcher.h"
 #include "boomerang/ssl/exp/Location.h"
 #include "boomerang/ssl/exp/RefExp.h"
 #include "boomerang/ssl/exp/Terminal.h"
@@ -47,15 +49,22 @@
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
 #include "boomerang/visitor/stmtexpvisitor/StmtConstFinder.h"
 
+#include <algorithm>
 #include <cstring>
+#include <deque>
+#include <map>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 
 #define DFA_ITER_LIMIT (100)
 
 // idx + K; leave idx wild
-static const Binary unscaledArrayPat(opPlus, Terminal::get(opWild), Terminal::get(opWildIntConst));
+static const ExpPatternMatcher unscaledArrayPat = {
+    Binary::get(opPlus, Terminal::get(opWild), Terminal::get(opWildIntConst))
+};
 
 
 DFATypeRecovery::DFATypeRecovery(Project *project)
@@ -64,9 +73,9 @@ DFATypeRecovery::DFATypeRecovery(Project *project)
 }
 
 
-void DFATypeRecovery::printResults(StatementList &stmts, int iter)
+void DFATypeRecovery::printResults(StatementList &stmts, int maxVisits)
 {
-    LOG_VERBOSE("%1 iterations", iter);
+    LOG_VERBOSE("At most %1 visits per statement", maxVisits);
 
     for (Statement *s : stmts) {
         LOG_VERBOSE("%1", s); // Print the statement; has dest type
@@ -113,13 +122,13 @@ void DFATypeRecovery::printResults(StatementList &stmts, int iter)
 
 // clang-format off
 // m[idx*K1 + K2]; leave idx wild
-static const Location scaledArrayPat(opMemOf,
-                                     Binary::get(opPlus,
-                                                 Binary::get(opMult,
-                                                             Terminal::get(opWild),
-                                                             Terminal::get(opWildIntConst)),
-                                                 Terminal::get(opWildIntConst)),
-                                     nullptr);
+static const ExpPatternMatcher scaledArrayPat = {
+    Location::memOf(Binary::get(opPlus,
+                                Binary::get(opMult,
+                                            Terminal::get(opWild),
+                                            Terminal::get(opWildIntConst)),
+                                Terminal::get(opWildIntConst)))
+};
 // clang-format on
 
 
@@ -128,16 +137,22 @@ void DFATypeRecovery::replaceArrayIndices(Statement *s)
     UserProc *proc = s->getProc();
     Prog *prog     = proc->getProg();
 
+    const Exp &pattern = *scaledArrayPat.getPattern(0);
+
     std::list<SharedExp> result;
-    s->searchAll(scaledArrayPat, result);
+    s->searchAll(pattern, result);
 
     // We have m[idx*stride + base]
     // Rewrite it as globalN[idx] with addr(globalN) == base
     // with a global array globalN with base type size \e stride
     for (SharedExp arrayExp : result) {
-        const Address base = arrayExp->access<Const, 1, 2>()->getAddr();
-        // const int stride   = arrayExp->access<Const, 1, 1, 2>()->getInt();
-        SharedExp idx = arrayExp->access<Exp, 1, 1, 1>();
+        ExpPatternMatcher::Bindings bindings; // idx, stride, base
+        if (scaledArrayPat.match(arrayExp, &bindings) == -1) {
+            continue;
+        }
+
+        const Address base = bindings[2]->access<Const>()->getAddr();
+        SharedExp idx      = bindings[0];
 
         // Replace with the array expression
         QString name = prog->getGlobalNameByAddr(base);
@@ -147,7 +162,7 @@ void DFATypeRecovery::replaceArrayIndices(Statement *s)
 
         SharedExp array = Binary::get(opArrayIndex, Location::global(name, proc), idx);
 
-        if (s->searchAndReplace(scaledArrayPat, array)) {
+        if (s->searchAndReplace(pattern, array)) {
             if (s->isImplicit()) {
                 // Register an array of appropriate type
                 prog->markGlobalUsed(
@@ -249,56 +264,133 @@ void DFATypeRecovery::dfaTypeAnalysis(UserProc *proc)
     // First use the type information from the signature.
     // Sometimes needed to split variables (e.g. argc as a
     // int and char* in sparc/switch_gcc)
-    bool ch = dfaTypeAnalysis(proc->getSignature().get(), cfg);
+    dfaTypeAnalysis(proc->getSignature().get(), cfg);
     StatementList stmts;
     proc->getStatements(stmts);
 
-    int iter = 0;
+    const bool debugTA = proc->getProg()->getProject()->getSettings()->debugTA;
 
-    for (iter = 1; iter <= DFA_ITER_LIMIT; ++iter) {
-        ch = false;
+    // Types are stored at the definitions, so analyzing a statement can change the type
+    // of its own definition as well as the types of the definitions it uses.
+    // Only the statements that use or define these definitions need to be analyzed again.
+    // Type analysis does not change the definitions used by statements.
+    const DefUseIndex &defUses = proc->getDefUseIndex();
 
-        for (Statement *stmt : stmts) {
-            Statement *before = nullptr;
+    // The types of globals are stored in the Prog instead (see Unary::descendType),
+    // so statements referencing the same global are related as well.
+    std::map<QString, std::vector<Statement *>> globalUsers;
+    std::unordered_map<const Statement *, std::vector<QString>> usedGlobals;
 
-            if (proc->getProg()->getProject()->getSettings()->debugTA) {
-                before = stmt->clone();
-            }
+    for (Statement *stmt : stmts) {
+        Location search(opGlobal, Terminal::get(opWild), proc);
+        std::list<SharedExp> globals;
 
-            DFATypeAnalyzer ana;
-            stmt->accept(&ana);
-            const bool thisCh = ana.hasChanged();
+        if (!stmt->searchAll(search, globals)) {
+            continue;
+        }
 
-            if (thisCh) {
-                ch = true;
+        for (const SharedExp &global : globals) {
+            const QString name = global->access<Const, 1>()->getStr();
+            globalUsers[name].push_back(stmt);
+            usedGlobals[stmt].push_back(name);
+        }
+    }
 
-                if (proc->getProg()->getProject()->getSettings()->debugTA) {
-                    LOG_VERBOSE("  Caused change:\n"
-                                "    FROM: %1\n"
-                                "    TO:   %2",
-                                before, stmt);
-                }
+    std::deque<Statement *> workList;
+    std::unordered_set<const Statement *> inWorkList;
+    std::unordered_map<const Statement *, int> numVisits;
+
+    bool limitExceeded = false;
+
+    auto enqueue = [&](Statement *stmt) {
+        auto it = numVisits.find(stmt);
+        if (it == numVisits.end() || inWorkList.count(stmt) > 0) {
+            return; // not a statement of this procedure, or already queued
+        }
+        else if (it->second >= DFA_ITER_LIMIT) {
+            limitExceeded = true;
+            return;
+        }
+
+        inWorkList.insert(stmt);
+        workList.push_back(stmt);
+    };
+
+    auto enqueueAffected = [&](Statement *stmt) {
+        enqueue(stmt);
+
+        for (Statement *user : defUses.getUsers(stmt)) {
+            enqueue(user);
+        }
+
+        for (const Statement *def : defUses.getUsedDefs(stmt)) {
+            enqueue(const_cast<Statement *>(def));
+
+            for (Statement *user : defUses.getUsers(def)) {
+                enqueue(user);
             }
+        }
 
-            if (proc->getProg()->getProject()->getSettings()->debugTA) {
-                delete before;
+        auto globalsIt = usedGlobals.find(stmt);
+        if (globalsIt != usedGlobals.end()) {
+            for (const QString &name : globalsIt->second) {
+                for (Statement *user : globalUsers[name]) {
+                    enqueue(user);
+                }
             }
         }
+    };
+
+    // All statements are analyzed once. Afterwards, only the statements affected
+    // by a change are analyzed again, until no statement changes any more.
+    for (Statement *stmt : stmts) {
+        numVisits[stmt] = 0;
+        enqueue(stmt);
+    }
+
+    DFATypeAnalyzer ana;
+    int numVisited = 0;
+    int maxVisits  = 0;
+
+    while (!workList.empty()) {
+        Statement *stmt = workList.front();
+        workList.pop_front();
+        inWorkList.erase(stmt);
+
+        maxVisits = std::max(maxVisits, ++numVisits[stmt]);
+        numVisited++;
 
-        if (!ch) {
-            // No more changes: round robin algorithm terminates
-            break;
+        Statement *before = debugTA ? stmt->clone() : nullptr;
+
+        ana.resetChanged();
+        stmt->accept(&ana);
+
+        if (ana.hasChanged()) {
+            enqueueAffected(stmt);
+
+            if (debugTA) {
+                LOG_VERBOSE("  Caused change:\n"
+                            "    FROM: %1\n"
+                            "    TO:   %2",
+                            before, stmt);
+            }
         }
+
+        delete before;
     }
 
-    if (ch) {
+    if (limitExceeded) {
         LOG_VERBOSE("Iteration limit exceeded for dfaTypeAnalysis of procedure '%1'",
                     proc->getName());
     }
 
+    LOG_VERBOSE("DFA type analysis of procedure '%1' finished after %2 statement visits "
+                "(%3 statements, at most %4 visits per statement)",
+                proc->getName(), numVisited, stmts.size(), maxVisits);
+
     if (proc->getProg()->getProject()->getSettings()->debugTA) {
         LOG_MSG("### Results for data flow based type analysis for %1 ###", proc->getName());
-        printResults(stmts, iter);
+        printResults(stmts, maxVisits);
         LOG_MSG("### End results for Data flow based type analysis for %1 ###", proc->getName());
     }
 
@@ -387,19 +479,20 @@ void DFATypeRecovery::dfaTypeAnalysis(UserProc *proc)
                     // We have found a constant in s which has type pointer to array of alpha. We
                     // can't get the parent of con, but we can find it with the pattern
                     // unscaledArrayPat.
+                    const Exp &pattern = *unscaledArrayPat.getPattern(0);
+
                     std::list<SharedExp> result;
-                    s->searchAll(unscaledArrayPat, result);
+                    s->searchAll(pattern, result);
 
                     for (auto &elem : result) {
                         // idx + K
-                        auto bin_rr = std::dynamic_pointer_cast<Binary>(elem);
-
-                        if (!bin_rr) {
+                        ExpPatternMatcher::Bindings bindings;
+                        if (unscaledArrayPat.match(elem, &bindings) == -1) {
                             assert(false);
                             return;
                         }
 
-                        auto constK = bin_rr->access<Const, 2>();
+                        auto constK = bindings[1]->access<Const>();
 
                         // Note: keep searching till we find the pattern with this constant, since
                         // other constants may not be used as pointer to array type.
@@ -408,7 +501,7 @@ void DFATypeRecovery::dfaTypeAnalysis(UserProc *proc)
                         }
 
                         Address K     = Address(constK->getInt());
-                        SharedExp idx = bin_rr->getSubExp1();
+                        SharedExp idx = bindings[0];
                         SharedExp arr = Unary::get(
                             opAddrOf,
                             Binary::get(opArrayIndex,
@@ -422,7 +515,7 @@ void DFATypeRecovery::dfaTypeAnalysis(UserProc *proc)
                             cfg->removeImplicitAssign(static_cast<ImplicitAssign *>(s)->getLeft());
                         }
 
-                        if (!s->searchAndReplace(unscaledArrayPat, arr)) {
+                        if (!s->searchAndReplace(pattern, arr)) {
                             arr = nullptr; // remove if not emplaced in s
                         }
 
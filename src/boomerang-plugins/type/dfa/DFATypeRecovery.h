@@ -56,7 +56,8 @@ private:
     bool dfaTypeAnalysis(Signature *signature, ProcCFG *cfg);
     bool dfaTypeAnalysis(Statement *stmt);
 
-    void printResults(StatementList &stmts, int iter);
+    /// Print the types of all statements after \p maxVisits visits of a statement at most
+    void printResults(StatementList &stmts, int maxVisits);
 
     /// Replace array references of the form m[idx*K1 + K2]
     /// in \p s. Create global array variables as needed.
@@ -13,6 +13,8 @@
 #include "boomerang/core/Watcher.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/binary/BinarySymbolTable.h"
+#include "boomerang/db/serialization/SaveFileReader.h"
+#include "boomerang/db/serialization/SaveFileWriter.h"
 #include "boomerang/decomp/ProgDecompiler.h"
 #include "boomerang/util/CallGraphDotWriter.h"
 #include "boomerang/util/ProgSymbolWriter.h"
@@ -116,35 +118,69 @@ bool Project::loadBinaryFile(const QString &filePath)
         unloadBinaryFile();
     }
 
-    QFile srcFile(filePath);
-    if (!srcFile.open(QFile::ReadOnly)) {
-        LOG_WARN("Opening '%1' failed");
+    std::unique_ptr<QFile> srcFile(new QFile(filePath));
+    if (!srcFile->open(QFile::ReadOnly)) {
+        LOG_WARN("Opening '%1' failed", filePath);
         return false;
     }
 
-    m_loadedBinary.reset(new BinaryFile(srcFile.readAll(), loader));
+    if (getSettings()->mapBinaryFiles) {
+        m_loadedBinary.reset(new BinaryFile(std::move(srcFile), loader));
+    }
+    else {
+        m_loadedBinary.reset(new BinaryFile(srcFile->readAll(), loader));
+    }
 
     if (loader->loadFromFile(m_loadedBinary.get()) == false) {
         return false;
     }
 
     m_loadedBinary->getImage()->updateTextLimits();
+    m_loadedBinaryPath = QFileInfo(filePath).absoluteFilePath();
 
     return createProg(m_loadedBinary.get(), QFileInfo(filePath).baseName()) != nullptr;
 }
 
 
-bool Project::loadSaveFile(const QString & /*filePath*/)
+bool Project::loadSaveFile(const QString &filePath)
 {
-    LOG_ERROR("Loading save files is not implemented.");
-    return false;
+    LOG_MSG("Loading save file '%1'", filePath);
+
+    std::unique_ptr<SaveFileReader> reader(new SaveFileReader());
+    if (!reader->open(filePath)) {
+        return false;
+    }
+
+    const QString binaryFilePath = reader->getBinaryFilePath();
+    if (QFileInfo(binaryFilePath).size() != reader->getBinaryFileSize()) {
+        LOG_ERROR("Cannot load save file '%1': Binary file '%2' is missing or has changed",
+                  filePath, binaryFilePath);
+        return false;
+    }
+    else if (!loadBinaryFile(binaryFilePath)) {
+        return false;
+    }
+
+    m_prog->readDefaultLibraryCatalogues();
+
+    if (!reader->readProg(m_prog.get())) {
+        unloadBinaryFile();
+        return false;
+    }
+
+    m_saveFileReader = std::move(reader);
+    return true;
 }
 
 
-bool Project::writeSaveFile(const QString & /*filePath*/)
+bool Project::writeSaveFile(const QString &filePath)
 {
-    LOG_ERROR("Saving save files is not implemented.");
-    return false;
+    if (!m_prog) {
+        LOG_ERROR("Cannot write save file: No binary file is loaded.");
+        return false;
+    }
+
+    return SaveFileWriter().writeSaveFile(m_prog.get(), m_loadedBinaryPath, filePath);
 }
 
 
@@ -157,7 +193,9 @@ bool Project::isBinaryLoaded() const
 void Project::unloadBinaryFile()
 {
     m_prog.reset();
+    m_saveFileReader.reset();
     m_loadedBinary.reset();
+    m_loadedBinaryPath.clear();
 }
 
 
@@ -212,6 +250,10 @@ bool Project::decompileBinaryFile()
         return false;
     }
 
+    if (m_saveFileReader) {
+        m_saveFileReader->loadAllBodies();
+    }
+
     ProgDecompiler dcomp(m_prog.get());
     dcomp.decompile();
 
@@ -230,6 +272,10 @@ bool Project::generateCode(Module *module)
         return false;
     }
 
+    if (m_saveFileReader) {
+        m_saveFileReader->loadAllBodies();
+    }
+
     LOG_MSG("Generating code...");
     for (auto &plugin : m_pluginManager->getPluginsByType(PluginType::CodeGenerator)) {
         ICodeGenerator *gen = plugin->getIfc<ICodeGenerator>();
@@ -250,6 +296,7 @@ Prog *Project::createProg(BinaryFile *file, const QString &name)
     // unload old Prog before creating a new one
     m_fe = nullptr;
     m_prog.reset();
+    m_saveFileReader.reset();
 
     m_prog.reset(new Prog(name, this));
     m_fe = createFrontEnd();
@@ -393,8 +440,17 @@ void Project::addWatcher(IWatcher *watcher)
 }
 
 
+void Project::removeWatcher(IWatcher *watcher)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_watcherMutex);
+    m_watchers.erase(watcher);
+}
+
+
 void Project::alertDecompileDebugPoint(UserProc *p, const char *description)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watcherMutex);
+
     for (IWatcher *elem : m_watchers) {
         elem->onDecompileDebugPoint(p, description);
     }
@@ -467,6 +523,8 @@ void Project::alertEndDecode()
 
 void Project::alertStartDecompile(UserProc *proc)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watcherMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onStartDecompile(proc);
     }
@@ -475,6 +533,8 @@ void Project::alertStartDecompile(UserProc *proc)
 
 void Project::alertProcStatusChanged(UserProc *proc)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watcherMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onProcStatusChange(proc);
     }
@@ -483,6 +543,8 @@ void Project::alertProcStatusChanged(UserProc *proc)
 
 void Project::alertEndDecompile(UserProc *proc)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watcherMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onEndDecompile(proc);
     }
@@ -491,6 +553,8 @@ void Project::alertEndDecompile(UserProc *proc)
 
 void Project::alertDiscovered(Function *function)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watcherMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onFunctionDiscovered(function);
     }
@@ -499,6 +563,8 @@ void Project::alertDiscovered(Function *function)
 
 void Project::alertDecompiling(UserProc *proc)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_watcherMutex);
+
     for (IWatcher *it : m_watchers) {
         it->onDecompileInProgress(proc);
     }
@@ -15,7 +15,10 @@
 #include "boomerang/ifc/IFileLoader.h"
 #include "boomerang/util/Address.h"
 
+#include <QString>
+
 #include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 
@@ -28,11 +31,10 @@ class ITypeRecovery;
 class IWatcher;
 class Module;
 class Prog;
+class SaveFileReader;
 class Settings;
 class UserProc;
 
-class QString;
-
 
 class BOOMERANG_API Project
 {
@@ -81,7 +83,8 @@ public:
     /**
      * Load a saved file from \p filePath.
      * If a binary file is already loaded, it is unloaded first (all unsaved data is lost).
-     * \note Not yet implemented.
+     * The binary file the save file was created from is loaded again; it must not have changed.
+     * Procedure bodies are loaded from the save file when they are first accessed.
      * \returns true iff loading was successful.
      */
     bool loadSaveFile(const QString &filePath);
@@ -89,7 +92,6 @@ public:
     /**
      * Save data to the save file at \p filePath.
      * If the file already exists, it is overwritten.
-     * \note Not yet implemented.
      * \returns true iff saving was successful.
      */
     bool writeSaveFile(const QString &filePath);
@@ -123,11 +125,29 @@ public:
      */
     bool generateCode(Module *module = nullptr);
 
+    /// \returns the number of procedures restored from the decompilation cache
+    /// by the last call to \ref decompileBinaryFile.
+    int getNumCacheHits() const { return m_numCacheHits; }
+
+    /// \returns the number of procedures that could not be restored from the decompilation
+    /// cache by the last call to \ref decompileBinaryFile.
+    int getNumCacheMisses() const { return m_numCacheMisses; }
+
+    /// Set the decompilation cache statistics of the current decompilation.
+    void setCacheStatistics(int numHits, int numMisses)
+    {
+        m_numCacheHits   = numHits;
+        m_numCacheMisses = numMisses;
+    }
+
 public:
     /// Register a watcher to receive events about the decompilation.
     /// Does NOT take ownership of the pointer.
     void addWatcher(IWatcher *watcher);
 
+    /// Unregister a watcher previously registered by \ref addWatcher.
+    void removeWatcher(IWatcher *watcher);
+
     /// Called once after a function was created.
     void alertFunctionCreated(Function *function);
 
@@ -210,10 +230,21 @@ private:
     /// The watchers which are interested in this decompilation.
     std::set<IWatcher *> m_watchers;
 
+    /// Watchers are notified by one thread at a time,
+    /// even if procedures are decompiled in parallel.
+    std::recursive_mutex m_watcherMutex;
+
     std::unique_ptr<PluginManager> m_pluginManager;
 
     std::unique_ptr<BinaryFile> m_loadedBinary;
+    QString m_loadedBinaryPath; ///< Absolute path of the loaded binary file
+
+    /// Reader of the loaded save file; loads procedure bodies on demand.
+    std::unique_ptr<SaveFileReader> m_saveFileReader;
     std::unique_ptr<Prog> m_prog;
 
+    int m_numCacheHits   = 0;
+    int m_numCacheMisses = 0;
+
     IFrontEnd *m_fe;
 };
@@ -12,6 +12,7 @@
 #include "boomerang/util/log/Log.h"
 
 #include <QCoreApplication>
+#include <QStandardPaths>
 
 
 Settings::Settings()
@@ -22,6 +23,11 @@ Settings::Settings()
     setDataDirectory(appDirPath + "/../share/boomerang");
     setPluginDirectory(appDirPath + "/../lib/boomerang/plugins");
     setOutputDirectory("./output");
+
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (!cacheDir.isEmpty()) {
+        signatureCacheDir = QDir(cacheDir).absoluteFilePath("signatures");
+    }
 }
 
 
@@ -45,6 +45,11 @@ public:
     /// Get the path where the decompiled files should be put
     QDir getOutputDirectory() const { return m_outputDirectory; }
 
+    /// \returns the number of threads for tasks that may reach a debug point
+    /// (see \ref stopAtDebugPoints). This is 1 when stopping at debug points,
+    /// since the debugger must not stop inside a worker thread.
+    int getNumDebuggableThreads() const { return stopAtDebugPoints ? 1 : numThreads; }
+
 public:
     // Command line flags
     bool verboseOutput       = false;
@@ -87,6 +92,42 @@ public:
     bool assumeABI         = false; ///< Assume ABI compliance
     bool experimental      = false; ///< Activate experimental code. Caution!
 
+    /// Number of threads used to decode procedures, to compress CFGs
+    /// and to generate code. Procedures are still decompiled on a single thread.
+    /// Values < 1 mean one thread per hardware thread.
+    int numThreads = 1;
+
+    /// Allocate statements, RTLs and expressions created while decoding or loading a procedure
+    /// from a per-procedure memory arena that is released in one go when the procedure
+    /// is re-decoded or deleted. Decompilation passes allocate from the heap.
+    bool useProcArenas = false;
+
+    /// Map binary files into memory instead of reading them.
+    /// Unmodified file contents are then shared with the OS page cache instead of being copied.
+    bool mapBinaryFiles = false;
+
+    /// Check all CFGs in Prog::isWellFormed, not only the ones modified since the last check.
+    /// Very slow for large programs; intended for debugging.
+    bool checkAllCFGs = false;
+
+    /// After each pass that used the def-use index of a procedure, check the index
+    /// against a full rescan of the procedure. Slow; intended for debugging.
+    bool verifyDefUses = false;
+
+    /// Directory where the results of decompiling procedures are cached,
+    /// so that unchanged procedures are not decompiled again. Empty to disable the cache.
+    QString decompilationCacheDir;
+
+    /// Directory where signature catalogs are stored precompiled,
+    /// so that their signature files do not have to be parsed again.
+    /// Defaults to the user's cache directory. Empty to always parse the signature files.
+    QString signatureCacheDir;
+
+    /// Collect timing and change statistics of all passes and write them to this file
+    /// at the end of decompilation (as CSV if the file name ends with ".csv", JSON otherwise).
+    /// Statistics are not collected if empty.
+    QString passStatsFile;
+
     QString replayFile;  ///< file with commands to execute in interactive mode
     QString sslFileName; ///< Use this SSL file instead of one of the hard-coded ones.
 
@@ -22,6 +22,20 @@
 #include "boomerang/util/log/Log.h"
 
 
+/// Mark the CFG of the procedure containing \p bb as modified.
+static void setCFGModified(BasicBlock *bb)
+{
+    Function *function = bb->getFunction();
+
+    if (function && !function->isLib()) {
+        ProcCFG *cfg = static_cast<UserProc *>(function)->getCFG();
+        if (cfg) {
+            cfg->setModified();
+        }
+    }
+}
+
+
 BasicBlock::BasicBlock(Address lowAddr, Function *function)
     : m_function(function)
     , m_lowAddr(lowAddr)
@@ -103,6 +117,7 @@ void BasicBlock::setRTLs(std::unique_ptr<RTLList> rtls)
 {
     m_listOfRTLs = std::move(rtls);
     updateBBAddresses();
+    setCFGModified(this);
 
     if (!m_listOfRTLs) {
         return;
@@ -223,6 +238,7 @@ void BasicBlock::setPredecessor(int i, BasicBlock *predecessor)
 {
     assert(Util::inRange(i, 0, getNumPredecessors()));
     m_predecessors[i] = predecessor;
+    setCFGModified(this);
 }
 
 
@@ -230,6 +246,7 @@ void BasicBlock::setSuccessor(int i, BasicBlock *successor)
 {
     assert(Util::inRange(i, 0, getNumSuccessors()));
     m_successors[i] = successor;
+    setCFGModified(this);
 }
 
 
@@ -260,12 +277,28 @@ const BasicBlock *BasicBlock::getSuccessor(int i) const
 void BasicBlock::addPredecessor(BasicBlock *predecessor)
 {
     m_predecessors.push_back(predecessor);
+    setCFGModified(this);
 }
 
 
 void BasicBlock::addSuccessor(BasicBlock *successor)
 {
     m_successors.push_back(successor);
+    setCFGModified(this);
+}
+
+
+void BasicBlock::removeAllPredecessors()
+{
+    m_predecessors.clear();
+    setCFGModified(this);
+}
+
+
+void BasicBlock::removeAllSuccessors()
+{
+    m_successors.clear();
+    setCFGModified(this);
 }
 
 
@@ -275,6 +308,7 @@ void BasicBlock::removePredecessor(BasicBlock *pred)
     for (auto it = m_predecessors.begin(); it != m_predecessors.end(); ++it) {
         if (*it == pred) {
             m_predecessors.erase(it);
+            setCFGModified(this);
             return;
         }
     }
@@ -287,6 +321,7 @@ void BasicBlock::removeSuccessor(BasicBlock *succ)
     for (auto it = m_successors.begin(); it != m_successors.end(); ++it) {
         if (*it == succ) {
             m_successors.erase(it);
+            setCFGModified(this);
             return;
         }
     }
@@ -169,10 +169,10 @@ public:
 
     /// Removes all successor BBs.
     /// Called when noreturn call is found
-    void removeAllSuccessors() { m_successors.clear(); }
+    void removeAllSuccessors();
 
     /// removes all predecessor BBs.
-    void removeAllPredecessors() { m_predecessors.clear(); }
+    void removeAllPredecessors();
 
     /// \returns true if this BB is a (direct) predecessor of \p bb,
     /// i.e. there is an edge from this BB to \p bb
@@ -12,6 +12,7 @@
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/DefUseIndex.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/proc/ProcCFG.h"
 #include "boomerang/db/proc/UserProc.h"
@@ -24,6 +25,7 @@
 #include "boomerang/visitor/expmodifier/ExpSSAXformer.h"
 #include "boomerang/visitor/expmodifier/ImplicitConverter.h"
 
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 
@@ -40,24 +42,40 @@ DataFlow::~DataFlow()
 }
 
 
-void DataFlow::dfs(int myIdx, int parentIdx)
+void DataFlow::dfs(int entryIdx)
 {
-    if (m_dfnum[myIdx] != -1) {
-        // already visited
-        return;
-    }
-
-    m_dfnum[myIdx]  = N;
-    m_vertex[N]     = myIdx;
-    m_parent[myIdx] = parentIdx;
+    // Iterative version of a recursive pre-order traversal, so that very deep CFGs
+    // cannot overflow the stack. Each stack entry is a node and its next successor to visit.
+    std::vector<std::pair<int, std::size_t>> stack;
 
+    m_dfnum[entryIdx]  = N;
+    m_vertex[N]        = entryIdx;
+    m_parent[entryIdx] = -1;
     N++;
 
-    // Recurse to successors
-    BasicBlock *bb = m_BBs[myIdx];
+    stack.push_back({ entryIdx, 0 });
+
+    while (!stack.empty()) {
+        const int myIdx                       = stack.back().first;
+        const std::vector<BasicBlock *> &succ = m_BBs[myIdx]->getSuccessors();
+
+        if (stack.back().second >= succ.size()) {
+            stack.pop_back();
+            continue;
+        }
+
+        const int succIdx = m_indices[succ[stack.back().second++]];
+        if (m_dfnum[succIdx] != -1) {
+            // already visited
+            continue;
+        }
 
-    for (BasicBlock *succ : bb->getSuccessors()) {
-        dfs(m_indices[succ], myIdx);
+        m_dfnum[succIdx]  = N;
+        m_vertex[N]       = succIdx;
+        m_parent[succIdx] = myIdx;
+        N++;
+
+        stack.push_back({ succIdx, 0 });
     }
 }
 
@@ -72,28 +90,39 @@ bool DataFlow::calculateDominators()
         return false; // nothing to do
     }
 
+    if (m_domVersion == cfg->getVersion()) {
+        // The CFG did not change since the dominators were calculated,
+        // so only the placement of phi functions starts over.
+        clearA_phi();
+        return true;
+    }
+
     N = 0;
     allocateData();
 
     // calculate spanning tree
-    dfs(0, -1);
+    dfs(0);
     assert(N >= 1);
 
     // Process BBs in reverse pre-traversal order (i.e. return blocks first)
     for (int i = N - 1; i >= 1; i--) {
         int n = m_vertex[i];
-        int p = m_parent[n];
-        int s = p;
+        int s = m_parent[n];
 
         /* These lines calculate the semi-dominator of n, based on the Semidominator Theorem */
         // for each predecessor v of n
         for (BasicBlock *pred : m_BBs[n]->getPredecessors()) {
-            if (m_indices.find(pred) == m_indices.end()) {
+            auto it = m_indices.find(pred);
+            if (it == m_indices.end()) {
                 LOG_ERROR("BB not in indices: ", pred->toString());
                 return false;
             }
 
-            int v     = m_indices[pred];
+            int v = it->second;
+            if (m_dfnum[v] == -1) {
+                continue; // unreachable predecessor
+            }
+
             int sdash = v;
 
             if (m_dfnum[v] > m_dfnum[n]) {
@@ -106,58 +135,54 @@ bool DataFlow::calculateDominators()
         }
 
         m_semi[n] = s;
-        /* Calculation of n's dominator is deferred until the path from s to n has been linked
-         * intothe forest */
-        m_bucket[s].insert(n);
-        link(p, n);
-
-        // for each v in bucket[p]
-        for (int v : m_bucket[p]) {
-            /* Now that the path from p to v has been linked into the spanning forest,
-             * these lines calculate the dominator of v, based on the first clause of the Dominator
-             * Theorem,# or else defer the calculation until y's dominator is known. */
-            int y = getAncestorWithLowestSemi(v);
-
-            if (m_semi[y] == m_semi[v]) {
-                m_idom[v] = p; // Success!
-            }
-            else {
-                m_samedom[v] = y; // Defer
-            }
-        }
-
-        m_bucket[p].clear();
+        link(m_parent[n], n);
     }
 
-    for (int i = 1; i < N - 1; i++) {
-        /* Now all the deferred dominator calculations, based on the second clause of the Dominator
-         * Theorem, are performed. */
-        int n = m_vertex[i];
+    // The immediate dominator of n is the nearest common ancestor of n's parent and semi-dominator
+    // in the dominator tree (Semi-NCA, Georgiadis 2005). Visit the BBs in pre-order so that
+    // the dominators of all ancestors in the spanning tree are known.
+    for (int i = 1; i < N; i++) {
+        int n    = m_vertex[i];
+        int idom = m_parent[n];
 
-        if (m_samedom[n] != -1) {
-            m_idom[n] = m_idom[m_samedom[n]]; // Deferred success!
+        while (m_dfnum[idom] > m_dfnum[m_semi[n]]) {
+            idom = m_idom[idom];
         }
+
+        m_idom[n] = idom;
     }
 
     // the entry BB is always executed.
     m_idom[0] = 0;
     m_semi[0] = 0;
 
-    computeDF(0); // Finally, compute the dominance frontiers
+    computeDF(); // Finally, compute the dominance frontiers
+
+    m_domVersion = cfg->getVersion();
     return true;
 }
 
 
 int DataFlow::getAncestorWithLowestSemi(int v)
 {
-    int a = m_ancestor[v];
+    // Iterative version of algorithm 19.10b of Appel 2002. First find the path to the node
+    // just below the root of the tree in the spanning forest, then compress it top-down.
+    std::vector<int> &path = m_path;
+    path.clear();
+
+    for (int u = v; m_ancestor[m_ancestor[u]] != -1; u = m_ancestor[u]) {
+        path.push_back(u);
+    }
+
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+        const int u = *it;
+        const int a = m_ancestor[u];
+        const int b = m_best[a];
 
-    if (m_ancestor[a] != -1) {
-        int b         = getAncestorWithLowestSemi(a);
-        m_ancestor[v] = m_ancestor[a];
+        m_ancestor[u] = m_ancestor[a];
 
-        if (m_dfnum[m_semi[b]] < m_dfnum[m_semi[m_best[v]]]) {
-            m_best[v] = b;
+        if (m_dfnum[m_semi[b]] < m_dfnum[m_semi[m_best[u]]]) {
+            m_best[u] = b;
         }
     }
 
@@ -172,60 +197,40 @@ void DataFlow::link(int p, int n)
 }
 
 
-bool DataFlow::doesDominate(int n, int w)
+void DataFlow::computeDF()
 {
-    while (m_idom[w] != w) {
-        if (m_idom[w] == n) {
-            return true;
-        }
+    // y is in the dominance frontier of n iff n dominates a predecessor of y,
+    // but does not strictly dominate y. So walk up the dominator tree from each predecessor
+    // of y until the immediate dominator of y is reached (Cooper, Harvey, Kennedy 2001).
+    // The entry node has no dominator, so the walk continues up to the root for it.
+    const int numBB = static_cast<int>(m_BBs.size());
 
-        w = m_idom[w]; // Move up the dominator tree
-    }
+    m_DF.assign(numBB, std::vector<int>());
 
-    return false;
-}
-
-
-void DataFlow::computeDF(int n)
-{
-    std::set<int> S;
-    // This loop computes DF_local[n]
-    // for each node y in succ(n)
-    BasicBlock *bb = m_BBs[n];
-
-    for (BasicBlock *b : bb->getSuccessors()) {
-        int y = m_indices[b];
-
-        if (m_idom[y] != n) {
-            S.insert(y);
+    for (int y = 0; y < numBB; ++y) {
+        if (m_dfnum[y] == -1) {
+            continue; // unreachable
         }
-    }
 
-    // for each child c of n in the dominator tree
-    // Note: this is a linear search!
-    const int sz = m_idom.size(); // ? Was ancestor.size()
+        const int stop = (y == 0) ? -1 : m_idom[y];
 
-    for (int c = 0; c < sz; ++c) {
-        if (m_idom[c] != n) {
-            continue;
-        }
-        else if (c != n) { // do not calculate DF for entry BB again
-            computeDF(c);
-        }
+        for (BasicBlock *pred : m_BBs[y]->getPredecessors()) {
+            int runner = m_indices[pred];
+            if (m_dfnum[runner] == -1) {
+                continue;
+            }
 
-        /* This loop computes DF_up[c] */
-        // for each element w of DF[c]
-        std::set<int> &s = m_DF[c];
-        std::set<int>::iterator ww;
+            while (runner != stop) {
+                std::vector<int> &df = m_DF[runner];
+                if (!df.empty() && df.back() == y) {
+                    break; // already walked from here for another predecessor
+                }
 
-        for (int w : s) {
-            if (n == w || !doesDominate(n, w)) {
-                S.insert(w);
+                df.push_back(y);
+                runner = (runner == 0) ? -1 : m_idom[runner];
             }
         }
     }
-
-    m_DF[n] = S;
 }
 
 
@@ -266,45 +271,19 @@ bool DataFlow::canRename(SharedConstExp exp) const
 
 bool DataFlow::placePhiFunctions()
 {
-    // First free some memory no longer needed
-    m_dfnum.resize(0);
-    m_semi.resize(0);
-    m_ancestor.resize(0);
-    m_samedom.resize(0);
-    m_vertex.resize(0);
-    m_parent.resize(0);
-    m_best.resize(0);
-    m_bucket.resize(0);
-    m_defsites.clear();
-    m_defallsites.clear();
-
-    for (ExSet &exps : m_definedAt) {
-        for (auto iter = exps.begin(); iter != exps.end();) {
-            if (m_A_phi.find(*iter) == m_A_phi.end()) {
-                iter = exps.erase(iter);
-            }
-            else {
-                ++iter;
-            }
-        }
-    }
-
-    m_definedAt.clear(); // and A_orig,
-    m_defStmts.clear();  // and the map from variable to defining Stmt
-
-
-    // Set the sizes of needed vectors
     const int numIndices = m_indices.size();
     const int numBB      = m_proc->getCFG()->getNumBBs();
     assert(numIndices == numBB);
     Q_UNUSED(numIndices);
 
-    m_definedAt.resize(numBB);
-
     const bool assumeABICompliance = m_proc->getProg()->getProject()->getSettings()->assumeABI;
 
-    // We need to create m_definedAt[n] for all n
-    // Recreate each call because propagation and other changes make old data invalid
+    // Collect the BBs defining each renamable location, indexed by location ID.
+    // Recreate these on each call because propagation and other changes make old data invalid.
+    std::vector<BitSet> defsites;
+    std::vector<int> definedLocs; ///< IDs of all locations defined in this procedure
+    BitSet defallsites;           ///< BBs defining all locations
+
     for (int n = 0; n < numBB; n++) {
         BasicBlock::RTLIterator rit;
         StatementList::iterator sit;
@@ -317,62 +296,93 @@ bool DataFlow::placePhiFunctions()
             // If this is a childless call
             if (stmt->isCall() && static_cast<const CallStatement *>(stmt)->isChildless()) {
                 // then this block defines every variable
-                m_defallsites.insert(n);
+                defallsites.set(n);
             }
 
             for (const SharedExp &exp : locationSet) {
-                if (canRename(exp)) {
-                    m_definedAt[n].insert(exp->clone());
-                    m_defStmts[exp] = stmt;
+                if (!canRename(exp)) {
+                    continue;
+                }
+
+                const int id = getLocationID(exp);
+                if (id >= static_cast<int>(defsites.size())) {
+                    defsites.resize(m_locations.size());
+                }
+
+                if (defsites[id].none()) {
+                    definedLocs.push_back(id);
                 }
+
+                defsites[id].set(n);
             }
         }
     }
 
-    for (int n = 0; n < numBB; n++) {
-        for (const SharedExp &a : m_definedAt[n]) {
-            m_defsites[a].insert(n);
+    // Phis are inserted in the same order as the variables are visited,
+    // so visit them in a deterministic order.
+    std::sort(definedLocs.begin(), definedLocs.end(), [this](int a, int b) {
+        return lessExpStar()(m_locations[a], m_locations[b]);
+    });
+
+    BitSet wasQueued(numBB);
+    std::vector<int> worklist;
+
+    auto enqueue = [&wasQueued, &worklist](int n) {
+        if (!wasQueued.test(n)) {
+            wasQueued.set(n);
+            worklist.push_back(n);
         }
-    }
+    };
 
     bool change = false;
-    // For each variable a (in defsites, i.e. defined anywhere)
-    for (auto &val : m_defsites) {
-        SharedExp a = val.first;
+
+    // For each variable a defined anywhere
+    for (int id : definedLocs) {
+        const BitSet &sites = defsites[id];
+        BitSet &phiSites    = m_A_phi[id];
 
         // Those variables that are defined everywhere (i.e. in defallsites)
         // need to be defined at every defsite, too
-        for (int da : m_defallsites) {
-            m_defsites[a].insert(da);
+        worklist.clear();
+        for (std::size_t n = sites.findFirst(); n != BitSet::npos; n = sites.findNext(n + 1)) {
+            enqueue(n);
         }
 
-        std::set<int> W = m_defsites[a];
-
-        while (!W.empty()) {
-            // Pop first node from W
-            const int n = *W.begin();
-            W.erase(W.begin());
+        for (std::size_t n = defallsites.findFirst(); n != BitSet::npos;
+             n = defallsites.findNext(n + 1)) {
+            enqueue(n);
+        }
 
-            for (int y : m_DF[n]) {
+        // The worklist is never shrunk, so it can be used to reset the marks below.
+        for (std::size_t i = 0; i < worklist.size(); ++i) {
+            // The dominance frontiers are kept as sorted lists instead of bit sets
+            // because they are sparse and only ever iterated.
+            for (int y : m_DF[worklist[i]]) {
                 // phi function already created for y?
-                if (m_A_phi[a].find(y) != m_A_phi[a].end()) {
+                if (phiSites.test(y)) {
                     continue;
                 }
 
                 // Insert trivial phi function for a at top of block y: a := phi()
                 change = true;
-                m_BBs[y]->addPhi(a->clone());
+                phiSites.set(y); // A_phi[a] <- A_phi[a] U {y}
+                PhiAssign *phi = m_BBs[y]->addPhi(m_locations[id]->clone());
 
-                // A_phi[a] <- A_phi[a] U {y}
-                m_A_phi[a].insert(y);
+                if (phi && m_proc->isDefUseIndexValid()) {
+                    m_proc->getDefUseIndex().addStatement(phi);
+                }
 
                 // if a !elementof A_orig[y]
-                if (!m_definedAt[y].contains(a)) {
+                if (!sites.test(y)) {
                     // W <- W U {y}
-                    W.insert(y);
+                    enqueue(y);
                 }
             }
         }
+
+        for (int n : worklist) {
+            wasQueued.reset(n);
+        }
     }
 
     return change;
@@ -383,51 +393,45 @@ void DataFlow::convertImplicits()
 {
     ProcCFG *cfg = m_proc->getCFG();
 
-    // Convert statements in A_phi from m[...]{-} to m[...]{0}
-    std::map<SharedExp, std::set<int>, lessExpStar> A_phi_copy = m_A_phi; // Object copy
+    // Convert locations in A_phi from m[...]{-} to m[...]{0}
+    const std::vector<SharedExp> locations = std::move(m_locations);
+    const std::vector<BitSet> A_phi        = std::move(m_A_phi);
     ImplicitConverter ic(cfg);
-    m_A_phi.clear();
+    clearA_phi();
 
-    for (std::pair<SharedExp, std::set<int>> it : A_phi_copy) {
-        SharedExp e = it.first->clone();
+    for (std::size_t id = 0; id < locations.size(); ++id) {
+        SharedExp e = locations[id]->clone();
         e           = e->acceptModifier(&ic);
-        m_A_phi[e]  = it.second; // Copy the set (doesn't have to be deep)
+        m_A_phi[getLocationID(e)] |= A_phi[id];
     }
+}
 
-    std::map<SharedExp, std::set<int>, lessExpStar> defsites_copy = m_defsites; // Object copy
-    m_defsites.clear();
 
-    for (std::pair<SharedExp, std::set<int>> dd : defsites_copy) {
-        SharedExp e   = dd.first->clone();
-        e             = e->acceptModifier(&ic);
-        m_defsites[e] = dd.second; // Copy the set (doesn't have to be deep)
+int DataFlow::getLocationID(const SharedExp &e)
+{
+    auto it = m_locationIDs.find(e);
+    if (it != m_locationIDs.end()) {
+        return it->second;
     }
 
-    std::vector<ExSet> definedAtCopy = m_definedAt;
-    m_definedAt.clear();
-
-    for (ExSet &se : definedAtCopy) {
-        ExSet se_new;
-
-        for (const SharedExp &ee : se) {
-            SharedExp e = ee->clone()->acceptModifier(&ic);
-            se_new.insert(e);
-        }
-
-        // Copy the set (doesn't have to be a deep copy)
-        m_definedAt.insert(m_definedAt.end(), se_new);
-    }
+    const int id = static_cast<int>(m_locations.size());
+    m_locations.push_back(e->clone());
+    m_A_phi.emplace_back();
+    m_locationIDs.insert({ m_locations.back(), id });
+    return id;
 }
 
 
-void DataFlow::findLiveAtDomPhi(LocationSet &usedByDomPhi, LocationSet &usedByDomPhi0,
+void DataFlow::findLiveAtDomPhi(HashedLocationSet &usedByDomPhi,
+                                HashedLocationSet &usedByDomPhi0,
                                 std::map<SharedExp, PhiAssign *, lessExpStar> &defdByPhi)
 {
     return findLiveAtDomPhi(0, usedByDomPhi, usedByDomPhi0, defdByPhi);
 }
 
 
-void DataFlow::findLiveAtDomPhi(int n, LocationSet &usedByDomPhi, LocationSet &usedByDomPhi0,
+void DataFlow::findLiveAtDomPhi(int n, HashedLocationSet &usedByDomPhi,
+                                HashedLocationSet &usedByDomPhi0,
                                 std::map<SharedExp, PhiAssign *, lessExpStar> &defdByPhi)
 {
     if (m_BBs.empty()) {
@@ -513,18 +517,12 @@ void DataFlow::allocateData()
     m_semi.assign(numBBs, -1);
     m_ancestor.assign(numBBs, -1);
     m_idom.assign(numBBs, -1);
-    m_samedom.assign(numBBs, -1);
     m_vertex.assign(numBBs, -1);
     m_parent.assign(numBBs, -1);
     m_best.assign(numBBs, -1);
-    m_bucket.resize(numBBs);
-    m_definedAt.resize(numBBs);
-    m_DF.resize(numBBs);
-
-    m_A_phi.clear();
-    m_defsites.clear();
-    m_defallsites.clear();
-    m_defStmts.clear();
+    m_DF.assign(numBBs, std::vector<int>());
+
+    clearA_phi();
 
 
     // Set up the BBs and indices vectors. Do this here
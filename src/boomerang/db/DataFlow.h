@@ -10,10 +10,13 @@
 #pragma once
 
 
+#include "boomerang/util/BitSet.h"
+#include "boomerang/util/HashedLocationSet.h"
 #include "boomerang/util/LocationSet.h"
 
 #include <map>
 #include <unordered_map>
+#include <vector>
 
 
 class BasicBlock;
@@ -26,8 +29,6 @@ class PhiAssign;
  */
 class BOOMERANG_API DataFlow
 {
-    using ExSet = ExpSet<Exp>;
-
 public:
     DataFlow(UserProc *proc);
     DataFlow(const DataFlow &other) = delete;
@@ -40,9 +41,13 @@ public:
 
 public:
     /**
-     * Calculate dominators for every node n using Lengauer-Tarjan with path compression.
-     * Essentially Algorithm 19.9 of Appel's
-     * "Modern compiler implementation in Java" 2nd ed 2002
+     * Calculate dominators and dominance frontiers for every node n.
+     * Semi-dominators are calculated as in Algorithm 19.9 of Appel's
+     * "Modern compiler implementation in Java" 2nd ed 2002, immediate dominators
+     * by the Semi-NCA algorithm.
+     *
+     * The result is cached until the CFG is modified (see \ref ProcCFG::getVersion);
+     * calling this function for an unmodified CFG only resets the placement of phi functions.
      */
     bool calculateDominators();
 
@@ -76,7 +81,7 @@ public:
      * each location is defined only once, so that's the time to decide if it is dominated by a phi
      * use or not.
      */
-    void findLiveAtDomPhi(LocationSet &usedByDomPhi, LocationSet &usedByDomPhi0,
+    void findLiveAtDomPhi(HashedLocationSet &usedByDomPhi, HashedLocationSet &usedByDomPhi0,
                           std::map<SharedExp, PhiAssign *, lessExpStar> &defdByPhi);
 
     // for testing
@@ -110,16 +115,17 @@ public:
 
     int pbbToNode(const BasicBlock *bb) const { return m_indices.at(const_cast<BasicBlock *>(bb)); }
 
-    std::set<int> &getDF(int node) { return m_DF[node]; }
+    const std::vector<int> &getDF(int node) const { return m_DF[node]; }
     int getIdom(int node) const { return m_idom[node]; }
     int getSemi(int node) const { return m_semi[node]; }
-    std::set<int> &getA_phi(SharedExp e) { return m_A_phi[e]; }
+
+    /// \returns the indices of the BBs needing a phi for \p e
+    const BitSet &getA_phi(const SharedExp &e) { return m_A_phi[getLocationID(e)]; }
 
 private:
-    /// depth first search
-    /// \param myIdx index of the current BB
-    /// \param parentIdx index of the parent of the current BB
-    void dfs(int myIdx, int parentIdx);
+    /// Depth first search from the BB with index \p entryIdx.
+    /// Numbers the BBs in pre-order and computes the spanning tree.
+    void dfs(int entryIdx);
 
     /// Basically algorithm 19.10b of Appel 2002 (uses path compression for O(log N) amortised time
     /// per operation (overall O(N log N))
@@ -127,19 +133,26 @@ private:
 
     void link(int p, int n);
 
-    void computeDF(int n);
-
-    /// Return true if n dominates w
-    bool doesDominate(int n, int w);
+    /// Compute the dominance frontiers of all nodes from the immediate dominators.
+    void computeDF();
 
     bool canRenameLocalsParams() const { return renameLocalsAndParams; }
 
-    void clearA_phi() { m_A_phi.clear(); }
+    void clearA_phi()
+    {
+        m_locationIDs.clear();
+        m_locations.clear();
+        m_A_phi.clear();
+    }
+
+    /// \returns the ID of the location \p e for \ref m_A_phi, numbering it if necessary.
+    int getLocationID(const SharedExp &e);
 
 private:
     void allocateData();
 
-    void findLiveAtDomPhi(int n, LocationSet &usedByDomPhi, LocationSet &usedByDomPhi0,
+    void findLiveAtDomPhi(int n, HashedLocationSet &usedByDomPhi,
+                          HashedLocationSet &usedByDomPhi0,
                           std::map<SharedExp, PhiAssign *, lessExpStar> &defdByPhi);
 
 private:
@@ -162,31 +175,25 @@ private:
     std::vector<int> m_semi;     /// Semi dominator of n
     std::vector<int> m_idom;     /// Immediate dominator
 
-    std::vector<int> m_samedom;          ///< ? To do with deferring
-    std::vector<int> m_vertex;           ///< ?
-    std::vector<int> m_parent;           ///< Parent in the dominator tree?
-    std::vector<int> m_best;             ///< Improves ancestorWithLowestSemi
-    std::vector<std::set<int>> m_bucket; ///< Deferred calculation?
-    std::vector<std::set<int>> m_DF;     ///< Dominance frontier for every node n
-    int N = 0;                           ///< Current node number in algorithm
+    std::vector<int> m_vertex;          ///< Node with order number n during the depth first search
+    std::vector<int> m_parent;          ///< Parent in the depth first spanning tree
+    std::vector<int> m_best;            ///< Improves ancestorWithLowestSemi
+    std::vector<int> m_path;            ///< Scratch space for ancestorWithLowestSemi
+    std::vector<std::vector<int>> m_DF; ///< Dominance frontier for every node n, sorted
+    int N = 0;                          ///< Current node number in algorithm
+
+    /// Version of the CFG the dominators were calculated for, or -1 if they were not calculated.
+    int64_t m_domVersion = -1;
 
     /*
      * Inserting phi-functions
      */
-    /// Array of sets of locations defined in BB n
-    std::vector<ExSet> m_definedAt; // was: m_A_orig
-
-    /// For a given expression e, stores the BBs needing a phi for e
-    std::map<SharedExp, std::set<int>, lessExpStar> m_A_phi;
-
-    /// For a given expression e, stores the BBs where e is defined
-    std::map<SharedExp, std::set<int>, lessExpStar> m_defsites;
-
-    /// Set of block numbers defining all variables
-    std::set<int> m_defallsites;
+    /// Dense numbering of the locations that phi functions were placed for
+    std::unordered_map<SharedConstExp, int, hashExpStar, equalExpStar> m_locationIDs;
+    std::vector<SharedExp> m_locations; ///< Maps location ID -> location
 
-    /// A Boomerang requirement: Statements defining particular subscripted locations
-    std::map<SharedExp, Statement *, lessExpStar> m_defStmts;
+    /// For every location ID, stores the BBs needing a phi for the location
+    std::vector<BitSet> m_A_phi;
 
     /**
      * Initially false, meaning that locals and parameters are not renamed and hence not propagated.
@@ -28,22 +28,21 @@ void DefCollector::clear()
 }
 
 
-void DefCollector::updateDefs(std::map<SharedExp, std::deque<Statement *>, lessExpStar> &Stacks,
-                              UserProc *proc)
+bool DefCollector::updateDefs(
+    const std::vector<std::pair<SharedExp, Statement *>> &reachingDefs, UserProc *proc)
 {
-    for (auto &Stack : Stacks) {
-        if (Stack.second.empty()) {
-            continue; // This variable's definition doesn't reach here
-        }
+    const int numDefs = m_defs.size();
 
+    for (const auto &[loc, def] : reachingDefs) {
         // Create an assignment of the form loc := loc{def}
-        auto re    = RefExp::get(Stack.first->clone(), Stack.second.back());
-        Assign *as = new Assign(Stack.first->clone(), re);
+        auto re    = RefExp::get(loc->clone(), def);
+        Assign *as = new Assign(loc->clone(), re);
         as->setProc(proc); // Simplify sometimes needs this
         insert(as);
     }
 
     m_initialised = true;
+    return m_defs.size() != numDefs;
 }
 
 
@@ -13,8 +13,7 @@
 #include "boomerang/ssl/exp/ExpHelp.h"
 #include "boomerang/util/StatementSet.h"
 
-#include <deque>
-#include <map>
+#include <vector>
 
 
 class Statement;
@@ -27,6 +26,8 @@ class UserProc;
  */
 class BOOMERANG_API DefCollector
 {
+    friend class SaveFileReader;
+
 public:
     typedef AssignSet::const_iterator const_iterator;
     typedef AssignSet::iterator iterator;
@@ -71,9 +72,11 @@ public:
 
     /**
      * Update the definitions with the current set of reaching definitions
+     * \p reachingDefs (pairs of a location and the statement defining it).
      * proc is the enclosing procedure
+     * \returns true if any definition was added
      */
-    void updateDefs(std::map<SharedExp, std::deque<Statement *>, lessExpStar> &Stacks,
+    bool updateDefs(const std::vector<std::pair<SharedExp, Statement *>> &reachingDefs,
                     UserProc *proc);
 
     /**
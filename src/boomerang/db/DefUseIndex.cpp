@@ -0,0 +1,338 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "DefUseIndex.h"
+
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/statements/Statement.h"
+#include "boomerang/util/LocationSet.h"
+#include "boomerang/util/StatementList.h"
+#include "boomerang/util/log/Log.h"
+#include "boomerang/visitor/stmtexpvisitor/StmtDestCounter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <set>
+
+
+static const std::vector<Statement *> NO_USERS;
+static const std::vector<const Statement *> NO_DEFS;
+static const ExpDestCounter::ExpCountMap NO_DEST_COUNTS;
+
+static std::atomic<uint64_t> g_generation(0);
+
+
+/// Add all distinct definitions referenced by \p stmt to \p defs, in the order they were found.
+static void findUsedDefs(Statement *stmt, bool countCols, std::vector<const Statement *> &defs)
+{
+    LocationSet used;
+    stmt->addUsedLocs(used, countCols);
+
+    for (const SharedExp &e : used) {
+        if (!e->isSubscript()) {
+            continue;
+        }
+
+        const Statement *def = e->access<RefExp>()->getDef();
+        if (def && std::find(defs.begin(), defs.end(), def) == defs.end()) {
+            defs.push_back(def);
+        }
+    }
+}
+
+
+void DefUseIndex::build(const UserProc *proc)
+{
+    clear();
+
+    StatementList stmts;
+    proc->getStatements(stmts);
+
+    for (Statement *stmt : stmts) {
+        addStatement(stmt);
+    }
+}
+
+
+/// \returns true if both maps contain the same references with the same counts
+static bool sameDestCounts(const ExpDestCounter::ExpCountMap &a,
+                           const ExpDestCounter::ExpCountMap &b)
+{
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](const auto &x, const auto &y) {
+               return *x.first == *y.first && x.second == y.second;
+           });
+}
+
+
+void DefUseIndex::clear()
+{
+    m_users.clear();
+    m_usedDefs.clear();
+    m_numDirectUsers.clear();
+    m_destCounts.clear();
+
+    clearChangedStatements();
+}
+
+
+void DefUseIndex::addStatement(Statement *stmt)
+{
+    // in case it was added before
+    const ExpDestCounter::ExpCountMap oldDestCounts = removeUses(stmt);
+
+    UsedDefs &usedDefs = m_usedDefs[stmt];
+    findUsedDefs(stmt, false, usedDefs.defs);
+
+    // Uses in implicit assignments (e.g. x in m[x]) are not real uses
+    usedDefs.numDirect = stmt->isImplicit() ? 0 : usedDefs.defs.size();
+
+    // Only calls and returns have collectors
+    if (stmt->isCall() || stmt->isReturn()) {
+        findUsedDefs(stmt, true, usedDefs.defs);
+    }
+
+    for (std::size_t i = 0; i < usedDefs.defs.size(); ++i) {
+        m_users[usedDefs.defs[i]].push_back(stmt);
+
+        if (i < usedDefs.numDirect) {
+            m_numDirectUsers[usedDefs.defs[i]]++;
+        }
+    }
+
+    ExpDestCounter edc(usedDefs.destCounts);
+    StmtDestCounter sdc(&edc);
+    stmt->accept(&sdc);
+
+    for (const auto &[exp, count] : usedDefs.destCounts) {
+        m_destCounts[exp] += count;
+    }
+
+    markLostUses(oldDestCounts, usedDefs.destCounts);
+
+    if (m_changed.insert(stmt).second) {
+        m_changedOrder.push_back(stmt);
+    }
+}
+
+
+void DefUseIndex::removeStatement(const Statement *stmt)
+{
+    const ExpDestCounter::ExpCountMap oldDestCounts = removeUses(stmt);
+    markLostUses(oldDestCounts, NO_DEST_COUNTS);
+
+    // The statement might be deleted after this
+    m_changed.erase(stmt);
+    m_lostUse.erase(stmt);
+}
+
+
+ExpDestCounter::ExpCountMap DefUseIndex::removeUses(const Statement *stmt)
+{
+    auto it = m_usedDefs.find(stmt);
+    if (it == m_usedDefs.end()) {
+        return {};
+    }
+
+    UsedDefs &usedDefs = it->second;
+
+    for (std::size_t i = 0; i < usedDefs.defs.size(); ++i) {
+        const Statement *def = usedDefs.defs[i];
+
+        auto usersIt = m_users.find(def);
+        if (usersIt != m_users.end()) {
+            std::vector<Statement *> &users = usersIt->second;
+            auto userIt                     = std::find(users.begin(), users.end(), stmt);
+
+            if (userIt != users.end()) {
+                users.erase(userIt);
+            }
+
+            if (users.empty()) {
+                m_users.erase(usersIt);
+            }
+        }
+
+        if (i < usedDefs.numDirect) {
+            auto countIt = m_numDirectUsers.find(def);
+            if (countIt != m_numDirectUsers.end() && --countIt->second <= 0) {
+                m_numDirectUsers.erase(countIt);
+            }
+        }
+    }
+
+    for (const auto &[exp, count] : usedDefs.destCounts) {
+        auto countIt = m_destCounts.find(exp);
+        if (countIt != m_destCounts.end() && (countIt->second -= count) <= 0) {
+            m_destCounts.erase(countIt);
+        }
+    }
+
+    ExpDestCounter::ExpCountMap oldDestCounts = std::move(usedDefs.destCounts);
+    m_usedDefs.erase(it);
+    return oldDestCounts;
+}
+
+
+void DefUseIndex::markLostUses(const ExpDestCounter::ExpCountMap &oldDestCounts,
+                               const ExpDestCounter::ExpCountMap &newDestCounts)
+{
+    for (const auto &[exp, count] : oldDestCounts) {
+        auto newIt = newDestCounts.find(exp);
+        if (newIt != newDestCounts.end() && newIt->second >= count) {
+            continue;
+        }
+
+        // Only a reference that is used once is propagated regardless of its complexity
+        // (see Statement::propagateTo)
+        auto totalIt = m_destCounts.find(exp);
+        if (totalIt == m_destCounts.end() || totalIt->second != 1) {
+            continue;
+        }
+
+        const Statement *def = exp->access<RefExp>()->getDef();
+        if (def && m_lostUse.insert(def).second) {
+            m_lostUseOrder.push_back(def);
+        }
+    }
+}
+
+
+void DefUseIndex::updateStatement(Statement *stmt)
+{
+    addStatement(stmt);
+}
+
+
+const std::vector<Statement *> &DefUseIndex::getUsers(const Statement *def) const
+{
+    auto it = m_users.find(def);
+    return it != m_users.end() ? it->second : NO_USERS;
+}
+
+
+const std::vector<const Statement *> &DefUseIndex::getUsedDefs(const Statement *stmt) const
+{
+    auto it = m_usedDefs.find(stmt);
+    return it != m_usedDefs.end() ? it->second.defs : NO_DEFS;
+}
+
+
+const DefUseIndex::UsedDefs &DefUseIndex::getUsedDefsOf(const Statement *stmt) const
+{
+    static const UsedDefs noUsedDefs;
+
+    auto it = m_usedDefs.find(stmt);
+    return it != m_usedDefs.end() ? it->second : noUsedDefs;
+}
+
+
+int DefUseIndex::getNumDirectUsers(const Statement *def) const
+{
+    auto it = m_numDirectUsers.find(def);
+    return it != m_numDirectUsers.end() ? it->second : 0;
+}
+
+
+const ExpDestCounter::ExpCountMap &DefUseIndex::getDestCounts(const Statement *stmt) const
+{
+    auto it = m_usedDefs.find(stmt);
+    return it != m_usedDefs.end() ? it->second.destCounts : NO_DEST_COUNTS;
+}
+
+
+std::vector<Statement *> DefUseIndex::getChangedStatements() const
+{
+    std::vector<Statement *> changed;
+    std::unordered_set<const Statement *> found;
+
+    for (Statement *stmt : m_changedOrder) {
+        if (m_changed.find(stmt) != m_changed.end() && found.insert(stmt).second) {
+            changed.push_back(stmt);
+        }
+    }
+
+    for (const Statement *def : m_lostUseOrder) {
+        if (m_lostUse.find(def) == m_lostUse.end()) {
+            continue;
+        }
+
+        for (Statement *user : getUsers(def)) {
+            if (found.insert(user).second) {
+                changed.push_back(user);
+            }
+        }
+    }
+
+    return changed;
+}
+
+
+void DefUseIndex::clearChangedStatements()
+{
+    m_changedOrder.clear();
+    m_changed.clear();
+    m_lostUseOrder.clear();
+    m_lostUse.clear();
+}
+
+
+bool DefUseIndex::verify(const UserProc *proc) const
+{
+    DefUseIndex actual;
+    actual.build(proc);
+
+    bool ok = true;
+
+    // Compare both ways, since a statement might be missing from either index
+    const DefUseIndex *indices[] = { this, &actual };
+    for (const DefUseIndex *index : indices) {
+        for (const auto &entry : index->m_usedDefs) {
+            const Statement *stmt = entry.first;
+
+            const UsedDefs &expected = actual.getUsedDefsOf(stmt);
+            const UsedDefs &indexed  = getUsedDefsOf(stmt);
+
+            const std::set<const Statement *> expectedDefs(expected.defs.begin(),
+                                                           expected.defs.end());
+            const std::set<const Statement *> indexedDefs(indexed.defs.begin(),
+                                                          indexed.defs.end());
+            const std::set<const Statement *> expectedDirect(
+                expected.defs.begin(), expected.defs.begin() + expected.numDirect);
+            const std::set<const Statement *> indexedDirect(
+                indexed.defs.begin(), indexed.defs.begin() + indexed.numDirect);
+
+            if (expectedDefs != indexedDefs || expectedDirect != indexedDirect) {
+                LOG_ERROR("Def-use index of '%1' is out of date for statement %2",
+                          proc->getName(), stmt);
+                ok = false;
+            }
+        }
+    }
+
+    if (!sameDestCounts(m_destCounts, actual.m_destCounts)) {
+        LOG_ERROR("Use counts in the def-use index of '%1' are out of date", proc->getName());
+        ok = false;
+    }
+
+    return ok;
+}
+
+
+void DefUseIndex::invalidateAll()
+{
+    g_generation++;
+}
+
+
+uint64_t DefUseIndex::getGeneration()
+{
+    return g_generation.load();
+}
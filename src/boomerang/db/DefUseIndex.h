@@ -0,0 +1,156 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/visitor/expvisitor/ExpDestCounter.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+class Statement;
+class UserProc;
+
+
+/**
+ * Maps each definition (i.e. defining statement) of a procedure in SSA form
+ * to the statements using it. A statement uses a definition if it contains a reference
+ * to it, including references in its collectors (see Statement::addUsedLocs).
+ *
+ * The index is updated statement by statement: Statements that are inserted, removed or
+ * modified must be announced to the index (see \ref UserProc::getDefUseIndex).
+ * Users of a definition are returned in the order they were added to the index.
+ *
+ * Uses in collectors and in implicit assignments are not direct uses
+ * (see \ref getNumDirectUsers); this is the notion of use for dead code elimination.
+ *
+ * Additionally, the index counts how often each reference is used (see \ref getDestCounts)
+ * and records the statements that changed since the last call to \ref clearChangedStatements,
+ * so statement propagation only needs to visit these statements and their users.
+ */
+class BOOMERANG_API DefUseIndex
+{
+public:
+    DefUseIndex()                         = default;
+    DefUseIndex(const DefUseIndex &other) = delete;
+    DefUseIndex(DefUseIndex &&other)      = default;
+
+    ~DefUseIndex() = default;
+
+    DefUseIndex &operator=(const DefUseIndex &other) = delete;
+    DefUseIndex &operator=(DefUseIndex &&other) = default;
+
+public:
+    /// Rebuild the index from all statements of \p proc.
+    void build(const UserProc *proc);
+
+    /// Remove all definitions and uses.
+    void clear();
+
+    /// Add the uses of \p stmt, which was just inserted into the procedure.
+    void addStatement(Statement *stmt);
+
+    /// Remove the uses of \p stmt, which was just removed from the procedure.
+    void removeStatement(const Statement *stmt);
+
+    /// Recompute the uses of \p stmt after its expressions have changed,
+    /// e.g. by propagation or by changing the definition of a reference.
+    void updateStatement(Statement *stmt);
+
+    /// \returns all statements that use the definition \p def.
+    const std::vector<Statement *> &getUsers(const Statement *def) const;
+
+    /// \returns all definitions used by \p stmt.
+    const std::vector<const Statement *> &getUsedDefs(const Statement *stmt) const;
+
+    /// \returns true if any statement uses the definition \p def.
+    bool isUsed(const Statement *def) const { return !getUsers(def).empty(); }
+
+    /// \returns the number of statements using the definition \p def
+    /// outside of collectors and implicit assignments.
+    int getNumDirectUsers(const Statement *def) const;
+
+    /// \returns the number of uses of each reference over all statements
+    /// (see ExpDestCounter).
+    const ExpDestCounter::ExpCountMap &getDestCounts() const { return m_destCounts; }
+
+    /// \returns the number of uses of each reference by \p stmt.
+    const ExpDestCounter::ExpCountMap &getDestCounts(const Statement *stmt) const;
+
+    /**
+     * \returns the statements that were added or updated since the last call to
+     * \ref clearChangedStatements, in the order they changed, followed by the remaining users
+     * of definitions that lost a use (a definition used only once might be propagated further).
+     */
+    std::vector<Statement *> getChangedStatements() const;
+
+    /// Forget all changed statements (see \ref getChangedStatements).
+    void clearChangedStatements();
+
+    /**
+     * Check this index against a full rescan of the statements of \p proc.
+     * Differences are logged as errors; this is intended for debugging.
+     * \returns true if the index is up to date.
+     */
+    bool verify(const UserProc *proc) const;
+
+    /**
+     * Invalidate the def-use indices of all procedures. Needed after statements
+     * of arbitrary procedures have changed, e.g. by inter-procedural analyses.
+     * \sa UserProc::isDefUseIndexValid
+     */
+    static void invalidateAll();
+
+    /// \returns the number of calls to \ref invalidateAll so far.
+    static uint64_t getGeneration();
+
+private:
+    struct UsedDefs
+    {
+        std::vector<const Statement *> defs;    ///< Direct uses first, then uses in collectors
+        std::size_t numDirect = 0;              ///< Number of direct uses in \ref defs
+        ExpDestCounter::ExpCountMap destCounts; ///< Number of uses of each reference
+    };
+
+    typedef std::unordered_map<const Statement *, std::vector<Statement *>> UserMap;
+    typedef std::unordered_map<const Statement *, UsedDefs> DefMap;
+    typedef std::unordered_map<const Statement *, int> CountMap;
+
+    const UsedDefs &getUsedDefsOf(const Statement *stmt) const;
+
+    /// Remove the uses of \p stmt from the index, but not from the changed statements.
+    /// \returns the number of uses of each reference by \p stmt before the removal.
+    ExpDestCounter::ExpCountMap removeUses(const Statement *stmt);
+
+    /// Remember the definitions of references that are used only once now since
+    /// a statement used them less often (\p oldDestCounts before, \p newDestCounts after).
+    void markLostUses(const ExpDestCounter::ExpCountMap &oldDestCounts,
+                      const ExpDestCounter::ExpCountMap &newDestCounts);
+
+private:
+    UserMap m_users;           ///< Users of each definition
+    DefMap m_usedDefs;         ///< Definitions used by each statement
+    CountMap m_numDirectUsers; ///< Number of direct users of each definition
+
+    ExpDestCounter::ExpCountMap m_destCounts; ///< Number of uses of each reference
+
+    /// Statements changed since the last call to \ref clearChangedStatements, in order.
+    /// Statements that were removed since are only erased from \ref m_changed.
+    std::vector<Statement *> m_changedOrder;
+    std::unordered_set<const Statement *> m_changed;
+
+    /// Definitions that lost a use since the last call to \ref clearChangedStatements
+    std::vector<const Statement *> m_lostUseOrder;
+    std::unordered_set<const Statement *> m_lostUse;
+};
@@ -297,18 +297,49 @@ int Prog::getNumFunctions(bool userOnly) const
 
 bool Prog::isWellFormed() const
 {
-    bool wellformed = true;
+    if (m_project && m_project->getSettings()->checkAllCFGs) {
+        bool wellformed = true;
 
-    for (const auto &module : m_moduleList) {
-        for (Function *func : *module) {
-            if (!func->isLib()) {
-                UserProc *proc = static_cast<UserProc *>(func);
-                wellformed &= proc->getCFG()->isWellFormed();
+        for (const auto &module : m_moduleList) {
+            for (Function *func : *module) {
+                if (!func->isLib()) {
+                    UserProc *proc = static_cast<UserProc *>(func);
+                    wellformed &= proc->getCFG()->isWellFormed(true);
+                }
             }
         }
+
+        return wellformed;
+    }
+
+    std::lock_guard<std::mutex> lock(m_cfgMutex);
+
+    for (const ProcCFG *cfg : m_modifiedCFGs) {
+        if (cfg->isWellFormed()) {
+            m_malformedCFGs.erase(cfg);
+        }
+        else {
+            m_malformedCFGs.insert(cfg);
+        }
     }
 
-    return wellformed;
+    m_modifiedCFGs.clear();
+    return m_malformedCFGs.empty();
+}
+
+
+void Prog::setCFGModified(const ProcCFG *cfg)
+{
+    std::lock_guard<std::mutex> lock(m_cfgMutex);
+    m_modifiedCFGs.insert(cfg);
+}
+
+
+void Prog::removeCFG(const ProcCFG *cfg)
+{
+    std::lock_guard<std::mutex> lock(m_cfgMutex);
+    m_modifiedCFGs.erase(cfg);
+    m_malformedCFGs.erase(cfg);
 }
 
 
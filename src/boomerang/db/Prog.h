@@ -24,6 +24,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 
 
@@ -35,6 +36,7 @@ class Function;
 class IFrontEnd;
 class LibProc;
 class Module;
+class ProcCFG;
 class Project;
 class Signature;
 class ISymbolProvider;
@@ -140,9 +142,19 @@ public:
     /// \returns the number of functions in this program.
     int getNumFunctions(bool userOnly = true) const;
 
-    /// Check the wellformedness of all the procedures/ProcCFGs in this program
+    /**
+     * Check the wellformedness of all the procedures/ProcCFGs in this program.
+     * Only CFGs that were modified since the last check are checked again,
+     * unless Settings::checkAllCFGs is set.
+     */
     bool isWellFormed() const;
 
+    /// Called by \p cfg when it is modified, so it is checked by the next call to \ref isWellFormed.
+    void setCFGModified(const ProcCFG *cfg);
+
+    /// Called by \p cfg when it is destroyed.
+    void removeCFG(const ProcCFG *cfg);
+
     /// \returns true if this program was loaded from a PE executable file.
     bool isWin32() const;
 
@@ -252,6 +264,13 @@ private:
     BinaryFile *m_binaryFile = nullptr;
     IFrontEnd *m_fe          = nullptr; ///< Pointer to the FrontEnd object for the project
     Module *m_rootModule     = nullptr; ///< Root of the module tree
+
+    /// Protects m_modifiedCFGs and m_malformedCFGs.
+    /// Declared before m_moduleList since CFGs deregister themselves when they are destroyed.
+    mutable std::mutex m_cfgMutex;
+    mutable std::set<const ProcCFG *> m_modifiedCFGs;  ///< CFGs modified since the last check
+    mutable std::set<const ProcCFG *> m_malformedCFGs; ///< CFGs not well-formed at the last check
+
     ModuleList m_moduleList;            ///< The Modules that make up this program
 
     /// list of UserProcs for entry point(s)
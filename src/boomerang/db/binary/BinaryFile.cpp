@@ -13,6 +13,8 @@
 #include "boomerang/db/binary/BinarySymbolTable.h"
 #include "boomerang/ifc/IFileLoader.h"
 
+#include <QFile>
+
 
 BinaryFile::BinaryFile(const QByteArray &rawData, IFileLoader *loader)
     : m_image(new BinaryImage(rawData))
@@ -22,6 +24,14 @@ BinaryFile::BinaryFile(const QByteArray &rawData, IFileLoader *loader)
 }
 
 
+BinaryFile::BinaryFile(std::unique_ptr<QFile> file, IFileLoader *loader)
+    : m_image(new BinaryImage(std::move(file)))
+    , m_symbols(new BinarySymbolTable())
+    , m_loader(loader)
+{
+}
+
+
 BinaryFile::~BinaryFile()
 {
 }
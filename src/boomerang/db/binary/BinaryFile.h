@@ -20,6 +20,7 @@ class BinarySymbolTable;
 class IFileLoader;
 
 class QByteArray;
+class QFile;
 
 
 /// This enum allows a sort of run time type identification, without using
@@ -53,6 +54,9 @@ class BOOMERANG_API BinaryFile
 {
 public:
     BinaryFile(const QByteArray &rawData, IFileLoader *loader);
+
+    /// Creates a binary file from the contents of \p file, which are memory-mapped if possible.
+    BinaryFile(std::unique_ptr<QFile> file, IFileLoader *loader);
     BinaryFile(const BinaryFile &) = delete;
     BinaryFile(BinaryFile &&)      = delete;
 
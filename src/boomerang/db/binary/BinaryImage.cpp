@@ -14,7 +14,10 @@
 #include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 
+#include <QFile>
+
 #include <algorithm>
+#include <cassert>
 
 
 BinaryImage::BinaryImage(const QByteArray &rawData)
@@ -23,12 +26,45 @@ BinaryImage::BinaryImage(const QByteArray &rawData)
 }
 
 
+BinaryImage::BinaryImage(std::unique_ptr<QFile> file)
+    : m_mappedFile(std::move(file))
+{
+    assert(m_mappedFile && m_mappedFile->isOpen());
+
+    const qint64 size = m_mappedFile->size();
+    if (size > 0) {
+        m_mappedData = m_mappedFile->map(0, size, QFileDevice::MapPrivateOption);
+    }
+
+    if (m_mappedData != nullptr) {
+        // does not copy the data
+        m_rawData = QByteArray::fromRawData(reinterpret_cast<const char *>(m_mappedData), size);
+    }
+    else {
+        LOG_VERBOSE("Cannot map '%1' into memory, reading it instead",
+                    m_mappedFile->fileName());
+        m_rawData = m_mappedFile->readAll();
+        m_mappedFile.reset();
+    }
+}
+
+
 BinaryImage::~BinaryImage()
 {
     reset();
 }
 
 
+Byte *BinaryImage::getRawBytes()
+{
+    if (m_mappedData != nullptr) {
+        return m_mappedData;
+    }
+
+    return reinterpret_cast<Byte *>(m_rawData.data());
+}
+
+
 void BinaryImage::reset()
 {
     m_sectionMap.clear();
@@ -21,6 +21,8 @@
 
 class BinarySection;
 
+class QFile;
+
 
 /**
  * This class provides file-format independent access to sections and code/data
@@ -39,6 +41,11 @@ class BOOMERANG_API BinaryImage
 
 public:
     BinaryImage(const QByteArray &rawData);
+
+    /// Creates an image from the contents of \p file. The contents are mapped into memory
+    /// (copy-on-write) instead of being read. If \p file cannot be mapped,
+    /// it is read into memory instead.
+    BinaryImage(std::unique_ptr<QFile> file);
     BinaryImage(const BinaryImage &other) = delete;
     BinaryImage(BinaryImage &&other)      = delete;
 
@@ -60,9 +67,21 @@ public:
     const_reverse_iterator rend() const { return m_sections.rend(); }
 
 public:
+    /// \note Modifying the raw data of a memory-mapped image creates a copy of the data.
+    /// Use \ref getRawBytes to modify the raw data in place.
     QByteArray &getRawData() { return m_rawData; }
     const QByteArray &getRawData() const { return m_rawData; }
 
+    /// \returns the raw contents of the file. Memory-mapped contents are not copied;
+    /// modifications only affect this image, not the file itself.
+    Byte *getRawBytes();
+
+    /// \returns the size of the raw contents of the file in bytes.
+    std::size_t getRawSize() const { return m_rawData.size(); }
+
+    /// \returns true if the raw contents of the file are memory-mapped.
+    bool isMapped() const { return m_mappedData != nullptr; }
+
     /// \returns the number of sections in this image
     int getNumSections() const { return m_sections.size(); }
 
@@ -119,6 +138,8 @@ public:
     bool isReadOnly(Address addr) const;
 
 private:
+    std::unique_ptr<QFile> m_mappedFile; ///< File backing the mapping, if any
+    Byte *m_mappedData = nullptr;        ///< Start of the private mapping of m_mappedFile
     QByteArray m_rawData;
     Address m_limitTextLow  = Address::INVALID;
     Address m_limitTextHigh = Address::INVALID;
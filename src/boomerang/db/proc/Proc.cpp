@@ -34,6 +34,38 @@ Function::~Function()
 }
 
 
+void Function::setCallersLoader(std::function<void()> loader)
+{
+    std::lock_guard<std::recursive_mutex> lock(getLoaderMutex());
+
+    m_callersLoader = std::move(loader);
+    m_callersLoaded.store(!m_callersLoader, std::memory_order_release);
+}
+
+
+std::recursive_mutex &Function::getLoaderMutex()
+{
+    static std::recursive_mutex mutex;
+    return mutex;
+}
+
+
+void Function::invokeCallersLoader() const
+{
+    std::lock_guard<std::recursive_mutex> lock(getLoaderMutex());
+
+    // Reset the loader before invoking it, so accessing the callers from the loader
+    // does not invoke it again. Other threads wait for the loader to finish.
+    std::function<void()> loader = std::move(m_callersLoader);
+    m_callersLoader              = nullptr;
+
+    if (loader) {
+        loader();
+        m_callersLoaded.store(true, std::memory_order_release);
+    }
+}
+
+
 QString Function::getName() const
 {
     assert(m_signature);
@@ -16,6 +16,9 @@
 
 #include <QString>
 
+#include <atomic>
+#include <functional>
+#include <mutex>
 #include <set>
 
 
@@ -76,12 +79,36 @@ public:
     void setSignature(std::shared_ptr<Signature> sig) { m_signature = sig; }
 
     /// \returns the call statements that call this function.
-    const std::set<CallStatement *> &getCallers() const { return m_callers; }
-    std::set<CallStatement *> &getCallers() { return m_callers; }
+    /// \sa setCallersLoader
+    const std::set<CallStatement *> &getCallers() const
+    {
+        loadCallers();
+        return m_callers;
+    }
+
+    std::set<CallStatement *> &getCallers()
+    {
+        loadCallers();
+        return m_callers;
+    }
 
     /// Add to the set of callers
     void addCaller(CallStatement *caller) { m_callers.insert(caller); }
 
+    /// Remove from the set of callers
+    void removeCaller(CallStatement *caller) { m_callers.erase(caller); }
+
+    /**
+     * Set a function that completes the set of callers on first access, e.g. by loading
+     * the bodies of the calling procedures from a save file. The loader is invoked at most once,
+     * even if the callers are accessed by multiple threads.
+     */
+    void setCallersLoader(std::function<void()> loader);
+
+    /// \returns the lock that is held while lazily loaded data (callers, procedure bodies)
+    /// is loaded. Loaders may load other data on the same thread, so the lock is recursive.
+    static std::recursive_mutex &getLoaderMutex();
+
     void removeParameterFromSignature(SharedExp e);
 
     /// Rename the first parameter named \p oldName to \p newName.
@@ -96,6 +123,16 @@ public:
     /// \returns true iff \p e is preserved by this proc
     virtual bool isPreserved(SharedExp e) = 0;
 
+private:
+    void loadCallers() const
+    {
+        if (!m_callersLoaded.load(std::memory_order_acquire)) {
+            invokeCallersLoader();
+        }
+    }
+
+    void invokeCallersLoader() const;
+
 protected:
     Prog *m_prog           = nullptr;          ///< Program containing this function.
     Module *m_module       = nullptr;          ///< Module containing this function.
@@ -113,4 +150,9 @@ protected:
 
     /// Set of callers (CallStatements that call this procedure).
     std::set<CallStatement *> m_callers;
+
+private:
+    /// Completes m_callers on first access (if not done yet).
+    mutable std::function<void()> m_callersLoader;
+    mutable std::atomic<bool> m_callersLoaded{ true };
 };
@@ -10,6 +10,7 @@
 #include "ProcCFG.h"
 
 #include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/Prog.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/db/signature/Parameter.h"
 #include "boomerang/ssl/RTL.h"
@@ -31,6 +32,10 @@ ProcCFG::ProcCFG(UserProc *proc)
 ProcCFG::~ProcCFG()
 {
     qDeleteAll(begin(), end()); // deletes all BBs
+
+    if (m_myProc && m_myProc->getProg()) {
+        m_myProc->getProg()->removeCFG(this);
+    }
 }
 
 
@@ -45,7 +50,7 @@ void ProcCFG::clear()
     m_implicitMap.clear();
     m_entryBB    = nullptr;
     m_exitBB     = nullptr;
-    m_wellFormed = true;
+    setModified();
 }
 
 
@@ -70,6 +75,7 @@ bool ProcCFG::hasBB(const BasicBlock *bb) const
 BasicBlock *ProcCFG::createBB(BBType bbType, std::unique_ptr<RTLList> bbRTLs)
 {
     assert(!bbRTLs->empty());
+    setModified();
 
     // First find the native address of the first RTL
     // Can't use BasicBlock::getLowAddr(), since we don't yet have a BB!
@@ -283,6 +289,8 @@ void ProcCFG::removeBB(BasicBlock *bb)
         return;
     }
 
+    setModified();
+
     BBStartMap::iterator firstIt, lastIt;
     std::tie(firstIt, lastIt) = m_bbStartMap.equal_range(bb->getLowAddr());
 
@@ -305,6 +313,8 @@ void ProcCFG::addEdge(BasicBlock *sourceBB, BasicBlock *destBB)
         return;
     }
 
+    setModified();
+
     // Wire up edges
     sourceBB->addSuccessor(destBB);
     destBB->addPredecessor(sourceBB);
@@ -330,16 +340,41 @@ void ProcCFG::addEdge(BasicBlock *sourceBB, Address addr)
 }
 
 
-bool ProcCFG::isWellFormed() const
+bool ProcCFG::isWellFormed(bool forceCheck) const
+{
+    if (m_modified || forceCheck) {
+        m_wellFormed = checkWellFormed();
+        m_modified   = false;
+    }
+
+    return m_wellFormed;
+}
+
+
+void ProcCFG::setModified()
+{
+    m_version++;
+
+    if (m_modified) {
+        return; // already known to the Prog
+    }
+
+    m_modified = true;
+
+    if (m_myProc && m_myProc->getProg()) {
+        m_myProc->getProg()->setCFGModified(this);
+    }
+}
+
+
+bool ProcCFG::checkWellFormed() const
 {
     for (const BasicBlock *bb : *this) {
         if (bb->isIncomplete()) {
-            m_wellFormed = false;
             LOG_ERROR("CFG is not well formed: BB at address %1 is incomplete", bb->getLowAddr());
             return false;
         }
         else if (bb->getFunction() != m_myProc) {
-            m_wellFormed = false;
             LOG_ERROR("CFG is not well formed: BB at address %1 does not belong to proc '%2'",
                       bb->getLowAddr(), m_myProc->getName());
             return false;
@@ -347,13 +382,11 @@ bool ProcCFG::isWellFormed() const
 
         for (const BasicBlock *pred : bb->getPredecessors()) {
             if (!pred->isPredecessorOf(bb)) {
-                m_wellFormed = false;
                 LOG_ERROR("CFG is not well formed: Edge from BB at %1 to BB at %2 is malformed.",
                           pred->getLowAddr(), bb->getLowAddr());
                 return false;
             }
             else if (pred->getFunction() != bb->getFunction()) {
-                m_wellFormed = false;
                 LOG_ERROR("CFG is not well formed: Interprocedural edge from '%1' to '%2' found",
                           pred->getFunction() ? "<invalid>" : pred->getFunction()->getName(),
                           bb->getFunction()->getName());
@@ -363,13 +396,11 @@ bool ProcCFG::isWellFormed() const
 
         for (const BasicBlock *succ : bb->getSuccessors()) {
             if (!succ->isSuccessorOf(bb)) {
-                m_wellFormed = false;
                 LOG_ERROR("CFG is not well formed: Edge from BB at %1 to BB at %2 is malformed.",
                           bb->getLowAddr(), succ->getLowAddr());
                 return false;
             }
             else if (succ->getFunction() != bb->getFunction()) {
-                m_wellFormed = false;
                 LOG_ERROR("CFG is not well formed: Interprocedural edge from '%1' to '%2' found",
                           bb->getFunction()->getName(),
                           succ->getFunction() ? "<invalid>" : succ->getFunction()->getName());
@@ -378,7 +409,6 @@ bool ProcCFG::isWellFormed() const
         }
     }
 
-    m_wellFormed = true;
     return true;
 }
 
@@ -494,6 +524,8 @@ BasicBlock *ProcCFG::splitBB(BasicBlock *bb, Address splitAddr, BasicBlock *_new
         return bb;
     }
 
+    setModified();
+
     if (_newBB && !_newBB->isIncomplete()) {
         // we already have a BB for the high part. Delete overlapping RTLs and adjust edges.
 
@@ -567,6 +599,8 @@ void ProcCFG::insertBB(BasicBlock *bb)
 {
     assert(bb != nullptr);
     assert(bb->getLowAddr() != Address::INVALID);
+    setModified();
+
     if (bb->getLowAddr() != Address::ZERO) {
         auto it = m_bbStartMap.find(bb->getLowAddr());
         if (it != m_bbStartMap.end()) {
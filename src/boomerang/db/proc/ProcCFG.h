@@ -38,6 +38,9 @@ enum class BBType;
  */
 class BOOMERANG_API ProcCFG
 {
+    friend class SaveFileReader;
+    friend class SaveFileWriter;
+
     typedef std::multimap<Address, BasicBlock *, std::less<Address>> BBStartMap;
     typedef std::map<SharedConstExp, Statement *, lessExpStar> ExpStatementMap;
 
@@ -185,8 +188,25 @@ public:
      * Checks that all BBs are complete, and all out edges are valid.
      * Also checks that the ProcCFG does not contain interprocedural edges.
      * By definition, the empty CFG is well-formed.
+     *
+     * The result is cached until the CFG is modified (see \ref setModified),
+     * so checking an unmodified CFG is cheap.
+     * \param forceCheck if true, check the CFG even if it was not modified since the last check.
+     */
+    bool isWellFormed(bool forceCheck = false) const;
+
+    /**
+     * Mark this CFG as modified, so the next call to \ref isWellFormed checks it again.
+     * This is done automatically when BBs or edges of this CFG are added, removed or changed.
      */
-    bool isWellFormed() const;
+    void setModified();
+
+    /// \returns true if this CFG was modified since it was last checked for well-formedness.
+    bool isModified() const { return m_modified; }
+
+    /// \returns a number that changes every time BBs or edges of this CFG are added,
+    /// removed or changed. Can be used to cache information derived from the CFG.
+    int64_t getVersion() const { return m_version; }
 
     /// Simplify all the expressions in the CFG
     void simplify();
@@ -240,6 +260,9 @@ public:
 private:
     void insertBB(BasicBlock *bb);
 
+    /// Check the well-formedness of all BBs and edges. \sa isWellFormed
+    bool checkWellFormed() const;
+
 private:
     UserProc *m_myProc = nullptr;    ///< Procedure to which this CFG belongs.
     BBStartMap m_bbStartMap;         ///< The Address to BB map
@@ -253,5 +276,7 @@ private:
     /// True when the implicits are done; they can cause problems
     /// (e.g. with ad-hoc global assignment)
     bool m_implicitsDone      = false;
-    mutable bool m_wellFormed = false;
+    mutable bool m_wellFormed = true;  ///< Result of the last well-formedness check
+    mutable bool m_modified   = false; ///< Modified since the last well-formedness check
+    int64_t m_version         = 0;     ///< Incremented on every modification
 };
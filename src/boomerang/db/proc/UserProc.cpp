@@ -28,6 +28,7 @@
 #include "boomerang/ssl/statements/ReturnStatement.h"
 #include "boomerang/ssl/type/IntegerType.h"
 #include "boomerang/util/DFGWriter.h"
+#include "boomerang/util/MemoryArena.h"
 #include "boomerang/util/UseGraphWriter.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/util/log/SeparateLogger.h"
@@ -47,6 +48,83 @@ UserProc::~UserProc()
 }
 
 
+const std::shared_ptr<MemoryArena> &UserProc::getArena()
+{
+    if (!m_arena && m_prog && m_prog->getProject() &&
+        m_prog->getProject()->getSettings()->useProcArenas) {
+        m_arena = std::make_shared<MemoryArena>();
+    }
+
+    return m_arena;
+}
+
+
+void UserProc::setBodyLoader(std::function<void(UserProc *)> loader)
+{
+    std::lock_guard<std::recursive_mutex> lock(getLoaderMutex());
+
+    m_bodyLoader = std::move(loader);
+    m_bodyLoaded.store(!m_bodyLoader, std::memory_order_release);
+}
+
+
+bool UserProc::isBodyLoaded() const
+{
+    std::lock_guard<std::recursive_mutex> lock(getLoaderMutex());
+    return !m_bodyLoader;
+}
+
+
+void UserProc::invokeBodyLoader() const
+{
+    std::lock_guard<std::recursive_mutex> lock(getLoaderMutex());
+
+    // Reset the loader before invoking it, so accessing the body from the loader
+    // does not load the body again. Other threads wait for the loader to finish.
+    std::function<void(UserProc *)> loader = std::move(m_bodyLoader);
+    m_bodyLoader                           = nullptr;
+
+    if (loader) {
+        loader(const_cast<UserProc *>(this));
+        m_bodyLoaded.store(true, std::memory_order_release);
+    }
+}
+
+
+void UserProc::clearBody()
+{
+    std::lock_guard<std::recursive_mutex> lock(getLoaderMutex());
+
+    if (m_bodyLoader) {
+        m_bodyLoader = nullptr;
+        m_bodyLoaded.store(true, std::memory_order_release);
+    }
+    else {
+        StatementList stmts;
+        getStatements(stmts);
+
+        for (Statement *stmt : stmts) {
+            if (stmt->isCall() && static_cast<CallStatement *>(stmt)->getDestProc()) {
+                CallStatement *call = static_cast<CallStatement *>(stmt);
+                call->getDestProc()->removeCaller(call);
+            }
+        }
+    }
+
+    m_retStatement = nullptr;
+    m_cfg->clear();
+    resetArena();
+
+    m_parameters.clear();
+    m_calleeList.clear();
+    m_locals.clear();
+    m_symbolMap.clear();
+    m_procUseCollector.clear();
+    m_provenTrue.clear();
+    m_recurPremises.clear();
+}
+
+
 bool UserProc::isNoReturn() const
 {
     std::set<const Function *> visited;
@@ -56,6 +134,8 @@ bool UserProc::isNoReturn() const
 
 SharedExp UserProc::getProven(SharedExp left)
 {
+    loadBody();
+
     // Note: proven information is in the form r28 mapsto (r28 + 4)
     auto it = m_provenTrue.find(left);
 
@@ -72,6 +152,8 @@ SharedExp UserProc::getProven(SharedExp left)
 
 SharedExp UserProc::getPremised(SharedExp left)
 {
+    loadBody();
+
     auto it = m_recurPremises.find(left);
     return it != m_recurPremises.end() ? it->second : nullptr;
 }
@@ -102,12 +184,16 @@ void UserProc::setDecoded()
 
 BasicBlock *UserProc::getEntryBB()
 {
+    loadBody();
+
     return m_cfg->getEntryBB();
 }
 
 
 void UserProc::setEntryBB()
 {
+    loadBody();
+
     BasicBlock *entryBB = m_cfg->getBBStartingAt(m_entryAddress);
     m_cfg->setEntryAndExitBB(entryBB);
 }
@@ -121,6 +207,8 @@ void UserProc::decompileRecursive()
 
 void UserProc::numberStatements() const
 {
+    loadBody();
+
     int stmtNumber = 0;
 
     for (BasicBlock *bb : *m_cfg) {
@@ -135,6 +223,8 @@ void UserProc::numberStatements() const
 
 void UserProc::getStatements(StatementList &stmts) const
 {
+    loadBody();
+
     for (const BasicBlock *bb : *m_cfg) {
         bb->appendStatementsTo(stmts);
     }
@@ -149,6 +239,8 @@ void UserProc::getStatements(StatementList &stmts) const
 
 bool UserProc::removeStatement(Statement *stmt)
 {
+    loadBody();
+
     if (!stmt) {
         return false;
     }
@@ -185,6 +277,11 @@ bool UserProc::removeStatement(Statement *stmt)
         for (RTL::iterator it = rtl->begin(); it != rtl->end(); ++it) {
             if (*it == stmt) {
                 rtl->erase(it);
+
+                if (m_defUseIndexValid) {
+                    m_defUseIndex.removeStatement(stmt);
+                }
+
                 return true;
             }
         }
@@ -194,8 +291,38 @@ bool UserProc::removeStatement(Statement *stmt)
 }
 
 
+DefUseIndex &UserProc::getDefUseIndex()
+{
+    if (!isDefUseIndexValid()) {
+        m_defUseIndexGeneration = DefUseIndex::getGeneration();
+        m_defUseIndexCFGVersion = getCFG()->getVersion();
+
+        m_defUseIndex.build(this);
+        m_defUseIndexValid = true;
+    }
+
+    return m_defUseIndex;
+}
+
+
+bool UserProc::isDefUseIndexValid() const
+{
+    return m_defUseIndexValid && m_defUseIndexGeneration == DefUseIndex::getGeneration() &&
+           m_defUseIndexCFGVersion == m_cfg->getVersion();
+}
+
+
+void UserProc::invalidateDefUseIndex()
+{
+    m_defUseIndex.clear();
+    m_defUseIndexValid = false;
+}
+
+
 Assign *UserProc::insertAssignAfter(Statement *s, SharedExp left, SharedExp right)
 {
+    loadBody();
+
     BasicBlock *bb = nullptr;
     Assign *as     = new Assign(left, right);
 
@@ -219,6 +346,11 @@ Assign *UserProc::insertAssignAfter(Statement *s, SharedExp left, SharedExp righ
             for (auto it = rtl->begin(); it != rtl->end(); ++it) {
                 if (*it == s) {
                     rtl->insert(++it, as);
+
+                    if (m_defUseIndexValid) {
+                        m_defUseIndex.addStatement(as);
+                    }
+
                     return as;
                 }
             }
@@ -233,12 +365,19 @@ Assign *UserProc::insertAssignAfter(Statement *s, SharedExp left, SharedExp righ
         // do not insert after a Branch statement etc.
         lastRTL->insert(std::prev(lastRTL->end()), as);
     }
+
+    if (m_defUseIndexValid) {
+        m_defUseIndex.addStatement(as);
+    }
+
     return as;
 }
 
 
 bool UserProc::insertStatementAfter(Statement *afterThis, Statement *stmt)
 {
+    loadBody();
+
     assert(!afterThis->isBranch());
 
     for (BasicBlock *bb : *m_cfg) {
@@ -253,6 +392,11 @@ bool UserProc::insertStatementAfter(Statement *afterThis, Statement *stmt)
                 if (*ss == afterThis) {
                     rtl->insert(std::next(ss), stmt);
                     stmt->setBB(bb);
+
+                    if (m_defUseIndexValid) {
+                        m_defUseIndex.addStatement(stmt);
+                    }
+
                     return true;
                 }
             }
@@ -274,6 +418,8 @@ void UserProc::addParameterToSignature(SharedExp e, SharedType ty)
 
 void UserProc::insertParameter(SharedExp e, SharedType ty)
 {
+    loadBody();
+
     if (filterParams(e)) {
         return; // Filtered out
     }
@@ -343,6 +489,8 @@ void UserProc::setParamType(const QString &name, SharedType ty)
 
 void UserProc::setParamType(int idx, SharedType ty)
 {
+    loadBody();
+
     if (static_cast<size_t>(idx) >= m_parameters.size()) {
         // index out of range
         return;
@@ -361,6 +509,8 @@ void UserProc::setParamType(int idx, SharedType ty)
 
 QString UserProc::lookupParam(SharedConstExp e) const
 {
+    loadBody();
+
     // Originally e.g. m[esp+K]
     Statement *def = m_cfg->findTheImplicitAssign(e);
 
@@ -420,12 +570,16 @@ bool UserProc::filterParams(SharedExp e)
 
 Address UserProc::getRetAddr()
 {
+    loadBody();
+
     return m_retStatement != nullptr ? m_retStatement->getRetAddr() : Address::INVALID;
 }
 
 
 void UserProc::setRetStmt(ReturnStatement *s, Address r)
 {
+    loadBody();
+
     assert(m_retStatement == nullptr);
     m_retStatement = s;
     m_retStatement->setRetAddr(r);
@@ -469,6 +623,8 @@ bool UserProc::filterReturns(SharedExp e)
 
 SharedExp UserProc::createLocal(SharedType ty, const SharedExp &e, const QString &name)
 {
+    loadBody();
+
     const QString localName = (name != "") ? name : newLocalName(e);
 
     if (ty == nullptr) {
@@ -484,6 +640,8 @@ SharedExp UserProc::createLocal(SharedType ty, const SharedExp &e, const QString
 
 void UserProc::addLocal(SharedType ty, const QString &name, SharedExp e)
 {
+    loadBody();
+
     // symbolMap is a multimap now; you might have r8->o0 for integers and r8->o0_1 for char*
     // assert(symbolMap.find(e) == symbolMap.end());
     mapSymbolTo(e, Location::local(name, this));
@@ -531,6 +689,8 @@ void UserProc::ensureExpIsMappedToLocal(const std::shared_ptr<RefExp> &ref)
 
 SharedExp UserProc::getSymbolExp(SharedExp le, SharedType ty, bool lastPass)
 {
+    loadBody();
+
     assert(ty != nullptr);
 
     SharedExp e = nullptr;
@@ -597,6 +757,8 @@ SharedExp UserProc::getSymbolExp(SharedExp le, SharedType ty, bool lastPass)
 
 QString UserProc::findLocal(const SharedExp &e, SharedType ty)
 {
+    loadBody();
+
     if (e->isLocal()) {
         return e->access<Const, 1>()->getStr();
     }
@@ -620,6 +782,8 @@ QString UserProc::findLocal(const SharedExp &e, SharedType ty)
 
 SharedConstType UserProc::getLocalType(const QString &name) const
 {
+    loadBody();
+
     auto it = m_locals.find(name);
     return (it != m_locals.end()) ? it->second : nullptr;
 }
@@ -627,6 +791,8 @@ SharedConstType UserProc::getLocalType(const QString &name) const
 
 void UserProc::setLocalType(const QString &name, SharedType ty)
 {
+    loadBody();
+
     const auto it = m_locals.find(name);
     if (it != m_locals.end()) {
         it->second = ty;
@@ -661,6 +827,8 @@ bool UserProc::isLocalOrParamPattern(SharedConstExp e) const
 
 SharedConstExp UserProc::expFromSymbol(const QString &name) const
 {
+    loadBody();
+
     for (const std::pair<SharedConstExp, SharedExp> &it : m_symbolMap) {
         const SharedConstExp exp = it.second;
         if (exp->isLocal() && (exp->access<Const, 1>()->getStr() == name)) {
@@ -674,6 +842,8 @@ SharedConstExp UserProc::expFromSymbol(const QString &name) const
 
 void UserProc::mapSymbolTo(const SharedConstExp &from, SharedExp to)
 {
+    loadBody();
+
     assert(from && to);
 
     SymbolMap::iterator it = m_symbolMap.find(from);
@@ -693,6 +863,8 @@ void UserProc::mapSymbolTo(const SharedConstExp &from, SharedExp to)
 
 QString UserProc::lookupSym(const SharedConstExp &arg, SharedConstType ty) const
 {
+    loadBody();
+
     SharedConstExp e = arg;
 
     if (arg->isTypedExp()) {
@@ -763,6 +935,8 @@ QString UserProc::lookupSymFromRefAny(const std::shared_ptr<const RefExp> &ref)
 
 void UserProc::markAsNonChildless(const std::shared_ptr<ProcSet> &cs)
 {
+    loadBody();
+
     assert(cs);
 
     BasicBlock::RTLRIterator rrit;
@@ -785,6 +959,8 @@ void UserProc::markAsNonChildless(const std::shared_ptr<ProcSet> &cs)
 
 void UserProc::addCallee(Function *callee)
 {
+    loadBody();
+
     assert(callee != nullptr);
 
     // is it already in? (this is much slower than using a set)
@@ -818,6 +994,8 @@ void UserProc::promoteSignature()
 
 QString UserProc::findFirstSymbol(const SharedConstExp &exp) const
 {
+    loadBody();
+
     auto it = m_symbolMap.find(exp);
     if (it != m_symbolMap.end()) {
         return it->second->access<Const, 1>()->getStr();
@@ -842,6 +1020,8 @@ bool UserProc::searchAndReplace(const Exp &search, SharedExp replace)
 
 void UserProc::markAsInitialParam(const SharedExp &loc)
 {
+    loadBody();
+
     m_procUseCollector.insert(loc);
 }
 
@@ -881,6 +1061,8 @@ QString UserProc::toString() const
 
 void UserProc::print(OStream &out) const
 {
+    loadBody();
+
     numberStatements();
 
     QString tgt1;
@@ -919,6 +1101,8 @@ void UserProc::print(OStream &out) const
 
 void UserProc::printParams(OStream &out) const
 {
+    loadBody();
+
     out << "parameters: ";
 
     if (!m_parameters.empty()) {
@@ -946,6 +1130,8 @@ void UserProc::printParams(OStream &out) const
 
 void UserProc::printSymbolMap(OStream &out) const
 {
+    loadBody();
+
     out << "symbols:\n";
 
     if (m_symbolMap.empty()) {
@@ -963,6 +1149,8 @@ void UserProc::printSymbolMap(OStream &out) const
 
 void UserProc::printLocals(OStream &os) const
 {
+    loadBody();
+
     os << "locals:\n";
 
     if (m_locals.empty()) {
@@ -1002,12 +1190,16 @@ void UserProc::debugPrintAll(const QString &stepName)
 
 bool UserProc::existsLocal(const QString &name) const
 {
+    loadBody();
+
     return m_locals.find(name) != m_locals.end();
 }
 
 
 QString UserProc::newLocalName(const SharedExp &e)
 {
+    loadBody();
+
     QString localName;
 
     if (e->isSubscript() && e->getSubExp1()->isRegOf()) {
@@ -1064,6 +1256,8 @@ QString UserProc::getRegName(SharedExp r)
 
 SharedType UserProc::getTypeForLocation(const SharedExp &e)
 {
+    loadBody();
+
     const QString name = e->access<Const, 1>()->getStr();
     if (e->isLocal()) {
         auto it = m_locals.find(name);
@@ -1079,6 +1273,8 @@ SharedType UserProc::getTypeForLocation(const SharedExp &e)
 
 SharedConstType UserProc::getTypeForLocation(const SharedConstExp &e) const
 {
+    loadBody();
+
     const QString name = e->access<Const, 1>()->getStr();
     if (e->isLocal()) {
         auto it = m_locals.find(name);
@@ -1097,6 +1293,8 @@ static const SharedExp defAll = Terminal::get(opDefineAll);
 
 bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRight, bool conditional)
 {
+    loadBody();
+
     if ((m_provenTrue.find(queryLeft) != m_provenTrue.end()) &&
         (*m_provenTrue[queryLeft] == *queryRight)) {
         if (m_prog->getProject()->getSettings()->debugProof) {
@@ -1507,6 +1705,8 @@ bool UserProc::prover(SharedExp query, std::set<PhiAssign *> &lastPhis,
 
 SharedExp UserProc::getSymbolFor(const SharedConstExp &from, const SharedConstType &ty) const
 {
+    loadBody();
+
     assert(ty != nullptr);
 
     SymbolMap::const_iterator ff = m_symbolMap.find(from);
@@ -1534,6 +1734,8 @@ SharedExp UserProc::getSymbolFor(const SharedConstExp &from, const SharedConstTy
 
 void UserProc::setPremise(const SharedExp &e)
 {
+    loadBody();
+
     SharedExp premise  = e->clone();
     m_recurPremises[e] = e;
 }
@@ -1541,12 +1743,16 @@ void UserProc::setPremise(const SharedExp &e)
 
 void UserProc::killPremise(const SharedExp &e)
 {
+    loadBody();
+
     m_recurPremises.erase(e);
 }
 
 
 bool UserProc::isNoReturnInternal(std::set<const Function *> &visited) const
 {
+    loadBody();
+
     // undecoded procs are assumed to always return (and define everything)
     if (!this->isDecoded()) {
         return false;
@@ -11,13 +11,18 @@
 
 
 #include "boomerang/db/DataFlow.h"
+#include "boomerang/db/DefUseIndex.h"
 #include "boomerang/db/UseCollector.h"
 #include "boomerang/db/proc/Proc.h"
 #include "boomerang/db/proc/ProcCFG.h"
 #include "boomerang/util/StatementList.h"
 
+#include <atomic>
+#include <functional>
+
 
 class Binary;
+class MemoryArena;
 class UserProc;
 class Assign;
 class ReturnStatement;
@@ -45,6 +50,9 @@ typedef std::list<UserProc *> ProcList;
  */
 class BOOMERANG_API UserProc : public Function
 {
+    friend class SaveFileReader;
+    friend class SaveFileWriter;
+
     typedef std::map<SharedExp, SharedExp, lessExpStar> ExpExpMap;
 
 public:
@@ -91,13 +99,72 @@ public:
 
 public:
     /// \returns a pointer to the CFG object.
-    ProcCFG *getCFG() { return m_cfg.get(); }
-    const ProcCFG *getCFG() const { return m_cfg.get(); }
+    ProcCFG *getCFG()
+    {
+        loadBody();
+        return m_cfg.get();
+    }
+    const ProcCFG *getCFG() const
+    {
+        loadBody();
+        return m_cfg.get();
+    }
 
     /// Returns a pointer to the DataFlow object.
     DataFlow *getDataFlow() { return &m_df; }
     const DataFlow *getDataFlow() const { return &m_df; }
 
+    /**
+     * \returns the index of the statements using each definition of this procedure.
+     * The index is built on first use. Afterwards, it is updated by \ref removeStatement,
+     * \ref insertAssignAfter and \ref insertStatementAfter; all other changes to statements
+     * must be announced to the index (see \ref DefUseIndex::updateStatement) or invalidate it.
+     * Changing the definition of a reference of a statement (\ref RefExp::setDef) updates
+     * the index; changing the CFG invalidates it.
+     */
+    DefUseIndex &getDefUseIndex();
+
+    /// \returns true if the def-use index was built and not invalidated since,
+    /// neither for this procedure nor for all procedures (\ref DefUseIndex::invalidateAll).
+    bool isDefUseIndexValid() const;
+
+    /// Discard the def-use index; it is rebuilt by the next call to \ref getDefUseIndex.
+    void invalidateDefUseIndex();
+
+    /// \returns the memory arena for statements, RTLs and expressions of this procedure
+    /// (created on first use), or nullptr if per-procedure arenas are disabled.
+    /// \sa Settings::useProcArenas
+    const std::shared_ptr<MemoryArena> &getArena();
+
+    /// Drop the memory arena of this procedure (e.g. before re-decoding the procedure).
+    /// The memory is released as soon as all objects allocated from it have been destroyed.
+    void resetArena() { m_arena.reset(); }
+
+    /// Set a function that loads the body of this procedure (CFG, parameters, locals etc.)
+    /// on first access, e.g. from a save file. The loader is invoked at most once,
+    /// even if the body is accessed by multiple threads.
+    void setBodyLoader(std::function<void(UserProc *)> loader);
+
+    /// \returns false if the body of this procedure has not been loaded yet.
+    /// Waits until the body has been loaded if it is being loaded by a different thread.
+    bool isBodyLoaded() const;
+
+    /// Load the body of this procedure if it has not been loaded yet.
+    void loadBody() const
+    {
+        if (!m_bodyLoaded.load(std::memory_order_acquire)) {
+            invokeBodyLoader();
+        }
+    }
+
+    /**
+     * Remove the body of this procedure (CFG, parameters, locals, symbols, callees etc.),
+     * e.g. before a different body is read for it. A body that has not been loaded yet
+     * is discarded without loading it. Calls of the old body are no longer registered
+     * as callers of their callees. The status of the procedure is not changed.
+     */
+    void clearBody();
+
     const std::shared_ptr<ProcSet> &getRecursionGroup() { return m_recursionGroup; }
     void setRecursionGroup(const std::shared_ptr<ProcSet> &recursionGroup)
     {
@@ -160,8 +227,16 @@ public:
 public:
     // parameter related
 
-    StatementList &getParameters() { return m_parameters; }
-    const StatementList &getParameters() const { return m_parameters; }
+    StatementList &getParameters()
+    {
+        loadBody();
+        return m_parameters;
+    }
+    const StatementList &getParameters() const
+    {
+        loadBody();
+        return m_parameters;
+    }
 
     /// Add the parameter to the signature
     void addParameterToSignature(SharedExp e, SharedType ty);
@@ -199,10 +274,22 @@ public:
     /// \param rtlAddr the address of the RTL containing \p retStmt
     void setRetStmt(ReturnStatement *retStmt, Address rtlAddr);
 
-    ReturnStatement *getRetStmt() { return m_retStatement; }
-    const ReturnStatement *getRetStmt() const { return m_retStatement; }
+    ReturnStatement *getRetStmt()
+    {
+        loadBody();
+        return m_retStatement;
+    }
+    const ReturnStatement *getRetStmt() const
+    {
+        loadBody();
+        return m_retStatement;
+    }
 
-    void removeRetStmt() { m_retStatement = nullptr; }
+    void removeRetStmt()
+    {
+        loadBody();
+        m_retStatement = nullptr;
+    }
 
     /**
      * Filter out locations not possible as return locations.
@@ -214,8 +301,16 @@ public:
 public:
     // local variable related
 
-    const std::map<QString, SharedType> &getLocals() const { return m_locals; }
-    std::map<QString, SharedType> &getLocals() { return m_locals; }
+    const std::map<QString, SharedType> &getLocals() const
+    {
+        loadBody();
+        return m_locals;
+    }
+    std::map<QString, SharedType> &getLocals()
+    {
+        loadBody();
+        return m_locals;
+    }
 
     /**
      * Return the next available local variable; make it the given type.
@@ -252,8 +347,16 @@ public:
 
 public:
     // symbol related
-    SymbolMap &getSymbolMap() { return m_symbolMap; }
-    const SymbolMap &getSymbolMap() const { return m_symbolMap; }
+    SymbolMap &getSymbolMap()
+    {
+        loadBody();
+        return m_symbolMap;
+    }
+    const SymbolMap &getSymbolMap() const
+    {
+        loadBody();
+        return m_symbolMap;
+    }
 
     /// \returns the original expression that maps to the local variable with name \p name
     /// Example: If eax maps to the local variable foo, return eax
@@ -283,7 +386,11 @@ public:
     void markAsNonChildless(const std::shared_ptr<ProcSet> &cs);
 
     /// Get the callees.
-    std::list<Function *> &getCallees() { return m_calleeList; }
+    std::list<Function *> &getCallees()
+    {
+        loadBody();
+        return m_calleeList;
+    }
 
     /**
      * Add this callee to the set of callees for this proc
@@ -302,8 +409,16 @@ public:
 public:
     bool canRename(SharedConstExp e) const { return m_df.canRename(e); }
 
-    UseCollector &getUseCollector() { return m_procUseCollector; }
-    const UseCollector &getUseCollector() const { return m_procUseCollector; }
+    UseCollector &getUseCollector()
+    {
+        loadBody();
+        return m_procUseCollector;
+    }
+    const UseCollector &getUseCollector() const
+    {
+        loadBody();
+        return m_procUseCollector;
+    }
 
     /// promote the signature if possible
     void promoteSignature();
@@ -334,6 +449,8 @@ public:
     void debugPrintAll(const QString &stepName);
 
 private:
+    void invokeBodyLoader() const;
+
     void printParams(OStream &out) const;
 
     /// Print just the symbol map
@@ -389,9 +506,22 @@ private:
 
     std::unique_ptr<ProcCFG> m_cfg; ///< The control flow graph.
 
+    /// Memory arena for statements, RTLs and expressions of this procedure.
+    std::shared_ptr<MemoryArena> m_arena;
+
+    /// Loads the body of this procedure on first access (if not loaded yet).
+    /// Guarded by Function::getLoaderMutex().
+    mutable std::function<void(UserProc *)> m_bodyLoader;
+    mutable std::atomic<bool> m_bodyLoaded{ true };
+
     /// DataFlow object. Holds information relevant to transforming to and from SSA form.
     DataFlow m_df;
 
+    DefUseIndex m_defUseIndex;
+    bool m_defUseIndexValid          = false;
+    uint64_t m_defUseIndexGeneration = 0; ///< \ref DefUseIndex::getGeneration at build time
+    int64_t m_defUseIndexCFGVersion  = 0; ///< \ref ProcCFG::getVersion at build time
+
     /**
      * The list of parameters, ordered and filtered.
      * Note that a LocationList could be used, but then there would be nowhere
@@ -0,0 +1,90 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include <QDataStream>
+
+
+/**
+ * Constants of the save file format shared by SaveFileWriter and SaveFileReader.
+ *
+ * A save file is a QDataStream consisting of
+ *  - a header (magic number, format version, path and size of the binary file),
+ *  - the program database without procedure bodies (modules, functions, signatures,
+ *    entry points, recursion groups, globals and the procedures calling each function),
+ *  - one length-prefixed blob per decoded UserProc containing its body
+ *    (CFG, statements, parameters, locals, symbols etc.).
+ *
+ * Procedure bodies are self-contained, so they can be deserialized lazily.
+ * References to functions, basic blocks and statements are stored as indices.
+ */
+namespace SaveFileFormat
+{
+/// "BMSF" in little endian
+static constexpr quint32 MAGIC = 0x46534D42;
+
+/// Must be incremented on every incompatible change of the format.
+static constexpr quint32 VERSION = 2;
+
+static constexpr int STREAM_VERSION = QDataStream::Qt_5_6;
+
+/// Index of a missing function, basic block or statement
+static constexpr qint32 NO_INDEX = -1;
+
+/// Index of STMT_WILD
+static constexpr qint32 WILD_INDEX = -2;
+
+/// Type tag of a null type. Other types are tagged by their TypeClass.
+static constexpr quint8 NULL_TYPE = 0xFF;
+
+/// Statement tag of a null statement. Other statements are tagged by their StmtType.
+static constexpr quint8 NULL_STMT = 0xFF;
+
+
+enum class ExpTag : quint8
+{
+    Null = 0,
+    Terminal,
+    Const,
+    Unary,
+    Binary,
+    Ternary,
+    TypedExp,
+    RefExp,
+    Location
+};
+
+
+/// How the value of a Const is stored
+enum class ConstTag : quint8
+{
+    Int = 0,
+    Long,
+    Float,
+    String,
+    Func
+};
+
+
+enum class SignatureTag : quint8
+{
+    Null = 0,
+    Generic,
+    Custom,
+    Pentium,
+    Win32,
+    Win32Tc,
+    SPARC,
+    SPARCLib,
+    PPC,
+    ST20
+};
+}
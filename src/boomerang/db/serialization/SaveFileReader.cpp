@@ -0,0 +1,1218 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "SaveFileReader.h"
+
+#include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/Global.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/module/ModuleFactory.h"
+#include "boomerang/db/proc/LibProc.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/db/serialization/SaveFileFormat.h"
+#include "boomerang/db/signature/CustomSignature.h"
+#include "boomerang/db/signature/PPCSignature.h"
+#include "boomerang/db/signature/Parameter.h"
+#include "boomerang/db/signature/PentiumSignature.h"
+#include "boomerang/db/signature/Return.h"
+#include "boomerang/db/signature/SPARCSignature.h"
+#include "boomerang/db/signature/ST20Signature.h"
+#include "boomerang/db/signature/Win32Signature.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/exp/Ternary.h"
+#include "boomerang/ssl/exp/TypedExp.h"
+#include "boomerang/ssl/exp/Unary.h"
+#include "boomerang/ssl/statements/BoolAssign.h"
+#include "boomerang/ssl/statements/BranchStatement.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+#include "boomerang/ssl/statements/CaseStatement.h"
+#include "boomerang/ssl/statements/ImplicitAssign.h"
+#include "boomerang/ssl/statements/PhiAssign.h"
+#include "boomerang/ssl/statements/ReturnStatement.h"
+#include "boomerang/ssl/type/ArrayType.h"
+#include "boomerang/ssl/type/BooleanType.h"
+#include "boomerang/ssl/type/CharType.h"
+#include "boomerang/ssl/type/CompoundType.h"
+#include "boomerang/ssl/type/FloatType.h"
+#include "boomerang/ssl/type/FuncType.h"
+#include "boomerang/ssl/type/IntegerType.h"
+#include "boomerang/ssl/type/NamedType.h"
+#include "boomerang/ssl/type/PointerType.h"
+#include "boomerang/ssl/type/SizeType.h"
+#include "boomerang/ssl/type/UnionType.h"
+#include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/MemoryArena.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QDataStream>
+
+
+using namespace SaveFileFormat;
+
+
+static void initStream(QDataStream &is)
+{
+    is.setVersion(STREAM_VERSION);
+    is.setByteOrder(QDataStream::LittleEndian);
+}
+
+
+static Address readAddress(QDataStream &is)
+{
+    quint64 value = 0;
+    is >> value;
+    return Address(value);
+}
+
+
+SaveFileReader::SaveFileReader()
+{
+}
+
+
+SaveFileReader::~SaveFileReader()
+{
+    if (m_mappedData) {
+        m_file.unmap(const_cast<uchar *>(m_mappedData));
+    }
+}
+
+
+bool SaveFileReader::open(const QString &filePath)
+{
+    m_file.setFileName(filePath);
+    if (!m_file.open(QFile::ReadOnly)) {
+        LOG_ERROR("Cannot open save file '%1' for reading", filePath);
+        return false;
+    }
+
+    // Procedure bodies are read on demand, so keep the file mapped if possible.
+    m_mappedData = m_file.map(0, m_file.size());
+    if (m_mappedData) {
+        m_dataSize = static_cast<std::size_t>(m_file.size());
+    }
+    else {
+        m_data     = m_file.readAll();
+        m_dataSize = static_cast<std::size_t>(m_data.size());
+    }
+
+    QDataStream is(getData(0, m_dataSize));
+    initStream(is);
+
+    quint32 magic = 0, version = 0;
+    is >> magic >> version;
+
+    if (magic != MAGIC) {
+        LOG_ERROR("'%1' is not a save file", filePath);
+        return false;
+    }
+    else if (version != VERSION) {
+        LOG_ERROR("Cannot load save file '%1': Unsupported version %2 (expected version %3)",
+                  filePath, version, VERSION);
+        return false;
+    }
+
+    QString boomerangVersion;
+    is >> boomerangVersion >> m_binaryFilePath >> m_binaryFileSize;
+
+    if (is.status() != QDataStream::Ok) {
+        LOG_ERROR("Cannot load save file '%1': File is truncated", filePath);
+        return false;
+    }
+
+    m_progOffset = is.device()->pos();
+    return true;
+}
+
+
+bool SaveFileReader::readProg(Prog *prog)
+{
+    m_prog = prog;
+    m_functions.clear();
+    m_bodyOffsets.clear();
+
+    QDataStream is(getData(m_progOffset, static_cast<qint64>(m_dataSize) - m_progOffset));
+    initStream(is);
+
+    QString progName;
+    is >> progName;
+    prog->setName(progName);
+
+    // Modules
+    quint32 numModules = 0;
+    is >> numModules;
+
+    std::vector<Module *> modules;
+    for (quint32 i = 0; i < numModules && is.status() == QDataStream::Ok; ++i) {
+        QString name;
+        qint32 parentIdx = NO_INDEX;
+        bool isAggregate = false;
+        is >> name >> parentIdx >> isAggregate;
+
+        Module *module = nullptr;
+        if (i == 0) {
+            module = prog->getRootModule();
+        }
+        else if (parentIdx >= 0 && parentIdx < static_cast<qint32>(modules.size())) {
+            Module *parent = modules[parentIdx];
+            module         = isAggregate ? prog->createModule(name, parent, ClassModFactory())
+                                 : prog->createModule(name, parent, DefaultModFactory());
+
+            if (!module) { // already exists
+                module = prog->getRootModule()->find(name);
+            }
+        }
+        else {
+            module = isAggregate ? prog->getOrInsertModule(name, ClassModFactory())
+                                 : prog->getOrInsertModule(name, DefaultModFactory());
+        }
+
+        if (!module) {
+            LOG_ERROR("Cannot load save file: Invalid module '%1'", name);
+            return false;
+        }
+
+        modules.push_back(module);
+    }
+
+    // Functions
+    quint32 numFunctions = 0;
+    is >> numFunctions;
+
+    for (quint32 i = 0; i < numFunctions && is.status() == QDataStream::Ok; ++i) {
+        qint32 moduleIdx = NO_INDEX;
+        bool isLib       = false;
+        QString name;
+        is >> moduleIdx >> isLib >> name;
+        const Address entryAddr = readAddress(is);
+
+        if (moduleIdx < 0 || moduleIdx >= static_cast<qint32>(modules.size())) {
+            LOG_ERROR("Cannot load save file: Invalid module of function '%1'", name);
+            return false;
+        }
+
+        m_functions.push_back(modules[moduleIdx]->createFunction(name, entryAddr, isLib));
+    }
+
+    for (Function *function : m_functions) {
+        function->setSignature(readSignature(is));
+
+        if (!function->isLib()) {
+            quint8 status = 0;
+            is >> status;
+            static_cast<UserProc *>(function)->setStatus(static_cast<ProcStatus>(status));
+        }
+    }
+
+    quint32 numEntryProcs = 0;
+    is >> numEntryProcs;
+    for (quint32 i = 0; i < numEntryProcs && is.status() == QDataStream::Ok; ++i) {
+        qint32 funcIdx = NO_INDEX;
+        is >> funcIdx;
+
+        Function *function = getFunction(funcIdx);
+        if (function) {
+            prog->addEntryPoint(function->getEntryAddress());
+        }
+    }
+
+    quint32 numRecursionGroups = 0;
+    is >> numRecursionGroups;
+    for (quint32 i = 0; i < numRecursionGroups && is.status() == QDataStream::Ok; ++i) {
+        std::shared_ptr<ProcSet> group = std::make_shared<ProcSet>();
+
+        quint32 numMembers = 0;
+        is >> numMembers;
+        for (quint32 j = 0; j < numMembers && is.status() == QDataStream::Ok; ++j) {
+            qint32 funcIdx = NO_INDEX;
+            is >> funcIdx;
+
+            Function *function = getFunction(funcIdx);
+            if (function && !function->isLib()) {
+                group->insert(static_cast<UserProc *>(function));
+            }
+        }
+
+        for (UserProc *proc : *group) {
+            proc->setRecursionGroup(group);
+        }
+    }
+
+    quint32 numGlobals = 0;
+    is >> numGlobals;
+    for (quint32 i = 0; i < numGlobals && is.status() == QDataStream::Ok; ++i) {
+        QString name;
+        is >> name;
+        const Address addr = readAddress(is);
+        SharedType ty      = readType(is);
+
+        prog->getGlobals().insert(std::make_shared<Global>(ty, addr, name, prog));
+    }
+
+    // Callers are registered when the bodies of the calling procedures are read,
+    // so the callers of a function load these bodies first.
+    for (Function *function : m_functions) {
+        quint32 numCallers = 0;
+        is >> numCallers;
+
+        std::vector<UserProc *> callerProcs;
+        for (quint32 i = 0; i < numCallers && is.status() == QDataStream::Ok; ++i) {
+            qint32 funcIdx = NO_INDEX;
+            is >> funcIdx;
+
+            Function *caller = getFunction(funcIdx);
+            if (caller && !caller->isLib()) {
+                callerProcs.push_back(static_cast<UserProc *>(caller));
+            }
+        }
+
+        if (!callerProcs.empty()) {
+            function->setCallersLoader([callerProcs]() {
+                for (UserProc *caller : callerProcs) {
+                    caller->loadBody();
+                }
+            });
+        }
+    }
+
+    // Procedure bodies are only indexed here; they are read on first access.
+    quint32 numBodies = 0;
+    is >> numBodies;
+    for (quint32 i = 0; i < numBodies && is.status() == QDataStream::Ok; ++i) {
+        qint32 funcIdx = NO_INDEX;
+        quint32 length = 0;
+        is >> funcIdx >> length;
+
+        const qint64 offset = m_progOffset + is.device()->pos();
+        if (is.skipRawData(length) != static_cast<int>(length)) {
+            break;
+        }
+
+        Function *function = getFunction(funcIdx);
+        if (!function || function->isLib()) {
+            continue;
+        }
+
+        UserProc *proc      = static_cast<UserProc *>(function);
+        m_bodyOffsets[proc] = { offset, length };
+        proc->setBodyLoader([this](UserProc *p) { loadBody(p); });
+    }
+
+    if (is.status() != QDataStream::Ok) {
+        LOG_ERROR("Cannot load save file: File is truncated");
+        return false;
+    }
+
+    return true;
+}
+
+
+void SaveFileReader::loadAllBodies()
+{
+    for (Function *function : m_functions) {
+        if (!function->isLib()) {
+            static_cast<UserProc *>(function)->loadBody();
+        }
+    }
+}
+
+
+void SaveFileReader::loadBody(UserProc *proc)
+{
+    std::lock_guard<std::recursive_mutex> lock(Function::getLoaderMutex());
+
+    auto it = m_bodyOffsets.find(proc);
+    if (it == m_bodyOffsets.end()) {
+        return;
+    }
+
+    const auto [offset, length] = it->second;
+    m_bodyOffsets.erase(it);
+
+    QDataStream is(getData(offset, length));
+    initStream(is);
+
+    if (!readProcBody(is, proc) || is.status() != QDataStream::Ok) {
+        LOG_ERROR("Cannot load body of procedure '%1' from save file", proc->getName());
+        clearProcBody(proc);
+        proc->setStatus(ProcStatus::Undecoded);
+    }
+
+    resetBodyState();
+}
+
+
+bool SaveFileReader::readProcedure(const QByteArray &data, UserProc *proc)
+{
+    std::lock_guard<std::recursive_mutex> lock(Function::getLoaderMutex());
+
+    m_prog = proc->getProg();
+
+    QDataStream is(data);
+    initStream(is);
+
+    quint32 magic = 0, version = 0;
+    is >> magic >> version;
+
+    if (magic != MAGIC || version != VERSION) {
+        return false;
+    }
+
+    std::vector<Function *> functions;
+
+    quint32 numFunctions = 0;
+    is >> numFunctions;
+    for (quint32 i = 0; i < numFunctions && is.status() == QDataStream::Ok; ++i) {
+        bool isLib = false;
+        QString name;
+        is >> isLib >> name;
+        const Address entryAddr = readAddress(is);
+
+        // Library functions do not necessarily have an entry address.
+        Function *function = isLib ? m_prog->getFunctionByName(name)
+                                   : m_prog->getFunctionByAddr(entryAddr);
+
+        if (!function || function->isLib() != isLib || function->getName() != name) {
+            return false;
+        }
+
+        functions.push_back(function);
+    }
+
+    QByteArray procData;
+    is >> procData;
+
+    if (is.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    QDataStream procStream(procData);
+    initStream(procStream);
+
+    // Indices in the data refer to the function table of the procedure,
+    // not to the one of the save file.
+    std::swap(m_functions, functions);
+
+    std::shared_ptr<Signature> sig = readSignature(procStream);
+    quint8 status                  = 0;
+    QByteArray body;
+    procStream >> status >> body;
+
+    bool ok = sig && procStream.status() == QDataStream::Ok;
+    if (ok) {
+        clearProcBody(proc);
+        proc->setSignature(sig);
+
+        QDataStream bodyStream(body);
+        initStream(bodyStream);
+
+        ok = readProcBody(bodyStream, proc) && bodyStream.status() == QDataStream::Ok;
+        if (ok) {
+            proc->setStatus(static_cast<ProcStatus>(status));
+        }
+        else {
+            clearProcBody(proc);
+            proc->setStatus(ProcStatus::Undecoded);
+        }
+    }
+
+    std::swap(m_functions, functions);
+    resetBodyState();
+
+    if (!ok) {
+        return false;
+    }
+
+    // Calls to this procedure that already use the return statement of the old body.
+    // Callers that have not been loaded yet get the new return statement when they are loaded.
+    for (CallStatement *caller : proc->m_callers) {
+        if (caller->getCalleeReturn()) {
+            caller->setCalleeReturn(proc->m_retStatement);
+        }
+    }
+
+    return true;
+}
+
+
+std::shared_ptr<Signature> SaveFileReader::readSignature(const QByteArray &data)
+{
+    std::lock_guard<std::recursive_mutex> lock(Function::getLoaderMutex());
+
+    QDataStream is(data);
+    initStream(is);
+
+    std::shared_ptr<Signature> sig = readSignature(is);
+    return is.status() == QDataStream::Ok ? sig : nullptr;
+}
+
+
+SharedType SaveFileReader::readType(const QByteArray &data)
+{
+    std::lock_guard<std::recursive_mutex> lock(Function::getLoaderMutex());
+
+    QDataStream is(data);
+    initStream(is);
+
+    SharedType ty = readType(is);
+    return is.status() == QDataStream::Ok ? ty : nullptr;
+}
+
+
+bool SaveFileReader::readProcBody(QDataStream &is, UserProc *proc)
+{
+    MemoryArena::Scope arenaScope(proc->getArena());
+
+    resetBodyState();
+    m_currentProc = proc;
+
+    ProcCFG *cfg = proc->m_cfg.get();
+
+    qint32 nextLocal = 0;
+    is >> nextLocal;
+    proc->m_nextLocal = nextLocal;
+
+    quint32 numBBs = 0;
+    is >> numBBs;
+
+    for (quint32 i = 0; i < numBBs && is.status() == QDataStream::Ok; ++i) {
+        qint8 bbType = 0;
+        is >> bbType;
+        const Address lowAddr = readAddress(is);
+
+        quint32 numRTLs = 0;
+        is >> numRTLs;
+
+        std::unique_ptr<RTLList> rtls(new RTLList);
+        for (quint32 j = 0; j < numRTLs && is.status() == QDataStream::Ok; ++j) {
+            std::unique_ptr<RTL> rtl(new RTL(readAddress(is)));
+
+            quint32 numStmts = 0;
+            is >> numStmts;
+            for (quint32 k = 0; k < numStmts && is.status() == QDataStream::Ok; ++k) {
+                Statement *stmt = readStatement(is);
+                if (stmt) {
+                    rtl->append(stmt);
+                }
+            }
+
+            rtls->push_back(std::move(rtl));
+        }
+
+        // Insert the BBs directly; createBB() would split or merge them.
+        BasicBlock *bb = nullptr;
+        if (rtls->empty()) {
+            bb = new BasicBlock(lowAddr, proc);
+            bb->setType(static_cast<BBType>(bbType));
+        }
+        else {
+            bb = new BasicBlock(static_cast<BBType>(bbType), std::move(rtls), proc);
+        }
+
+        cfg->insertBB(bb);
+        m_bbs.push_back(bb);
+    }
+
+    for (BasicBlock *bb : m_bbs) {
+        quint32 numSuccessors = 0;
+        is >> numSuccessors;
+        for (quint32 i = 0; i < numSuccessors && is.status() == QDataStream::Ok; ++i) {
+            qint32 bbIdx = NO_INDEX;
+            is >> bbIdx;
+            bb->addSuccessor(getBB(bbIdx));
+        }
+
+        quint32 numPredecessors = 0;
+        is >> numPredecessors;
+        for (quint32 i = 0; i < numPredecessors && is.status() == QDataStream::Ok; ++i) {
+            qint32 bbIdx = NO_INDEX;
+            is >> bbIdx;
+            bb->addPredecessor(getBB(bbIdx));
+        }
+    }
+
+    qint32 entryIdx = NO_INDEX, exitIdx = NO_INDEX;
+    bool implicitsDone = false;
+    is >> entryIdx >> exitIdx >> implicitsDone;
+
+    cfg->m_entryBB       = getBB(entryIdx);
+    cfg->m_exitBB        = getBB(exitIdx);
+    cfg->m_implicitsDone = implicitsDone;
+
+    quint32 numImplicits = 0;
+    is >> numImplicits;
+    for (quint32 i = 0; i < numImplicits && is.status() == QDataStream::Ok; ++i) {
+        SharedExp exp = readExp(is);
+        qint32 defID  = NO_INDEX;
+        is >> defID;
+
+        if (exp && getStatement(defID)) {
+            cfg->m_implicitMap[exp] = getStatement(defID);
+        }
+    }
+
+    readStatementList(is, proc->m_parameters);
+
+    qint32 retID = NO_INDEX;
+    is >> retID;
+    proc->m_retStatement = dynamic_cast<ReturnStatement *>(getStatement(retID));
+
+    quint32 numLocals = 0;
+    is >> numLocals;
+    for (quint32 i = 0; i < numLocals && is.status() == QDataStream::Ok; ++i) {
+        QString name;
+        is >> name;
+        proc->m_locals[name] = readType(is);
+    }
+
+    quint32 numSymbols = 0;
+    is >> numSymbols;
+    for (quint32 i = 0; i < numSymbols && is.status() == QDataStream::Ok; ++i) {
+        SharedExp from = readExp(is);
+        SharedExp to   = readExp(is);
+        proc->m_symbolMap.insert({ from, to });
+    }
+
+    quint32 numCallees = 0;
+    is >> numCallees;
+    for (quint32 i = 0; i < numCallees && is.status() == QDataStream::Ok; ++i) {
+        qint32 funcIdx = NO_INDEX;
+        is >> funcIdx;
+
+        if (getFunction(funcIdx)) {
+            proc->m_calleeList.push_back(getFunction(funcIdx));
+        }
+    }
+
+    quint32 numUses = 0;
+    is >> numUses;
+    for (quint32 i = 0; i < numUses && is.status() == QDataStream::Ok; ++i) {
+        proc->m_procUseCollector.insert(readExp(is));
+    }
+
+    for (UserProc::ExpExpMap *premises : { &proc->m_provenTrue, &proc->m_recurPremises }) {
+        quint32 numPremises = 0;
+        is >> numPremises;
+        for (quint32 i = 0; i < numPremises && is.status() == QDataStream::Ok; ++i) {
+            SharedExp left  = readExp(is);
+            SharedExp right = readExp(is);
+            (*premises)[left] = right;
+        }
+    }
+
+    if (is.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    // Resolve references to statements, which may have been read after their uses.
+    for (auto &[ref, defID] : m_pendingRefs) {
+        ref->setDef(getStatement(defID));
+    }
+
+    for (const PendingPhiDef &phiDef : m_pendingPhiDefs) {
+        phiDef.phi->putAt(getBB(phiDef.bbIdx), getStatement(phiDef.defID), phiDef.exp);
+    }
+
+    for (CallStatement *call : m_calls) {
+        for (Statement *arg : call->getArguments()) {
+            arg->setBB(call->getBB());
+        }
+    }
+
+    // Calls to this procedure that were loaded before this procedure
+    // are waiting for its return statement.
+    for (CallStatement *caller : proc->m_callers) {
+        if (m_callsWithCalleeReturn.erase(caller) > 0) {
+            caller->setCalleeReturn(proc->m_retStatement);
+        }
+    }
+
+    return true;
+}
+
+
+void SaveFileReader::clearProcBody(UserProc *proc)
+{
+    if (proc->isBodyLoaded()) {
+        StatementList stmts;
+        proc->getStatements(stmts);
+
+        for (Statement *stmt : stmts) {
+            if (stmt->isCall()) {
+                m_callsWithCalleeReturn.erase(static_cast<CallStatement *>(stmt));
+            }
+        }
+    }
+
+    // calls of a partially read body might not be part of the CFG yet
+    for (CallStatement *call : m_calls) {
+        m_callsWithCalleeReturn.erase(call);
+    }
+
+    proc->clearBody();
+}
+
+
+void SaveFileReader::resetBodyState()
+{
+    m_currentProc = nullptr;
+    m_bbs.clear();
+    m_statements.clear();
+    m_pendingRefs.clear();
+    m_pendingPhiDefs.clear();
+    m_calls.clear();
+}
+
+
+std::shared_ptr<Signature> SaveFileReader::readSignature(QDataStream &is)
+{
+    using namespace CallingConvention;
+
+    quint8 tag = 0;
+    is >> tag;
+
+    if (static_cast<SignatureTag>(tag) == SignatureTag::Null) {
+        return nullptr;
+    }
+
+    QString name, sigFile, preferredName;
+    bool ellipsis = false, unknown = false, forced = false;
+    is >> name >> sigFile >> preferredName >> ellipsis >> unknown >> forced;
+
+    std::shared_ptr<Signature> sig;
+
+    switch (static_cast<SignatureTag>(tag)) {
+    case SignatureTag::Custom: {
+        std::shared_ptr<CustomSignature> custom = std::make_shared<CustomSignature>(name);
+
+        qint32 spReg = 0;
+        is >> spReg;
+        custom->setSP(spReg);
+        sig = custom;
+    } break;
+
+    case SignatureTag::Pentium: sig = std::make_shared<StdC::PentiumSignature>(name); break;
+    case SignatureTag::Win32: sig = std::make_shared<Win32Signature>(name); break;
+    case SignatureTag::Win32Tc: sig = std::make_shared<Win32TcSignature>(name); break;
+    case SignatureTag::SPARC: sig = std::make_shared<StdC::SPARCSignature>(name); break;
+    case SignatureTag::SPARCLib: sig = std::make_shared<StdC::SPARCLibSignature>(name); break;
+    case SignatureTag::PPC: sig = std::make_shared<StdC::PPCSignature>(name); break;
+    case SignatureTag::ST20: sig = std::make_shared<StdC::ST20Signature>(name); break;
+    default: sig = std::make_shared<Signature>(name); break;
+    }
+
+    sig->setSigFilePath(sigFile);
+    sig->setPreferredName(preferredName);
+    sig->setHasEllipsis(ellipsis);
+    sig->setUnknown(unknown);
+    sig->setForced(forced);
+
+    // The constructors of the derived signatures add default parameters and returns.
+    sig->m_params.clear();
+    sig->m_returns.clear();
+
+    quint32 numParams = 0;
+    is >> numParams;
+    for (quint32 i = 0; i < numParams && is.status() == QDataStream::Ok; ++i) {
+        SharedType ty = readType(is);
+        QString paramName;
+        is >> paramName;
+        SharedExp exp = readExp(is);
+        QString boundMax;
+        is >> boundMax;
+
+        sig->m_params.push_back(std::make_shared<Parameter>(ty, paramName, exp, boundMax));
+    }
+
+    quint32 numReturns = 0;
+    is >> numReturns;
+    for (quint32 i = 0; i < numReturns && is.status() == QDataStream::Ok; ++i) {
+        SharedType ty = readType(is);
+        SharedExp exp = readExp(is);
+
+        sig->m_returns.push_back(std::make_shared<Return>(ty, exp));
+    }
+
+    return sig;
+}
+
+
+SharedType SaveFileReader::readType(QDataStream &is)
+{
+    quint8 tag = NULL_TYPE;
+    is >> tag;
+
+    if (tag == NULL_TYPE) {
+        return nullptr;
+    }
+
+    switch (static_cast<TypeClass>(tag)) {
+    case TypeClass::Void: return VoidType::get();
+    case TypeClass::Boolean: return BooleanType::get();
+    case TypeClass::Char: return CharType::get();
+    case TypeClass::Func: return FuncType::get(readSignature(is));
+
+    case TypeClass::Integer: {
+        quint64 size = 0;
+        qint8 sign   = 0;
+        is >> size >> sign;
+        return IntegerType::get(size, static_cast<Sign>(sign));
+    }
+
+    case TypeClass::Float: {
+        quint64 size = 0;
+        is >> size;
+        return FloatType::get(size);
+    }
+
+    case TypeClass::Size: {
+        quint64 size = 0;
+        is >> size;
+        return SizeType::get(size);
+    }
+
+    case TypeClass::Pointer: return PointerType::get(readType(is));
+
+    case TypeClass::Array: {
+        SharedType baseType = readType(is);
+        quint64 length      = 0;
+        is >> length;
+        return ArrayType::get(baseType, length);
+    }
+
+    case TypeClass::Named: {
+        QString name;
+        is >> name;
+        return NamedType::get(name);
+    }
+
+    case TypeClass::Compound: {
+        std::shared_ptr<CompoundType> compound = CompoundType::get();
+
+        quint32 numMembers = 0;
+        is >> numMembers;
+        for (quint32 i = 0; i < numMembers && is.status() == QDataStream::Ok; ++i) {
+            SharedType memberType = readType(is);
+            QString memberName;
+            is >> memberName;
+            compound->addMember(memberType, memberName);
+        }
+
+        return compound;
+    }
+
+    case TypeClass::Union: {
+        std::shared_ptr<UnionType> unionType = UnionType::get();
+
+        quint32 numMembers = 0;
+        is >> numMembers;
+        for (quint32 i = 0; i < numMembers && is.status() == QDataStream::Ok; ++i) {
+            SharedType memberType = readType(is);
+            QString memberName;
+            is >> memberName;
+            unionType->addType(memberType, memberName);
+        }
+
+        return unionType;
+    }
+    }
+
+    LOG_ERROR("Cannot load type: Invalid type class %1", static_cast<int>(tag));
+    is.setStatus(QDataStream::ReadCorruptData);
+    return nullptr;
+}
+
+
+SharedExp SaveFileReader::readExp(QDataStream &is)
+{
+    quint8 tag = 0;
+    is >> tag;
+
+    qint16 oper = 0;
+
+    switch (static_cast<ExpTag>(tag)) {
+    case ExpTag::Null: return nullptr;
+
+    case ExpTag::Const: {
+        quint8 constTag = 0;
+        is >> oper >> constTag;
+
+        std::shared_ptr<Const> c;
+        switch (static_cast<ConstTag>(constTag)) {
+        case ConstTag::Int: {
+            qint32 value = 0;
+            is >> value;
+            c = Const::get(static_cast<int>(value));
+        } break;
+
+        case ConstTag::Long: {
+            quint64 value = 0;
+            is >> value;
+            c = Const::get(static_cast<QWord>(value));
+        } break;
+
+        case ConstTag::Float: {
+            double value = 0.0;
+            is >> value;
+            c = Const::get(value);
+        } break;
+
+        case ConstTag::String: {
+            QString value;
+            is >> value;
+            c = Const::get(value);
+        } break;
+
+        case ConstTag::Func: {
+            qint32 funcIdx = NO_INDEX;
+            is >> funcIdx;
+            c = Const::get(getFunction(funcIdx));
+        } break;
+
+        default: is.setStatus(QDataStream::ReadCorruptData); return nullptr;
+        }
+
+        // e.g. addresses are stored as 64 bit integer constants with opIntConst
+        c->setOper(static_cast<OPER>(oper));
+        c->setType(readType(is));
+        return c;
+    }
+
+    case ExpTag::Location: {
+        is >> oper;
+        SharedExp sub1 = readExp(is);
+        qint32 procIdx = NO_INDEX;
+        is >> procIdx;
+
+        Function *proc = getFunction(procIdx);
+        return Location::get(static_cast<OPER>(oper), sub1,
+                             (proc && !proc->isLib()) ? static_cast<UserProc *>(proc) : nullptr);
+    }
+
+    case ExpTag::RefExp: {
+        SharedExp sub1 = readExp(is);
+        qint32 defID   = NO_INDEX;
+        is >> defID;
+
+        if (defID == WILD_INDEX) {
+            return RefExp::get(sub1, STMT_WILD);
+        }
+
+        std::shared_ptr<RefExp> ref = RefExp::get(sub1, nullptr);
+        if (defID != NO_INDEX) {
+            m_pendingRefs.push_back({ ref, defID });
+        }
+
+        return ref;
+    }
+
+    case ExpTag::TypedExp: {
+        SharedType ty  = readType(is);
+        SharedExp sub1 = readExp(is);
+        return TypedExp::get(ty, sub1);
+    }
+
+    case ExpTag::Terminal: is >> oper; return Terminal::get(static_cast<OPER>(oper));
+
+    case ExpTag::Unary: {
+        is >> oper;
+        SharedExp sub1 = readExp(is);
+        return Unary::get(static_cast<OPER>(oper), sub1);
+    }
+
+    case ExpTag::Binary: {
+        is >> oper;
+        SharedExp sub1 = readExp(is);
+        SharedExp sub2 = readExp(is);
+        return Binary::get(static_cast<OPER>(oper), sub1, sub2);
+    }
+
+    case ExpTag::Ternary: {
+        is >> oper;
+        SharedExp sub1 = readExp(is);
+        SharedExp sub2 = readExp(is);
+        SharedExp sub3 = readExp(is);
+        return Ternary::get(static_cast<OPER>(oper), sub1, sub2, sub3);
+    }
+    }
+
+    LOG_ERROR("Cannot load expression: Invalid tag %1", tag);
+    is.setStatus(QDataStream::ReadCorruptData);
+    return nullptr;
+}
+
+
+Statement *SaveFileReader::readStatement(QDataStream &is)
+{
+    quint8 kindTag = NULL_STMT;
+    is >> kindTag;
+
+    if (kindTag == NULL_STMT) {
+        return nullptr;
+    }
+
+    qint32 id = NO_INDEX, number = 0;
+    is >> id >> number;
+
+    const StmtType kind = static_cast<StmtType>(kindTag);
+
+    SharedType ty;
+    SharedExp lhs;
+    if (kind == StmtType::Assign || kind == StmtType::PhiAssign || kind == StmtType::ImpAssign ||
+        kind == StmtType::BoolAssign) {
+        ty  = readType(is);
+        lhs = readExp(is);
+    }
+
+    Statement *stmt = nullptr;
+
+    switch (kind) {
+    case StmtType::Assign: {
+        SharedExp rhs   = readExp(is);
+        SharedExp guard = readExp(is);
+        stmt            = new Assign(ty, lhs, rhs, guard);
+    } break;
+
+    case StmtType::PhiAssign: {
+        PhiAssign *phi = new PhiAssign(ty, lhs);
+
+        quint32 numDefs = 0;
+        is >> numDefs;
+        for (quint32 i = 0; i < numDefs && is.status() == QDataStream::Ok; ++i) {
+            qint32 bbIdx = NO_INDEX;
+            is >> bbIdx;
+            SharedExp exp = readExp(is);
+            qint32 defID  = NO_INDEX;
+            is >> defID;
+
+            m_pendingPhiDefs.push_back({ phi, bbIdx, exp, defID });
+        }
+
+        stmt = phi;
+    } break;
+
+    case StmtType::ImpAssign: stmt = new ImplicitAssign(ty, lhs); break;
+
+    case StmtType::BoolAssign: {
+        qint32 size  = 0;
+        quint8 cond  = 0;
+        bool isFloat = false;
+        is >> size >> cond >> isFloat;
+
+        BoolAssign *asgn = new BoolAssign(size);
+        asgn->setLeft(lhs);
+        asgn->setType(ty);
+        asgn->setCondType(static_cast<BranchType>(cond), isFloat);
+        asgn->setCondExprND(readExp(is));
+        stmt = asgn;
+    } break;
+
+    case StmtType::Goto:
+    case StmtType::Branch:
+    case StmtType::Case:
+    case StmtType::Call: {
+        GotoStatement *jump = nullptr;
+        switch (kind) {
+        case StmtType::Branch: jump = new BranchStatement(); break;
+        case StmtType::Case: jump = new CaseStatement(); break;
+        case StmtType::Call: jump = new CallStatement(); break;
+        default: jump = new GotoStatement(); break;
+        }
+
+        jump->setDest(readExp(is));
+
+        bool isComputed = false;
+        is >> isComputed;
+        jump->setIsComputed(isComputed);
+        stmt = jump;
+    } break;
+
+    case StmtType::Ret: {
+        ReturnStatement *ret = new ReturnStatement();
+        ret->setRetAddr(readAddress(is));
+        readStatementList(is, ret->m_modifieds);
+        readStatementList(is, ret->m_returns);
+
+        bool initialised = false;
+        is >> initialised;
+
+        quint32 numDefs = 0;
+        is >> numDefs;
+        for (quint32 i = 0; i < numDefs && is.status() == QDataStream::Ok; ++i) {
+            Assign *def = dynamic_cast<Assign *>(readStatement(is));
+            if (def) {
+                ret->m_col.insert(def);
+            }
+        }
+
+        ret->m_col.m_initialised = initialised;
+        stmt                     = ret;
+    } break;
+
+    default:
+        LOG_ERROR("Cannot load statement: Invalid kind %1", kindTag);
+        is.setStatus(QDataStream::ReadCorruptData);
+        return nullptr;
+    }
+
+    if (stmt->isBranch()) {
+        quint8 condType = 0;
+        bool isFloat    = false;
+        is >> condType >> isFloat;
+
+        BranchStatement *branch = static_cast<BranchStatement *>(stmt);
+        branch->setCondType(static_cast<BranchType>(condType), isFloat);
+        branch->setCondExpr(readExp(is));
+    }
+    else if (stmt->isCase()) {
+        bool hasSwitchInfo = false;
+        is >> hasSwitchInfo;
+
+        if (hasSwitchInfo) {
+            SwitchInfo *si = new SwitchInfo;
+            si->switchExp  = readExp(is);
+
+            qint8 switchType  = 0;
+            qint32 lowerBound = 0, upperBound = 0, numTableEntries = 0, offsetFromJumpTbl = 0;
+            is >> switchType >> lowerBound >> upperBound;
+            si->tableAddr = readAddress(is);
+            is >> numTableEntries >> offsetFromJumpTbl;
+
+            si->switchType        = static_cast<SwitchType>(switchType);
+            si->lowerBound        = lowerBound;
+            si->upperBound        = upperBound;
+            si->numTableEntries   = numTableEntries;
+            si->offsetFromJumpTbl = offsetFromJumpTbl;
+
+            static_cast<CaseStatement *>(stmt)->setSwitchInfo(si);
+        }
+    }
+    else if (stmt->isCall()) {
+        CallStatement *call = static_cast<CallStatement *>(stmt);
+
+        bool returnAfterCall = false;
+        qint32 destIdx       = NO_INDEX;
+        is >> returnAfterCall >> destIdx;
+
+        call->setReturnAfterCall(returnAfterCall);
+        if (Function *dest = getFunction(destIdx)) {
+            call->setDestProc(dest);
+            dest->addCaller(call);
+        }
+
+        call->setSignature(readSignature(is));
+
+        StatementList args, defines;
+        readStatementList(is, args);
+        readStatementList(is, defines);
+        call->setArguments(args);
+        call->setDefines(defines);
+
+        quint32 numUses = 0;
+        is >> numUses;
+        for (quint32 i = 0; i < numUses && is.status() == QDataStream::Ok; ++i) {
+            call->getUseCollector()->insert(readExp(is));
+        }
+
+        bool initialised = false;
+        is >> initialised;
+
+        quint32 numDefs = 0;
+        is >> numDefs;
+        for (quint32 i = 0; i < numDefs && is.status() == QDataStream::Ok; ++i) {
+            Assign *def = dynamic_cast<Assign *>(readStatement(is));
+            if (def) {
+                call->getDefCollector()->insert(def);
+            }
+        }
+
+        call->getDefCollector()->m_initialised = initialised;
+
+        bool hasCalleeReturn = false;
+        is >> hasCalleeReturn;
+
+        // The return statement of the callee is only available once the callee is loaded.
+        if (hasCalleeReturn && call->getDestProc() && !call->getDestProc()->isLib()) {
+            UserProc *callee = static_cast<UserProc *>(call->getDestProc());
+
+            if (callee->isBodyLoaded() && callee != m_currentProc) {
+                call->setCalleeReturn(callee->m_retStatement);
+            }
+            else {
+                m_callsWithCalleeReturn.insert(call);
+            }
+        }
+
+        m_calls.push_back(call);
+    }
+
+    stmt->setProc(m_currentProc);
+    stmt->setNumber(number);
+
+    if (id != NO_INDEX) {
+        m_statements[id] = stmt;
+    }
+
+    return stmt;
+}
+
+
+void SaveFileReader::readStatementList(QDataStream &is, StatementList &stmts)
+{
+    quint32 numStmts = 0;
+    is >> numStmts;
+
+    for (quint32 i = 0; i < numStmts && is.status() == QDataStream::Ok; ++i) {
+        Statement *stmt = readStatement(is);
+        if (stmt) {
+            stmts.append(stmt);
+        }
+    }
+}
+
+
+QByteArray SaveFileReader::getData(qint64 offset, qint64 length) const
+{
+    if (offset < 0 || length < 0 || static_cast<std::size_t>(offset + length) > m_dataSize) {
+        return QByteArray();
+    }
+
+    const char *data = m_mappedData ? reinterpret_cast<const char *>(m_mappedData)
+                                    : m_data.constData();
+
+    // Does not copy the data
+    return QByteArray::fromRawData(data + offset, static_cast<int>(length));
+}
+
+
+Function *SaveFileReader::getFunction(qint32 idx) const
+{
+    return (idx >= 0 && idx < static_cast<qint32>(m_functions.size())) ? m_functions[idx]
+                                                                        : nullptr;
+}
+
+
+BasicBlock *SaveFileReader::getBB(qint32 idx) const
+{
+    return (idx >= 0 && idx < static_cast<qint32>(m_bbs.size())) ? m_bbs[idx] : nullptr;
+}
+
+
+Statement *SaveFileReader::getStatement(qint32 id) const
+{
+    auto it = m_statements.find(id);
+    return it != m_statements.end() ? it->second : nullptr;
+}
@@ -0,0 +1,161 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+
+class BasicBlock;
+class CallStatement;
+class Exp;
+class Function;
+class PhiAssign;
+class Prog;
+class QDataStream;
+class RefExp;
+class Signature;
+class Statement;
+class StatementList;
+class Type;
+class UserProc;
+
+
+/**
+ * Reads a Prog from a save file written by SaveFileWriter.
+ *
+ * The program database (modules, functions, signatures, globals) is read eagerly by readProg().
+ * Procedure bodies are only read when they are first accessed
+ * (see \ref UserProc::setBodyLoader), or by loadAllBodies().
+ * The reader must therefore outlive the Prog it has read.
+ */
+class BOOMERANG_API SaveFileReader
+{
+public:
+    SaveFileReader();
+    SaveFileReader(const SaveFileReader &other) = delete;
+    SaveFileReader(SaveFileReader &&other)      = delete;
+
+    ~SaveFileReader();
+
+    SaveFileReader &operator=(const SaveFileReader &other) = delete;
+    SaveFileReader &operator=(SaveFileReader &&other) = delete;
+
+public:
+    /**
+     * Open the save file at \p filePath and read its header.
+     * \returns false if the file cannot be opened or is not a valid save file.
+     */
+    bool open(const QString &filePath);
+
+    /// \returns the absolute path of the binary file the save file was created from.
+    const QString &getBinaryFilePath() const { return m_binaryFilePath; }
+
+    /// \returns the size of the binary file the save file was created from.
+    qint64 getBinaryFileSize() const { return m_binaryFileSize; }
+
+    /**
+     * Read the program database into \p prog, which must be empty
+     * (i.e. newly created for the binary file of the save file).
+     * Procedure bodies are loaded lazily.
+     * \returns true on success.
+     */
+    bool readProg(Prog *prog);
+
+    /// Load the bodies of all procedures that have not been loaded yet.
+    void loadAllBodies();
+
+    /**
+     * Replace the signature, status and body of \p proc by \p data,
+     * which was written by SaveFileWriter::writeProcedure.
+     * Functions referenced by \p data are looked up in the program of \p proc.
+     * \returns false if \p data is invalid or refers to functions that do not exist.
+     * If reading the body fails, the body of \p proc is removed and \p proc must be decoded again.
+     */
+    bool readProcedure(const QByteArray &data, UserProc *proc);
+
+    /// Read a signature written by SaveFileWriter::writeSignature.
+    /// \returns nullptr if \p data is invalid.
+    std::shared_ptr<Signature> readSignature(const QByteArray &data);
+
+    /// Read a type written by SaveFileWriter::writeType.
+    /// \returns nullptr if \p data is invalid.
+    std::shared_ptr<Type> readType(const QByteArray &data);
+
+private:
+    /// Load the body of \p proc from the save file.
+    void loadBody(UserProc *proc);
+    bool readProcBody(QDataStream &is, UserProc *proc);
+
+    /// Remove the current body of \p proc, so that a different body can be read.
+    void clearProcBody(UserProc *proc);
+
+    /// Reset the state that is only valid while reading a procedure body.
+    void resetBodyState();
+
+    std::shared_ptr<Signature> readSignature(QDataStream &is);
+    std::shared_ptr<Type> readType(QDataStream &is);
+    std::shared_ptr<Exp> readExp(QDataStream &is);
+    Statement *readStatement(QDataStream &is);
+    void readStatementList(QDataStream &is, StatementList &stmts);
+
+    /// \returns the part of the save file at \p offset without copying it.
+    QByteArray getData(qint64 offset, qint64 length) const;
+
+    Function *getFunction(qint32 idx) const;
+    BasicBlock *getBB(qint32 idx) const;
+
+    /// \returns the statement with ID \p id in the procedure body being read,
+    /// or nullptr if it has not been read yet.
+    Statement *getStatement(qint32 id) const;
+
+private:
+    /// Phi operand whose definition may not have been read yet
+    struct PendingPhiDef
+    {
+        PhiAssign *phi;
+        qint32 bbIdx;
+        std::shared_ptr<Exp> exp;
+        qint32 defID;
+    };
+
+    QFile m_file;
+    const uchar *m_mappedData = nullptr;
+    QByteArray m_data; ///< Contents of the save file if it cannot be mapped
+    std::size_t m_dataSize = 0;
+
+    qint64 m_progOffset = 0; ///< Offset of the program database in the save file
+    QString m_binaryFilePath;
+    qint64 m_binaryFileSize = 0;
+
+    Prog *m_prog = nullptr;
+    std::vector<Function *> m_functions;
+    std::unordered_map<const UserProc *, std::pair<qint64, quint32>> m_bodyOffsets;
+
+    /// Calls whose callee return statement is set when the callee is loaded
+    std::set<CallStatement *> m_callsWithCalleeReturn;
+
+    // Only valid while reading a procedure body
+    UserProc *m_currentProc = nullptr;
+    std::vector<BasicBlock *> m_bbs;
+    std::unordered_map<qint32, Statement *> m_statements;
+    std::vector<std::pair<std::shared_ptr<RefExp>, qint32>> m_pendingRefs;
+    std::vector<PendingPhiDef> m_pendingPhiDefs;
+    std::vector<CallStatement *> m_calls;
+};
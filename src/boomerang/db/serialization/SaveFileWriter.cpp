@@ -0,0 +1,739 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "SaveFileWriter.h"
+
+#include "boomerang/core/Project.h"
+#include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/db/serialization/SaveFileFormat.h"
+#include "boomerang/db/signature/CustomSignature.h"
+#include "boomerang/db/signature/PPCSignature.h"
+#include "boomerang/db/signature/Parameter.h"
+#include "boomerang/db/signature/PentiumSignature.h"
+#include "boomerang/db/signature/Return.h"
+#include "boomerang/db/signature/SPARCSignature.h"
+#include "boomerang/db/signature/ST20Signature.h"
+#include "boomerang/db/signature/Win32Signature.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/exp/TypedExp.h"
+#include "boomerang/ssl/statements/BoolAssign.h"
+#include "boomerang/ssl/statements/BranchStatement.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+#include "boomerang/ssl/statements/CaseStatement.h"
+#include "boomerang/ssl/statements/ImplicitAssign.h"
+#include "boomerang/ssl/statements/PhiAssign.h"
+#include "boomerang/ssl/statements/ReturnStatement.h"
+#include "boomerang/ssl/type/ArrayType.h"
+#include "boomerang/ssl/type/CompoundType.h"
+#include "boomerang/ssl/type/FloatType.h"
+#include "boomerang/ssl/type/FuncType.h"
+#include "boomerang/ssl/type/IntegerType.h"
+#include "boomerang/ssl/type/NamedType.h"
+#include "boomerang/ssl/type/PointerType.h"
+#include "boomerang/ssl/type/UnionType.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <set>
+
+
+using namespace SaveFileFormat;
+
+
+static void initStream(QDataStream &os)
+{
+    os.setVersion(STREAM_VERSION);
+    os.setByteOrder(QDataStream::LittleEndian);
+}
+
+
+static void writeAddress(QDataStream &os, Address addr)
+{
+    os << static_cast<quint64>(addr.value());
+}
+
+
+bool SaveFileWriter::writeSaveFile(Prog *prog, const QString &binaryFilePath,
+                                   const QString &saveFilePath)
+{
+    LOG_MSG("Writing save file '%1'", saveFilePath);
+
+    QSaveFile saveFile(saveFilePath);
+    if (!saveFile.open(QFile::WriteOnly)) {
+        LOG_ERROR("Cannot open save file '%1' for writing", saveFilePath);
+        return false;
+    }
+
+    const QFileInfo binaryInfo(binaryFilePath);
+
+    QDataStream os(&saveFile);
+    initStream(os);
+
+    os << MAGIC << VERSION;
+    os << QString(prog->getProject()->getVersionStr());
+    os << binaryInfo.absoluteFilePath() << static_cast<qint64>(binaryInfo.size());
+
+    writeProg(os, prog);
+
+    if (os.status() != QDataStream::Ok || !saveFile.commit()) {
+        LOG_ERROR("Writing save file '%1' failed", saveFilePath);
+        return false;
+    }
+
+    return true;
+}
+
+
+QByteArray SaveFileWriter::writeProcedure(UserProc *proc)
+{
+    m_functionIndices.clear();
+    m_usedFunctions.clear();
+    m_indexFunctionsOnUse = true;
+
+    QByteArray procData;
+    QDataStream procStream(&procData, QIODevice::WriteOnly);
+    initStream(procStream);
+
+    writeSignature(procStream, proc->getSignature().get());
+    procStream << static_cast<quint8>(proc->getStatus());
+    procStream << writeProcBody(proc);
+
+    // The table of used functions is only complete after the procedure has been written.
+    QByteArray data;
+    QDataStream os(&data, QIODevice::WriteOnly);
+    initStream(os);
+
+    os << MAGIC << VERSION;
+    os << static_cast<quint32>(m_usedFunctions.size());
+    for (const Function *function : m_usedFunctions) {
+        os << function->isLib() << function->getName();
+        writeAddress(os, function->getEntryAddress());
+    }
+
+    os << procData;
+
+    m_indexFunctionsOnUse = false;
+    m_functionIndices.clear();
+    m_usedFunctions.clear();
+
+    return data;
+}
+
+
+QByteArray SaveFileWriter::writeFunctionSignature(const Function *function)
+{
+    return writeSignature(function->getSignature().get());
+}
+
+
+QByteArray SaveFileWriter::writeSignature(const Signature *sig)
+{
+    QByteArray data;
+    QDataStream os(&data, QIODevice::WriteOnly);
+    initStream(os);
+
+    writeSignature(os, sig);
+    return data;
+}
+
+
+QByteArray SaveFileWriter::writeType(const SharedConstType &ty)
+{
+    QByteArray data;
+    QDataStream os(&data, QIODevice::WriteOnly);
+    initStream(os);
+
+    writeType(os, ty);
+    return data;
+}
+
+
+void SaveFileWriter::writeProg(QDataStream &os, Prog *prog)
+{
+    m_functionIndices.clear();
+
+    std::unordered_map<const Module *, qint32> moduleIndices;
+    std::vector<Function *> functions;
+
+    for (const auto &module : prog->getModuleList()) {
+        moduleIndices[module.get()] = static_cast<qint32>(moduleIndices.size());
+
+        for (Function *function : *module) {
+            m_functionIndices[function] = static_cast<qint32>(functions.size());
+            functions.push_back(function);
+        }
+    }
+
+    os << prog->getName();
+
+    // Modules. Parent modules are always created (and listed) before their children.
+    os << static_cast<quint32>(prog->getModuleList().size());
+    for (const auto &module : prog->getModuleList()) {
+        const Module *parent = module->getParentModule();
+        os << module->getName();
+        os << (parent ? moduleIndices[parent] : NO_INDEX);
+        os << module->isAggregate();
+    }
+
+    // Functions. Signatures are written after all functions are known,
+    // since they may refer to other functions.
+    os << static_cast<quint32>(functions.size());
+    for (const Function *function : functions) {
+        os << moduleIndices[function->getModule()] << function->isLib() << function->getName();
+        writeAddress(os, function->getEntryAddress());
+    }
+
+    for (const Function *function : functions) {
+        writeSignature(os, function->getSignature().get());
+
+        if (!function->isLib()) {
+            os << static_cast<quint8>(static_cast<const UserProc *>(function)->getStatus());
+        }
+    }
+
+    os << static_cast<quint32>(prog->getEntryProcs().size());
+    for (const UserProc *proc : prog->getEntryProcs()) {
+        os << getFunctionIndex(proc);
+    }
+
+    // Recursion groups are shared between all procedures of the group
+    std::vector<const ProcSet *> recursionGroups;
+    std::unordered_map<const ProcSet *, qint32> groupIndices;
+
+    for (Function *function : functions) {
+        if (function->isLib()) {
+            continue;
+        }
+
+        const ProcSet *group = static_cast<UserProc *>(function)->getRecursionGroup().get();
+        if (group && groupIndices.find(group) == groupIndices.end()) {
+            groupIndices[group] = static_cast<qint32>(recursionGroups.size());
+            recursionGroups.push_back(group);
+        }
+    }
+
+    os << static_cast<quint32>(recursionGroups.size());
+    for (const ProcSet *group : recursionGroups) {
+        os << static_cast<quint32>(group->size());
+        for (const UserProc *proc : *group) {
+            os << getFunctionIndex(proc);
+        }
+    }
+
+    os << static_cast<quint32>(prog->getGlobals().size());
+    for (const std::shared_ptr<Global> &global : prog->getGlobals()) {
+        os << global->getName();
+        writeAddress(os, global->getAddress());
+        writeType(os, global->getType());
+    }
+
+    // Procedures calling each function, so the callers of a function can be loaded
+    // without loading all procedure bodies.
+    for (const Function *function : functions) {
+        std::set<qint32> callerIndices;
+        for (const CallStatement *call : function->getCallers()) {
+            if (call->getProc()) {
+                callerIndices.insert(getFunctionIndex(call->getProc()));
+            }
+        }
+
+        os << static_cast<quint32>(callerIndices.size());
+        for (qint32 callerIdx : callerIndices) {
+            os << callerIdx;
+        }
+    }
+
+    // Procedure bodies
+    std::vector<UserProc *> decodedProcs;
+    for (Function *function : functions) {
+        if (!function->isLib() && static_cast<UserProc *>(function)->isDecoded()) {
+            decodedProcs.push_back(static_cast<UserProc *>(function));
+        }
+    }
+
+    os << static_cast<quint32>(decodedProcs.size());
+    for (UserProc *proc : decodedProcs) {
+        os << getFunctionIndex(proc) << writeProcBody(proc);
+    }
+}
+
+
+QByteArray SaveFileWriter::writeProcBody(UserProc *proc)
+{
+    QByteArray body;
+    QDataStream os(&body, QIODevice::WriteOnly);
+    initStream(os);
+
+    ProcCFG *cfg = proc->getCFG(); // loads the body if necessary
+
+    m_inProcBody = true;
+    m_bbIndices.clear();
+    m_statementIDs.clear();
+
+    for (const BasicBlock *bb : *cfg) {
+        m_bbIndices[bb] = static_cast<qint32>(m_bbIndices.size());
+    }
+
+    os << static_cast<qint32>(proc->m_nextLocal);
+
+    os << static_cast<quint32>(cfg->getNumBBs());
+    for (BasicBlock *bb : *cfg) {
+        os << static_cast<qint8>(bb->getType());
+        writeAddress(os, bb->getLowAddr());
+
+        const RTLList *rtls = bb->getRTLs();
+        os << static_cast<quint32>(rtls ? rtls->size() : 0);
+
+        if (rtls) {
+            for (const auto &rtl : *rtls) {
+                writeAddress(os, rtl->getAddress());
+                os << static_cast<quint32>(rtl->size());
+
+                for (Statement *stmt : *rtl) {
+                    writeStatement(os, stmt);
+                }
+            }
+        }
+    }
+
+    for (const BasicBlock *bb : *cfg) {
+        os << static_cast<quint32>(bb->getNumSuccessors());
+        for (const BasicBlock *succ : bb->getSuccessors()) {
+            os << getBBIndex(succ);
+        }
+
+        os << static_cast<quint32>(bb->getNumPredecessors());
+        for (const BasicBlock *pred : bb->getPredecessors()) {
+            os << getBBIndex(pred);
+        }
+    }
+
+    os << getBBIndex(cfg->getEntryBB()) << getBBIndex(cfg->getExitBB());
+    os << cfg->isImplicitsDone();
+
+    os << static_cast<quint32>(cfg->m_implicitMap.size());
+    for (const auto &[exp, def] : cfg->m_implicitMap) {
+        writeExp(os, exp);
+        os << getStatementID(def);
+    }
+
+    writeStatementList(os, proc->getParameters());
+    os << (proc->getRetStmt() ? getStatementID(proc->getRetStmt()) : NO_INDEX);
+
+    os << static_cast<quint32>(proc->getLocals().size());
+    for (const auto &[name, ty] : proc->getLocals()) {
+        os << name;
+        writeType(os, ty);
+    }
+
+    os << static_cast<quint32>(proc->getSymbolMap().size());
+    for (const auto &[from, to] : proc->getSymbolMap()) {
+        writeExp(os, from);
+        writeExp(os, to);
+    }
+
+    os << static_cast<quint32>(proc->getCallees().size());
+    for (const Function *callee : proc->getCallees()) {
+        os << getFunctionIndex(callee);
+    }
+
+    os << static_cast<quint32>(proc->getUseCollector().getLocSet().size());
+    for (const SharedExp &loc : proc->getUseCollector()) {
+        writeExp(os, loc);
+    }
+
+    for (const UserProc::ExpExpMap *premises : { &proc->m_provenTrue, &proc->m_recurPremises }) {
+        os << static_cast<quint32>(premises->size());
+        for (const auto &[left, right] : *premises) {
+            writeExp(os, left);
+            writeExp(os, right);
+        }
+    }
+
+    m_inProcBody = false;
+    m_bbIndices.clear();
+    m_statementIDs.clear();
+
+    return body;
+}
+
+
+void SaveFileWriter::writeSignature(QDataStream &os, const Signature *sig)
+{
+    using namespace CallingConvention;
+
+    SignatureTag tag = SignatureTag::Generic;
+
+    // Derived classes must be checked before their base classes
+    if (!sig) {
+        tag = SignatureTag::Null;
+    }
+    else if (dynamic_cast<const Win32TcSignature *>(sig)) {
+        tag = SignatureTag::Win32Tc;
+    }
+    else if (dynamic_cast<const Win32Signature *>(sig)) {
+        tag = SignatureTag::Win32;
+    }
+    else if (dynamic_cast<const StdC::PentiumSignature *>(sig)) {
+        tag = SignatureTag::Pentium;
+    }
+    else if (dynamic_cast<const StdC::SPARCLibSignature *>(sig)) {
+        tag = SignatureTag::SPARCLib;
+    }
+    else if (dynamic_cast<const StdC::SPARCSignature *>(sig)) {
+        tag = SignatureTag::SPARC;
+    }
+    else if (dynamic_cast<const StdC::PPCSignature *>(sig)) {
+        tag = SignatureTag::PPC;
+    }
+    else if (dynamic_cast<const StdC::ST20Signature *>(sig)) {
+        tag = SignatureTag::ST20;
+    }
+    else if (dynamic_cast<const CustomSignature *>(sig)) {
+        tag = SignatureTag::Custom;
+    }
+
+    os << static_cast<quint8>(tag);
+    if (!sig) {
+        return;
+    }
+
+    os << sig->getName() << sig->getSigFilePath() << sig->getPreferredName();
+    os << sig->hasEllipsis() << sig->isUnknown() << sig->isForced();
+
+    if (tag == SignatureTag::Custom) {
+        os << static_cast<qint32>(sig->getStackRegister());
+    }
+
+    os << static_cast<quint32>(sig->getParameters().size());
+    for (const std::shared_ptr<Parameter> &param : sig->getParameters()) {
+        writeType(os, param->getType());
+        os << param->getName();
+        writeExp(os, param->getExp());
+        os << param->getBoundMax();
+    }
+
+    os << static_cast<quint32>(sig->getNumReturns());
+    for (int i = 0; i < sig->getNumReturns(); ++i) {
+        writeType(os, sig->getReturnType(i));
+        writeExp(os, sig->getReturnExp(i));
+    }
+}
+
+
+void SaveFileWriter::writeType(QDataStream &os, const SharedConstType &ty)
+{
+    if (!ty) {
+        os << NULL_TYPE;
+        return;
+    }
+
+    os << static_cast<quint8>(ty->getId());
+
+    switch (ty->getId()) {
+    case TypeClass::Void:
+    case TypeClass::Boolean:
+    case TypeClass::Char: break;
+
+    case TypeClass::Func: writeSignature(os, ty->as<FuncType>()->getSignature()); break;
+
+    case TypeClass::Integer:
+        os << static_cast<quint64>(ty->getSize());
+        os << static_cast<qint8>(ty->as<IntegerType>()->getSign());
+        break;
+
+    case TypeClass::Float:
+    case TypeClass::Size: os << static_cast<quint64>(ty->getSize()); break;
+
+    case TypeClass::Pointer: writeType(os, ty->as<PointerType>()->getPointsTo()); break;
+
+    case TypeClass::Array:
+        writeType(os, ty->as<ArrayType>()->getBaseType());
+        os << static_cast<quint64>(ty->as<ArrayType>()->getLength());
+        break;
+
+    case TypeClass::Named: os << ty->as<NamedType>()->getName(); break;
+
+    case TypeClass::Compound: {
+        std::shared_ptr<CompoundType> compound = std::const_pointer_cast<Type>(ty)
+                                                     ->as<CompoundType>();
+
+        os << static_cast<quint32>(compound->getNumMembers());
+        for (int i = 0; i < compound->getNumMembers(); ++i) {
+            writeType(os, compound->getMemberTypeByIdx(i));
+            os << compound->getMemberNameByIdx(i);
+        }
+    } break;
+
+    case TypeClass::Union: {
+        const UnionType::UnionEntries &entries = ty->as<UnionType>()->getEntries();
+
+        os << static_cast<quint32>(entries.size());
+        for (const auto &[memberType, memberName] : entries) {
+            writeType(os, memberType);
+            os << memberName;
+        }
+    } break;
+    }
+}
+
+
+void SaveFileWriter::writeExp(QDataStream &os, const SharedConstExp &exp)
+{
+    if (!exp) {
+        os << static_cast<quint8>(ExpTag::Null);
+        return;
+    }
+
+    const qint16 oper = static_cast<qint16>(exp->getOper());
+
+    if (const Const *c = dynamic_cast<const Const *>(exp.get())) {
+        os << static_cast<quint8>(ExpTag::Const) << oper;
+
+        std::visit(
+            [this, &os](const auto &value) {
+                using T = std::decay_t<decltype(value)>;
+
+                if constexpr (std::is_same_v<T, int>) {
+                    os << static_cast<quint8>(ConstTag::Int) << static_cast<qint32>(value);
+                }
+                else if constexpr (std::is_same_v<T, QWord>) {
+                    os << static_cast<quint8>(ConstTag::Long) << static_cast<quint64>(value);
+                }
+                else if constexpr (std::is_same_v<T, double>) {
+                    os << static_cast<quint8>(ConstTag::Float) << value;
+                }
+                else if constexpr (std::is_same_v<T, Function *>) {
+                    os << static_cast<quint8>(ConstTag::Func) << getFunctionIndex(value);
+                }
+                else {
+                    // Raw strings point into the loaded binary; store them by value.
+                    os << static_cast<quint8>(ConstTag::String) << QString(value);
+                }
+            },
+            c->m_value);
+
+        writeType(os, c->getType());
+    }
+    else if (const Location *loc = dynamic_cast<const Location *>(exp.get())) {
+        os << static_cast<quint8>(ExpTag::Location) << oper;
+        writeExp(os, loc->getSubExp1());
+        os << getFunctionIndex(loc->getProc());
+    }
+    else if (exp->isSubscript()) {
+        const Statement *def = exp->access<const RefExp>()->getDef();
+
+        os << static_cast<quint8>(ExpTag::RefExp);
+        writeExp(os, exp->getSubExp1());
+        os << (def == STMT_WILD ? WILD_INDEX : getStatementID(def));
+    }
+    else if (exp->isTypedExp()) {
+        os << static_cast<quint8>(ExpTag::TypedExp);
+        writeType(os, exp->access<const TypedExp>()->getType());
+        writeExp(os, exp->getSubExp1());
+    }
+    else {
+        switch (exp->getArity()) {
+        case 0: os << static_cast<quint8>(ExpTag::Terminal) << oper; break;
+
+        case 1:
+            os << static_cast<quint8>(ExpTag::Unary) << oper;
+            writeExp(os, exp->getSubExp1());
+            break;
+
+        case 2:
+            os << static_cast<quint8>(ExpTag::Binary) << oper;
+            writeExp(os, exp->getSubExp1());
+            writeExp(os, exp->getSubExp2());
+            break;
+
+        default:
+            os << static_cast<quint8>(ExpTag::Ternary) << oper;
+            writeExp(os, exp->getSubExp1());
+            writeExp(os, exp->getSubExp2());
+            writeExp(os, exp->getSubExp3());
+            break;
+        }
+    }
+}
+
+
+void SaveFileWriter::writeStatement(QDataStream &os, Statement *stmt)
+{
+    if (!stmt) {
+        os << NULL_STMT;
+        return;
+    }
+
+    os << static_cast<quint8>(stmt->getKind()) << getStatementID(stmt);
+    os << static_cast<qint32>(stmt->getNumber());
+
+    if (stmt->isAssignment()) {
+        const Assignment *asgn = static_cast<const Assignment *>(stmt);
+        writeType(os, asgn->getType());
+        writeExp(os, asgn->getLeft());
+    }
+
+    switch (stmt->getKind()) {
+    case StmtType::Assign:
+        writeExp(os, static_cast<const Assign *>(stmt)->getRight());
+        writeExp(os, static_cast<const Assign *>(stmt)->getGuard());
+        break;
+
+    case StmtType::PhiAssign: {
+        const PhiAssign::PhiDefs &defs = static_cast<const PhiAssign *>(stmt)->getDefs();
+
+        os << static_cast<quint32>(defs.size());
+        for (const auto &[bb, ref] : defs) {
+            os << getBBIndex(bb);
+            writeExp(os, ref.getSubExp1());
+            os << getStatementID(ref.getDef());
+        }
+    } break;
+
+    case StmtType::ImpAssign: break;
+
+    case StmtType::BoolAssign: {
+        const BoolAssign *asgn = static_cast<const BoolAssign *>(stmt);
+        os << static_cast<qint32>(asgn->getSize()) << static_cast<quint8>(asgn->getCond());
+        os << asgn->isFloat();
+        writeExp(os, asgn->getCondExpr());
+    } break;
+
+    case StmtType::Goto:
+    case StmtType::Branch:
+    case StmtType::Case:
+    case StmtType::Call: {
+        const GotoStatement *jump = static_cast<const GotoStatement *>(stmt);
+        writeExp(os, jump->getDest());
+        os << jump->isComputed();
+    } break;
+
+    case StmtType::Ret: {
+        ReturnStatement *ret = static_cast<ReturnStatement *>(stmt);
+        writeAddress(os, ret->getRetAddr());
+        writeStatementList(os, ret->getModifieds());
+        writeStatementList(os, ret->getReturns());
+
+        os << ret->getCollector()->isInitialised();
+        os << static_cast<quint32>(std::distance(ret->getCollector()->begin(),
+                                                 ret->getCollector()->end()));
+        for (Assign *def : *ret->getCollector()) {
+            writeStatement(os, def);
+        }
+    } break;
+
+    default: LOG_WARN("Cannot save statement of unknown kind: %1", stmt); break;
+    }
+
+    if (stmt->isBranch()) {
+        const BranchStatement *branch = static_cast<const BranchStatement *>(stmt);
+        os << static_cast<quint8>(branch->getCondType()) << branch->isFloat();
+        writeExp(os, branch->getCondExpr());
+    }
+    else if (stmt->isCase()) {
+        const SwitchInfo *si = static_cast<const CaseStatement *>(stmt)->getSwitchInfo();
+
+        os << (si != nullptr);
+        if (si) {
+            writeExp(os, si->switchExp);
+            os << static_cast<qint8>(si->switchType);
+            os << static_cast<qint32>(si->lowerBound) << static_cast<qint32>(si->upperBound);
+            writeAddress(os, si->tableAddr);
+            os << static_cast<qint32>(si->numTableEntries);
+            os << static_cast<qint32>(si->offsetFromJumpTbl);
+        }
+    }
+    else if (stmt->isCall()) {
+        CallStatement *call = static_cast<CallStatement *>(stmt);
+
+        os << call->isReturnAfterCall() << getFunctionIndex(call->getDestProc());
+        writeSignature(os, call->getSignature().get());
+        writeStatementList(os, call->getArguments());
+        writeStatementList(os, call->getDefines());
+
+        os << static_cast<quint32>(call->getUseCollector()->getLocSet().size());
+        for (const SharedExp &loc : *call->getUseCollector()) {
+            writeExp(os, loc);
+        }
+
+        os << call->getDefCollector()->isInitialised();
+        os << static_cast<quint32>(std::distance(call->getDefCollector()->begin(),
+                                                 call->getDefCollector()->end()));
+        for (Assign *def : *call->getDefCollector()) {
+            writeStatement(os, def);
+        }
+
+        // The return statement of the callee is in a different procedure body;
+        // it is looked up again when the call is loaded.
+        os << (call->getCalleeReturn() != nullptr);
+    }
+}
+
+
+void SaveFileWriter::writeStatementList(QDataStream &os, const StatementList &stmts)
+{
+    os << static_cast<quint32>(stmts.size());
+    for (Statement *stmt : stmts) {
+        writeStatement(os, stmt);
+    }
+}
+
+
+qint32 SaveFileWriter::getFunctionIndex(const Function *function)
+{
+    if (!function) {
+        return NO_INDEX;
+    }
+
+    auto it = m_functionIndices.find(function);
+    if (it != m_functionIndices.end()) {
+        return it->second;
+    }
+    else if (!m_indexFunctionsOnUse) {
+        return NO_INDEX;
+    }
+
+    const qint32 idx            = static_cast<qint32>(m_usedFunctions.size());
+    m_functionIndices[function] = idx;
+    m_usedFunctions.push_back(function);
+    return idx;
+}
+
+
+qint32 SaveFileWriter::getBBIndex(const BasicBlock *bb) const
+{
+    if (!bb) {
+        return NO_INDEX;
+    }
+
+    auto it = m_bbIndices.find(bb);
+    return it != m_bbIndices.end() ? it->second : NO_INDEX;
+}
+
+
+qint32 SaveFileWriter::getStatementID(const Statement *stmt)
+{
+    if (!stmt || !m_inProcBody) {
+        return NO_INDEX;
+    }
+
+    // IDs are assigned on first use, so statements can be referenced before they are written.
+    return m_statementIDs.insert({ stmt, static_cast<qint32>(m_statementIDs.size()) })
+        .first->second;
+}
@@ -0,0 +1,92 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <QByteArray>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+
+class BasicBlock;
+class Exp;
+class Function;
+class Prog;
+class QDataStream;
+class QString;
+class Signature;
+class Statement;
+class StatementList;
+class Type;
+class UserProc;
+
+
+/**
+ * Writes a Prog to a save file. See SaveFileFormat for a description of the format.
+ * Procedures that were not loaded yet from a previous save file are loaded before they are written.
+ */
+class BOOMERANG_API SaveFileWriter
+{
+public:
+    /**
+     * Write \p prog to the save file at \p saveFilePath.
+     * \param binaryFilePath path to the binary file \p prog was loaded from.
+     * \returns true on success.
+     */
+    bool writeSaveFile(Prog *prog, const QString &binaryFilePath, const QString &saveFilePath);
+
+    /**
+     * Serialize the signature, status and body of \p proc independently of the rest of the program.
+     * Other functions are referenced by name and entry address instead of by index,
+     * so the data can be read into a different Prog by SaveFileReader::readProcedure.
+     */
+    QByteArray writeProcedure(UserProc *proc);
+
+    /// Serialize the signature of \p function.
+    QByteArray writeFunctionSignature(const Function *function);
+
+    /// Serialize \p sig. Can be read by SaveFileReader::readSignature.
+    QByteArray writeSignature(const Signature *sig);
+
+    /// Serialize \p ty. Can be read by SaveFileReader::readType.
+    QByteArray writeType(const std::shared_ptr<const Type> &ty);
+
+private:
+    void writeProg(QDataStream &os, Prog *prog);
+    QByteArray writeProcBody(UserProc *proc);
+
+    void writeSignature(QDataStream &os, const Signature *sig);
+    void writeType(QDataStream &os, const std::shared_ptr<const Type> &ty);
+    void writeExp(QDataStream &os, const std::shared_ptr<const Exp> &exp);
+    void writeStatement(QDataStream &os, Statement *stmt);
+    void writeStatementList(QDataStream &os, const StatementList &stmts);
+
+    qint32 getFunctionIndex(const Function *function);
+    qint32 getBBIndex(const BasicBlock *bb) const;
+
+    /// \returns the ID of \p stmt in the procedure body being written.
+    qint32 getStatementID(const Statement *stmt);
+
+private:
+    std::unordered_map<const Function *, qint32> m_functionIndices;
+
+    /// When writing a single procedure, functions are indexed on first use.
+    bool m_indexFunctionsOnUse = false;
+    std::vector<const Function *> m_usedFunctions;
+
+    // Only valid while writing a procedure body
+    bool m_inProcBody = false;
+    std::unordered_map<const BasicBlock *, qint32> m_bbIndices;
+    std::unordered_map<const Statement *, qint32> m_statementIDs;
+};
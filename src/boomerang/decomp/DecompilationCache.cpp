@@ -0,0 +1,295 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "DecompilationCache.h"
+
+#include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/decomp/ProcScheduler.h"
+#include "boomerang/ifc/IDecoder.h"
+#include "boomerang/ifc/IFrontEnd.h"
+#include "boomerang/ssl/RTLInstDict.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+
+#include <algorithm>
+
+
+/// Increment when the contents of cache files change.
+static const quint32 CACHE_VERSION = 1;
+
+
+DecompilationCache::DecompilationCache(Prog *prog, const QString &cacheDir)
+    : m_prog(prog)
+    , m_cacheDir(cacheDir)
+{
+    if (!m_cacheDir.mkpath(".")) {
+        LOG_WARN("Cannot create decompilation cache directory '%1'", cacheDir);
+    }
+}
+
+
+DecompilationCache::~DecompilationCache()
+{
+}
+
+
+void DecompilationCache::restoreProcs()
+{
+    m_keys.clear();
+    m_restoredProcs.clear();
+    m_initialCallees.clear();
+    m_numHits   = 0;
+    m_numMisses = 0;
+
+    findSCCs();
+
+    const QByteArray envHash = computeEnvironmentHash();
+
+    // SCCs are ordered callees first, so the keys of all callees are known
+    // when the key of an SCC is computed.
+    std::vector<QByteArray> sccKeys(m_sccs.size());
+    std::vector<bool> sccRestored(m_sccs.size(), false);
+
+    for (std::size_t i = 0; i < m_sccs.size(); ++i) {
+        const std::vector<UserProc *> &scc = m_sccs[i];
+
+        bool hasKey = true;
+        std::set<std::size_t> calleeSCCs;
+        std::vector<QByteArray> contentHashes;
+        bool isRecursive = scc.size() > 1;
+
+        for (UserProc *proc : scc) {
+            if (proc->getStatus() != ProcStatus::Decoded) {
+                hasKey = false;
+                continue;
+            }
+
+            std::set<const Function *> &callees = m_initialCallees[proc];
+            for (Function *callee : proc->getCallees()) {
+                callees.insert(callee);
+                isRecursive |= (callee == proc);
+
+                if (callee->isLib()) {
+                    continue;
+                }
+
+                auto it = m_sccIndices.find(static_cast<UserProc *>(callee));
+                if (it == m_sccIndices.end()) {
+                    hasKey = false; // callee was removed from the program
+                }
+                else if (it->second != i) {
+                    calleeSCCs.insert(it->second);
+                }
+            }
+        }
+
+        for (std::size_t calleeSCC : calleeSCCs) {
+            hasKey &= !sccKeys[calleeSCC].isEmpty();
+        }
+
+        if (!hasKey) {
+            for (UserProc *proc : scc) {
+                if (proc->getStatus() == ProcStatus::Decoded) {
+                    m_numMisses++;
+                }
+            }
+
+            continue;
+        }
+
+        for (UserProc *proc : scc) {
+            contentHashes.push_back(computeContentHash(proc));
+        }
+
+        QCryptographicHash sccHash(QCryptographicHash::Sha1);
+        sccHash.addData(envHash);
+
+        std::vector<QByteArray> sortedHashes = contentHashes;
+        std::sort(sortedHashes.begin(), sortedHashes.end());
+        for (const QByteArray &hash : sortedHashes) {
+            sccHash.addData(hash);
+        }
+
+        std::vector<QByteArray> calleeKeys;
+        for (std::size_t calleeSCC : calleeSCCs) {
+            calleeKeys.push_back(sccKeys[calleeSCC]);
+        }
+
+        std::sort(calleeKeys.begin(), calleeKeys.end());
+        for (const QByteArray &key : calleeKeys) {
+            sccHash.addData(key);
+        }
+
+        sccKeys[i] = sccHash.result();
+
+        for (std::size_t j = 0; j < scc.size(); ++j) {
+            QCryptographicHash procHash(QCryptographicHash::Sha1);
+            procHash.addData(sccKeys[i]);
+            procHash.addData(contentHashes[j]);
+            m_keys[scc[j]] = procHash.result();
+        }
+
+        // Restored procedures refer to the decompiled versions of their callees,
+        // so they can only be restored if all their callees were restored as well.
+        bool canRestore = std::all_of(calleeSCCs.begin(), calleeSCCs.end(),
+                                      [&sccRestored](std::size_t idx) {
+                                          return sccRestored[idx];
+                                      });
+
+        std::vector<QByteArray> cachedProcs;
+        for (std::size_t j = 0; j < scc.size() && canRestore; ++j) {
+            QFile cacheFile(getCacheFilePath(m_keys[scc[j]]));
+            canRestore = cacheFile.open(QFile::ReadOnly);
+
+            if (canRestore) {
+                cachedProcs.push_back(cacheFile.readAll());
+            }
+        }
+
+        for (std::size_t j = 0; j < scc.size() && canRestore; ++j) {
+            if (m_reader.readProcedure(cachedProcs[j], scc[j])) {
+                continue;
+            }
+
+            LOG_WARN("Cannot restore procedure '%1' from the decompilation cache",
+                     scc[j]->getName());
+            canRestore = false;
+
+            // The procedure is decoded again when it is decompiled.
+            // Do the same for the procedures of the SCC that were already restored.
+            for (std::size_t k = 0; k < j; ++k) {
+                scc[k]->clearBody();
+                scc[k]->setStatus(ProcStatus::Undecoded);
+            }
+        }
+
+        if (!canRestore) {
+            m_numMisses += static_cast<int>(scc.size());
+            continue;
+        }
+
+        if (isRecursive) {
+            std::shared_ptr<ProcSet> group = std::make_shared<ProcSet>(scc.begin(), scc.end());
+            for (UserProc *proc : scc) {
+                proc->setRecursionGroup(group);
+            }
+        }
+
+        sccRestored[i] = true;
+        m_numHits += static_cast<int>(scc.size());
+        m_restoredProcs.insert(scc.begin(), scc.end());
+    }
+}
+
+
+void DecompilationCache::onEndDecompile(UserProc *proc)
+{
+    auto it = m_keys.find(proc);
+    if (it == m_keys.end() || m_restoredProcs.find(proc) != m_restoredProcs.end()) {
+        return;
+    }
+
+    const std::set<const Function *> &initialCallees = m_initialCallees[proc];
+    for (const Function *callee : proc->getCallees()) {
+        if (initialCallees.find(callee) == initialCallees.end()) {
+            LOG_VERBOSE("Not caching procedure '%1': New callee '%2' found during decompilation",
+                        proc->getName(), callee->getName());
+            return;
+        }
+    }
+
+    const QString filePath = getCacheFilePath(it->second);
+    if (QFile::exists(filePath)) {
+        return;
+    }
+
+    QSaveFile cacheFile(filePath);
+    if (!cacheFile.open(QFile::WriteOnly) ||
+        cacheFile.write(m_writer.writeProcedure(proc)) < 0 || !cacheFile.commit()) {
+        LOG_WARN("Cannot write decompilation cache file '%1'", filePath);
+    }
+}
+
+
+QByteArray DecompilationCache::computeEnvironmentHash() const
+{
+    QByteArray data;
+    QDataStream os(&data, QIODevice::WriteOnly);
+
+    os << CACHE_VERSION << QString(m_prog->getProject()->getVersionStr());
+
+    const Settings *settings = m_prog->getProject()->getSettings();
+    os << settings->useDataflow << settings->removeNull << settings->useLocals
+       << settings->removeLabels << settings->usePromotion << settings->propOnlyToAll
+       << settings->nameParameters << settings->decodeThruIndCall << settings->decodeChildren
+       << settings->useProof << settings->changeSignatures << settings->useTypeAnalysis
+       << settings->useGlobals << settings->assumeABI << settings->experimental
+       << settings->removeReturns;
+    os << static_cast<qint32>(settings->numToPropagate)
+       << static_cast<qint32>(settings->propMaxDepth);
+
+    const IFrontEnd *fe       = m_prog->getFrontEnd();
+    const RTLInstDict *dict   = (fe && fe->getDecoder()) ? fe->getDecoder()->getDict() : nullptr;
+    const QString sslFileName = dict ? dict->getSSLFileName() : QString();
+
+    QFile sslFile(sslFileName);
+    if (sslFile.open(QFile::ReadOnly)) {
+        os << sslFile.readAll();
+    }
+    else {
+        os << sslFileName;
+    }
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+
+QByteArray DecompilationCache::computeContentHash(UserProc *proc)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    // The decoded RTLs of the procedure stand in for the bytes of its instructions.
+    hash.addData(m_writer.writeProcedure(proc));
+
+    for (const Function *callee : proc->getCallees()) {
+        if (callee->isLib()) {
+            hash.addData(m_writer.writeFunctionSignature(callee));
+        }
+    }
+
+    return hash.result();
+}
+
+
+void DecompilationCache::findSCCs()
+{
+    m_sccs = ProcScheduler(m_prog, 1).getCallGraphSCCs();
+    m_sccIndices.clear();
+
+    for (std::size_t i = 0; i < m_sccs.size(); ++i) {
+        for (const UserProc *proc : m_sccs[i]) {
+            m_sccIndices[proc] = i;
+        }
+    }
+}
+
+
+QString DecompilationCache::getCacheFilePath(const QByteArray &key) const
+{
+    return m_cacheDir.absoluteFilePath(QString::fromLatin1(key.toHex()) + ".proc");
+}
@@ -0,0 +1,105 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/Watcher.h"
+#include "boomerang/db/serialization/SaveFileReader.h"
+#include "boomerang/db/serialization/SaveFileWriter.h"
+
+#include <QByteArray>
+#include <QDir>
+
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+
+class Prog;
+
+
+/**
+ * Caches the results of decompiling procedures on disk, so that procedures that did not change
+ * since the last decompilation are not decompiled again.
+ *
+ * Procedures are identified by a key that is computed from
+ *  - the decoded procedure and its signature,
+ *  - the signatures of the library procedures it calls,
+ *  - the SSL file and the settings that affect decompilation, and
+ *  - the keys of all procedures it calls.
+ * Mutually recursive procedures (i.e. strongly connected components of the call graph)
+ * share the keys of their callees and are only restored together.
+ *
+ * Procedures are stored when ProcDecompiler has finished them (i.e. while still in SSA form);
+ * all program-wide analyses are run again on restored procedures.
+ */
+class BOOMERANG_API DecompilationCache : public IWatcher
+{
+public:
+    /// \param cacheDir directory of the cache files; created if it does not exist.
+    DecompilationCache(Prog *prog, const QString &cacheDir);
+    DecompilationCache(const DecompilationCache &other) = delete;
+    DecompilationCache(DecompilationCache &&other)      = delete;
+
+    ~DecompilationCache() override;
+
+    DecompilationCache &operator=(const DecompilationCache &other) = delete;
+    DecompilationCache &operator=(DecompilationCache &&other) = delete;
+
+public:
+    /**
+     * Compute the keys of all decoded procedures and replace each procedure
+     * by its decompiled version from the cache, if available.
+     * Must be called before any procedure is decompiled.
+     */
+    void restoreProcs();
+
+    /// \returns the number of procedures that were restored from the cache.
+    int getNumHits() const { return m_numHits; }
+
+    /// \returns the number of decoded procedures that were not restored from the cache.
+    int getNumMisses() const { return m_numMisses; }
+
+    /// Store \p proc in the cache, unless it was restored from the cache.
+    void onEndDecompile(UserProc *proc) override;
+
+private:
+    /// Hash of everything besides the procedures that affects decompilation.
+    QByteArray computeEnvironmentHash() const;
+
+    /// Hash of \p proc and the library procedures it calls.
+    QByteArray computeContentHash(UserProc *proc);
+
+    /// Find the strongly connected components of the call graph of all procedures,
+    /// callees before callers.
+    void findSCCs();
+
+    QString getCacheFilePath(const QByteArray &key) const;
+
+private:
+    Prog *m_prog;
+    QDir m_cacheDir;
+    SaveFileReader m_reader;
+    SaveFileWriter m_writer;
+
+    std::vector<std::vector<UserProc *>> m_sccs;
+    std::unordered_map<const UserProc *, std::size_t> m_sccIndices;
+
+    std::unordered_map<const UserProc *, QByteArray> m_keys;
+    std::set<const UserProc *> m_restoredProcs;
+
+    /// Procedures that are called by each decoded procedure before decompilation.
+    /// Procedures that call other procedures after decompilation are not stored,
+    /// since their keys do not cover the new callees.
+    std::unordered_map<const UserProc *, std::set<const Function *>> m_initialCallees;
+
+    int m_numHits   = 0;
+    int m_numMisses = 0;
+};
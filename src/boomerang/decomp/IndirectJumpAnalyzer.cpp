@@ -16,6 +16,7 @@
 #include "boomerang/ssl/RTL.h"
 #include "boomerang/ssl/exp/Binary.h"
 #include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/ExpPatternMatcher.h"
 #include "boomerang/ssl/exp/Location.h"
 #include "boomerang/ssl/statements/BranchStatement.h"
 #include "boomerang/ssl/statements/CallStatement.h"
@@ -26,6 +27,8 @@
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ConstGlobalConverter.h"
 
+#include <iterator>
+
 
 // clang-format off
 // Switch High Level patterns
@@ -91,22 +94,17 @@ static const SharedConstExp form_r =
 
 // clang-format on
 
-struct SwitchForm
-{
-    SharedConstExp pattern;
-    SwitchType type;
-};
+static const SharedConstExp hlFormPatterns[] = { form_a, form_A, form_o,
+                                                 form_O, form_R, form_r };
 
-// clang-format off
-static const SwitchForm hlForms[] = {
-    { form_a, SwitchType::a },
-    { form_A, SwitchType::A },
-    { form_o, SwitchType::o },
-    { form_O, SwitchType::O },
-    { form_R, SwitchType::R },
-    { form_r, SwitchType::r }
-};
-// clang-format on
+/// Switch types of the patterns of hlFormPatterns
+static const SwitchType hlFormTypes[] = { SwitchType::a, SwitchType::A, SwitchType::o,
+                                          SwitchType::O, SwitchType::R, SwitchType::r };
+
+static_assert(std::size(hlFormPatterns) == std::size(hlFormTypes),
+              "Each switch pattern must have a switch type");
+
+static const ExpPatternMatcher hlForms(hlFormPatterns);
 
 
 /// Find all the possible constant values that the location defined by s could be assigned with
@@ -132,17 +130,18 @@ static void findConstantValues(const Statement *s, std::list<int> &dests)
 }
 
 
-void findSwParams(SwitchType form, SharedExp e, SharedExp &expr, Address &T)
+/**
+ * Find the switch expression \p expr and the address of the switch table \p T
+ * of a switch of type \p form.
+ * \param bindings wildcard bindings of the pattern of \p form
+ */
+static void findSwParams(SwitchType form, const ExpPatternMatcher::Bindings &bindings,
+                         SharedExp &expr, Address &T)
 {
     switch (form) {
     case SwitchType::a: {
         // Pattern: <base>{}[<index>]{}
-        if (e->isSubscript()) {
-            e = e->getSubExp1();
-        }
-
-        assert(e->getOper() == opArrayIndex);
-        SharedExp base = e->getSubExp1();
+        SharedExp base = bindings[0];
 
         if (base->isSubscript()) {
             base = base->getSubExp1();
@@ -155,69 +154,33 @@ void findSwParams(SwitchType form, SharedExp e, SharedExp &expr, Address &T)
         UserProc *p     = base->access<Location>()->getProc();
         Prog *prog      = p->getProg();
         T               = prog->getGlobalAddrByName(gloName);
-        expr            = e->getSubExp2();
+        expr            = bindings[1];
         break;
     }
 
-    case SwitchType::A: {
+    case SwitchType::A:
         // Pattern: m[<expr> * 4 + T ]
-        if (e->isSubscript()) {
-            e = e->getSubExp1();
-        }
-
-        // b will be (<expr> * 4) + T
-        SharedExp b = e->getSubExp1();
-        T           = b->access<Const, 2>()->getAddr();
-        expr        = b->access<Exp, 1, 1>();
+        expr = bindings[0];
+        T    = bindings[1]->access<Const>()->getAddr();
         break;
-    }
 
-    case SwitchType::O: { // Form O
+    case SwitchType::O:
         // Pattern: m[<expr> * 4 + T ] + T
-        T = e->access<Const, 2>()->getAddr();
-        // l = m[<expr> * 4 + T ]:
-        SharedExp l = e->getSubExp1();
-
-        if (l->isSubscript()) {
-            l = l->getSubExp1();
-        }
-
-        // <expr> * 4 + T:
-        expr = l->access<Exp, 1, 1, 1>();
+        expr = bindings[0];
+        T    = bindings[2]->access<Const>()->getAddr();
         break;
-    }
 
-    case SwitchType::R: {
+    case SwitchType::R:
         // Pattern: %pc + m[%pc     + (<expr> * 4) + k]
-        T = Address::ZERO; // ?
-        // l = m[%pc  + (<expr> * 4) + k]:
-        SharedExp l = e->getSubExp2();
-
-        if (l->isSubscript()) {
-            l = l->getSubExp1();
-        }
-
-        // (%pc + (<expr> * 4)) + k:
-        expr = l->access<Exp, 1, 2, 1, 1>();
+        T    = Address::ZERO; // ?
+        expr = bindings[0];
         break;
-    }
-
-    case SwitchType::r: {
-        // Pattern: %pc + m[%pc + ((<expr> * 4) - k)] - k
-        T = Address::ZERO; // ?
-        // b = %pc + m[%pc + ((<expr> * 4) - k)]:
-        SharedExp b = e->getSubExp1();
-        // l = m[%pc + ((<expr> * 4) - k)]:
-        SharedExp l = b->getSubExp2();
-
-        if (l->isSubscript()) {
-            l = l->getSubExp1();
-        }
 
-        // %pc + ((<expr> * 4) - k)
-        expr = l->access<Exp, 1, 2, 1, 1>();
+    case SwitchType::r:
+        // Pattern: %pc + m[%pc + ((<expr> * 4) - k)]
+        T    = Address::ZERO; // ?
+        expr = bindings[0];
         break;
-    }
 
     default: expr = nullptr; T = Address::INVALID;
     }
@@ -465,16 +428,14 @@ bool IndirectJumpAnalyzer::analyzeCompJump(BasicBlock *bb, UserProc *proc)
     }
 
     SwitchType switchType = SwitchType::Invalid;
+    ExpPatternMatcher::Bindings bindings;
+    const int formIdx = hlForms.match(jumpDest, &bindings);
 
-    for (auto &val : hlForms) {
-        if (jumpDest->equalNoSubscript(*val.pattern)) {
-            switchType = val.type;
-
-            if (proc->getProg()->getProject()->getSettings()->debugSwitch) {
-                LOG_MSG("Indirect jump matches form %1", static_cast<char>(switchType));
-            }
+    if (formIdx != -1) {
+        switchType = hlFormTypes[formIdx];
 
-            break;
+        if (proc->getProg()->getProject()->getSettings()->debugSwitch) {
+            LOG_MSG("Indirect jump matches form %1", static_cast<char>(switchType));
         }
     }
 
@@ -483,7 +444,7 @@ bool IndirectJumpAnalyzer::analyzeCompJump(BasicBlock *bb, UserProc *proc)
         swi->switchType = switchType;
         Address T       = Address::INVALID;
         SharedExp expr;
-        findSwParams(switchType, jumpDest, expr, T);
+        findSwParams(switchType, bindings, expr, T);
 
         if (expr) {
             swi->tableAddr       = T;
@@ -589,62 +550,64 @@ enum class IndCallPattern
     Bare
 };
 
-static const std::vector<std::pair<const SharedConstExp, IndCallPattern>> hlCallPatterns = {
-    {
-        // Pattern 0: global<wild>[0]
-        Binary::get(opArrayIndex,
-                    Location::get(opGlobal,
-                                  Terminal::get(opWildStrConst), nullptr),
-                    Const::get(0)),
-        IndCallPattern::Funcptr
-    },
-    {
-        // Pattern 1: m[ m[ <expr> + K1 ] + K2 ]
-        // K1 is vtable offset, K2 is virtual function offset (could come from m[A2],
-        // if A2 is in read-only memory
-        Location::memOf(Binary::get(opPlus,
-                                    Location::memOf(Binary::get(opPlus,
-                                                                Terminal::get(opWild),
-                                                                Terminal::get(opWildIntConst))),
-                                    Terminal::get(opWildIntConst))),
-        IndCallPattern::Both
-    },
-    {
-        // Pattern 2: m[ m[ <expr> ] + K2]
-        Location::memOf(Binary::get(opPlus,
-                                    Location::memOf(Terminal::get(opWild)),
-                                    Terminal::get(opWildIntConst))),
-        IndCallPattern::VTO
-    },
-    {
-        // Pattern 3: m[ m[ <expr> + K1] ]
-        Location::memOf(Location::memOf(Binary::get(opPlus,
-                                                    Terminal::get(opWild),
-                                                    Terminal::get(opWildIntConst)))),
-        IndCallPattern::VFO
-    },
-    {
-        // Pattern 4: m[ m[ <expr> ] ]
-        Location::memOf(Location::memOf(Terminal::get(opWild))),
-        IndCallPattern::None
-    },
-    {
-        Location::memOf(Binary::get(opPlus,
-                                    Binary::get(opMult,
+static const SharedConstExp hlCallPatternExps[] = {
+    // Pattern 0: global<wild>[0]
+    Binary::get(opArrayIndex,
+                Location::get(opGlobal,
+                              Terminal::get(opWildStrConst), nullptr),
+                Const::get(0)),
+
+    // Pattern 1: m[ m[ <expr> + K1 ] + K2 ]
+    // K1 is vtable offset, K2 is virtual function offset (could come from m[A2],
+    // if A2 is in read-only memory
+    Location::memOf(Binary::get(opPlus,
+                                Location::memOf(Binary::get(opPlus,
+                                                            Terminal::get(opWild),
+                                                            Terminal::get(opWildIntConst))),
+                                Terminal::get(opWildIntConst))),
+
+    // Pattern 2: m[ m[ <expr> ] + K2]
+    Location::memOf(Binary::get(opPlus,
+                                Location::memOf(Terminal::get(opWild)),
+                                Terminal::get(opWildIntConst))),
+
+    // Pattern 3: m[ m[ <expr> + K1] ]
+    Location::memOf(Location::memOf(Binary::get(opPlus,
                                                 Terminal::get(opWild),
-                                                Const::get(4)),
-                                    Terminal::get(opWildIntConst))),
-        IndCallPattern::BareArray
-    },
-    {
-        // Pattern 6: m[ <expr> ]
-        // note that this must be checked for *after* all m[ m[ <expr> ] ] patterns because
-        // m[m[<expr>]] is a subset of m[<expr>]
-        Location::memOf(Terminal::get(opWild)),
-        IndCallPattern::Bare
-    }
+                                                Terminal::get(opWildIntConst)))),
+
+    // Pattern 4: m[ m[ <expr> ] ]
+    Location::memOf(Location::memOf(Terminal::get(opWild))),
+
+    // Pattern 5: m[ <expr> * 4 + T ]
+    Location::memOf(Binary::get(opPlus,
+                                Binary::get(opMult,
+                                            Terminal::get(opWild),
+                                            Const::get(4)),
+                                Terminal::get(opWildIntConst))),
+
+    // Pattern 6: m[ <expr> ]
+    // note that this must be checked for *after* all m[ m[ <expr> ] ] patterns because
+    // m[m[<expr>]] is a subset of m[<expr>]
+    Location::memOf(Terminal::get(opWild))
+};
+
+/// Pattern IDs of the patterns of hlCallPatternExps
+static const IndCallPattern hlCallPatternIDs[] = {
+    IndCallPattern::Funcptr,
+    IndCallPattern::Both,
+    IndCallPattern::VTO,
+    IndCallPattern::VFO,
+    IndCallPattern::None,
+    IndCallPattern::BareArray,
+    IndCallPattern::Bare
 };
 
+static_assert(std::size(hlCallPatternExps) == std::size(hlCallPatternIDs),
+              "Each indirect call pattern must have a pattern ID");
+
+static const ExpPatternMatcher hlCallPatterns(hlCallPatternExps);
+
 // clang-format on
 
 
@@ -686,15 +649,13 @@ bool IndirectJumpAnalyzer::analyzeCompCall(BasicBlock *bb, UserProc *proc)
     }
 
     IndCallPattern foundPatternID = IndCallPattern::Invalid;
+    const int patternIdx          = hlCallPatterns.match(e);
 
-    for (auto &[pattern, patternID] : hlCallPatterns) {
-        if (e->equalNoSubscript(*pattern)) {
-            foundPatternID = patternID;
-            if (prog->getProject()->getSettings()->debugSwitch) {
-                LOG_MSG("Indirect call matches pattern '%1'", pattern);
-            }
+    if (patternIdx != -1) {
+        foundPatternID = hlCallPatternIDs[patternIdx];
 
-            break;
+        if (prog->getProject()->getSettings()->debugSwitch) {
+            LOG_MSG("Indirect call matches pattern '%1'", hlCallPatterns.getPattern(patternIdx));
         }
     }
 
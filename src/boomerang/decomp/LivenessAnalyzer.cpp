@@ -20,32 +20,25 @@
 #include "boomerang/util/ConnectionGraph.h"
 #include "boomerang/util/log/Log.h"
 
+#include <algorithm>
 #include <deque>
+#include <utility>
 
 
-/**
- * Check for overlap of liveness between the currently live locations (liveLocs) and the set of
- * locations in \p ls.
- * Also check for type conflicts when using DFA type analysis
- * This is a helper function that is not directly declared in the BasicBlock class
- */
-void checkForOverlap(LocationSet &liveLocs, LocationSet &ls, ConnectionGraph &ig, UserProc *proc)
+void LivenessAnalyzer::checkForOverlap(BitSet &liveLocs, const std::vector<int> &locs,
+                                       ConnectionGraph &ig, UserProc *proc)
 {
     // For each location to be considered
-    for (SharedExp exp : ls) {
-        if (!exp->isSubscript()) {
-            continue; // Only interested in subscripted vars
-        }
-
-        assert(std::dynamic_pointer_cast<RefExp>(exp) != nullptr);
-        auto refexp = exp->access<RefExp>();
+    for (int loc : locs) {
+        const SharedExp &refexp = m_locs[loc];
 
         // Interference if we can find a live variable which differs only in the reference
-        SharedExp dr;
+        const int different = findDifferentRef(liveLocs, loc);
 
-        if (liveLocs.findDifferentRef(refexp, dr)) {
+        if (different != -1) {
+            const SharedExp &dr = m_locs[different];
             assert(dr->access<RefExp>()->getDef() != nullptr);
-            assert(exp->access<RefExp>()->getDef() != nullptr);
+            assert(refexp->access<RefExp>()->getDef() != nullptr);
             // We have an interference between r and dr. Record it
             ig.connect(refexp, dr);
 
@@ -56,7 +49,7 @@ void checkForOverlap(LocationSet &liveLocs, LocationSet &ls, ConnectionGraph &ig
 
         // Add the uses one at a time. Note: don't use makeUnion, because then we don't discover
         // interferences from the same statement, e.g.  blah := r24{2} + r24{3}
-        liveLocs.insert(exp);
+        liveLocs.set(loc);
     }
 }
 
@@ -64,12 +57,13 @@ void checkForOverlap(LocationSet &liveLocs, LocationSet &ls, ConnectionGraph &ig
 bool LivenessAnalyzer::calcLiveness(BasicBlock *bb, ConnectionGraph &ig, UserProc *myProc)
 {
     // Start with the liveness at the bottom of the BB
-    LocationSet liveLocs, phiLocs;
+    BitSet liveLocs;
+    const std::vector<int> *phiLocs = nullptr;
     getLiveOut(bb, liveLocs, phiLocs);
 
     // Do the livenesses that result from phi statements at successors first.
     // FIXME: document why this is necessary
-    checkForOverlap(liveLocs, phiLocs, ig, myProc);
+    checkForOverlap(liveLocs, *phiLocs, ig, myProc);
 
     const bool assumeABICompliance = myProc->getProg()->getProject()->getSettings()->assumeABI;
 
@@ -77,15 +71,13 @@ bool LivenessAnalyzer::calcLiveness(BasicBlock *bb, ConnectionGraph &ig, UserPro
         // For all statements in this BB in reverse order
         for (auto rit = bb->getRTLs()->rbegin(); rit != bb->getRTLs()->rend(); ++rit) {
             for (auto sit = (*rit)->rbegin(); sit != (*rit)->rend(); ++sit) {
-                Statement *s = *sit;
-                LocationSet defs;
-                s->getDefinitions(defs, assumeABICompliance);
-
-                // The definitions don't have refs yet
-                defs.addSubscript(s);
+                Statement *s         = *sit;
+                const StmtLocs &locs = getStmtLocs(s, assumeABICompliance);
 
                 // Definitions kill uses. Now we are moving to the "top" of statement s
-                liveLocs.makeDiff(defs);
+                for (int def : locs.defs) {
+                    liveLocs.reset(def);
+                }
 
                 // Phi functions are a special case. The operands of phi functions are uses, but
                 // they don't interfere with each other (since they come via different BBs).
@@ -98,20 +90,21 @@ bool LivenessAnalyzer::calcLiveness(BasicBlock *bb, ConnectionGraph &ig, UserPro
                 }
 
                 // Check for livenesses that overlap
-                LocationSet uses;
-                s->addUsedLocs(uses);
-                checkForOverlap(liveLocs, uses, ig, myProc);
+                checkForOverlap(liveLocs, locs.uses, ig, myProc);
 
                 if (myProc->getProg()->getProject()->getSettings()->debugLiveness) {
-                    LOG_MSG(" ## liveness: at top of %1, liveLocs is %2", s, liveLocs.toString());
+                    LOG_MSG(" ## liveness: at top of %1, liveLocs is %2", s,
+                            toLocationSet(liveLocs).toString());
                 }
             }
         }
     }
 
     // liveIn is what we calculated last time
-    if (!(liveLocs == m_liveIn[bb])) {
-        m_liveIn[bb] = liveLocs;
+    BitSet &liveIn = m_liveIn[bb];
+
+    if (liveLocs != liveIn) {
+        liveIn = std::move(liveLocs);
         return true; // A change
     }
 
@@ -120,16 +113,38 @@ bool LivenessAnalyzer::calcLiveness(BasicBlock *bb, ConnectionGraph &ig, UserPro
 }
 
 
-void LivenessAnalyzer::getLiveOut(BasicBlock *bb, LocationSet &liveout, LocationSet &phiLocs)
+void LivenessAnalyzer::getLiveOut(BasicBlock *bb, BitSet &liveout,
+                                  const std::vector<int> *&phiLocs)
 {
-    ProcCFG *cfg = static_cast<UserProc *>(bb->getFunction())->getCFG();
-
-    liveout.clear();
+    liveout.reset();
 
     for (BasicBlock *currBB : bb->getSuccessors()) {
         // First add the non-phi liveness
-        liveout.makeUnion(m_liveIn[currBB]); // add successor liveIn to this liveout set.
+        liveout |= m_liveIn[currBB]; // add successor liveIn to this liveout set.
+    }
+
+    // The phi operands do not change while the liveness is calculated,
+    // so they only have to be found once
+    auto it = m_phiLocs.find(bb);
+
+    if (it == m_phiLocs.end()) {
+        it = m_phiLocs.insert({ bb, findPhiLocs(bb) }).first;
+    }
+
+    phiLocs = &it->second;
+
+    for (int loc : *phiLocs) {
+        liveout.set(loc);
+    }
+}
+
 
+std::vector<int> LivenessAnalyzer::findPhiLocs(BasicBlock *bb)
+{
+    ProcCFG *cfg = static_cast<UserProc *>(bb->getFunction())->getCFG();
+    LocationSet phiLocs;
+
+    for (BasicBlock *currBB : bb->getSuccessors()) {
         // The first RTL will have the phi functions, if any
         if (!currBB->getRTLs() || currBB->getRTLs()->empty()) {
             continue;
@@ -198,7 +213,6 @@ void LivenessAnalyzer::getLiveOut(BasicBlock *bb, LocationSet &liveout, Location
 
             SharedExp ref = RefExp::get(pa->getLeft()->clone(), def);
             assert(def);
-            liveout.insert(ref);
             phiLocs.insert(ref);
 
             if (bb->getFunction()->getProg()->getProject()->getSettings()->debugLiveness) {
@@ -207,4 +221,107 @@ void LivenessAnalyzer::getLiveOut(BasicBlock *bb, LocationSet &liveout, Location
             }
         }
     }
+
+    std::vector<int> locs;
+    for (const SharedExp &ref : phiLocs) {
+        locs.push_back(getNumber(ref));
+    }
+
+    return locs;
+}
+
+
+int LivenessAnalyzer::findDifferentRef(const BitSet &liveLocs, int loc) const
+{
+    for (int version : m_versions[m_versionsOf[loc]]) {
+        if (version != loc && liveLocs.test(version)) {
+            return version;
+        }
+    }
+
+    return -1;
+}
+
+
+const LivenessAnalyzer::StmtLocs &LivenessAnalyzer::getStmtLocs(Statement *stmt,
+                                                                 bool assumeABICompliance)
+{
+    // Statements are not changed while the liveness is calculated,
+    // so their locations only have to be found once
+    auto it = m_stmtLocs.find(stmt);
+    if (it != m_stmtLocs.end()) {
+        return it->second;
+    }
+
+    StmtLocs &locs = m_stmtLocs[stmt];
+
+    LocationSet defs;
+    stmt->getDefinitions(defs, assumeABICompliance);
+
+    // The definitions don't have refs yet
+    defs.addSubscript(stmt);
+
+    for (const SharedExp &def : defs) {
+        if (def->isSubscript()) {
+            locs.defs.push_back(getNumber(def));
+        }
+    }
+
+    if (!stmt->isPhi()) {
+        LocationSet uses;
+        stmt->addUsedLocs(uses);
+
+        for (const SharedExp &use : uses) {
+            if (use->isSubscript()) { // Only interested in subscripted vars
+                assert(std::dynamic_pointer_cast<RefExp>(use) != nullptr);
+                locs.uses.push_back(getNumber(use));
+            }
+        }
+    }
+
+    return locs;
+}
+
+
+int LivenessAnalyzer::getNumber(const SharedExp &ref)
+{
+    auto it = m_numbers.find(ref);
+    if (it != m_numbers.end()) {
+        return it->second;
+    }
+
+    const int number = static_cast<int>(m_locs.size());
+    m_numbers.insert({ ref, number });
+    m_locs.push_back(ref);
+
+    // Keep the versions of each base expression in the order of LocationSet,
+    // so findDifferentRef finds the same location as LocationSet::findDifferentRef
+    const SharedConstExp base = ref->getSubExp1();
+    auto baseIt               = m_baseIndices.find(base);
+
+    if (baseIt == m_baseIndices.end()) {
+        baseIt = m_baseIndices.insert({ base, static_cast<int>(m_versions.size()) }).first;
+        m_versions.emplace_back();
+    }
+
+    m_versionsOf.push_back(baseIt->second);
+
+    auto isLess = [this](int a, int b) { return lessExpStar()(m_locs[a], m_locs[b]); };
+
+    std::vector<int> &versions = m_versions[baseIt->second];
+    versions.insert(std::lower_bound(versions.begin(), versions.end(), number, isLess), number);
+
+    return number;
+}
+
+
+LocationSet LivenessAnalyzer::toLocationSet(const BitSet &locs) const
+{
+    LocationSet result;
+
+    for (std::size_t i = locs.findFirst(); i != BitSet::npos; i = locs.findNext(i + 1)) {
+        result.insert(m_locs[i]);
+    }
+
+    return result;
 }
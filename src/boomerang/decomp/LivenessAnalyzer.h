@@ -10,30 +10,84 @@
 #pragma once
 
 
+#include "boomerang/ssl/exp/ExpHelp.h"
+#include "boomerang/util/BitSet.h"
 #include "boomerang/util/LocationSet.h"
 
 #include <unordered_map>
+#include <vector>
 
 
 class BasicBlock;
 class ConnectionGraph;
+class Statement;
 class UserProc;
 
 
+/**
+ * Calculates the locations that are live at the start of each BB
+ * and records the interferences of different versions of the same location.
+ *
+ * Subscripted locations are numbered densely as they are encountered,
+ * so sets of live locations are bit vectors over these numbers.
+ */
 class LivenessAnalyzer
 {
+    /// The numbers of the locations defined and used by a statement
+    struct StmtLocs
+    {
+        std::vector<int> defs;
+        std::vector<int> uses; ///< in the order of LocationSet
+    };
+
 public:
     LivenessAnalyzer() = default;
 
     // Liveness
     bool calcLiveness(BasicBlock *bb, ConnectionGraph &ig, UserProc *proc);
 
+private:
     /// Locations that are live at the end of this BB are the union of the locations that are live
     /// at the start of its successors. \p live gets all the livenesses,
-    /// and phiLocs gets a subset of these, which are due to phi statements at the top of successors
-    void getLiveOut(BasicBlock *bb, LocationSet &live, LocationSet &phiLocs);
+    /// and \p phiLocs gets a subset of these, which are due to phi statements at the top of
+    /// successors (in the order of LocationSet)
+    void getLiveOut(BasicBlock *bb, BitSet &live, const std::vector<int> *&phiLocs);
+
+    /// \returns the phi operands of the successors of \p bb which have a use from \p bb
+    std::vector<int> findPhiLocs(BasicBlock *bb);
+
+    /**
+     * Check for overlap of liveness between the currently live locations (\p liveLocs) and
+     * the set of locations in \p locs, and add \p locs to the live locations.
+     */
+    void checkForOverlap(BitSet &liveLocs, const std::vector<int> &locs, ConnectionGraph &ig,
+                         UserProc *proc);
+
+    /// \returns the number of a location in \p liveLocs that differs from location \p loc
+    /// only in the reference, or -1 if there is none. Like LocationSet::findDifferentRef,
+    /// if there is more than one, the first one in the order of LocationSet is returned.
+    int findDifferentRef(const BitSet &liveLocs, int loc) const;
+
+    const StmtLocs &getStmtLocs(Statement *stmt, bool assumeABICompliance);
+
+    /// \returns the number of subscripted location \p ref, numbering it if necessary.
+    int getNumber(const SharedExp &ref);
+
+    /// Convert a set of location numbers to a set of locations, e.g. for debug output
+    LocationSet toLocationSet(const BitSet &locs) const;
 
 private:
+    std::unordered_map<SharedConstExp, int, hashExpStar, equalExpStar> m_numbers;
+    std::vector<SharedExp> m_locs;   ///< Subscripted locations by number
+    std::vector<int> m_versionsOf;   ///< Index into m_versions by location number
+
+    /// All numbered locations with the same base expression, in the order of LocationSet
+    std::vector<std::vector<int>> m_versions;
+    std::unordered_map<SharedConstExp, int, hashExpStar, equalExpStar> m_baseIndices;
+
+    std::unordered_map<Statement *, StmtLocs> m_stmtLocs;
+    std::unordered_map<BasicBlock *, std::vector<int>> m_phiLocs;
+
     ///< Set of locations live at BB start
-    std::unordered_map<BasicBlock *, LocationSet> m_liveIn;
+    std::unordered_map<BasicBlock *, BitSet> m_liveIn;
 };
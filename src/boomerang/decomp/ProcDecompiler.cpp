@@ -12,6 +12,7 @@
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/DefUseIndex.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/decomp/IndirectJumpAnalyzer.h"
 #include "boomerang/ifc/IFrontEnd.h"
@@ -356,6 +357,11 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
             // Everything including new arguments reaching the exit
             proc->getRetStmt()->updateModifieds();
             proc->getRetStmt()->updateReturns();
+
+            if (proc->isDefUseIndexValid()) {
+                // the return statement uses different definitions now
+                proc->getDefUseIndex().updateStatement(proc->getRetStmt());
+            }
         }
 
         // Print if requested
@@ -411,7 +417,8 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
 
         // this is just to make it readable, do NOT rely on these statements being removed
         PassManager::get()->executePass(PassID::AssignRemoval, proc);
-    } while (change && ++pass < 12);
+        pass++;
+    } while (change);
 
     // At this point, there will be some memofs that have still not been renamed. They have been
     // prevented from getting renamed so that they didn't get renamed incorrectly (usually as {-}),
@@ -491,6 +498,7 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
 
     tryConvertCallsToDirect(proc);
     tryConvertFunctionPointerAssignments(proc);
+    proc->invalidateDefUseIndex(); // calls and assignments were changed in place
 
     proc->setStatus(ProcStatus::MiddleDone);
 
@@ -535,6 +543,7 @@ bool ProcDecompiler::decompileProcInRecursionGroup(UserProc *proc, ProcSet &visi
     // Mark all the relevant calls as non childless (will harmlessly get done again later)
     // FIXME: why exactly do we do this?
     proc->markAsNonChildless(proc->getRecursionGroup());
+    proc->invalidateDefUseIndex(); // calls were changed in place
 
     // Need to propagate into the initial arguments, since arguments are uses,
     // and we are about to remove unused statements.
@@ -675,6 +684,7 @@ ProcStatus ProcDecompiler::reDecompileRecursive(UserProc *proc)
     // Now, decode from scratch
     proc->removeRetStmt();
     proc->getCFG()->clear();
+    proc->resetArena();
 
     if (!proc->getProg()->reDecode(proc)) {
         return ProcStatus::Undecoded;
@@ -0,0 +1,351 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProcScheduler.h"
+
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/UserProc.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+
+ProcScheduler::ProcScheduler(const Prog *prog, int numThreads)
+    : m_prog(prog)
+    , m_numThreads(numThreads)
+{
+    if (m_numThreads < 1) {
+        m_numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+}
+
+
+void ProcScheduler::runBottomUp(const Task &task)
+{
+    const std::vector<ProcGroup> groups = getCallGraphSCCs();
+
+    std::unordered_map<const UserProc *, std::size_t> groupOf;
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        for (UserProc *proc : groups[i]) {
+            groupOf[proc] = i;
+        }
+    }
+
+    std::vector<std::vector<std::size_t>> calleeGroups(groups.size());
+
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        for (UserProc *proc : groups[i]) {
+            for (Function *callee : proc->getCallees()) {
+                if (callee->isLib()) {
+                    continue;
+                }
+
+                auto it = groupOf.find(static_cast<UserProc *>(callee));
+                if (it == groupOf.end() || it->second == i) {
+                    continue;
+                }
+
+                std::vector<std::size_t> &deps = calleeGroups[i];
+                if (std::find(deps.begin(), deps.end(), it->second) == deps.end()) {
+                    deps.push_back(it->second);
+                }
+            }
+        }
+    }
+
+    runGroups(groups, calleeGroups, task);
+}
+
+
+void ProcScheduler::runUnordered(const Task &task)
+{
+    std::vector<ProcGroup> groups;
+
+    for (UserProc *proc : getUserProcs()) {
+        groups.push_back({ proc });
+    }
+
+    runGroups(groups, std::vector<std::vector<std::size_t>>(groups.size()), task);
+}
+
+
+std::vector<ProcScheduler::ProcGroup> ProcScheduler::getCallGraphSCCs() const
+{
+    const std::vector<UserProc *> procs = getUserProcs();
+    const std::size_t numProcs          = procs.size();
+
+    std::unordered_map<const UserProc *, std::size_t> procIndex;
+    for (std::size_t i = 0; i < numProcs; ++i) {
+        procIndex[procs[i]] = i;
+    }
+
+    std::vector<std::vector<std::size_t>> callees(numProcs);
+    for (std::size_t i = 0; i < numProcs; ++i) {
+        for (Function *callee : procs[i]->getCallees()) {
+            if (callee->isLib()) {
+                continue;
+            }
+
+            auto it = procIndex.find(static_cast<UserProc *>(callee));
+            if (it != procIndex.end()) {
+                callees[i].push_back(it->second);
+            }
+        }
+    }
+
+    // Tarjan's algorithm. The DFS stack is kept explicitly
+    // since call graphs of large programs can be very deep.
+    const std::size_t UNVISITED = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> index(numProcs, UNVISITED);
+    std::vector<std::size_t> lowLink(numProcs, 0);
+    std::vector<bool> onStack(numProcs, false);
+    std::vector<std::size_t> sccStack;
+    std::vector<std::pair<std::size_t, std::size_t>> dfsStack; // (proc, next callee to visit)
+    std::size_t nextIndex = 0;
+
+    std::vector<ProcGroup> result;
+
+    for (std::size_t root = 0; root < numProcs; ++root) {
+        if (index[root] != UNVISITED) {
+            continue;
+        }
+
+        index[root] = lowLink[root] = nextIndex++;
+        sccStack.push_back(root);
+        onStack[root] = true;
+        dfsStack.push_back({ root, 0 });
+
+        while (!dfsStack.empty()) {
+            const std::size_t v = dfsStack.back().first;
+
+            if (dfsStack.back().second < callees[v].size()) {
+                const std::size_t w = callees[v][dfsStack.back().second++];
+
+                if (index[w] == UNVISITED) {
+                    index[w] = lowLink[w] = nextIndex++;
+                    sccStack.push_back(w);
+                    onStack[w] = true;
+                    dfsStack.push_back({ w, 0 });
+                }
+                else if (onStack[w]) {
+                    lowLink[v] = std::min(lowLink[v], index[w]);
+                }
+
+                continue;
+            }
+
+            // all callees of v have been visited
+            if (lowLink[v] == index[v]) {
+                std::vector<std::size_t> members;
+                std::size_t w = UNVISITED;
+
+                do {
+                    w = sccStack.back();
+                    sccStack.pop_back();
+                    onStack[w] = false;
+                    members.push_back(w);
+                } while (w != v);
+
+                // keep module order inside the group to be deterministic
+                std::sort(members.begin(), members.end());
+
+                ProcGroup group;
+                for (std::size_t member : members) {
+                    group.push_back(procs[member]);
+                }
+
+                result.push_back(group);
+            }
+
+            dfsStack.pop_back();
+
+            if (!dfsStack.empty()) {
+                const std::size_t caller = dfsStack.back().first;
+                lowLink[caller]          = std::min(lowLink[caller], lowLink[v]);
+            }
+        }
+    }
+
+    return result;
+}
+
+
+std::vector<UserProc *> ProcScheduler::getUserProcs() const
+{
+    std::vector<UserProc *> procs;
+
+    for (const auto &module : m_prog->getModuleList()) {
+        for (Function *func : *module) {
+            if (!func->isLib()) {
+                procs.push_back(static_cast<UserProc *>(func));
+            }
+        }
+    }
+
+    return procs;
+}
+
+
+void ProcScheduler::runGroups(const std::vector<ProcGroup> &groups,
+                              const std::vector<std::vector<std::size_t>> &calleeGroups,
+                              const Task &task)
+{
+    const std::size_t numWorkers = std::min(static_cast<std::size_t>(m_numThreads),
+                                            groups.size());
+
+    if (numWorkers <= 1) {
+        // groups are already sorted in a valid order.
+        for (const ProcGroup &group : groups) {
+            for (UserProc *proc : group) {
+                task(proc);
+            }
+        }
+
+        return;
+    }
+
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<std::size_t> groups;
+    };
+
+    std::vector<WorkQueue> queues(numWorkers);
+
+    std::vector<std::size_t> numPendingCallees(groups.size());
+    std::vector<std::vector<std::size_t>> callerGroups(groups.size());
+
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        numPendingCallees[i] = calleeGroups[i].size();
+
+        for (std::size_t callee : calleeGroups[i]) {
+            callerGroups[callee].push_back(i);
+        }
+    }
+
+    // All members below are protected by stateMutex
+    std::mutex stateMutex;
+    std::condition_variable stateChanged;
+    std::size_t numRemaining = groups.size();
+    std::size_t numQueued    = 0;
+    std::exception_ptr error = nullptr;
+
+    // Distribute the leaves round-robin
+    for (std::size_t i = 0, nextQueue = 0; i < groups.size(); ++i) {
+        if (numPendingCallees[i] == 0) {
+            queues[nextQueue].groups.push_back(i);
+            nextQueue = (nextQueue + 1) % numWorkers;
+            numQueued++;
+        }
+    }
+
+    // Take from the back of our own queue, steal from the front of other queues.
+    auto takeWork = [&](std::size_t self, std::size_t &groupIdx) {
+        for (std::size_t i = 0; i < numWorkers; ++i) {
+            WorkQueue &queue = queues[(self + i) % numWorkers];
+            std::lock_guard<std::mutex> queueLock(queue.mutex);
+
+            if (queue.groups.empty()) {
+                continue;
+            }
+            else if (i == 0) {
+                groupIdx = queue.groups.back();
+                queue.groups.pop_back();
+            }
+            else {
+                groupIdx = queue.groups.front();
+                queue.groups.pop_front();
+            }
+
+            return true;
+        }
+
+        return false;
+    };
+
+    auto worker = [&](std::size_t self) {
+        while (true) {
+            std::size_t groupIdx = 0;
+
+            if (!takeWork(self, groupIdx)) {
+                std::unique_lock<std::mutex> lock(stateMutex);
+                stateChanged.wait(lock, [&]() { return numRemaining == 0 || numQueued > 0; });
+
+                if (numRemaining == 0) {
+                    return;
+                }
+
+                continue;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                numQueued--;
+            }
+
+            try {
+                for (UserProc *proc : groups[groupIdx]) {
+                    task(proc);
+                }
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+
+            std::vector<std::size_t> readyGroups;
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                for (std::size_t caller : callerGroups[groupIdx]) {
+                    if (--numPendingCallees[caller] == 0) {
+                        readyGroups.push_back(caller);
+                    }
+                }
+            }
+
+            if (!readyGroups.empty()) {
+                std::lock_guard<std::mutex> queueLock(queues[self].mutex);
+                queues[self].groups.insert(queues[self].groups.end(), readyGroups.begin(),
+                                           readyGroups.end());
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                numQueued += readyGroups.size();
+                numRemaining--;
+            }
+
+            stateChanged.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < numWorkers; ++i) {
+        threads.emplace_back(worker, i);
+    }
+
+    worker(0);
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
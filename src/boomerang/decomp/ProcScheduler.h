@@ -0,0 +1,80 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <functional>
+#include <vector>
+
+
+class Prog;
+class UserProc;
+
+
+/**
+ * Runs a task on all UserProcs of a program, using a pool of worker threads.
+ *
+ * The call graph is partitioned into strongly connected components (recursion groups).
+ * A component is scheduled only after all components it calls have been processed,
+ * i.e. leaves are processed first. All procedures of a component are processed
+ * by the same worker, in the order in which they appear in the program's modules.
+ * Each worker has its own queue of ready components; idle workers steal from the queues
+ * of other workers.
+ *
+ * The task must only access the procedure passed to it (see \ref IPass::isProcLocal).
+ * In this case, the result does not depend on the number of threads,
+ * so parallel runs produce the same output as serial runs.
+ */
+class BOOMERANG_API ProcScheduler
+{
+public:
+    typedef std::function<void(UserProc *)> Task;
+    typedef std::vector<UserProc *> ProcGroup;
+
+public:
+    /// \param numThreads Number of worker threads. If < 1, use one worker per hardware thread.
+    ProcScheduler(const Prog *prog, int numThreads);
+
+public:
+    /// \returns the number of worker threads used by this scheduler.
+    int getNumThreads() const { return m_numThreads; }
+
+    /// Run \p task on every UserProc of the program.
+    /// Callees are processed before their callers.
+    void runBottomUp(const Task &task);
+
+    /// Run \p task on every UserProc of the program, without any ordering constraints
+    /// between different procedures.
+    void runUnordered(const Task &task);
+
+    /**
+     * Compute the strongly connected components of the call graph.
+     * Only UserProcs are considered; calls to library procedures are ignored.
+     * \returns the components in bottom-up order (callees first).
+     */
+    std::vector<ProcGroup> getCallGraphSCCs() const;
+
+private:
+    /// \returns all UserProcs of the program in module order.
+    std::vector<UserProc *> getUserProcs() const;
+
+    /**
+     * Run \p task for all procs in \p groups.
+     * Group \p groups[i] is not started before all groups in \p calleeGroups[i] have finished.
+     */
+    void runGroups(const std::vector<ProcGroup> &groups,
+                   const std::vector<std::vector<std::size_t>> &calleeGroups, const Task &task);
+
+private:
+    const Prog *m_prog;
+    int m_numThreads;
+};
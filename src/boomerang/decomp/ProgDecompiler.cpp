@@ -16,6 +16,8 @@
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/decomp/CFGCompressor.h"
+#include "boomerang/decomp/DecompilationCache.h"
+#include "boomerang/decomp/ProcScheduler.h"
 #include "boomerang/decomp/UnusedReturnRemover.h"
 #include "boomerang/passes/PassManager.h"
 #include "boomerang/ssl/exp/Const.h"
@@ -34,8 +36,24 @@ void ProgDecompiler::decompile()
     assert(!m_prog->getModuleList().empty());
     LOG_VERBOSE("%1 procedures", m_prog->getNumFunctions(false));
 
+    Project *project = m_prog->getProject();
+    PassManager::get()->setCollectStatistics(!project->getSettings()->passStatsFile.isEmpty());
+
+    std::unique_ptr<DecompilationCache> cache;
+    project->setCacheStatistics(0, 0);
+
+    if (!project->getSettings()->decompilationCacheDir.isEmpty()) {
+        cache.reset(new DecompilationCache(m_prog, project->getSettings()->decompilationCacheDir));
+        cache->restoreProcs();
+        project->addWatcher(cache.get());
+    }
+
     // Start decompiling each entry point
     for (UserProc *up : m_prog->getEntryProcs()) {
+        if (up->isDecompiled()) { // restored from the decompilation cache
+            continue;
+        }
+
         LOG_MSG("Decompiling entry point '%1'", up->getName());
         up->decompileRecursive();
     }
@@ -67,6 +85,13 @@ void ProgDecompiler::decompile()
         }
     }
 
+    if (cache) {
+        project->removeWatcher(cache.get());
+        LOG_MSG("Decompilation cache: %1 procedures restored, %2 procedures decompiled",
+                cache->getNumHits(), cache->getNumMisses());
+        project->setCacheStatistics(cache->getNumHits(), cache->getNumMisses());
+    }
+
     globalTypeAnalysis();
 
     if (m_prog->getProject()->getSettings()->removeReturns) {
@@ -93,12 +118,17 @@ void ProgDecompiler::decompile()
 
     LOG_MSG("Compressing CFG...");
 
-    for (const auto &module : m_prog->getModuleList()) {
-        for (Function *func : *module) {
-            if (!func->isLib()) {
-                CFGCompressor().compressCFG(static_cast<UserProc *>(func)->getCFG());
-            }
+    // CFG compression only modifies the CFG of the proc itself
+    ProcScheduler scheduler(m_prog, getNumThreads());
+    scheduler.runUnordered([](UserProc *proc) { CFGCompressor().compressCFG(proc->getCFG()); });
+
+    if (PassManager::get()->getStatistics()) {
+        const QString &statsFile = project->getSettings()->passStatsFile;
+        if (PassManager::get()->getStatistics()->writeToFile(statsFile)) {
+            LOG_MSG("Pass statistics written to '%1'", statsFile);
         }
+
+        PassManager::get()->setCollectStatistics(false);
     }
 
     LOG_MSG("Decompilation finished.");
@@ -201,7 +231,11 @@ void ProgDecompiler::removeUnusedGlobals()
 bool ProgDecompiler::removeUnusedParamsAndReturns()
 {
     LOG_MSG("Removing unused returns...");
-    return UnusedReturnRemover(m_prog).removeUnusedReturns();
+    const bool change = UnusedReturnRemover(m_prog).removeUnusedReturns();
+
+    // Returns and calls of any procedure might have been changed in place
+    DefUseIndex::invalidateAll();
+    return change;
 }
 
 
@@ -209,15 +243,27 @@ void ProgDecompiler::fromSSAForm()
 {
     LOG_MSG("Transforming from SSA form...");
 
-    for (const auto &module : m_prog->getModuleList()) {
-        for (Function *pp : *module) {
-            if (pp->isLib()) {
-                continue;
-            }
+    ProcScheduler scheduler(m_prog, getNumThreadsForPass(PassID::FromSSAForm));
+    scheduler.runUnordered([](UserProc *proc) {
+        proc->numberStatements();
+        PassManager::get()->executePass(PassID::FromSSAForm, proc);
+    });
+}
 
-            UserProc *proc = static_cast<UserProc *>(pp);
-            proc->numberStatements();
-            PassManager::get()->executePass(PassID::FromSSAForm, proc);
-        }
+
+int ProgDecompiler::getNumThreads() const
+{
+    return m_prog->getProject()->getSettings()->getNumDebuggableThreads();
+}
+
+
+int ProgDecompiler::getNumThreadsForPass(PassID passID) const
+{
+    const IPass *pass = PassManager::get()->getPass(passID);
+
+    if (!pass || !pass->isProcLocal()) {
+        return 1;
     }
+
+    return getNumThreads();
 }
@@ -11,6 +11,7 @@
 
 
 #include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/passes/Pass.h"
 
 
 class Prog;
@@ -41,6 +42,14 @@ private:
     /// Convert from SSA form
     void fromSSAForm();
 
+    /// \returns the number of threads that can be used for tasks that only modify
+    /// a single procedure. This is 1 when stopping at debug points.
+    int getNumThreads() const;
+
+    /// \returns the number of threads that can be used to execute the pass \p passID
+    /// for all procedures. Passes that are not proc-local are always executed serially.
+    int getNumThreadsForPass(PassID passID) const;
+
 private:
     Prog *m_prog;
 };
@@ -30,14 +30,22 @@
 #include "boomerang/ssl/statements/ReturnStatement.h"
 #include "boomerang/ssl/type/FuncType.h"
 #include "boomerang/ssl/type/NamedType.h"
+#include "boomerang/util/MemoryArena.h"
 #include "boomerang/util/log/Log.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+
+/// The worker decoder of the calling thread while DefaultFrontEnd::decodeConcurrently is running
+static thread_local IDecoder *g_workerDecoder = nullptr;
+
 
 DefaultFrontEnd::DefaultFrontEnd(Project *project)
     : IFrontEnd(project)
     , m_binaryFile(project->getLoadedBinaryFile())
     , m_program(project->getProg())
-    , m_targetQueue(project->getSettings()->traceDecoder)
 {
 }
 
@@ -79,6 +87,7 @@ bool DefaultFrontEnd::decodeEntryPointsRecursive(bool decodeMain)
 
     if (a == Address::INVALID) {
         std::vector<Address> entrypoints = findEntryPoints();
+        decodeSpeculatively(entrypoints);
 
         for (auto &entrypoint : entrypoints) {
             if (!decodeRecursive(entrypoint)) {
@@ -89,6 +98,7 @@ bool DefaultFrontEnd::decodeEntryPointsRecursive(bool decodeMain)
         return true;
     }
 
+    decodeSpeculatively({ a });
     decodeRecursive(a);
     m_program->addEntryPoint(a);
 
@@ -168,6 +178,28 @@ bool DefaultFrontEnd::decodeUndecoded()
     bool change = true;
     LOG_MSG("Looking for undecoded procedures to decode...");
 
+    std::vector<UserProc *> undecodedProcs = getUndecodedProcs();
+
+    if (m_program->getProject()->getSettings()->decodeChildren && createWorkerDecoders()) {
+        // Each round decodes the procedures that were found while decoding the previous round.
+        while (!undecodedProcs.empty()) {
+            if (!decodeConcurrently(undecodedProcs)) {
+                m_parallelDecoder.reset();
+                return false;
+            }
+
+            undecodedProcs = getUndecodedProcs();
+        }
+    }
+    else {
+        std::vector<Address> undecodedEntryPoints;
+        for (UserProc *proc : undecodedProcs) {
+            undecodedEntryPoints.push_back(proc->getEntryAddress());
+        }
+
+        decodeSpeculatively(undecodedEntryPoints);
+    }
+
     while (change) {
         change = false;
 
@@ -187,6 +219,7 @@ bool DefaultFrontEnd::decodeUndecoded()
                 change = true;
 
                 if (!processProc(userProc, userProc->getEntryAddress())) {
+                    m_parallelDecoder.reset();
                     return false;
                 }
 
@@ -204,10 +237,70 @@ bool DefaultFrontEnd::decodeUndecoded()
         }
     }
 
+    // Everything reachable has been decoded now, so the remaining speculatively decoded
+    // instructions are not needed any more.
+    m_parallelDecoder.reset();
+
     return m_program->isWellFormed();
 }
 
 
+std::vector<UserProc *> DefaultFrontEnd::getUndecodedProcs() const
+{
+    std::vector<UserProc *> undecodedProcs;
+
+    for (const auto &m : m_program->getModuleList()) {
+        for (Function *function : *m) {
+            if (!function->isLib() && !static_cast<UserProc *>(function)->isDecoded()) {
+                undecodedProcs.push_back(static_cast<UserProc *>(function));
+            }
+        }
+    }
+
+    return undecodedProcs;
+}
+
+
+bool DefaultFrontEnd::decodeConcurrently(const std::vector<UserProc *> &procs)
+{
+    std::atomic<std::size_t> nextProc(0);
+    std::atomic<bool> success(true);
+
+    auto worker = [&](std::size_t self) {
+        g_workerDecoder = m_workerDecoders[self].get();
+
+        for (std::size_t i = nextProc++; i < procs.size() && success; i = nextProc++) {
+            UserProc *proc = procs[i];
+
+            if (processProc(proc, proc->getEntryAddress())) {
+                proc->setDecoded();
+            }
+            else {
+                success = false;
+            }
+        }
+
+        g_workerDecoder = nullptr;
+    };
+
+    const std::size_t numWorkers = std::min(m_workerDecoders.size(), procs.size());
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < numWorkers; ++i) {
+        threads.emplace_back(worker, i);
+    }
+
+    worker(0);
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    LOG_VERBOSE("Decoded %1 procedures using %2 threads", procs.size(), numWorkers);
+    return success;
+}
+
+
 bool DefaultFrontEnd::decodeFragment(UserProc *proc, Address a)
 {
     if (m_program->getProject()->getSettings()->traceDecoder) {
@@ -224,6 +317,8 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
 
     LOG_VERBOSE("### Decoding proc '%1' at address %2 ###", proc->getName(), addr);
 
+    MemoryArena::Scope arenaScope(proc->getArena());
+
     // We have a set of CallStatement pointers. These may be disregarded if this is a speculative
     // decode that fails (i.e. an illegal instruction is found). If not, this set will be used to
     // add to the set of calls to be analysed in the ProcCFG, and also to call newProc()
@@ -237,7 +332,8 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
     assert(cfg);
 
     // Initialise the queue of control flow targets that have yet to be decoded.
-    m_targetQueue.initial(addr);
+    TargetQueue targetQueue(m_program->getProject()->getSettings()->traceDecoder);
+    targetQueue.initial(addr);
 
     // Clear the pointer used by the caller prologue code to access the last call rtl of this
     // procedure decoder.resetLastCall();
@@ -246,7 +342,7 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
     Address startAddr   = addr;
     Address lastAddr    = addr;
 
-    while ((addr = m_targetQueue.getNextAddress(*cfg)) != Address::INVALID) {
+    while ((addr = targetQueue.getNextAddress(*cfg)) != Address::INVALID) {
         // The list of RTLs for the current basic block
         std::unique_ptr<RTLList> BB_rtls(new RTLList);
 
@@ -286,7 +382,10 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
 
             if (!inst.valid) {
                 // Alert the watchers to the problem
-                m_program->getProject()->alertBadDecode(addr);
+                {
+                    std::lock_guard<std::recursive_mutex> lock(m_programMutex);
+                    m_program->getProject()->alertBadDecode(addr);
+                }
 
                 // An invalid instruction. Most likely because a call did not return (e.g. call
                 // _exit()), etc. Best thing is to emit an INVALID BB, and continue with valid
@@ -298,7 +397,10 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
             }
 
             // alert the watchers that we have decoded an instruction
-            m_program->getProject()->alertInstructionDecoded(addr, inst.numBytes);
+            {
+                std::lock_guard<std::recursive_mutex> lock(m_programMutex);
+                m_program->getProject()->alertInstructionDecoded(addr, inst.numBytes);
+            }
             numBytesDecoded += inst.numBytes;
 
             // Check if this is an already decoded jump instruction (from a previous pass with
@@ -343,8 +445,11 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
                 Statement *s = *ss;
                 s->setProc(proc); // let's do this really early!
 
-                if (m_refHints.find(inst.rtl->getAddress()) != m_refHints.end()) {
-                    const QString &name(m_refHints[inst.rtl->getAddress()]);
+                auto refHint = m_refHints.find(inst.rtl->getAddress());
+
+                if (refHint != m_refHints.end()) {
+                    std::lock_guard<std::recursive_mutex> lock(m_programMutex);
+                    const QString &name(refHint->second);
                     Address globAddr = m_program->getGlobalAddrByName(name);
 
                     if (globAddr != Address::INVALID) {
@@ -383,7 +488,7 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
                         // Add the out edge if it is to a destination within the
                         // procedure
                         if (jumpDest < m_program->getBinaryFile()->getImage()->getLimitTextHigh()) {
-                            m_targetQueue.visit(cfg, jumpDest, currentBB);
+                            targetQueue.visit(cfg, jumpDest, currentBB);
                             cfg->addEdge(currentBB, jumpDest);
                         }
                         else {
@@ -398,6 +503,7 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
                     SharedExp jumpDest = jumpStmt->getDest();
 
                     if (jumpDest == nullptr) { // Happens if already analysed (now redecoding)
+                        std::lock_guard<std::recursive_mutex> lock(m_programMutex);
                         BB_rtls->push_back(std::move(inst.rtl));
 
                         // processSwitch will update num outedges
@@ -411,6 +517,7 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
 
                     // Check for indirect calls to library functions, especially in Win32 programs
                     if (refersToImportedFunction(jumpDest)) {
+                        std::lock_guard<std::recursive_mutex> lock(m_programMutex);
                         LOG_VERBOSE("Jump to a library function: %1, replacing with a call/ret.",
                                     jumpStmt);
 
@@ -434,7 +541,7 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
                             std::unique_ptr<RTL>(new RTL(inst.rtl->getAddress(), { call })));
 
                         currentBB = cfg->createBB(BBType::Call, std::move(BB_rtls));
-                        appendSyntheticReturn(currentBB, proc, inst.rtl.get());
+                        appendSyntheticReturn(currentBB, proc, inst.rtl.get(), targetQueue);
                         sequentialDecode = false;
 
                         if (inst.rtl->getAddress() == proc->getEntryAddress()) {
@@ -478,7 +585,7 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
                     else {
                         // Add the out edge if it is to a destination within the section
                         if (jumpDest < m_program->getBinaryFile()->getImage()->getLimitTextHigh()) {
-                            m_targetQueue.visit(cfg, jumpDest, currentBB);
+                            targetQueue.visit(cfg, jumpDest, currentBB);
                             cfg->addEdge(currentBB, jumpDest);
                         }
                         else {
@@ -494,6 +601,7 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
                 } break;
 
                 case StmtType::Call: {
+                    std::lock_guard<std::recursive_mutex> lock(m_programMutex);
                     CallStatement *call = static_cast<CallStatement *>(s);
 
                     // Check for a dynamic linked library function
@@ -611,7 +719,7 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
                             // Make sure it has a return appended (so there is only one exit
                             // from the function)
                             currentBB = cfg->createBB(BBType::Call, std::move(BB_rtls));
-                            appendSyntheticReturn(currentBB, proc, rtl);
+                            appendSyntheticReturn(currentBB, proc, rtl, targetQueue);
 
                             // Stop decoding sequentially
                             sequentialDecode = false;
@@ -660,7 +768,8 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
 
                     // Create the list of RTLs for the next basic block and
                     // continue with the next instruction.
-                    createReturnBlock(proc, std::move(BB_rtls), std::move(inst.rtl));
+                    createReturnBlock(proc, std::move(BB_rtls), std::move(inst.rtl),
+                                      targetQueue);
                     break;
 
                 case StmtType::BoolAssign:
@@ -720,6 +829,7 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
         sequentialDecode = true;
     } // while getNextAddress() != Address::INVALID
 
+    std::lock_guard<std::recursive_mutex> lock(m_programMutex);
 
     for (CallStatement *callStmt : callList) {
         Address dest = callStmt->getFixedDest();
@@ -747,6 +857,15 @@ bool DefaultFrontEnd::processProc(UserProc *proc, Address addr)
 
 bool DefaultFrontEnd::decodeSingleInstruction(Address pc, DecodeResult &result)
 {
+    if (m_parallelDecoder) {
+        std::lock_guard<std::recursive_mutex> lock(m_programMutex);
+
+        if (m_parallelDecoder->takeDecoded(pc, result)) {
+            resolveCallDestinations(result.rtl.get());
+            return true;
+        }
+    }
+
     BinaryImage *image = m_program->getBinaryFile()->getImage();
     if (!image || (image->getSectionByAddr(pc) == nullptr)) {
         LOG_ERROR("Attempted to decode outside any known section at address %1", pc);
@@ -764,7 +883,19 @@ bool DefaultFrontEnd::decodeSingleInstruction(Address pc, DecodeResult &result)
     ptrdiff_t host_native_diff = (section->getHostAddr() - section->getSourceAddr()).value();
 
     try {
-        return m_decoder->decodeInstruction(pc, host_native_diff, result);
+        IDecoder *decoder = getThreadDecoder();
+
+        if (decoder == m_decoder) {
+            return m_decoder->decodeInstruction(pc, host_native_diff, result);
+        }
+        else if (!decoder->decodeInstruction(pc, host_native_diff, result)) {
+            return false;
+        }
+
+        // Worker decoders do not assign procedures to calls
+        std::lock_guard<std::recursive_mutex> lock(m_programMutex);
+        resolveCallDestinations(result.rtl.get());
+        return true;
     }
     catch (std::runtime_error &e) {
         LOG_ERROR("%1", e.what());
@@ -875,7 +1006,8 @@ void DefaultFrontEnd::saveDecodedRTL(Address a, RTL *rtl)
 
 
 BasicBlock *DefaultFrontEnd::createReturnBlock(UserProc *proc, std::unique_ptr<RTLList> BB_rtls,
-                                               std::unique_ptr<RTL> returnRTL)
+                                               std::unique_ptr<RTL> returnRTL,
+                                               TargetQueue &targetQueue)
 {
     ProcCFG *cfg = proc->getCFG();
 
@@ -925,7 +1057,7 @@ BasicBlock *DefaultFrontEnd::createReturnBlock(UserProc *proc, std::unique_ptr<R
 
             // Visit the return instruction. This will be needed in most cases to split the
             // return BB (if it has other instructions before the return instruction).
-            m_targetQueue.visit(cfg, retAddr, newBB);
+            targetQueue.visit(cfg, retAddr, newBB);
         }
     }
 
@@ -956,11 +1088,13 @@ bool DefaultFrontEnd::refersToImportedFunction(const SharedExp &exp)
 }
 
 
-void DefaultFrontEnd::appendSyntheticReturn(BasicBlock *callBB, UserProc *proc, RTL *callRTL)
+void DefaultFrontEnd::appendSyntheticReturn(BasicBlock *callBB, UserProc *proc, RTL *callRTL,
+                                            TargetQueue &targetQueue)
 {
     std::unique_ptr<RTLList> ret_rtls(new RTLList);
     std::unique_ptr<RTL> retRTL(new RTL(callRTL->getAddress() + 1, { new ReturnStatement }));
-    BasicBlock *retBB = createReturnBlock(proc, std::move(ret_rtls), std::move(retRTL));
+    BasicBlock *retBB = createReturnBlock(proc, std::move(ret_rtls), std::move(retRTL),
+                                          targetQueue);
 
     assert(callBB->getNumSuccessors() == 0);
     proc->getCFG()->addEdge(callBB, retBB);
@@ -977,6 +1111,7 @@ void DefaultFrontEnd::preprocessProcGoto(std::list<Statement *>::iterator ss, Ad
         return;
     }
 
+    std::lock_guard<std::recursive_mutex> lock(m_programMutex);
     Function *proc = m_program->getFunctionByAddr(dest);
 
     if (proc == nullptr) {
@@ -1003,6 +1138,97 @@ void DefaultFrontEnd::preprocessProcGoto(std::list<Statement *>::iterator ss, Ad
 }
 
 
+bool DefaultFrontEnd::createWorkerDecoders()
+{
+    if (m_workerDecodersCreated) {
+        return !m_workerDecoders.empty();
+    }
+
+    m_workerDecodersCreated  = true;
+    const Settings *settings = m_program->getProject()->getSettings();
+    int numThreads           = settings->numThreads;
+
+    if (numThreads < 1) {
+        numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    // Keep the decoder output in order when tracing
+    if (numThreads <= 1 || !m_decoder || settings->traceDecoder || settings->debugDecoder) {
+        return false;
+    }
+
+    for (int i = 0; i < numThreads; ++i) {
+        m_workerDecoders.push_back(m_decoder->createWorkerDecoder(m_program->getProject()));
+
+        if (!m_workerDecoders.back()) {
+            m_workerDecoders.clear(); // not supported by the decoder
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+IDecoder *DefaultFrontEnd::getThreadDecoder() const
+{
+    return g_workerDecoder ? g_workerDecoder : m_decoder;
+}
+
+
+void DefaultFrontEnd::decodeSpeculatively(const std::vector<Address> &entryPoints)
+{
+    if (!createWorkerDecoders()) {
+        return;
+    }
+
+    const Settings *settings = m_program->getProject()->getSettings();
+
+    std::vector<IDecoder *> decoders;
+    for (const std::unique_ptr<IDecoder> &decoder : m_workerDecoders) {
+        decoders.push_back(decoder.get());
+    }
+
+    if (!m_parallelDecoder) {
+        m_parallelDecoder.reset(new ParallelDecoder(m_program->getBinaryFile()->getImage()));
+    }
+
+    m_parallelDecoder->decodeFrom(decoders, entryPoints, settings->decodeChildren);
+
+    LOG_VERBOSE("Speculatively decoded %1 instructions using %2 threads",
+                m_parallelDecoder->getNumDecoded(), decoders.size());
+}
+
+
+void DefaultFrontEnd::resolveCallDestinations(RTL *rtl)
+{
+    if (rtl == nullptr) {
+        return;
+    }
+
+    for (Statement *s : *rtl) {
+        if (!s->isCall()) {
+            continue;
+        }
+
+        CallStatement *call = static_cast<CallStatement *>(s);
+        const Address dest  = call->getFixedDest();
+
+        if (call->isComputed() || call->getDestProc() || dest == Address::INVALID) {
+            continue;
+        }
+
+        Function *destProc = m_program->getOrCreateFunction(dest);
+
+        if (destProc == reinterpret_cast<Function *>(-1)) {
+            destProc = nullptr; // In case a deleted Proc
+        }
+
+        call->setDestProc(destProc);
+    }
+}
+
+
 UserProc *DefaultFrontEnd::createFunctionForEntryPoint(Address entryAddr,
                                                        const QString &functionType)
 {
@@ -10,12 +10,15 @@
 #pragma once
 
 
+#include "boomerang/frontend/ParallelDecoder.h"
 #include "boomerang/frontend/SigEnum.h"
 #include "boomerang/frontend/TargetQueue.h"
 #include "boomerang/ifc/IFrontEnd.h"
 
 #include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 
 class Function;
@@ -93,16 +96,21 @@ public:
     virtual void saveDecodedRTL(Address a, RTL *rtl) override;
 
 protected:
+    /// \returns the decoder to be used by the calling thread, i.e. its worker decoder
+    /// while \ref decodeConcurrently is running, or the main decoder otherwise.
+    IDecoder *getThreadDecoder() const;
+
     /**
      * Create a Return or a Oneway BB if a return statement already exists.
      * \param proc      pointer to enclosing UserProc
      * \param BB_rtls   list of RTLs for the current BB (not including \p returnRTL)
      * \param returnRTL pointer to the current RTL with the semantics for the return statement
      *                  (including a ReturnStatement as the last statement)
+     * \param targetQueue the queue of addresses that still need to be decoded in \p proc
      * \returns  Pointer to the newly created BB
      */
     BasicBlock *createReturnBlock(UserProc *proc, std::unique_ptr<RTLList> bb_rtls,
-                                  std::unique_ptr<RTL> returnRTL);
+                                  std::unique_ptr<RTL> returnRTL, TargetQueue &targetQueue);
 
     /**
      * Given the dest of a call, determine if this is a machine specific helper function with
@@ -126,8 +134,10 @@ private:
      * \param callBB  the call BB that will be followed by the return or jump
      * \param proc    the enclosing UserProc
      * \param callRTL the current RTL with the call instruction
+     * \param targetQueue the queue of addresses that still need to be decoded in \p proc
      */
-    void appendSyntheticReturn(BasicBlock *callBB, UserProc *proc, RTL *callRTL);
+    void appendSyntheticReturn(BasicBlock *callBB, UserProc *proc, RTL *callRTL,
+                               TargetQueue &targetQueue);
 
     /**
      * Change a jump to a call if the jump destination is an impoted function.
@@ -136,6 +146,37 @@ private:
     void preprocessProcGoto(std::list<Statement *>::iterator ss, Address dest,
                             const std::list<Statement *> &sl, RTL *originalRTL);
 
+    /**
+     * Create one decoder per worker thread (Settings::numThreads), if this has not been done
+     * before. No worker decoders are created if only one thread is used or the decoder
+     * does not support concurrent decoding.
+     * \returns true if there are worker decoders.
+     */
+    bool createWorkerDecoders();
+
+    /**
+     * Decode all instructions reachable from \p entryPoints ahead of time using
+     * the worker decoders. Does nothing if there are no worker decoders.
+     * The instructions are picked up by \ref decodeSingleInstruction.
+     */
+    void decodeSpeculatively(const std::vector<Address> &entryPoints);
+
+    /**
+     * Build the CFGs of \p procs using one worker thread per worker decoder.
+     * Each procedure is processed by \ref processProc on a single thread.
+     * New procedures found in \p procs are created in the order in which they are found,
+     * which depends on the scheduling of the threads.
+     * \returns false if a procedure could not be decoded.
+     */
+    bool decodeConcurrently(const std::vector<UserProc *> &procs);
+
+    /// \returns all user procedures that have not been decoded yet, in module order.
+    std::vector<UserProc *> getUndecodedProcs() const;
+
+    /// Assign procedures to the static calls in \p rtl that were decoded by a worker decoder.
+    /// \sa IDecoder::createWorkerDecoder
+    void resolveCallDestinations(RTL *rtl);
+
     /// Creates a UserProc for the entry point at address \p addr.
     /// Returns nullptr on failure.
     UserProc *createFunctionForEntryPoint(Address entryAddr, const QString &functionType);
@@ -151,12 +192,21 @@ protected:
     BinaryFile *m_binaryFile = nullptr;
     Prog *m_program          = nullptr;
 
-    TargetQueue m_targetQueue; ///< Holds the addresses that still need to be processed
-
     /// Map from address to meaningful name
     std::map<Address, QString> m_refHints;
 
     /// Map from address to previously decoded RTLs for decoded indirect control transfer
     /// instructions
     std::map<Address, RTL *> m_previouslyDecoded;
+
+    /// Instructions decoded ahead of time by \ref decodeSpeculatively
+    std::unique_ptr<ParallelDecoder> m_parallelDecoder;
+
+    /// Decoders of the worker threads, see \ref createWorkerDecoders
+    std::vector<std::unique_ptr<IDecoder>> m_workerDecoders;
+    bool m_workerDecodersCreated = false;
+
+    /// Serializes all changes to the program (and the watchers of the project)
+    /// while procedures are decoded concurrently by \ref decodeConcurrently.
+    std::recursive_mutex m_programMutex;
 };
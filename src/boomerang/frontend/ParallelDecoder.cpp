@@ -0,0 +1,295 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ParallelDecoder.h"
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/ifc/IDecoder.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+
+ParallelDecoder::ParallelDecoder(const BinaryImage *image)
+    : m_image(image)
+{
+}
+
+
+ParallelDecoder::~ParallelDecoder()
+{
+}
+
+
+void ParallelDecoder::decodeFrom(const std::vector<IDecoder *> &decoders,
+                                 const std::vector<Address> &entryPoints, bool followCalls)
+{
+    const std::size_t numWorkers = decoders.size();
+    if (numWorkers == 0) {
+        return;
+    }
+
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Address> entryPoints;
+    };
+
+    std::vector<WorkQueue> queues(numWorkers);
+    std::vector<DecodedMap> decoded(numWorkers);
+
+    // All members below (and m_procsSeen) are protected by stateMutex
+    std::mutex stateMutex;
+    std::condition_variable stateChanged;
+    std::size_t numPending = 0; ///< queued or being decoded
+    std::size_t numQueued  = 0;
+
+    // Distribute the entry points round-robin
+    for (std::size_t i = 0, nextQueue = 0; i < entryPoints.size(); ++i) {
+        if (m_procsSeen.insert(entryPoints[i]).second) {
+            queues[nextQueue].entryPoints.push_back(entryPoints[i]);
+            nextQueue = (nextQueue + 1) % numWorkers;
+            numPending++;
+            numQueued++;
+        }
+    }
+
+    // Take from the back of our own queue, steal from the front of other queues.
+    auto takeWork = [&](std::size_t self, Address &entryAddr) {
+        for (std::size_t i = 0; i < numWorkers; ++i) {
+            WorkQueue &queue = queues[(self + i) % numWorkers];
+            std::lock_guard<std::mutex> queueLock(queue.mutex);
+
+            if (queue.entryPoints.empty()) {
+                continue;
+            }
+            else if (i == 0) {
+                entryAddr = queue.entryPoints.back();
+                queue.entryPoints.pop_back();
+            }
+            else {
+                entryAddr = queue.entryPoints.front();
+                queue.entryPoints.pop_front();
+            }
+
+            return true;
+        }
+
+        return false;
+    };
+
+    auto worker = [&](std::size_t self) {
+        std::vector<Address> callDests;
+
+        while (true) {
+            Address entryAddr = Address::INVALID;
+
+            if (!takeWork(self, entryAddr)) {
+                std::unique_lock<std::mutex> lock(stateMutex);
+                stateChanged.wait(lock, [&]() { return numPending == 0 || numQueued > 0; });
+
+                if (numPending == 0) {
+                    return;
+                }
+
+                continue;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                numQueued--;
+            }
+
+            callDests.clear();
+            decodeProc(decoders[self], entryAddr, decoded[self], callDests);
+
+            std::vector<Address> newEntryPoints;
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+
+                if (followCalls) {
+                    for (Address dest : callDests) {
+                        if (m_procsSeen.insert(dest).second) {
+                            newEntryPoints.push_back(dest);
+                        }
+                    }
+                }
+
+                numPending += newEntryPoints.size();
+                numQueued += newEntryPoints.size();
+            }
+
+            if (!newEntryPoints.empty()) {
+                std::lock_guard<std::mutex> queueLock(queues[self].mutex);
+                queues[self].entryPoints.insert(queues[self].entryPoints.end(),
+                                                newEntryPoints.begin(), newEntryPoints.end());
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                numPending--;
+            }
+
+            stateChanged.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < numWorkers; ++i) {
+        threads.emplace_back(worker, i);
+    }
+
+    worker(0);
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    // Merge in worker order. If an instruction was decoded by more than one worker,
+    // all results are equivalent, so it does not matter which one is kept.
+    for (DecodedMap &workerDecoded : decoded) {
+        for (auto &[addr, result] : workerDecoded) {
+            m_decoded.emplace(addr, std::move(result));
+        }
+    }
+}
+
+
+bool ParallelDecoder::takeDecoded(Address pc, DecodeResult &result)
+{
+    auto it = m_decoded.find(pc);
+    if (it == m_decoded.end()) {
+        return false;
+    }
+
+    result = std::move(it->second);
+    m_decoded.erase(it);
+    return true;
+}
+
+
+void ParallelDecoder::clear()
+{
+    m_decoded.clear();
+    m_procsSeen.clear();
+}
+
+
+void ParallelDecoder::decodeProc(IDecoder *decoder, Address entryAddr, DecodedMap &decoded,
+                                 std::vector<Address> &callDests) const
+{
+    const Address textLow  = m_image->getLimitTextLow();
+    const Address textHigh = m_image->getLimitTextHigh();
+
+    std::vector<Address> targets = { entryAddr };
+    std::set<Address> visited;
+
+    while (!targets.empty()) {
+        Address addr = targets.back();
+        targets.pop_back();
+
+        // Decode sequentially until a CTI without a fall through edge is found
+        while (addr >= textLow && addr < textHigh && visited.insert(addr).second &&
+               decoded.find(addr) == decoded.end()) {
+            DecodeResult inst;
+            if (!decodeInstruction(decoder, addr, inst)) {
+                break; // leave it to the front end to report the error
+            }
+
+            bool sequentialDecode = true;
+
+            if (inst.rtl) {
+                for (const Statement *s : inst.rtl->getStatements()) {
+                    switch (s->getKind()) {
+                    case StmtType::Goto: {
+                        const Address dest = static_cast<const GotoStatement *>(s)->getFixedDest();
+                        if (dest != Address::INVALID) {
+                            targets.push_back(dest);
+                        }
+
+                        sequentialDecode = false;
+                    } break;
+
+                    case StmtType::Branch: {
+                        const Address dest = static_cast<const GotoStatement *>(s)->getFixedDest();
+                        if (dest != Address::INVALID) {
+                            targets.push_back(dest);
+                        }
+                    } break;
+
+                    case StmtType::Call: {
+                        const CallStatement *call = static_cast<const CallStatement *>(s);
+                        const Address dest        = call->getFixedDest();
+
+                        if (!call->isComputed() && dest != Address::INVALID && !dest.isZero()) {
+                            callDests.push_back(dest);
+                        }
+
+                        if (call->isReturnAfterCall()) {
+                            sequentialDecode = false;
+                        }
+                    } break;
+
+                    case StmtType::Case:
+                    case StmtType::Ret: sequentialDecode = false; break;
+
+                    default: break;
+                    }
+                }
+            }
+
+            const int numBytes = inst.numBytes;
+            decoded.emplace(addr, std::move(inst));
+
+            if (!sequentialDecode || numBytes <= 0) {
+                break;
+            }
+
+            addr += numBytes;
+        }
+    }
+}
+
+
+bool ParallelDecoder::decodeInstruction(IDecoder *decoder, Address pc, DecodeResult &result) const
+{
+    const BinarySection *section = m_image->getSectionByAddr(pc);
+    if (section == nullptr || section->getHostAddr() == HostAddress::INVALID) {
+        return false;
+    }
+
+    const ptrdiff_t delta = (section->getHostAddr() - section->getSourceAddr()).value();
+
+    try {
+        if (!decoder->decodeInstruction(pc, delta, result) || !result.valid) {
+            return false;
+        }
+
+        if (result.reDecode) {
+            // The semantics of instructions that are decoded more than once (e.g. x86 BSF/BSR)
+            // depend on the state of the decoder. Bring the decoder back to its initial state,
+            // but leave these instructions to the front end.
+            while (result.reDecode && decoder->decodeInstruction(pc, delta, result)) {
+            }
+
+            return false;
+        }
+    }
+    catch (std::runtime_error &) {
+        return false;
+    }
+
+    return true;
+}
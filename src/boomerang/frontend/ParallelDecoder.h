@@ -0,0 +1,103 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/frontend/DecodeResult.h"
+#include "boomerang/util/Address.h"
+
+#include <functional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+
+class BinaryImage;
+class IDecoder;
+
+
+/**
+ * Speculatively decodes the instructions of a program using multiple threads.
+ *
+ * Starting from a set of procedure entry points, each worker follows the control flow
+ * inside the procedure (fall-through edges, branch and jump targets) and queues the
+ * destinations of static calls as new entry points. Each worker has its own queue of
+ * entry points; idle workers steal from the queues of other workers.
+ *
+ * Workers use their own decoder instances, which must not modify the program
+ * (see \ref IDecoder::createWorkerDecoder). Decoded instructions are kept by address
+ * until they are picked up by the front end when it builds the control flow graphs.
+ */
+class BOOMERANG_API ParallelDecoder
+{
+public:
+    explicit ParallelDecoder(const BinaryImage *image);
+    ParallelDecoder(const ParallelDecoder &other) = delete;
+    ParallelDecoder(ParallelDecoder &&other)      = default;
+
+    ~ParallelDecoder();
+
+    ParallelDecoder &operator=(const ParallelDecoder &other) = delete;
+    ParallelDecoder &operator=(ParallelDecoder &&other) = default;
+
+public:
+    /**
+     * Decode all instructions reachable from \p entryPoints.
+     * Procedures that have been decoded by a previous call are not decoded again.
+     *
+     * \param decoders    the decoders of the worker threads. One thread is used per decoder.
+     * \param followCalls if true, also decode the procedures called from \p entryPoints
+     *                    (transitively).
+     */
+    void decodeFrom(const std::vector<IDecoder *> &decoders,
+                    const std::vector<Address> &entryPoints, bool followCalls);
+
+    /**
+     * Take the speculatively decoded instruction at address \p pc.
+     * Each decoded instruction can only be taken once.
+     * \returns false if the instruction at \p pc has not been decoded.
+     */
+    bool takeDecoded(Address pc, DecodeResult &result);
+
+    /// \returns the number of decoded instructions that have not been taken yet.
+    std::size_t getNumDecoded() const { return m_decoded.size(); }
+
+    /// Discard all decoded instructions that have not been taken yet.
+    void clear();
+
+private:
+    struct AddressHash
+    {
+        std::size_t operator()(Address addr) const
+        {
+            return std::hash<Address::value_type>()(addr.value());
+        }
+    };
+
+    typedef std::unordered_map<Address, DecodeResult, AddressHash> DecodedMap;
+
+    /**
+     * Decode all instructions of the procedure starting at \p entryAddr,
+     * using \p decoder, and store them into \p decoded.
+     * Destinations of static calls are stored into \p callDests.
+     */
+    void decodeProc(IDecoder *decoder, Address entryAddr, DecodedMap &decoded,
+                    std::vector<Address> &callDests) const;
+
+    /// Decode a single instruction. \returns false if the instruction must not be cached.
+    bool decodeInstruction(IDecoder *decoder, Address pc, DecodeResult &result) const;
+
+private:
+    const BinaryImage *m_image;
+
+    DecodedMap m_decoded;          ///< Decoded instructions that have not been taken yet
+    std::set<Address> m_procsSeen; ///< Entry points of all procedures decoded so far
+};
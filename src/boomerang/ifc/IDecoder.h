@@ -13,6 +13,8 @@
 #include "boomerang/frontend/DecodeResult.h"
 #include "boomerang/ssl/Register.h"
 
+#include <memory>
+
 
 class Exp;
 class RTL;
@@ -59,6 +61,14 @@ public:
 
     virtual const RTLInstDict *getDict() const = 0;
 
+    /**
+     * Create a new decoder for the same architecture that can be used by another thread
+     * concurrently with this decoder. The new decoder must not modify the program,
+     * e.g. by creating procedures for the destinations of call instructions.
+     * \returns nullptr if this decoder does not support concurrent decoding.
+     */
+    virtual std::unique_ptr<IDecoder> createWorkerDecoder(Project *) const { return nullptr; }
+
     /// \return true if this is a SPARC restore instruction.
     // For all other architectures, this must return false.
     virtual bool isSPARCRestore(Address pc, ptrdiff_t delta) const = 0;
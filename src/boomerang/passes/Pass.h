@@ -65,6 +65,12 @@ public:
     /// This means that procLocal passes can be executed for each function in parallel.
     virtual bool isProcLocal() const { return false; }
 
+    /// \returns true iff the pass announces all its changes of statements to the
+    /// def-use index of the function (see \ref UserProc::getDefUseIndex) and does not
+    /// change statements of other functions. Otherwise, the index is invalidated
+    /// after the pass has been executed.
+    virtual bool maintainsDefUseIndex() const { return false; }
+
     /// Run this pass, updating \p proc
     /// \returns true iff any change
     virtual bool execute(UserProc *proc) = 0;
@@ -10,7 +10,10 @@
 #include "PassManager.h"
 
 #include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/BasicBlock.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/ProcCFG.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/passes/call/CallArgumentUpdatePass.h"
 #include "boomerang/passes/call/CallDefineUpdatePass.h"
@@ -38,10 +41,12 @@
 #include "boomerang/passes/middle/PreservationAnalysisPass.h"
 #include "boomerang/passes/middle/SPPreservationPass.h"
 #include "boomerang/passes/middle/StrengthReductionReversalPass.h"
+#include "boomerang/ssl/RTL.h"
 #include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 
 #include <cassert>
+#include <chrono>
 
 
 static PassManager g_passManager;
@@ -123,7 +128,39 @@ bool PassManager::executePass(IPass *pass, UserProc *proc)
     assert(pass != nullptr);
     LOG_VERBOSE("Executing pass '%1' for '%2'", pass->getName(), proc->getName());
 
-    const bool changed = pass->execute(proc);
+    bool changed = false;
+
+    if (!m_statistics) {
+        changed = pass->execute(proc);
+    }
+    else {
+        const std::size_t stmtsBefore = countStatements(proc);
+        const auto startTime          = std::chrono::steady_clock::now();
+
+        changed = pass->execute(proc);
+
+        const auto endTime = std::chrono::steady_clock::now();
+        const qint64 timeNs =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+
+        m_statistics->addInvocation(pass, proc->getName(), timeNs, changed, stmtsBefore,
+                                    countStatements(proc));
+    }
+
+    if (!pass->maintainsDefUseIndex()) {
+        // The pass might have changed statements of any procedure
+        // (or only of this one, if it is proc-local) without updating the def-use index
+        if (pass->isProcLocal()) {
+            proc->invalidateDefUseIndex();
+        }
+        else {
+            DefUseIndex::invalidateAll();
+        }
+    }
+    else if (proc->isDefUseIndexValid() &&
+             proc->getProg()->getProject()->getSettings()->verifyDefUses) {
+        proc->getDefUseIndex().verify(proc);
+    }
 
     QString msg = QString("after executing pass '%1'").arg(pass->getName());
     proc->debugPrintAll(qPrintable(msg));
@@ -153,6 +190,33 @@ bool PassManager::executePassGroup(const QString &name, UserProc *proc)
 }
 
 
+void PassManager::setCollectStatistics(bool collect)
+{
+    if (collect) {
+        m_statistics.reset(new PassStatistics);
+    }
+    else {
+        m_statistics.reset();
+    }
+}
+
+
+std::size_t PassManager::countStatements(const UserProc *proc)
+{
+    std::size_t numStmts = 0;
+
+    for (const BasicBlock *bb : *proc->getCFG()) {
+        if (bb->getRTLs()) {
+            for (const auto &rtl : *bb->getRTLs()) {
+                numStmts += rtl->size();
+            }
+        }
+    }
+
+    return numStmts;
+}
+
+
 void PassManager::registerPass(PassID passID, std::unique_ptr<IPass> pass)
 {
     assert(Util::inRange(static_cast<size_t>(passID), static_cast<size_t>(0), m_passes.size()));
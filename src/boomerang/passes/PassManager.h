@@ -13,6 +13,7 @@
 #include "boomerang/core/BoomerangAPI.h"
 #include "boomerang/passes/Pass.h"
 #include "boomerang/passes/PassGroup.h"
+#include "boomerang/passes/PassStatistics.h"
 
 #include <QMap>
 
@@ -53,10 +54,21 @@ public:
     /// \returns true iff at least 1 pass updated \p proc
     bool executePassGroup(const QString &name, UserProc *proc);
 
+    /// Enable or disable collecting timing and change statistics of pass executions.
+    /// Enabling discards previously collected statistics.
+    void setCollectStatistics(bool collect);
+
+    /// \returns the collected statistics, or nullptr if statistics are not collected.
+    PassStatistics *getStatistics() { return m_statistics.get(); }
+
 private:
     void registerPass(PassID passType, std::unique_ptr<IPass> pass);
 
+    /// \returns the number of statements in the CFG of \p proc.
+    static std::size_t countStatements(const UserProc *proc);
+
 private:
     std::vector<std::unique_ptr<IPass>> m_passes;
     QMap<QString, PassGroup> m_passGroups;
+    std::unique_ptr<PassStatistics> m_statistics;
 };
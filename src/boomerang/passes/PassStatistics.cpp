@@ -0,0 +1,214 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "PassStatistics.h"
+
+#include "boomerang/util/OStream.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QSaveFile>
+
+
+void PassStats::add(const PassStats &other)
+{
+    numInvocations += other.numInvocations;
+    numChanged += other.numChanged;
+    timeNs += other.timeNs;
+    stmtsBefore += other.stmtsBefore;
+    stmtsAfter += other.stmtsAfter;
+}
+
+
+/// Quote \p str as a JSON string
+static QString jsonString(const QString &str)
+{
+    QString result = "\"";
+
+    for (const QChar c : str) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        }
+        else if (c.unicode() < 0x20) {
+            result += QString("\\u%1").arg(c.unicode(), 4, 16, QChar('0'));
+        }
+        else {
+            result += c;
+        }
+    }
+
+    return result + "\"";
+}
+
+
+/// Quote \p str as a CSV field
+static QString csvString(const QString &str)
+{
+    QString result = str;
+    result.replace("\"", "\"\"");
+    return "\"" + result + "\"";
+}
+
+
+static QString jsonStats(const QString &passName, const PassStats &stats)
+{
+    return QString("{ \"pass\": %1, \"invocations\": %2, \"changed\": %3, \"timeMs\": %4, "
+                   "\"stmtsBefore\": %5, \"stmtsAfter\": %6 }")
+        .arg(jsonString(passName))
+        .arg(stats.numInvocations)
+        .arg(stats.numChanged)
+        .arg(stats.timeNs / 1e6, 0, 'f', 3)
+        .arg(stats.stmtsBefore)
+        .arg(stats.stmtsAfter);
+}
+
+
+static QString csvStats(const QString &procName, const QString &passName, const PassStats &stats)
+{
+    return QString("%1,%2,%3,%4,%5,%6,%7\n")
+        .arg(csvString(procName))
+        .arg(csvString(passName))
+        .arg(stats.numInvocations)
+        .arg(stats.numChanged)
+        .arg(stats.timeNs / 1e6, 0, 'f', 3)
+        .arg(stats.stmtsBefore)
+        .arg(stats.stmtsAfter);
+}
+
+
+void PassStatistics::addInvocation(const IPass *pass, const QString &procName, qint64 timeNs,
+                                   bool changed, std::size_t stmtsBefore, std::size_t stmtsAfter)
+{
+    PassStats stats;
+    stats.numInvocations = 1;
+    stats.numChanged     = changed ? 1 : 0;
+    stats.timeNs         = timeNs;
+    stats.stmtsBefore    = stmtsBefore;
+    stats.stmtsAfter     = stmtsAfter;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_passNames[pass->getType()] = pass->getName();
+    m_passStats[pass->getType()].add(stats);
+    m_procStats[procName][pass->getType()].add(stats);
+}
+
+
+PassStats PassStatistics::getPassStats(PassID passID) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_passStats.find(passID);
+    return it != m_passStats.end() ? it->second : PassStats();
+}
+
+
+PassStats PassStatistics::getPassStats(PassID passID, const QString &procName) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto procIt = m_procStats.find(procName);
+    if (procIt == m_procStats.end()) {
+        return PassStats();
+    }
+
+    auto it = procIt->second.find(passID);
+    return it != procIt->second.end() ? it->second : PassStats();
+}
+
+
+void PassStatistics::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_passNames.clear();
+    m_passStats.clear();
+    m_procStats.clear();
+}
+
+
+bool PassStatistics::writeToFile(const QString &filePath) const
+{
+    QSaveFile file(filePath);
+    if (!file.open(QFile::WriteOnly | QFile::Text)) {
+        LOG_ERROR("Cannot open '%1' for writing pass statistics", filePath);
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        OStream os(&file);
+
+        if (filePath.endsWith(".csv", Qt::CaseInsensitive)) {
+            writeCSV(os);
+        }
+        else {
+            writeJSON(os);
+        }
+    }
+
+    if (!file.commit()) {
+        LOG_ERROR("Writing pass statistics to '%1' failed", filePath);
+        return false;
+    }
+
+    return true;
+}
+
+
+void PassStatistics::writeJSON(OStream &os) const
+{
+    os << "{\n";
+    os << "  \"passes\": [";
+
+    bool first = true;
+    for (const auto &[passID, stats] : m_passStats) {
+        os << (first ? "\n" : ",\n") << "    " << jsonStats(m_passNames.at(passID), stats);
+        first = false;
+    }
+
+    os << "\n  ],\n";
+    os << "  \"procedures\": [";
+
+    first = true;
+    for (const auto &[procName, passStats] : m_procStats) {
+        os << (first ? "\n" : ",\n");
+        os << "    { \"name\": " << jsonString(procName) << ", \"passes\": [";
+
+        bool firstPass = true;
+        for (const auto &[passID, stats] : passStats) {
+            os << (firstPass ? "\n" : ",\n");
+            os << "      " << jsonStats(m_passNames.at(passID), stats);
+            firstPass = false;
+        }
+
+        os << "\n    ] }";
+        first = false;
+    }
+
+    os << "\n  ]\n";
+    os << "}\n";
+}
+
+
+void PassStatistics::writeCSV(OStream &os) const
+{
+    os << "procedure,pass,invocations,changed,timeMs,stmtsBefore,stmtsAfter\n";
+
+    // Totals over all procedures have an empty procedure name
+    for (const auto &[passID, stats] : m_passStats) {
+        os << csvStats("", m_passNames.at(passID), stats);
+    }
+
+    for (const auto &[procName, passStats] : m_procStats) {
+        for (const auto &[passID, stats] : passStats) {
+            os << csvStats(procName, m_passNames.at(passID), stats);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/passes/Pass.h"
+
+#include <QString>
+
+#include <map>
+#include <mutex>
+
+
+class OStream;
+
+
+/// Statistics about the executions of a single pass.
+struct BOOMERANG_API PassStats
+{
+    quint64 numInvocations = 0;
+    quint64 numChanged     = 0; ///< Number of invocations that changed the procedure
+    qint64 timeNs          = 0; ///< Total wall time of all invocations in nanoseconds
+    quint64 stmtsBefore    = 0; ///< Sum of the statement counts before each invocation
+    quint64 stmtsAfter     = 0; ///< Sum of the statement counts after each invocation
+
+    void add(const PassStats &other);
+};
+
+
+/**
+ * Collects timing and change statistics of pass executions, per pass and per procedure.
+ * Statistics are collected by PassManager when enabled (see \ref Settings::passStatsFile).
+ * Thread safe.
+ */
+class BOOMERANG_API PassStatistics
+{
+public:
+    /// Record a single execution of \p pass on the procedure named \p procName.
+    void addInvocation(const IPass *pass, const QString &procName, qint64 timeNs, bool changed,
+                       std::size_t stmtsBefore, std::size_t stmtsAfter);
+
+    /// \returns the statistics of \p passID, aggregated over all procedures.
+    PassStats getPassStats(PassID passID) const;
+
+    /// \returns the statistics of \p passID for the procedure named \p procName.
+    PassStats getPassStats(PassID passID, const QString &procName) const;
+
+    void clear();
+
+    /**
+     * Write the statistics to the file at \p filePath.
+     * The file is written as CSV if the file name ends with ".csv", and as JSON otherwise.
+     * \returns true on success.
+     */
+    bool writeToFile(const QString &filePath) const;
+
+private:
+    void writeJSON(OStream &os) const;
+    void writeCSV(OStream &os) const;
+
+private:
+    mutable std::mutex m_mutex;
+    std::map<PassID, QString> m_passNames;
+    std::map<PassID, PassStats> m_passStats;
+    std::map<QString, std::map<PassID, PassStats>> m_procStats;
+};
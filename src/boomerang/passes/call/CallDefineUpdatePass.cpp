@@ -29,6 +29,7 @@ CallDefineUpdatePass::CallDefineUpdatePass()
 
 bool CallDefineUpdatePass::execute(UserProc *proc)
 {
+    // The defines of a call are not uses, so the def-use index does not change here
     StatementList stmts;
     proc->getStatements(stmts);
 
@@ -24,6 +24,9 @@ public:
     CallDefineUpdatePass();
 
 public:
+    /// \copydoc IPass::maintainsDefUseIndex
+    bool maintainsDefUseIndex() const override { return true; }
+
     /// \copydoc IPass::execute
     bool execute(UserProc *proc) override;
 
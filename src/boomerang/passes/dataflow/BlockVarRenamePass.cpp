@@ -11,7 +11,10 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/db/DataFlow.h"
+#include "boomerang/db/DefUseIndex.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/ProcCFG.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/ssl/exp/Const.h"
 #include "boomerang/ssl/exp/Terminal.h"
@@ -22,6 +25,9 @@
 #include "boomerang/visitor/expmodifier/ExpSubscripter.h"
 #include "boomerang/visitor/stmtmodifier/StmtSubscripter.h"
 
+#include <unordered_map>
+#include <vector>
+
 
 BlockVarRenamePass::BlockVarRenamePass()
     : IPass("BlockVarRename", PassID::BlockVarRename)
@@ -29,29 +35,81 @@ BlockVarRenamePass::BlockVarRenamePass()
 }
 
 
-static SharedExp defineAll = Terminal::get(opDefineAll); // An expression representing <all>
+struct BlockVarRenamePass::RenameState
+{
+    RenameState(UserProc *_proc)
+        : proc(_proc)
+        , assumeABICompliance(_proc->getProg()->getProject()->getSettings()->assumeABI)
+    {
+    }
 
-// There is an entry in stacks[defineAll] that represents the latest definition
-// from a define-all source. It is needed for variables that don't have a definition as yet
-// (i.e. stacks[x].empty() is true). As soon as a real definition to x appears,
-// stacks[defineAll] does not apply for variable x. This is needed to get correct
-// operation of the use collectors in calls.
+    /// \returns the ID of \p loc, or -1 if \p loc was never defined.
+    int findLocation(const SharedConstExp &loc) const
+    {
+        auto it = locationIDs.find(loc);
+        return it != locationIDs.end() ? it->second : -1;
+    }
 
-// Care with the Stacks object (a map from expression to stack);
-// using Stacks[q].empty() can needlessly insert an empty stack
-#define STACKS_EMPTY(q) (stacks.find(q) == stacks.end() || stacks[q].empty())
+    /// \returns the ID of \p loc. Creates a new ID with an empty stack if \p loc was never defined.
+    int getOrCreateLocation(const SharedConstExp &loc)
+    {
+        auto it = locationIDs.find(loc);
+        if (it != locationIDs.end()) {
+            return it->second;
+        }
 
+        // Note: we clone loc because otherwise it could be an expression
+        // that gets deleted or changed through various modifications.
+        const int id = static_cast<int>(locations.size());
+        locations.push_back(loc->clone());
+        defStacks.emplace_back();
+        locationIDs.insert({ locations.back(), id });
 
-// Subscript dataflow variables
-bool BlockVarRenamePass::renameBlockVars(
-    UserProc *proc, int n, std::map<SharedExp, std::deque<Statement *>, lessExpStar> &stacks)
-{
-    if (proc->getCFG()->getNumBBs() == 0) {
-        return false;
+        return id;
     }
 
-    bool changed                   = false;
-    const bool assumeABICompliance = proc->getProg()->getProject()->getSettings()->assumeABI;
+    /// \returns the latest definition of the location with ID \p id,
+    /// or nullptr if it is not defined at this point.
+    Statement *getLatestDef(int id) const
+    {
+        return (id != -1 && !defStacks[id].empty()) ? defStacks[id].back() : nullptr;
+    }
+
+    /// \returns all locations that are defined at this point together with their latest definition
+    std::vector<std::pair<SharedExp, Statement *>> getReachingDefs() const
+    {
+        std::vector<std::pair<SharedExp, Statement *>> reachingDefs;
+
+        for (std::size_t id = 0; id < defStacks.size(); ++id) {
+            if (!defStacks[id].empty()) {
+                reachingDefs.push_back({ locations[id], defStacks[id].back() });
+            }
+        }
+
+        return reachingDefs;
+    }
+
+    UserProc *proc;
+    const bool assumeABICompliance;
+
+    std::unordered_map<SharedConstExp, int, hashExpStar, equalExpStar> locationIDs;
+    std::vector<SharedExp> locations;                ///< Location of each ID
+    std::vector<std::vector<Statement *>> defStacks; ///< Definitions of each location, latest last
+
+    /// ID of the location representing <all>, or -1 if there was no define-all yet.
+    /// The stack of this location contains the latest definition from a define-all source.
+    /// It is needed for variables that don't have a definition as yet (i.e. their stack is empty).
+    /// As soon as a real definition to x appears, the define-all stack does not apply for
+    /// variable x. This is needed to get correct operation of the use collectors in calls.
+    int defineAllID = -1;
+};
+
+
+// Subscript dataflow variables
+bool BlockVarRenamePass::renameBlockVars(RenameState &state, int n)
+{
+    UserProc *proc = state.proc;
+    bool changed   = false;
 
     // For each statement S in block n
     BasicBlock::RTLIterator rit;
@@ -59,6 +117,8 @@ bool BlockVarRenamePass::renameBlockVars(
     BasicBlock *bb = proc->getDataFlow()->nodeToBB(n);
 
     for (Statement *S = bb->getFirstStmt(rit, sit); S; S = bb->getNextStmt(rit, sit)) {
+        bool stmtChanged = false;
+
         {
             // For each use of some variable x in S (not just assignments)
             LocationSet locs;
@@ -115,31 +175,29 @@ bool BlockVarRenamePass::renameBlockVars(
                     continue; // Don't re-rename the renamed variable
                 }
 
-                if (!STACKS_EMPTY(location)) {
-                    def = stacks[location].back();
-                }
-                else if (!STACKS_EMPTY(defineAll)) {
-                    def = stacks[defineAll].back();
+                def = state.getLatestDef(state.findLocation(location));
+
+                if (!def) {
+                    def = state.getLatestDef(state.defineAllID);
                 }
-                else {
+
+                if (!def) {
                     // If the both stacks are empty, use a nullptr definition. This will be changed
                     // into a pointer to an implicit definition at the start of type analysis, but
                     // not until all the m[...] have stopped changing their expressions (complicates
                     // implicit assignments considerably).
-                    def = nullptr;
                     // Update the collector at the start of the UserProc
                     proc->markAsInitialParam(location->clone());
                 }
-
-
-                if (def && def->isCall()) {
+                else if (def->isCall()) {
                     // Calls have UseCollectors for locations that are used before definition
                     // at the call
                     static_cast<CallStatement *>(def)->useBeforeDefine(location->clone());
                 }
 
                 // Replace the use of x with x{def} in S
-                changed = true;
+                changed     = true;
+                stmtChanged = true;
 
                 if (S->isPhi()) {
                     SharedExp phiLeft = static_cast<PhiAssign *>(S)->getLeft();
@@ -164,12 +222,17 @@ bool BlockVarRenamePass::renameBlockVars(
                 col = static_cast<ReturnStatement *>(S)->getCollector();
             }
 
-            col->updateDefs(stacks, proc);
+            // The collector is part of the uses of S
+            stmtChanged |= col->updateDefs(state.getReachingDefs(), proc);
+        }
+
+        if (stmtChanged && proc->isDefUseIndexValid()) {
+            proc->getDefUseIndex().updateStatement(S);
         }
 
         // For each definition of some variable a in S
         LocationSet defs;
-        S->getDefinitions(defs, assumeABICompliance);
+        S->getDefinitions(defs, state.assumeABICompliance);
 
         for (SharedExp a : defs) {
             // Don't consider a if it cannot be renamed
@@ -177,16 +240,8 @@ bool BlockVarRenamePass::renameBlockVars(
 
             if (suitable) {
                 // Push i onto Stacks[a]
-                // Note: we clone a because otherwise it could be an expression
-                // that gets deleted through various modifications.
-                // This is necessary because we do several passes of this algorithm
-                // to sort out the memory expressions.
-                if (stacks.find(a) != stacks.end()) { // expression exists, no need for clone ?
-                    stacks[a].push_back(S);
-                }
-                else {
-                    stacks[a->clone()].push_back(S);
-                }
+                const int id = state.getOrCreateLocation(a);
+                state.defStacks[id].push_back(S);
 
                 // Replace definition of 'a' with definition of a_i in S (we don't do this)
             }
@@ -198,7 +253,8 @@ bool BlockVarRenamePass::renameBlockVars(
 
                 // Stacks already has a definition for a (as just the bare local)
                 if (suitable) {
-                    stacks[a1->clone()].push_back(S);
+                    const int id = state.getOrCreateLocation(a1);
+                    state.defStacks[id].push_back(S);
                 }
             }
         }
@@ -206,13 +262,14 @@ bool BlockVarRenamePass::renameBlockVars(
         // Special processing for define-alls (presently, only childless calls).
         // But note that only 'everythings' at the current memory level are defined!
         if (S->isCall() && static_cast<const CallStatement *>(S)->isChildless() &&
-            !proc->getProg()->getProject()->getSettings()->assumeABI) {
+            !state.assumeABICompliance) {
             // S is a childless call (and we're not assuming ABI compliance)
-            stacks[defineAll]; // Ensure that there is an entry for defineAll
+            if (state.defineAllID == -1) {
+                state.defineAllID = state.getOrCreateLocation(Terminal::get(opDefineAll));
+            }
 
-            for (auto &elem : stacks) {
-                // if (dd->first->isMemDepth(memDepth))
-                elem.second.push_back(S); // Add a definition for all vars
+            for (std::vector<Statement *> &stack : state.defStacks) {
+                stack.push_back(S); // Add a definition for all vars
             }
         }
     }
@@ -236,73 +293,96 @@ bool BlockVarRenamePass::renameBlockVars(
                 continue;
             }
 
-            Statement *def = nullptr; // assume No reaching definition
-
-            if (!STACKS_EMPTY(a)) {
-                def = stacks[a].back();
-            }
-
             // "Replace jth operand with a_i"
-            pa->putAt(bb, def, a);
+            // If there is no reaching definition, use nullptr
+            pa->putAt(bb, state.getLatestDef(state.findLocation(a)), a);
         }
     }
 
-    // For each child X of n
-    // Note: linear search!
-    const int numBB = proc->getCFG()->getNumBBs();
+    return changed;
+}
 
-    for (int X = 0; X < numBB; X++) {
-        const int idom = proc->getDataFlow()->getIdom(X);
-        if (idom == n && X != n) { // if 'n' is immediate dominator of X
-            renameBlockVars(proc, X, stacks);
-        }
-    }
 
+void BlockVarRenamePass::popBlockDefs(RenameState &state, int n)
+{
     // For each statement S in block n
     // NOTE: Because of the need to pop childless calls from the Stacks, it is important in my
     // algorithm to process the statments in the BB *backwards*. (It is not important in Appel's
     // algorithm, since he always pushes a definition for every variable defined on the Stacks).
     BasicBlock::RTLRIterator rrit;
     StatementList::reverse_iterator srit;
+    BasicBlock *bb = state.proc->getDataFlow()->nodeToBB(n);
 
     for (Statement *S = bb->getLastStmt(rrit, srit); S; S = bb->getPrevStmt(rrit, srit)) {
         // For each definition of some variable a in S
         LocationSet defs;
-        S->getDefinitions(defs, assumeABICompliance);
+        S->getDefinitions(defs, state.assumeABICompliance);
 
         for (const auto &def : defs) {
-            if (!proc->canRename(def)) {
+            if (!state.proc->canRename(def)) {
                 continue;
             }
 
-            auto stackIt = stacks.find(def);
-
-            if (stackIt == stacks.end()) {
+            const int id = state.findLocation(def);
+            if (id == -1) {
                 LOG_FATAL("Tried to pop '%1' from Stacks; does not exist", def);
             }
 
-            stackIt->second.pop_back();
+            state.defStacks[id].pop_back();
         }
 
         // Pop all defs due to childless calls
         if (S->isCall() && static_cast<const CallStatement *>(S)->isChildless()) {
-            for (auto &stack : stacks) {
-                if (!stack.second.empty() && (stack.second.back() == S)) {
-                    stack.second.pop_back();
+            for (std::vector<Statement *> &stack : state.defStacks) {
+                if (!stack.empty() && (stack.back() == S)) {
+                    stack.pop_back();
                 }
             }
         }
     }
-
-    return changed;
 }
 
 
 bool BlockVarRenamePass::execute(UserProc *proc)
 {
-    /// The stack which remembers the last definition of an expression.
-    std::map<SharedExp, std::deque<Statement *>, lessExpStar> stacks;
-    return renameBlockVars(proc, 0, stacks);
+    const int numBB = proc->getCFG()->getNumBBs();
+    if (numBB == 0) {
+        return false;
+    }
+
+    const DataFlow *df = proc->getDataFlow();
+
+    // Children of each BB in the dominator tree
+    std::vector<std::vector<int>> children(numBB);
+    for (int X = 0; X < numBB; X++) {
+        const int idom = df->getIdom(X);
+        if (idom != -1 && idom != X) {
+            children[idom].push_back(X);
+        }
+    }
+
+    RenameState state(proc);
+    bool changed = renameBlockVars(state, 0);
+
+    // Walk the dominator tree in depth first order without recursion, so that very deep
+    // dominator trees cannot overflow the stack. Each stack entry is a BB and its next child.
+    std::vector<std::pair<int, std::size_t>> stack = { { 0, 0 } };
+
+    while (!stack.empty()) {
+        const int n = stack.back().first;
+
+        if (stack.back().second < children[n].size()) {
+            const int X = children[n][stack.back().second++];
+            changed |= renameBlockVars(state, X);
+            stack.push_back({ X, 0 });
+        }
+        else {
+            popBlockDefs(state, n);
+            stack.pop_back();
+        }
+    }
+
+    return changed;
 }
 
 
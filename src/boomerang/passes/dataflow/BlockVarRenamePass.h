@@ -13,9 +13,6 @@
 #include "boomerang/passes/Pass.h"
 #include "boomerang/ssl/exp/ExpHelp.h"
 
-#include <deque>
-#include <map>
-
 
 class Statement;
 
@@ -27,12 +24,21 @@ public:
     BlockVarRenamePass();
 
 public:
+    /// \copydoc IPass::maintainsDefUseIndex
+    bool maintainsDefUseIndex() const override { return true; }
+
     /// \copydoc IPass::execute
     bool execute(UserProc *proc) override;
 
 private:
-    bool renameBlockVars(UserProc *proc, int n,
-                         std::map<SharedExp, std::deque<Statement *>, lessExpStar> &stacks);
+    /// Definition stacks and other state of a single execution of this pass
+    struct RenameState;
+
+    /// Subscript the uses in the BB with index \p n and push its definitions.
+    bool renameBlockVars(RenameState &state, int n);
+
+    /// Pop the definitions of the BB with index \p n after all BBs dominated by it are renamed.
+    void popBlockDefs(RenameState &state, int n);
 
     /// For all expressions in \p stmt, replace \p var with var{varDef}
     void subscriptVar(Statement *stmt, SharedExp var, Statement *varDef);
@@ -19,6 +19,9 @@ public:
     PhiPlacementPass();
 
 public:
+    /// \copydoc IPass::maintainsDefUseIndex
+    bool maintainsDefUseIndex() const override { return true; }
+
     /// \copydoc IPass::execute
     bool execute(UserProc *proc) override;
 };
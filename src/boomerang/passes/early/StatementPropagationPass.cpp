@@ -10,14 +10,22 @@
 #include "StatementPropagationPass.h"
 
 #include "boomerang/core/Project.h"
+#include "boomerang/db/DefUseIndex.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/passes/PassManager.h"
 #include "boomerang/ssl/exp/Location.h"
 #include "boomerang/ssl/statements/PhiAssign.h"
+#include "boomerang/util/HashedLocationSet.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expvisitor/ExpDestCounter.h"
-#include "boomerang/visitor/stmtexpvisitor/StmtDestCounter.h"
+
+#include <deque>
+#include <unordered_set>
+
+
+/// Maximum number of times a statement is visited again after one of its definitions changed
+static const int MAX_REVISITS = 10;
 
 
 StatementPropagationPass::StatementPropagationPass()
@@ -28,50 +36,107 @@ StatementPropagationPass::StatementPropagationPass()
 
 bool StatementPropagationPass::execute(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
+    // Only statements that changed since the last execution (and their users) can propagate
+    // anything new; all other statements were propagated as far as possible already.
+    DefUseIndex &defUses = proc->getDefUseIndex();
+    std::deque<Statement *> workList;
+    std::unordered_map<const Statement *, int> numVisits;
+    std::unordered_set<const Statement *> inWorkList;
+
+    auto enqueue = [&](Statement *stmt) {
+        if (stmt->isPhi()) {
+            return;
+        }
 
-    // Find the locations that are used by a live, dominating phi-function
-    LocationSet usedByDomPhi;
-    findLiveAtDomPhi(proc, usedByDomPhi);
+        // Guard against endless propagation cycles
+        int &visits = numVisits[stmt];
+        if (visits <= MAX_REVISITS && inWorkList.insert(stmt).second) {
+            visits++;
+            workList.push_back(stmt);
+        }
+    };
 
-    // Next pass: count the number of times each assignment LHS would be propagated somewhere
-    std::map<SharedExp, int, lessExpStar> destCounts;
+    auto enqueueUsers = [&](const Statement *def) {
+        for (Statement *user : defUses.getUsers(def)) {
+            if (user != def) {
+                enqueue(user);
+            }
+        }
+    };
+
+    const std::vector<Statement *> changedStmts = defUses.getChangedStatements();
+    for (Statement *s : changedStmts) {
+        enqueue(s);
+    }
 
-    // Also maintain a set of locations which are used by phi statements
-    for (Statement *s : stmts) {
-        ExpDestCounter edc(destCounts);
-        StmtDestCounter sdc(&edc);
-        s->accept(&sdc);
+    for (Statement *s : changedStmts) {
+        enqueueUsers(s);
     }
 
-    // A fourth pass to propagate only the flags (these must be propagated even if it results in
-    // extra locals)
     bool change = false;
 
-    Settings *settings = proc->getProg()->getProject()->getSettings();
-    for (Statement *s : stmts) {
-        if (!s->isPhi()) {
-            change |= s->propagateFlagsTo(settings);
+    if (!workList.empty()) {
+        // Find the locations that are used by a live, dominating phi-function
+        HashedLocationSet usedByDomPhi;
+        findLiveAtDomPhi(proc, usedByDomPhi);
+
+        // Propagate only the flags first (these must be propagated even if it results in
+        // extra locals)
+        Settings *settings = proc->getProg()->getProject()->getSettings();
+        for (std::size_t i = 0; i < workList.size(); ++i) {
+            if (workList[i]->propagateFlagsTo(settings)) {
+                defUses.updateStatement(workList[i]);
+                enqueueUsers(workList[i]);
+                change = true;
+            }
         }
-    }
 
-    // Finally the actual propagation
-    for (Statement *s : stmts) {
-        if (!s->isPhi()) {
-            change |= s->propagateTo(settings, &destCounts, &usedByDomPhi);
+        // Finally the actual propagation. A statement can only propagate more into its users
+        // if it changed itself, so only the users of changed statements are visited again.
+        while (!workList.empty()) {
+            Statement *s = workList.front();
+            workList.pop_front();
+            inWorkList.erase(s);
+
+            const ExpDestCounter::ExpCountMap oldDests = defUses.getDestCounts(s);
+
+            if (!s->propagateTo(settings, &defUses.getDestCounts(), &usedByDomPhi)) {
+                continue;
+            }
+
+            change = true;
+            defUses.updateStatement(s); // s uses different locations and definitions now
+            enqueueUsers(s);
+
+            const ExpDestCounter::ExpCountMap &newDests = defUses.getDestCounts(s);
+            for (const auto &[loc, count] : oldDests) {
+                auto newIt = newDests.find(loc);
+                if (newIt != newDests.end() && newIt->second >= count) {
+                    continue;
+                }
+
+                auto totalIt = defUses.getDestCounts().find(loc);
+                if (totalIt != defUses.getDestCounts().end() && totalIt->second == 1) {
+                    // The definition of loc can now be propagated into its last user
+                    // regardless of its complexity (see Statement::propagateTo)
+                    enqueueUsers(loc->access<RefExp>()->getDef());
+                }
+            }
         }
     }
 
+    // The changes made by this pass were propagated already
+    defUses.clearChangedStatements();
+
     propagateToCollector(&proc->getUseCollector());
 
     return change;
 }
 
 
-void StatementPropagationPass::findLiveAtDomPhi(UserProc *proc, LocationSet &usedByDomPhi)
+void StatementPropagationPass::findLiveAtDomPhi(UserProc *proc, HashedLocationSet &usedByDomPhi)
 {
-    LocationSet usedByDomPhi0;
+    HashedLocationSet usedByDomPhi0;
     std::map<SharedExp, PhiAssign *, lessExpStar> defdByPhi;
 
     proc->getDataFlow()->findLiveAtDomPhi(usedByDomPhi, usedByDomPhi0, defdByPhi);
@@ -13,22 +13,31 @@
 #include "boomerang/passes/Pass.h"
 
 
-class LocationSet;
+class HashedLocationSet;
 class UseCollector;
 
 
+/**
+ * Propagates the right hand sides of assignments into the statements using them.
+ *
+ * All statements are visited once. Afterwards, only the users of statements that changed
+ * are visited again, until no statement changes any more.
+ */
 class StatementPropagationPass final : public IPass
 {
 public:
     StatementPropagationPass();
 
 public:
+    /// \copydoc IPass::maintainsDefUseIndex
+    bool maintainsDefUseIndex() const override { return true; }
+
     /// \copydoc IPass::execute
     bool execute(UserProc *proc) override;
 
 private:
     /// Find the locations that are used by a live, dominating phi-function
-    void findLiveAtDomPhi(UserProc *proc, LocationSet &usedByDomPhi);
+    void findLiveAtDomPhi(UserProc *proc, HashedLocationSet &usedByDomPhi);
 
     /// Propagate into xxx of m[xxx] in the UseCollector (locations live at the entry of \p proc)
     void propagateToCollector(UseCollector *collector);
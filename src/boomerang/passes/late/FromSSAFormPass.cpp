@@ -269,8 +269,6 @@ bool FromSSAFormPass::execute(UserProc *proc)
             continue;
         }
 
-        LocationSet refs;
-        phi->addUsedLocs(refs);
         bool phiParamsSame = true;
         SharedExp first    = nullptr;
 
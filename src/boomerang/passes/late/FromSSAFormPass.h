@@ -17,7 +17,13 @@ class ConnectionGraph;
 class Statement;
 
 
-/// Transforms the statements a proc out of SSA form
+/**
+ * Transforms the statements a proc out of SSA form
+ *
+ * This pass is not proc-local: It runs the LocalAndParamMap pass
+ * and creates named types for new locals, so it must not run in parallel
+ * for different procedures.
+ */
 class FromSSAFormPass final : public IPass
 {
 public:
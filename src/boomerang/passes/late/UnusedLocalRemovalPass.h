@@ -29,6 +29,9 @@ public:
     /// \copydoc IPass::execute
     bool execute(UserProc *proc) override;
 
+    /// \copydoc IPass::isProcLocal
+    bool isProcLocal() const override { return true; }
+
 private:
     /// Special version of Statement::addUsedLocs for finding used locations.
     /// \return true if defineAll was found
@@ -11,11 +11,11 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/db/DefUseIndex.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/passes/PassManager.h"
-#include "boomerang/ssl/exp/RefExp.h"
-#include "boomerang/util/StatementSet.h"
+#include "boomerang/util/StatementList.h"
 #include "boomerang/util/log/Log.h"
 
 
@@ -28,14 +28,13 @@ UnusedStatementRemovalPass::UnusedStatementRemovalPass()
 bool UnusedStatementRemovalPass::execute(UserProc *proc)
 {
     // Only remove unused statements after decompiling as much as possible of the proc
-    // Remove unused statements
-    RefCounter refCounts; // The map
-    // Count the references first
-    updateRefCounts(proc, refCounts);
+    if (proc->getProg()->getProject()->getSettings()->debugUnused) {
+        printRefCounts(proc);
+    }
 
     // Now remove any that have no used
     if (proc->getProg()->getProject()->getSettings()->removeNull) {
-        remUnusedStmtEtc(proc, refCounts);
+        remUnusedStmtEtc(proc);
         removeNullStatements(proc);
         proc->debugPrintAll("after removing unused and null statements pass 1");
     }
@@ -44,57 +43,25 @@ bool UnusedStatementRemovalPass::execute(UserProc *proc)
 }
 
 
-void UnusedStatementRemovalPass::updateRefCounts(UserProc *proc, RefCounter &refCounts)
+void UnusedStatementRemovalPass::printRefCounts(UserProc *proc)
 {
     StatementList stmts;
     proc->getStatements(stmts);
 
-    for (Statement *s : stmts) {
-        // Don't count uses in implicit statements. There is no RHS of course,
-        // but you can still have x from m[x] on the LHS and so on, but these are not real uses
-        if (s->isImplicit()) {
-            continue;
-        }
-
-        if (proc->getProg()->getProject()->getSettings()->debugUnused) {
-            LOG_MSG("Counting references in %1", s);
-        }
+    LOG_MSG("### Reference counts for %1:", proc->getName());
 
-        LocationSet refs;
-        s->addUsedLocs(refs, false); // Ignore uses in collectors
-
-        for (const SharedExp &rr : refs) {
-            if (rr->isSubscript()) {
-                Statement *def = rr->access<RefExp>()->getDef();
-
-                // Used to not count implicit refs here (def->getNumber() == 0), meaning that
-                // implicit definitions get removed as dead code! But these are the ideal place to
-                // read off final parameters, and it is guaranteed now that implicit statements are
-                // sorted out for us by now (for dfa type analysis)
-                if (def /* && def->getNumber() */) {
-                    refCounts[def]++;
-
-                    if (proc->getProg()->getProject()->getSettings()->debugUnused) {
-                        LOG_MSG("counted ref to %1", rr);
-                    }
-                }
-            }
+    for (const Statement *s : stmts) {
+        const int numUsers = proc->getDefUseIndex().getNumDirectUsers(s);
+        if (numUsers > 0) {
+            LOG_MSG("  %1: %2", s->getNumber(), numUsers);
         }
     }
 
-    if (proc->getProg()->getProject()->getSettings()->debugUnused) {
-        LOG_MSG("### Reference counts for %1:", proc->getName());
-
-        for (RefCounter::iterator rr = refCounts.begin(); rr != refCounts.end(); ++rr) {
-            LOG_MSG("  %1: %2", rr->first->getNumber(), rr->second);
-        }
-
-        LOG_MSG("### End reference counts");
-    }
+    LOG_MSG("### End reference counts");
 }
 
 
-void UnusedStatementRemovalPass::remUnusedStmtEtc(UserProc *proc, RefCounter &refCounts)
+void UnusedStatementRemovalPass::remUnusedStmtEtc(UserProc *proc)
 {
     StatementList stmts;
     proc->getStatements(stmts);
@@ -135,36 +102,10 @@ void UnusedStatementRemovalPass::remUnusedStmtEtc(UserProc *proc, RefCounter &re
                 continue;
             }
 
-            if ((refCounts.find(s) == refCounts.end()) ||
-                (refCounts[s] == 0)) { // Care not to insert unnecessarily
-                // First adjust the counts, due to statements only referenced by statements that are
-                // themselves unused. Need to be careful not to count two refs to the same def as
-                // two; refCounts is a count of the number of statements that use a definition, not
-                // the total number of refs
-                StatementSet stmtsRefdByUnused;
-                LocationSet components;
-                // Second parameter false to ignore uses in collectors
-                s->addUsedLocs(components, false);
-
-                for (const SharedExp &component : components) {
-                    if (component->isSubscript() && component->access<RefExp>()->getDef()) {
-                        stmtsRefdByUnused.insert(component->access<RefExp>()->getDef());
-                    }
-                }
-
-                for (Statement *refd : stmtsRefdByUnused) {
-                    if (refd == nullptr) {
-                        continue;
-                    }
-
-                    if (proc->getProg()->getProject()->getSettings()->debugUnused) {
-                        LOG_MSG("Decrementing ref count of %1 because %2 is unused",
-                                refd->getNumber(), s->getNumber());
-                    }
-
-                    refCounts[refd]--;
-                }
-
+            // Uses in collectors and implicit statements do not count (see DefUseIndex).
+            // Removing the statement updates the def-use index, so the statements
+            // only used by unused statements become unused themselves.
+            if (proc->getDefUseIndex().getNumDirectUsers(s) == 0) {
                 if (proc->getProg()->getProject()->getSettings()->debugUnused) {
                     LOG_MSG("Removing unused statement %1 %2", s->getNumber(), s);
                 }
@@ -12,30 +12,26 @@
 
 #include "boomerang/passes/Pass.h"
 
-#include <map>
-
-
-class Statement;
-
 
 /// Remove unused statements
 class UnusedStatementRemovalPass final : public IPass
 {
-    typedef std::map<Statement *, int> RefCounter;
-
 public:
     UnusedStatementRemovalPass();
 
 public:
+    /// \copydoc IPass::maintainsDefUseIndex
+    bool maintainsDefUseIndex() const override { return true; }
+
     /// \copydoc IPass::execute
     bool execute(UserProc *proc) override;
 
 private:
-    /// Count references to the things that are under SSA control.
-    /// For each SSA subscripting, increment a counter for that definition
-    void updateRefCounts(UserProc *proc, RefCounter &refCounts);
+    /// Print the number of references to each definition (see DefUseIndex::getNumDirectUsers)
+    void printRefCounts(UserProc *proc);
 
-    void remUnusedStmtEtc(UserProc *proc, RefCounter &refCounts);
+    /// Remove assignments whose definitions are not used (see DefUseIndex::getNumDirectUsers)
+    void remUnusedStmtEtc(UserProc *proc);
 
     /// Remove statements of the form x := x
     bool removeNullStatements(UserProc *proc);
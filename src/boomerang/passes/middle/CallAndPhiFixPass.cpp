@@ -58,6 +58,13 @@ bool CallAndPhiFixPass::execute(UserProc *proc)
     StatementList stmts;
     proc->getStatements(stmts);
 
+    // Keep the def-use index up to date if it is in use (see IPass::maintainsDefUseIndex).
+    auto updateDefUses = [proc](Statement *stmt) {
+        if (proc->isDefUseIndexValid()) {
+            proc->getDefUseIndex().updateStatement(stmt);
+        }
+    };
+
     // a[m[]] hack, aint nothing better.
     bool found = true;
 
@@ -85,6 +92,7 @@ bool CallAndPhiFixPass::execute(UserProc *proc)
                         (((e->access<RefExp, 1>())->getDef() == nullptr) ||
                          (e->access<RefExp, 1>())->getDef()->isImplicit())) {
                         a->setRight(Unary::get(opAddrOf, Location::memOf(e->clone())));
+                        updateDefUses(call);
                         found = true;
                     }
                 }
@@ -111,12 +119,16 @@ bool CallAndPhiFixPass::execute(UserProc *proc)
         std::shared_ptr<RefExp> refExp = RefExp::get(phi->getLeft(), phi);
 
         phi->removeAllReferences(refExp);
+        updateDefUses(phi);
     }
 
     // Second pass
     for (Statement *s : stmts) {
         if (!s->isPhi()) { // Ordinary statement
-            s->bypass();
+            if (s->bypass()) {
+                updateDefUses(s);
+            }
+
             continue;
         }
 
@@ -154,7 +166,7 @@ bool CallAndPhiFixPass::execute(UserProc *proc)
             // if first is of the form lhs{x}
             if (first->isSubscript() && (*first->getSubExp1() == *lhs)) {
                 // replace first with x
-                phi_inf.setDef(first->access<RefExp>()->getDef());
+                phi_inf.setDef(first->access<RefExp>()->getDef(), phi);
             }
         }
 
@@ -176,7 +188,7 @@ bool CallAndPhiFixPass::execute(UserProc *proc)
                 // if current is of the form lhs{x}
                 if (current->isSubscript() && (*current->getSubExp1() == *lhs)) {
                     // replace current with x
-                    phi_inf2.setDef(current->access<RefExp>()->getDef());
+                    phi_inf2.setDef(current->access<RefExp>()->getDef(), phi);
                 }
             }
 
@@ -217,6 +229,8 @@ bool CallAndPhiFixPass::execute(UserProc *proc)
             phi->convertToAssign(best);
             LOG_VERBOSE2("Redundant phi replaced with copy assign; now %1", phi);
         }
+
+        updateDefUses(s); // phi might have been converted to an assignment
     }
 
     // Also do xxx in m[xxx] in the use collector
@@ -11,6 +11,7 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/db/DefUseIndex.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/ssl/exp/Binary.h"
@@ -74,5 +75,9 @@ bool PreservationAnalysisPass::execute(UserProc *proc)
         proc->getRetStmt()->removeModified(lhs);
     }
 
+    if (proc->isDefUseIndexValid()) {
+        proc->getDefUseIndex().updateStatement(proc->getRetStmt());
+    }
+
     return true;
 }
@@ -11,6 +11,7 @@
 
 
 #include "boomerang/util/Address.h"
+#include "boomerang/util/MemoryArena.h"
 
 #include <list>
 #include <memory>
@@ -58,6 +59,15 @@ public:
     RTL &operator=(const RTL &other);
     RTL &operator=(RTL &&other) = default;
 
+public:
+    /// RTLs are allocated from the current memory arena, if there is one.
+    /// \sa MemoryArena
+    static void *operator new(std::size_t size) { return MemoryArena::allocateObject(size); }
+    static void operator delete(void *ptr, std::size_t size)
+    {
+        MemoryArena::deallocateObject(ptr, size);
+    }
+
 public:
     /// Return RTL's native address
     Address getAddress() const { return m_nativeAddr; }
@@ -12,13 +12,17 @@
 #include "boomerang/ssl/RTL.h"
 #include "boomerang/ssl/exp/Binary.h"
 #include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/ExpInterner.h"
 #include "boomerang/ssl/exp/Location.h"
 #include "boomerang/ssl/exp/Terminal.h"
 #include "boomerang/ssl/parser/SSL2ParserDriver.h"
 #include "boomerang/ssl/statements/Assign.h"
 #include "boomerang/ssl/type/FloatType.h"
 #include "boomerang/ssl/type/IntegerType.h"
+#include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
+#include "boomerang/visitor/expmodifier/ExpInternModifier.h"
+#include "boomerang/visitor/stmtmodifier/StmtModifier.h"
 
 
 RTLInstDict::RTLInstDict(bool verboseOutput)
@@ -66,6 +70,10 @@ bool RTLInstDict::readSSLFile(const QString &sslFileName)
         return false;
     }
 
+    buildTemplateTable();
+    internTemplates();
+    m_sslFileName = sslFileName;
+
     if (m_verboseOutput) {
         OStream q_cout(stdout);
         q_cout << "\n=======Expanded RTL template dictionary=======\n";
@@ -77,6 +85,36 @@ bool RTLInstDict::readSSLFile(const QString &sslFileName)
 }
 
 
+void RTLInstDict::buildTemplateTable()
+{
+    m_templates.clear();
+    m_templateIDs.clear();
+
+    for (auto &[key, entry] : m_instructions) {
+        m_templateIDs[key] = m_templates.size();
+        m_templates.push_back(&entry);
+    }
+}
+
+
+void RTLInstDict::internTemplates()
+{
+    ExpInterner interner;
+    ExpInternModifier internModifier(&interner);
+    StmtModifier stmtModifier(&internModifier);
+
+    for (TableEntry *entry : m_templates) {
+        for (Statement *stmt : entry->m_rtl) {
+            stmt->accept(&stmtModifier);
+        }
+    }
+
+    // Each hit is a duplicate sub-expression that was replaced by a shared node
+    LOG_VERBOSE("Instruction templates share %1 expression nodes, %2 duplicate nodes removed",
+                interner.getNumNodes(), interner.getNumHits());
+}
+
+
 void RTLInstDict::print(OStream &os /*= std::cout*/)
 {
     for (auto &elem : m_instructions) {
@@ -104,18 +142,36 @@ void RTLInstDict::print(OStream &os /*= std::cout*/)
 std::unique_ptr<RTL> RTLInstDict::instantiateRTL(const QString &name, Address natPC,
                                                  const std::vector<SharedExp> &args)
 {
-    // TODO try to retrieve fast instruction mappings
-    // before trying the verbose instructions
-    auto dict_entry = m_instructions.find({ name, args.size() });
-    if (dict_entry == m_instructions.end()) {
+    const int templateID = getTemplateID(name, args.size());
+    if (templateID == INVALID_TEMPLATE) {
         LOG_ERROR("Cannot instatiate instruction '%1' at address %2: "
                   "No instruction template takes %3 arguments",
                   name, natPC, args.size());
         return nullptr; // instruction not found
     }
 
-    TableEntry &entry(dict_entry->second);
-    return instantiateRTL(entry.m_rtl, natPC, entry.m_params, args);
+    return instantiateRTL(templateID, natPC, args);
+}
+
+
+int RTLInstDict::getTemplateID(const QString &name, int numParams) const
+{
+    auto it = m_templateIDs.find({ name, numParams });
+    return it != m_templateIDs.end() ? it->second : INVALID_TEMPLATE;
+}
+
+
+std::unique_ptr<RTL> RTLInstDict::instantiateRTL(int templateID, Address natPC,
+                                                 const std::vector<SharedExp> &args)
+{
+    if (!Util::inRange(templateID, 0, static_cast<int>(m_templates.size()))) {
+        LOG_ERROR("Cannot instatiate instruction at address %1: Invalid template ID %2", natPC,
+                  templateID);
+        return nullptr;
+    }
+
+    const TableEntry *entry = m_templates[templateID];
+    return instantiateRTL(entry->m_rtl, natPC, entry->m_params, args);
 }
 
 
@@ -176,6 +232,9 @@ void RTLInstDict::reset()
     m_definedParams.clear();
     m_flagFuncs.clear();
     m_instructions.clear();
+    m_templates.clear();
+    m_templateIDs.clear();
+    m_sslFileName.clear();
 }
 
 
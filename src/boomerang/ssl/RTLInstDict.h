@@ -41,6 +41,10 @@ class BOOMERANG_API RTLInstDict
     friend class SSL2ParserDriver;
     friend class SSL2::parser;
 
+public:
+    /// ID of a non-existing instruction template
+    static constexpr int INVALID_TEMPLATE = -1;
+
 public:
     RTLInstDict(bool verboseOutput = false);
     RTLInstDict(const RTLInstDict &) = delete;
@@ -71,9 +75,34 @@ public:
     std::unique_ptr<RTL> instantiateRTL(const QString &name, Address pc,
                                         const std::vector<SharedExp> &args);
 
+    /**
+     * Look up an instruction template. Template IDs are dense (0 to number of templates - 1)
+     * and stay valid until the next call to \ref readSSLFile, so decoders can resolve
+     * instruction names once and instantiate instructions by ID afterwards.
+     *
+     * \param name      the sanitized name of the instruction (upper case, without '.')
+     * \param numParams the number of parameters of the instruction
+     * \returns the ID of the instruction template, or INVALID_TEMPLATE if not found.
+     */
+    int getTemplateID(const QString &name, int numParams) const;
+
+    /**
+     * Returns a new RTL containing the semantics of the instruction template \p templateID.
+     * Unlike instantiating by name, this does not involve any string operations.
+     *
+     * \param templateID the ID of the instruction template (see \ref getTemplateID)
+     * \param pc         address at which the instruction is located
+     * \param args       the actual values of the instruction parameters
+     */
+    std::unique_ptr<RTL> instantiateRTL(int templateID, Address pc,
+                                        const std::vector<SharedExp> &args);
+
     RegDB *getRegDB();
     const RegDB *getRegDB() const;
 
+    /// \returns the path of the SSL file read by the last successful call to \ref readSSLFile.
+    const QString &getSSLFileName() const { return m_sslFileName; }
+
 private:
     /// Reset the object to "undo" a readSSLFile()
     void reset();
@@ -103,6 +132,16 @@ private:
      */
     int insert(const QString &name, std::list<QString> &parameters, const RTL &rtl);
 
+    /// Assign IDs to all instruction templates after parsing an SSL file.
+    void buildTemplateTable();
+
+    /**
+     * Share structurally identical subexpressions between all instruction templates.
+     * Templates are never modified after parsing (\ref instantiateRTL works on a deep copy),
+     * so sharing their expressions is safe.
+     */
+    void internTemplates();
+
     /// Print a textual representation of the dictionary.
     void print(OStream &os);
 
@@ -127,4 +166,12 @@ private:
 
     /// The actual instruction dictionary.
     std::map<std::pair<QString, int>, TableEntry> m_instructions;
+
+    /// All entries of m_instructions, by template ID
+    std::vector<TableEntry *> m_templates;
+
+    /// Template IDs of all entries of m_instructions
+    std::map<std::pair<QString, int>, int> m_templateIDs;
+
+    QString m_sslFileName; ///< Path of the SSL file the dictionary was read from
 };
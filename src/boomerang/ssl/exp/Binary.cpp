@@ -51,13 +51,14 @@ Binary::~Binary()
 
 std::shared_ptr<Binary> Binary::get(OPER op, SharedExp e1, SharedExp e2)
 {
-    return std::make_shared<Binary>(op, e1, e2);
+    return MemoryArena::makeShared<Binary>(op, e1, e2);
 }
 
 
 void Binary::setSubExp2(SharedExp e)
 {
     m_subExp2 = e;
+    markModified();
     assert(m_subExp1 && m_subExp2);
 }
 
@@ -72,6 +73,7 @@ SharedExp Binary::getSubExp2()
 SharedExp &Binary::refSubExp2()
 {
     assert(m_subExp1 && m_subExp2);
+    markModified(); // the sub-expression might be replaced
     return m_subExp2;
 }
 
@@ -79,6 +81,7 @@ SharedExp &Binary::refSubExp2()
 void Binary::commute()
 {
     std::swap(m_subExp1, m_subExp2);
+    markModified();
     assert(m_subExp1 && m_subExp2);
 }
 
@@ -86,12 +89,16 @@ void Binary::commute()
 SharedExp Binary::clone() const
 {
     assert(m_subExp1 && m_subExp2);
-    return std::make_shared<Binary>(m_oper, m_subExp1->clone(), m_subExp2->clone());
+    return MemoryArena::makeShared<Binary>(m_oper, m_subExp1->clone(), m_subExp2->clone());
 }
 
 
 bool Binary::operator==(const Exp &o) const
 {
+    if (this == &o) {
+        return true;
+    }
+
     assert(m_subExp1 && m_subExp2);
 
     if (o.getOper() == opWild) {
@@ -116,6 +123,10 @@ bool Binary::operator==(const Exp &o) const
 
 bool Binary::operator<(const Exp &o) const
 {
+    if (this == &o) {
+        return false;
+    }
+
     assert(m_subExp1 && m_subExp2);
 
     if (m_oper < o.getOper()) {
@@ -531,8 +542,15 @@ SharedExp Binary::acceptPreModifier(ExpModifier *mod, bool &visitChildren)
 
 SharedExp Binary::acceptChildModifier(ExpModifier *mod)
 {
-    m_subExp1 = m_subExp1->acceptModifier(mod);
-    m_subExp2 = m_subExp2->acceptModifier(mod);
+    SharedExp sub1 = m_subExp1->acceptModifier(mod);
+    SharedExp sub2 = m_subExp2->acceptModifier(mod);
+
+    if (sub1 != m_subExp1 || sub2 != m_subExp2) {
+        m_subExp1 = sub1;
+        m_subExp2 = sub2;
+        markModified();
+    }
+
     return shared_from_this();
 }
 
@@ -20,6 +20,9 @@
 #include "boomerang/visitor/expmodifier/ExpModifier.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
 
+#include <functional>
+#include <type_traits>
+
 
 Const::Const(uint32_t i)
     : Exp(opIntConst)
@@ -185,6 +188,12 @@ Address Const::getAddr() const
 }
 
 
+Function *Const::getFunc() const
+{
+    return std::get<Function *>(m_value);
+}
+
+
 QString Const::getFuncName() const
 {
     return std::get<Function *>(m_value)->getName();
@@ -194,36 +203,42 @@ QString Const::getFuncName() const
 void Const::setInt(int value)
 {
     m_value = value;
+    markModified();
 }
 
 
 void Const::setLong(QWord value)
 {
     m_value = value;
+    markModified();
 }
 
 
 void Const::setFlt(double value)
 {
     m_value = value;
+    markModified();
 }
 
 
 void Const::setStr(const QString &value)
 {
     m_value = value;
+    markModified();
 }
 
 
 void Const::setRawStr(const char *p)
 {
     m_value = p;
+    markModified();
 }
 
 
 void Const::setAddr(Address addr)
 {
     m_value = (QWord)addr.value();
+    markModified();
 }
 
 
@@ -278,6 +293,23 @@ bool Const::operator==(const Exp &other) const
 }
 
 
+std::size_t Const::hashValue() const
+{
+    return std::visit(
+        [](const auto &value) -> std::size_t {
+            using T = std::decay_t<decltype(value)>;
+
+            if constexpr (std::is_same_v<T, QString>) {
+                return qHash(value);
+            }
+            else {
+                return std::hash<T>()(value);
+            }
+        },
+        m_value);
+}
+
+
 SharedType Const::ascendType()
 {
     if (m_type->resolvesToVoid()) {
@@ -310,12 +342,16 @@ bool Const::descendType(SharedType newType)
                 m_type  = FloatType::get(64);
                 int i   = getInt();
                 m_value = *reinterpret_cast<float *>(&i);
+
+                markModified();
             }
             else if (m_oper == opLongConst) {
                 m_oper  = opFltConst;
                 m_type  = FloatType::get(64);
                 QWord i = getLong();
                 m_value = *reinterpret_cast<double *>(&i);
+
+                markModified();
             }
         }
 
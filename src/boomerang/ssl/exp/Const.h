@@ -23,6 +23,8 @@ class Function;
 /// string, or address constant.
 class BOOMERANG_API Const : public Exp
 {
+    friend class SaveFileWriter;
+
 private:
     typedef std::variant<int,         ///< Integer
                          QWord,       ///< 64 bit integer / address / pointer
@@ -62,13 +64,13 @@ public:
     template<class T>
     static std::shared_ptr<Const> get(T i)
     {
-        return std::make_shared<Const>(i);
+        return MemoryArena::makeShared<Const>(i);
     }
 
     template<class T>
     static std::shared_ptr<Const> get(T i, SharedType ty)
     {
-        std::shared_ptr<Const> c = std::make_shared<Const>(i);
+        std::shared_ptr<Const> c = MemoryArena::makeShared<Const>(i);
         c->setType(ty);
         return c;
     }
@@ -82,6 +84,13 @@ public:
     /// \copydoc Exp::equalNoSubscript
     virtual bool equalNoSubscript(const Exp &o) const override;
 
+    /// \returns true if this constant holds exactly the same value as \p other.
+    /// Unlike operator==, this also compares the representation of the value (e.g. int vs. QWord)
+    bool hasSameValue(const Const &other) const { return m_value == other.m_value; }
+
+    /// \returns a hash of the value of this constant, consistent with \ref hasSameValue
+    std::size_t hashValue() const;
+
     // Get the constant
     int getInt() const;
     QWord getLong() const;
@@ -89,6 +98,7 @@ public:
     QString getStr() const;
     const char *getRawStr() const;
     Address getAddr() const;
+    Function *getFunc() const;
     QString getFuncName() const;
 
     // Set the constant
@@ -82,6 +82,21 @@ Exp::Exp(OPER oper)
 }
 
 
+Exp::Exp(const Exp &other)
+    : std::enable_shared_from_this<Exp>(other)
+    , m_oper(other.m_oper)
+{
+}
+
+
+Exp &Exp::operator=(const Exp &other)
+{
+    m_oper = other.m_oper;
+    markModified();
+    return *this;
+}
+
+
 int Exp::getArity() const
 {
     return 0;
@@ -354,16 +369,116 @@ SharedExp Exp::accumulate(std::list<SharedExp> &exprs)
 
 SharedExp Exp::simplify()
 {
-    bool changed  = false; // True if simplified at this or lower level
-    SharedExp res = shared_from_this();
+    ExpSimplifier es;
+    return simplifyNode(shared_from_this(), es);
+}
 
-    do {
-        ExpSimplifier es;
-        res     = res->acceptModifier(&es);
-        changed = es.isModified();
-    } while (changed); // If modified at this (or a lower) level, redo
 
-    return res;
+bool Exp::isSimplified() const
+{
+    if (m_simplifiedVersion.load(std::memory_order_relaxed) !=
+        m_version.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    for (int i = 1; i <= getArity(); ++i) {
+        SharedConstExp sub = (i == 1) ? getSubExp1() : (i == 2) ? getSubExp2() : getSubExp3();
+        if (!sub->isSimplified()) {
+            return false;
+        }
+    }
+
+    return getSubExpVersions() == m_subExpVersions.load(std::memory_order_relaxed);
+}
+
+
+uint64_t Exp::getSubExpVersions() const
+{
+    uint64_t versions = 0;
+
+    for (int i = 1; i <= getArity(); ++i) {
+        SharedConstExp sub = (i == 1) ? getSubExp1() : (i == 2) ? getSubExp2() : getSubExp3();
+        versions += sub->m_version.load(std::memory_order_relaxed);
+    }
+
+    return versions;
+}
+
+
+uint64_t Exp::simplifySubExps(const SharedExp &exp, ExpSimplifier &simplifier)
+{
+    uint64_t versions = 0;
+
+    for (int i = 1; i <= exp->getArity(); ++i) {
+        SharedExp sub    = (i == 1) ? exp->getSubExp1() : (i == 2) ? exp->getSubExp2()
+                                                                   : exp->getSubExp3();
+        SharedExp newSub = simplifyNode(sub, simplifier);
+        versions += newSub->m_version.load(std::memory_order_relaxed);
+
+        if (newSub == sub) {
+            continue;
+        }
+
+        switch (i) {
+        case 1: exp->setSubExp1(newSub); break;
+        case 2: exp->setSubExp2(newSub); break;
+        case 3: exp->setSubExp3(newSub); break;
+        }
+    }
+
+    return versions;
+}
+
+
+SharedExp Exp::simplifyNode(SharedExp exp, ExpSimplifier &simplifier)
+{
+    while (true) {
+        const uint32_t version = exp->m_version.load(std::memory_order_relaxed);
+
+        if (exp->m_simplifiedVersion.load(std::memory_order_relaxed) == version) {
+            // This expression was not modified since it was simplified,
+            // but its sub-expressions might have been (e.g. through another parent).
+            const uint64_t subExpVersions = simplifySubExps(exp, simplifier);
+
+            if (exp->m_version.load(std::memory_order_relaxed) == version &&
+                subExpVersions == exp->m_subExpVersions.load(std::memory_order_relaxed)) {
+                return exp;
+            }
+        }
+
+        bool visitChildren = true;
+        simplifier.clearModified();
+        SharedExp res = exp->acceptPreModifier(&simplifier, visitChildren);
+
+        if (simplifier.isModified() || res != exp) {
+            exp = res;
+            continue;
+        }
+
+        uint64_t subExpVersions = 0;
+        if (visitChildren) {
+            subExpVersions = simplifySubExps(exp, simplifier);
+        }
+
+        // Sub-expressions are simplified now, so the rules for this expression
+        // can be applied repeatedly until they do not change anything.
+        simplifier.clearModified();
+        res = exp->acceptPostModifier(&simplifier);
+
+        if (simplifier.isModified() || res != exp) {
+            exp = res;
+            continue;
+        }
+
+        if (visitChildren) {
+            // New version, so parents that were simplified with the old one are simplified again
+            const uint32_t newVersion = exp->m_version.fetch_add(1, std::memory_order_relaxed) + 1;
+            exp->m_subExpVersions.store(subExpVersions, std::memory_order_relaxed);
+            exp->m_simplifiedVersion.store(newVersion, std::memory_order_relaxed);
+        }
+
+        return exp;
+    }
 }
 
 
@@ -12,10 +12,12 @@
 
 #include "boomerang/ssl/exp/ExpHelp.h"
 #include "boomerang/ssl/exp/Operator.h"
+#include "boomerang/util/MemoryArena.h"
 #include "boomerang/util/OStream.h"
 
 #include <QString>
 
+#include <atomic>
 #include <cassert>
 #include <list>
 #include <memory>
@@ -27,6 +29,7 @@ class Exp;
 class Type;
 class ExpVisitor;
 class ExpModifier;
+class ExpSimplifier;
 class UserProc;
 class LocationSet;
 class Statement;
@@ -63,13 +66,11 @@ class BOOMERANG_API Exp : public std::enable_shared_from_this<Exp>
 {
 public:
     Exp(OPER oper);
-    Exp(const Exp &other) = default;
-    Exp(Exp &&other)      = default;
+    Exp(const Exp &other);
 
     virtual ~Exp() = default;
 
-    Exp &operator=(const Exp &) = default;
-    Exp &operator=(Exp &&) = default;
+    Exp &operator=(const Exp &other);
 
 public:
     /// Clone (make copy of self that can be deleted without affecting self)
@@ -92,7 +93,11 @@ public:
     OPER getOper() const { return m_oper; }
 
     /// A few simplifications use this
-    void setOper(OPER oper) { m_oper = oper; }
+    void setOper(OPER oper)
+    {
+        m_oper = oper;
+        markModified();
+    }
 
     /// Return the number of subexpressions. This is only needed in rare cases.
     /// Could use polymorphism for all those cases, but this is easier
@@ -401,11 +406,19 @@ public:
      * something powerful, but until then, don't rely on this code to do anything critical. - trent
      * 8/7/2002
      *
+     * Sub-expressions are simplified before their parents in a single traversal.
+     * The rules are only applied again to expressions that were modified since they were
+     * last simplified, or whose sub-expressions were.
+     *
      * \returns the simplified expression.
      * \sa ExpSimplifier
      */
     SharedExp simplify();
 
+    /// \returns true if this expression was simplified by \ref simplify and neither it
+    /// nor any of its sub-expressions was modified since, even through another parent.
+    bool isSimplified() const;
+
     /**
      * Just do addressof simplification:
      *     a[ m[ any ]] == any,
@@ -519,8 +532,39 @@ protected:
         return std::static_pointer_cast<CHILD>(shared_from_this());
     }
 
+private:
+    /// Simplify \p exp and all its sub-expressions.
+    static SharedExp simplifyNode(SharedExp exp, ExpSimplifier &simplifier);
+
+    /// Simplify all sub-expressions of \p exp.
+    /// \returns the sum of the versions of the simplified sub-expressions.
+    static uint64_t simplifySubExps(const SharedExp &exp, ExpSimplifier &simplifier);
+
+    /// \returns the sum of the versions of the sub-expressions of this expression.
+    uint64_t getSubExpVersions() const;
+
+protected:
+    /// Must be called whenever this expression is modified \sa isSimplified
+    void markModified() { m_version.fetch_add(1, std::memory_order_relaxed); }
+
 protected:
     OPER m_oper; ///< The operator (e.g. opPlus)
+
+    /**
+     * Incremented whenever this expression is modified, and when it is simplified again
+     * because a sub-expression was modified. Sub-expressions can be shared between several
+     * parents, so each parent remembers the versions of its sub-expressions instead of
+     * being notified about their modifications.
+     */
+    std::atomic<uint32_t> m_version{ 1 };
+
+    /// Value of \ref m_version when this expression was simplified \sa isSimplified
+    std::atomic<uint32_t> m_simplifiedVersion{ 0 };
+
+    /// Sum of the versions of the sub-expressions when this expression was simplified.
+    /// Versions never decrease, so the sum changes iff any of the versions changes
+    /// (replacing a sub-expression modifies this expression).
+    std::atomic<uint64_t> m_subExpVersions{ 0 };
 };
 
 
@@ -9,13 +9,69 @@
 #pragma endregion License
 #include "ExpHelp.h"
 
-#include "boomerang/ssl/exp/Exp.h"
+#include "boomerang/ssl/exp/Const.h"
 #include "boomerang/ssl/statements/Assign.h"
 #include "boomerang/util/log/Log.h"
 
+#include <QHash>
+
+#include <functional>
+
 
 // A helper class for comparing Exp*'s sensibly
 bool lessExpStar::operator()(const SharedConstExp &left, const SharedConstExp &right) const
 {
+    if (left == right) {
+        return false; // shared (e.g. interned) expression
+    }
+
     return (*left < *right); // Compare the actual Exps
 }
+
+
+static std::size_t combineHash(std::size_t seed, std::size_t value)
+{
+    return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+
+std::size_t hashExpStar::operator()(const SharedConstExp &exp) const
+{
+    // Only hash what all implementations of Exp::operator< compare;
+    // e.g. types of TypedExps and definitions of RefExps are ignored.
+    std::size_t hash = std::hash<int>()(exp->getOper());
+
+    switch (exp->getOper()) {
+    case opIntConst: return combineHash(hash, std::hash<int>()(exp->access<Const>()->getInt()));
+    case opLongConst: return combineHash(hash, std::hash<QWord>()(exp->access<Const>()->getLong()));
+    case opFltConst: {
+        const double value = exp->access<Const>()->getFlt();
+        return combineHash(hash, value == 0.0 ? 0 : std::hash<double>()(value)); // -0.0 == 0.0
+    }
+    case opStrConst: return combineHash(hash, qHash(exp->access<Const>()->getStr()));
+    default: break;
+    }
+
+    const int arity = exp->getArity();
+    if (arity >= 1) {
+        hash = combineHash(hash, (*this)(exp->getSubExp1()));
+    }
+    if (arity >= 2) {
+        hash = combineHash(hash, (*this)(exp->getSubExp2()));
+    }
+    if (arity >= 3) {
+        hash = combineHash(hash, (*this)(exp->getSubExp3()));
+    }
+
+    return hash;
+}
+
+
+bool equalExpStar::operator()(const SharedConstExp &left, const SharedConstExp &right) const
+{
+    if (left == right) {
+        return true;
+    }
+
+    return !(*left < *right) && !(*right < *left);
+}
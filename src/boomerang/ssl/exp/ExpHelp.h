@@ -26,3 +26,18 @@ struct BOOMERANG_API lessExpStar
 {
     bool operator()(const SharedConstExp &left, const SharedConstExp &right) const;
 };
+
+
+/// Hashes Exp*s by the actual expressions.
+/// Expressions that are equal according to \ref lessExpStar have the same hash.
+struct BOOMERANG_API hashExpStar
+{
+    std::size_t operator()(const SharedConstExp &exp) const;
+};
+
+
+/// Compares Exp*s for equality, using the same order as \ref lessExpStar.
+struct BOOMERANG_API equalExpStar
+{
+    bool operator()(const SharedConstExp &left, const SharedConstExp &right) const;
+};
@@ -0,0 +1,225 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ExpInterner.h"
+
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/exp/Ternary.h"
+#include "boomerang/ssl/exp/TypedExp.h"
+#include "boomerang/ssl/statements/Statement.h"
+#include "boomerang/ssl/type/Type.h"
+
+#include <functional>
+#include <typeinfo>
+
+
+static void hashCombine(std::size_t &seed, std::size_t value)
+{
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+
+static std::size_t hashType(const SharedConstType &ty)
+{
+    return ty ? static_cast<std::size_t>(ty->getId()) + 1 : 0;
+}
+
+
+static bool isSameType(const SharedConstType &a, const SharedConstType &b)
+{
+    if (a == b) {
+        return true;
+    }
+    else if (!a || !b) {
+        return false;
+    }
+
+    return *a == *b;
+}
+
+
+static SharedConstExp getChild(const Exp &exp, int i)
+{
+    // clang-format off
+    switch (i) {
+    case 0: return exp.getSubExp1();
+    case 1: return exp.getSubExp2();
+    case 2: return exp.getSubExp3();
+    default: return nullptr;
+    }
+    // clang-format on
+}
+
+
+SharedExp ExpInterner::intern(const SharedExp &exp)
+{
+    if (exp == nullptr) {
+        return nullptr;
+    }
+    else if (isInterned(exp)) {
+        m_numHits++;
+        return exp;
+    }
+    else if (!canIntern(*exp)) {
+        return exp;
+    }
+
+    const int arity       = exp->getArity();
+    SharedExp children[3] = { exp->getSubExp1(), exp->getSubExp2(), exp->getSubExp3() };
+    bool childrenChanged  = false;
+
+    for (int i = 0; i < arity; ++i) {
+        const SharedExp canonicalChild = intern(children[i]);
+        if (!isInterned(canonicalChild)) {
+            return exp; // contains wildcards
+        }
+
+        childrenChanged |= (canonicalChild != children[i]);
+        children[i] = canonicalChild;
+    }
+
+    // If all children are canonical already, the node itself can be re-used without copying.
+    const SharedExp node   = childrenChanged ? rebuild(exp, children) : exp;
+    const std::size_t hash = hashNode(*node);
+
+    auto range = m_nodes.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (isSameNode(*it->second, *node)) {
+            m_numHits++;
+            return it->second;
+        }
+    }
+
+    m_nodes.insert({ hash, node });
+    m_hashes[node.get()] = hash;
+    m_numMisses++;
+
+    return node;
+}
+
+
+bool ExpInterner::isInterned(const SharedConstExp &exp) const
+{
+    return exp && m_hashes.find(exp.get()) != m_hashes.end();
+}
+
+
+std::size_t ExpInterner::getHash(const SharedConstExp &exp) const
+{
+    if (!exp) {
+        return 0;
+    }
+
+    auto it = m_hashes.find(exp.get());
+    return it != m_hashes.end() ? it->second : 0;
+}
+
+
+void ExpInterner::clear()
+{
+    m_nodes.clear();
+    m_hashes.clear();
+    m_numHits   = 0;
+    m_numMisses = 0;
+}
+
+
+std::size_t ExpInterner::hashNode(const Exp &exp) const
+{
+    std::size_t hash = std::hash<int>()(static_cast<int>(exp.getOper()));
+
+    for (int i = 0; i < exp.getArity(); ++i) {
+        hashCombine(hash, std::hash<const Exp *>()(getChild(exp, i).get()));
+    }
+
+    if (const Const *c = dynamic_cast<const Const *>(&exp)) {
+        hashCombine(hash, c->hashValue());
+        hashCombine(hash, hashType(c->getType()));
+    }
+    else if (const Location *loc = dynamic_cast<const Location *>(&exp)) {
+        hashCombine(hash, std::hash<const UserProc *>()(loc->getProc()));
+    }
+    else if (const RefExp *ref = dynamic_cast<const RefExp *>(&exp)) {
+        hashCombine(hash, std::hash<const Statement *>()(ref->getDef()));
+    }
+    else if (const TypedExp *typed = dynamic_cast<const TypedExp *>(&exp)) {
+        hashCombine(hash, hashType(typed->getType()));
+    }
+
+    return hash;
+}
+
+
+bool ExpInterner::isSameNode(const Exp &a, const Exp &b) const
+{
+    if (a.getOper() != b.getOper() || typeid(a) != typeid(b)) {
+        return false;
+    }
+
+    for (int i = 0; i < a.getArity(); ++i) {
+        if (getChild(a, i) != getChild(b, i)) {
+            return false;
+        }
+    }
+
+    if (const Const *ca = dynamic_cast<const Const *>(&a)) {
+        const Const *cb = static_cast<const Const *>(&b);
+        return ca->hasSameValue(*cb) && isSameType(ca->getType(), cb->getType());
+    }
+    else if (const Location *la = dynamic_cast<const Location *>(&a)) {
+        return la->getProc() == static_cast<const Location &>(b).getProc();
+    }
+    else if (const RefExp *ra = dynamic_cast<const RefExp *>(&a)) {
+        return ra->getDef() == static_cast<const RefExp &>(b).getDef();
+    }
+    else if (const TypedExp *ta = dynamic_cast<const TypedExp *>(&a)) {
+        return isSameType(ta->getType(), static_cast<const TypedExp &>(b).getType());
+    }
+
+    return true;
+}
+
+
+bool ExpInterner::canIntern(const Exp &exp) const
+{
+    if (exp.isWildcard()) {
+        return false;
+    }
+    else if (exp.isSubscript()) {
+        return static_cast<const RefExp &>(exp).getDef() != STMT_WILD;
+    }
+
+    return true;
+}
+
+
+SharedExp ExpInterner::rebuild(const SharedExp &exp, const SharedExp children[3]) const
+{
+    const OPER oper = exp->getOper();
+
+    if (exp->isSubscript()) {
+        return RefExp::get(children[0], exp->access<RefExp>()->getDef());
+    }
+    else if (exp->isTypedExp()) {
+        return TypedExp::get(exp->access<TypedExp>()->getType(), children[0]);
+    }
+    else if (std::shared_ptr<Location> loc = std::dynamic_pointer_cast<Location>(exp)) {
+        return Location::get(oper, children[0], loc->getProc());
+    }
+
+    switch (exp->getArity()) {
+    case 1: return Unary::get(oper, children[0]);
+    case 2: return Binary::get(oper, children[0], children[1]);
+    case 3: return Ternary::get(oper, children[0], children[1], children[2]);
+    default: return exp->clone();
+    }
+}
@@ -0,0 +1,103 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/exp/Exp.h"
+
+#include <unordered_map>
+
+
+/**
+ * Hash-consing factory for expressions.
+ *
+ * Interning an expression returns the canonical node for it. Canonical nodes
+ * are shared, so two interned expressions are structurally identical
+ * if and only if they are the same object. Structural hashes are computed once
+ * when a node is interned, from the operator, the payload of the node and the
+ * addresses of its (already canonical) children.
+ *
+ * Interning is opt-in: Expressions not created by an interner behave exactly
+ * as before. Since canonical nodes are shared, they must be treated as immutable.
+ * To modify an interned expression, clone it first. Therefore, only expressions
+ * that are never modified in place should be interned, e.g. the expressions
+ * of instruction templates (see RTLInstDict).
+ *
+ * Identity of interned nodes is stricter than Exp::operator==:
+ * It also takes into account the procedure of locations, the exact definition
+ * of subscripts and the type of constants, so interning never loses information.
+ * Wildcards and expressions containing wildcards are never interned.
+ */
+class BOOMERANG_API ExpInterner
+{
+public:
+    ExpInterner() = default;
+    ExpInterner(const ExpInterner &other) = delete;
+    ExpInterner(ExpInterner &&other)      = default;
+
+    ~ExpInterner() = default;
+
+    ExpInterner &operator=(const ExpInterner &other) = delete;
+    ExpInterner &operator=(ExpInterner &&other) = default;
+
+public:
+    /**
+     * \returns the canonical node for \p exp. Sub-expressions that are already canonical
+     * are re-used without copying them. \p exp itself is never modified, but it may become
+     * the canonical node, so it must not be modified afterwards either.
+     * If \p exp cannot be interned (e.g. because it contains wildcards),
+     * \p exp is returned unchanged.
+     */
+    SharedExp intern(const SharedExp &exp);
+
+    /// \returns true if \p exp is a canonical node of this interner.
+    bool isInterned(const SharedConstExp &exp) const;
+
+    /// \returns the structural hash of the canonical node \p exp,
+    /// or 0 if \p exp was not interned by this interner.
+    std::size_t getHash(const SharedConstExp &exp) const;
+
+    /// \returns the number of canonical nodes
+    std::size_t getNumNodes() const { return m_hashes.size(); }
+
+    /// \returns how often an existing canonical node was returned by \ref intern
+    std::size_t getNumHits() const { return m_numHits; }
+
+    /// \returns how often a new canonical node had to be created by \ref intern
+    std::size_t getNumMisses() const { return m_numMisses; }
+
+    /// Remove all canonical nodes. Nodes that are still referenced elsewhere stay valid,
+    /// but are no longer considered canonical.
+    void clear();
+
+private:
+    /// \returns the hash of the node \p exp, assuming all children of \p exp are canonical.
+    std::size_t hashNode(const Exp &exp) const;
+
+    /// \returns true if \p a and \p b have the same operator and payload,
+    /// and identical children.
+    bool isSameNode(const Exp &a, const Exp &b) const;
+
+    /// \returns true if \p exp can be made canonical (ignoring its children).
+    bool canIntern(const Exp &exp) const;
+
+    /// \returns a copy of \p exp with its children replaced by \p children
+    SharedExp rebuild(const SharedExp &exp, const SharedExp children[3]) const;
+
+private:
+    /// all canonical nodes, by their structural hash
+    std::unordered_multimap<std::size_t, SharedExp> m_nodes;
+
+    /// structural hash of each canonical node
+    std::unordered_map<const Exp *, std::size_t> m_hashes;
+
+    std::size_t m_numHits   = 0;
+    std::size_t m_numMisses = 0;
+};
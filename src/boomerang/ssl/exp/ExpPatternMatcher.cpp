@@ -0,0 +1,234 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ExpPatternMatcher.h"
+
+#include <algorithm>
+#include <climits>
+#include <map>
+#include <utility>
+
+
+struct ExpPatternMatcher::Node
+{
+    int patternIdx    = -1;      ///< Index of the pattern ending at this node, if any
+    int minPatternIdx = INT_MAX; ///< Lowest index of all patterns in the subtree of this node
+
+    /// Successors for nodes with sub-expressions, by operator
+    std::map<OPER, std::unique_ptr<Node>> operEdges;
+
+    /// Successors for leaves (constants, terminals, wildcards), in the order they were added
+    std::vector<std::pair<SharedConstExp, std::unique_ptr<Node>>> leafEdges;
+};
+
+
+template<typename T>
+static T stripSubscripts(T exp)
+{
+    while (exp->isSubscript()) {
+        exp = exp->getSubExp1();
+    }
+
+    return exp;
+}
+
+
+/// \returns true if \p exp is matched by its operator and its sub-expressions,
+/// false if it is matched as a whole.
+static bool hasSubExps(const Exp &exp)
+{
+    return exp.getArity() > 0 && !exp.isTypedExp();
+}
+
+
+template<typename T>
+static T getSubExp(const T &exp, int i)
+{
+    switch (i) {
+    case 1: return exp->getSubExp1();
+    case 2: return exp->getSubExp2();
+    case 3: return exp->getSubExp3();
+    default: return nullptr;
+    }
+}
+
+
+ExpPatternMatcher::ExpPatternMatcher()
+    : m_root(new Node)
+{
+}
+
+
+ExpPatternMatcher::ExpPatternMatcher(std::initializer_list<SharedConstExp> patterns)
+    : ExpPatternMatcher()
+{
+    for (const SharedConstExp &pattern : patterns) {
+        addPattern(pattern);
+    }
+}
+
+
+ExpPatternMatcher::~ExpPatternMatcher()
+{
+}
+
+
+int ExpPatternMatcher::addPattern(const SharedConstExp &pattern)
+{
+    const int patternIdx = getNumPatterns();
+    m_patterns.push_back(pattern);
+
+    // Patterns are added in order of precedence, so the first pattern reaching a node
+    // has the lowest index of its subtree.
+    Node *node          = m_root.get();
+    node->minPatternIdx = std::min(node->minPatternIdx, patternIdx);
+
+    std::vector<SharedConstExp> pending = { pattern };
+
+    while (!pending.empty()) {
+        const SharedConstExp exp = stripSubscripts(pending.back());
+        pending.pop_back();
+
+        std::unique_ptr<Node> *next = nullptr;
+
+        if (hasSubExps(*exp)) {
+            next = &node->operEdges[exp->getOper()];
+
+            for (int i = exp->getArity(); i > 0; --i) {
+                pending.push_back(getSubExp(exp, i));
+            }
+        }
+        else {
+            for (auto &[leaf, succ] : node->leafEdges) {
+                if (leaf->getOper() == exp->getOper() && *leaf == *exp) {
+                    next = &succ;
+                    break;
+                }
+            }
+
+            if (!next) {
+                node->leafEdges.emplace_back(exp, nullptr);
+                next = &node->leafEdges.back().second;
+            }
+        }
+
+        if (!*next) {
+            next->reset(new Node);
+        }
+
+        node                = next->get();
+        node->minPatternIdx = std::min(node->minPatternIdx, patternIdx);
+    }
+
+    if (node->patternIdx == -1) {
+        node->patternIdx = patternIdx;
+    }
+
+    return patternIdx;
+}
+
+
+int ExpPatternMatcher::match(const SharedExp &exp, Bindings *bindings) const
+{
+    std::vector<SharedExp> pending = { exp };
+    int bestIdx                    = INT_MAX;
+    Bindings currentBindings;
+
+    matchNode(m_root.get(), pending, currentBindings, bestIdx, bindings);
+
+    return bestIdx != INT_MAX ? bestIdx : -1;
+}
+
+
+bool ExpPatternMatcher::searchAll(const SharedExp &exp, std::list<Match> &result) const
+{
+    bool found                     = false;
+    std::vector<SharedExp> toVisit = { exp };
+
+    while (!toVisit.empty()) {
+        const SharedExp e = stripSubscripts(toVisit.back());
+        toVisit.pop_back();
+
+        Match m;
+        m.patternIdx = match(e, &m.bindings);
+
+        if (m.patternIdx != -1) {
+            m.exp = e;
+            result.push_back(std::move(m));
+            found = true;
+        }
+
+        for (int i = e->getArity(); i > 0; --i) {
+            toVisit.push_back(getSubExp(e, i));
+        }
+    }
+
+    return found;
+}
+
+
+void ExpPatternMatcher::matchNode(const Node *node, std::vector<SharedExp> &pending,
+                                  Bindings &bindings, int &bestIdx, Bindings *bestBindings) const
+{
+    if (node->minPatternIdx >= bestIdx) {
+        return; // no pattern in this subtree takes precedence over the current match
+    }
+    else if (pending.empty()) {
+        // All patterns are complete trees, so a pattern ends here iff there is nothing left.
+        if (node->patternIdx != -1) {
+            bestIdx = node->patternIdx;
+
+            if (bestBindings) {
+                *bestBindings = bindings;
+            }
+        }
+
+        return;
+    }
+
+    const SharedExp exp = pending.back();
+    pending.pop_back();
+
+    const SharedExp stripped = stripSubscripts(exp);
+
+    if (hasSubExps(*stripped)) {
+        auto it = node->operEdges.find(stripped->getOper());
+
+        if (it != node->operEdges.end()) {
+            const std::size_t numPending = pending.size();
+
+            for (int i = stripped->getArity(); i > 0; --i) {
+                pending.push_back(getSubExp(stripped, i));
+            }
+
+            matchNode(it->second.get(), pending, bindings, bestIdx, bestBindings);
+            pending.resize(numPending);
+        }
+    }
+
+    for (const auto &[leaf, succ] : node->leafEdges) {
+        if (!exp->equalNoSubscript(*leaf)) {
+            continue;
+        }
+
+        const bool isWild = leaf->isWildcard();
+
+        if (isWild) {
+            bindings.push_back(exp);
+        }
+
+        matchNode(succ.get(), pending, bindings, bestIdx, bestBindings);
+
+        if (isWild) {
+            bindings.pop_back();
+        }
+    }
+
+    pending.push_back(exp);
+}
@@ -0,0 +1,111 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/exp/Exp.h"
+
+#include <cstddef>
+#include <initializer_list>
+#include <list>
+#include <memory>
+#include <vector>
+
+
+/**
+ * Matches expressions against a set of wildcard patterns at once.
+ *
+ * The patterns are compiled into a decision tree over their nodes in pre-order.
+ * Nodes with sub-expressions are keyed on their operator, so patterns sharing a common prefix
+ * are only matched once and patterns with a different operator are never tried.
+ * Leaves (constants, terminals and wildcards) are compared by Exp::equalNoSubscript.
+ *
+ * Like Exp::equalNoSubscript, subscripts are ignored, both in the patterns and in
+ * the matched expressions. Typed expressions in patterns are compared as a whole.
+ *
+ * When matching, the sub-expressions matched by the wildcards of a pattern are captured
+ * in the order the wildcards appear in the pattern (pre-order).
+ * If more than one pattern matches, the pattern that was added first takes precedence.
+ */
+class BOOMERANG_API ExpPatternMatcher
+{
+public:
+    typedef std::vector<SharedExp> Bindings;
+
+    struct Match
+    {
+        int patternIdx; ///< Index of the matching pattern
+        SharedExp exp;  ///< The expression matching the pattern
+        Bindings bindings;
+    };
+
+public:
+    ExpPatternMatcher();
+    ExpPatternMatcher(std::initializer_list<SharedConstExp> patterns);
+
+    template<std::size_t N>
+    explicit ExpPatternMatcher(const SharedConstExp (&patterns)[N])
+        : ExpPatternMatcher()
+    {
+        for (const SharedConstExp &pattern : patterns) {
+            addPattern(pattern);
+        }
+    }
+
+    ExpPatternMatcher(const ExpPatternMatcher &other) = delete;
+    ExpPatternMatcher(ExpPatternMatcher &&other)      = delete;
+
+    ~ExpPatternMatcher();
+
+    ExpPatternMatcher &operator=(const ExpPatternMatcher &other) = delete;
+    ExpPatternMatcher &operator=(ExpPatternMatcher &&other) = delete;
+
+public:
+    /// Add \p pattern with a lower precedence than all existing patterns.
+    /// \returns the index of the pattern.
+    int addPattern(const SharedConstExp &pattern);
+
+    /// \returns the number of patterns.
+    int getNumPatterns() const { return static_cast<int>(m_patterns.size()); }
+
+    /// \returns the pattern with index \p patternIdx
+    const SharedConstExp &getPattern(int patternIdx) const { return m_patterns[patternIdx]; }
+
+    /**
+     * Match \p exp against all patterns.
+     * \param bindings if not null, receives the sub-expressions matched by the wildcards
+     *                 of the matching pattern.
+     * \returns the index of the first pattern matching \p exp, or -1 if there is none.
+     */
+    int match(const SharedExp &exp, Bindings *bindings = nullptr) const;
+
+    /**
+     * Match all sub-expressions of \p exp (including \p exp itself) against all patterns
+     * in a single traversal. Matches are appended to \p result in pre-order.
+     * Subscripted sub-expressions are reported without the subscript.
+     * \returns true if any sub-expression matched.
+     */
+    bool searchAll(const SharedExp &exp, std::list<Match> &result) const;
+
+private:
+    struct Node;
+
+    /**
+     * Match the expressions in \p pending (last to be matched first) against the subtree
+     * of \p node and update \p bestIdx and \p bestBindings if a pattern with a lower index
+     * than \p bestIdx matches.
+     */
+    void matchNode(const Node *node, std::vector<SharedExp> &pending, Bindings &bindings,
+                   int &bestIdx, Bindings *bestBindings) const;
+
+private:
+    std::unique_ptr<Node> m_root;
+    std::vector<SharedConstExp> m_patterns;
+};
@@ -62,13 +62,13 @@ Location::Location(OPER oper, SharedExp exp, UserProc *proc)
 
 SharedExp Location::clone() const
 {
-    return std::make_shared<Location>(m_oper, m_subExp1->clone(), m_proc);
+    return MemoryArena::makeShared<Location>(m_oper, m_subExp1->clone(), m_proc);
 }
 
 
 SharedExp Location::get(OPER op, SharedExp childExp, UserProc *proc)
 {
-    return std::make_shared<Location>(op, childExp, proc);
+    return MemoryArena::makeShared<Location>(op, childExp, proc);
 }
 
 
@@ -59,7 +59,11 @@ public:
     static SharedExp param(const char *name, UserProc *proc = nullptr);
     static SharedExp param(const QString &name, UserProc *proc = nullptr);
 
-    void setProc(UserProc *p) { m_proc = p; }
+    void setProc(UserProc *p)
+    {
+        m_proc = p;
+        markModified();
+    }
     const UserProc *getProc() const { return m_proc; }
     UserProc *getProc() { return m_proc; }
 
@@ -26,7 +26,7 @@ RefExp::RefExp(SharedExp e, Statement *d)
 
 std::shared_ptr<RefExp> RefExp::get(SharedExp e, Statement *def)
 {
-    return std::make_shared<RefExp>(e, def);
+    return MemoryArena::makeShared<RefExp>(e, def);
 }
 
 
@@ -38,6 +38,10 @@ SharedExp RefExp::clone() const
 
 bool RefExp::operator==(const Exp &o) const
 {
+    if (this == &o) {
+        return true;
+    }
+
     if (o.getOper() == opWild) {
         return true;
     }
@@ -78,6 +82,10 @@ bool RefExp::operator==(const Exp &o) const
 
 bool RefExp::operator<(const Exp &o) const
 {
+    if (this == &o) {
+        return false;
+    }
+
     if (opSubscript < o.getOper()) {
         return true;
     }
@@ -145,13 +153,21 @@ bool RefExp::isImplicitDef() const
 SharedExp RefExp::addSubscript(Statement *def)
 {
     m_def = def;
+    markModified();
     return shared_from_this();
 }
 
 
-void RefExp::setDef(Statement *def)
+void RefExp::setDef(Statement *def, Statement *user)
 {
+    const bool changed = def != m_def;
+
     m_def = def;
+    markModified();
+
+    if (changed && user) {
+        user->updateUsedDefs();
+    }
 }
 
 
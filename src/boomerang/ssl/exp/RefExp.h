@@ -59,7 +59,13 @@ public:
     bool equalNoSubscript(const Exp &o) const override;
 
     Statement *getDef() const { return m_def; }
-    void setDef(Statement *def);
+
+    /**
+     * Change the definition of this reference to \p def.
+     * \param user the statement containing this reference, if any. Its uses are updated
+     * in the def-use index of its procedure. Otherwise the caller must update the index.
+     */
+    void setDef(Statement *def, Statement *user = nullptr);
 
     SharedExp addSubscript(Statement *def);
 
@@ -31,13 +31,13 @@ Terminal::Terminal(const Terminal &o)
 
 SharedExp Terminal::get(OPER op)
 {
-    return std::make_shared<Terminal>(op);
+    return MemoryArena::makeShared<Terminal>(op);
 }
 
 
 SharedExp Terminal::clone() const
 {
-    return std::make_shared<Terminal>(*this);
+    return MemoryArena::makeShared<Terminal>(*this);
 }
 
 
@@ -44,13 +44,14 @@ Ternary::~Ternary()
 
 std::shared_ptr<Ternary> Ternary::get(OPER op, SharedExp e1, SharedExp e2, SharedExp e3)
 {
-    return std::make_shared<Ternary>(op, e1, e2, e3);
+    return MemoryArena::makeShared<Ternary>(op, e1, e2, e3);
 }
 
 
 void Ternary::setSubExp3(SharedExp e)
 {
     m_subExp3 = e;
+    markModified();
     assert(m_subExp1 && m_subExp2 && m_subExp3);
 }
 
@@ -72,6 +73,7 @@ SharedConstExp Ternary::getSubExp3() const
 SharedExp &Ternary::refSubExp3()
 {
     assert(m_subExp1 && m_subExp2 && m_subExp3);
+    markModified(); // the sub-expression might be replaced
     return m_subExp3;
 }
 
@@ -85,6 +87,10 @@ SharedExp Ternary::clone() const
 
 bool Ternary::operator==(const Exp &o) const
 {
+    if (this == &o) {
+        return true;
+    }
+
     if (o.getOper() == opWild) {
         return true;
     }
@@ -101,6 +107,10 @@ bool Ternary::operator==(const Exp &o) const
 
 bool Ternary::operator<(const Exp &o) const
 {
+    if (this == &o) {
+        return false;
+    }
+
     if (m_oper != o.getOper()) {
         return m_oper < o.getOper();
     }
@@ -229,9 +239,17 @@ SharedExp Ternary::acceptPreModifier(ExpModifier *mod, bool &visitChildren)
 
 SharedExp Ternary::acceptChildModifier(ExpModifier *mod)
 {
-    m_subExp1 = m_subExp1->acceptModifier(mod);
-    m_subExp2 = m_subExp2->acceptModifier(mod);
-    m_subExp3 = m_subExp3->acceptModifier(mod);
+    SharedExp sub1 = m_subExp1->acceptModifier(mod);
+    SharedExp sub2 = m_subExp2->acceptModifier(mod);
+    SharedExp sub3 = m_subExp3->acceptModifier(mod);
+
+    if (sub1 != m_subExp1 || sub2 != m_subExp2 || sub3 != m_subExp3) {
+        m_subExp1 = sub1;
+        m_subExp2 = sub2;
+        m_subExp3 = sub3;
+        markModified();
+    }
+
     return shared_from_this();
 }
 
@@ -38,24 +38,28 @@ TypedExp::TypedExp(const TypedExp &o)
 
 std::shared_ptr<TypedExp> TypedExp::get(SharedExp exp)
 {
-    return std::make_shared<TypedExp>(exp);
+    return MemoryArena::makeShared<TypedExp>(exp);
 }
 
 
 std::shared_ptr<TypedExp> TypedExp::get(SharedType ty, SharedExp exp)
 {
-    return std::make_shared<TypedExp>(ty, exp);
+    return MemoryArena::makeShared<TypedExp>(ty, exp);
 }
 
 
 SharedExp TypedExp::clone() const
 {
-    return std::make_shared<TypedExp>(m_type, m_subExp1->clone());
+    return MemoryArena::makeShared<TypedExp>(m_type, m_subExp1->clone());
 }
 
 
 bool TypedExp::operator==(const Exp &o) const
 {
+    if (this == &o) {
+        return true;
+    }
+
     if (static_cast<const TypedExp &>(o).m_oper == opWild) {
         return true;
     }
@@ -75,6 +79,10 @@ bool TypedExp::operator==(const Exp &o) const
 
 bool TypedExp::operator<(const Exp &o) const // Type sensitive
 {
+    if (this == &o) {
+        return false;
+    }
+
     if (m_oper < o.getOper()) {
         return true;
     }
@@ -49,13 +49,14 @@ Unary::~Unary()
 
 SharedExp Unary::get(OPER op, SharedExp e1)
 {
-    return std::make_shared<Unary>(op, e1);
+    return MemoryArena::makeShared<Unary>(op, e1);
 }
 
 
 void Unary::setSubExp1(SharedExp e)
 {
     m_subExp1 = e;
+    markModified();
     assert(m_subExp1);
 }
 
@@ -77,6 +78,7 @@ SharedConstExp Unary::getSubExp1() const
 SharedExp &Unary::refSubExp1()
 {
     assert(m_subExp1);
+    markModified(); // the sub-expression might be replaced
     return m_subExp1;
 }
 
@@ -84,12 +86,16 @@ SharedExp &Unary::refSubExp1()
 SharedExp Unary::clone() const
 {
     assert(m_subExp1);
-    return std::make_shared<Unary>(m_oper, m_subExp1->clone());
+    return MemoryArena::makeShared<Unary>(m_oper, m_subExp1->clone());
 }
 
 
 bool Unary::operator==(const Exp &o) const
 {
+    if (this == &o) {
+        return true;
+    }
+
     if (o.getOper() == opWild) {
         return true;
     }
@@ -116,6 +122,10 @@ bool Unary::operator==(const Exp &o) const
 
 bool Unary::operator<(const Exp &o) const
 {
+    if (this == &o) {
+        return false;
+    }
+
     if (m_oper != static_cast<const Unary &>(o).m_oper) {
         return m_oper < static_cast<const Unary &>(o).m_oper;
     }
@@ -334,7 +344,13 @@ SharedExp Unary::acceptPreModifier(ExpModifier *mod, bool &visitChildren)
 
 SharedExp Unary::acceptChildModifier(ExpModifier *mod)
 {
-    m_subExp1 = m_subExp1->acceptModifier(mod);
+    SharedExp sub1 = m_subExp1->acceptModifier(mod);
+
+    if (sub1 != m_subExp1) {
+        m_subExp1 = sub1;
+        markModified();
+    }
+
     return shared_from_this();
 }
 
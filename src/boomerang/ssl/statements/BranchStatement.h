@@ -54,6 +54,12 @@ public:
      */
     void setCondType(BranchType cond, bool usesFloat = false);
 
+    /// \returns the type of conditional jump.
+    BranchType getCondType() const { return m_jumpType; }
+
+    /// \returns true if this conditional jump checks the floating point condition codes
+    bool isFloat() const { return m_isFloat; }
+
     /// Return the SemStr expression containing the HL condition.
     /// \returns ptr to an expression
     SharedExp getCondExpr() const;
@@ -290,6 +290,8 @@ void PhiAssign::putAt(BasicBlock *bb, Statement *def, SharedExp e)
         it->second.setDef(def);
         it->second.setSubExp1(e);
     }
+
+    updateUsedDefs();
 }
 
 
@@ -20,6 +20,8 @@
  */
 class BOOMERANG_API ReturnStatement : public Statement
 {
+    friend class SaveFileReader;
+
 public:
     typedef StatementList::iterator iterator;
     typedef StatementList::const_iterator const_iterator;
@@ -11,6 +11,7 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/db/DefUseIndex.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/ssl/exp/Binary.h"
@@ -18,6 +19,7 @@
 #include "boomerang/ssl/exp/Location.h"
 #include "boomerang/ssl/exp/RefExp.h"
 #include "boomerang/ssl/statements/CallStatement.h"
+#include "boomerang/util/HashedLocationSet.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/CallBypasser.h"
 #include "boomerang/visitor/expvisitor/UsedLocsFinder.h"
@@ -53,6 +55,14 @@ void Statement::setProc(UserProc *proc)
 }
 
 
+void Statement::updateUsedDefs()
+{
+    if (m_proc && m_proc->isDefUseIndexValid()) {
+        m_proc->getDefUseIndex().updateStatement(this);
+    }
+}
+
+
 OStream &operator<<(OStream &os, const Statement *s)
 {
     if (s == nullptr) {
@@ -120,8 +130,9 @@ bool Statement::canPropagateToExp(const Exp &exp)
 }
 
 
-bool Statement::propagateTo(Settings *settings, std::map<SharedExp, int, lessExpStar> *destCounts,
-                            LocationSet *usedByDomPhi, bool force)
+bool Statement::propagateTo(Settings *settings,
+                            const std::map<SharedExp, int, lessExpStar> *destCounts,
+                            HashedLocationSet *usedByDomPhi, bool force)
 {
     bool change            = false;
     int changes            = 0;
@@ -218,7 +229,7 @@ bool Statement::propagateTo(Settings *settings, std::map<SharedExp, int, lessExp
                 change |= doPropagateTo(e, def, settings);
             }
             else {
-                std::map<SharedExp, int, lessExpStar>::iterator ff = destCounts->find(e);
+                std::map<SharedExp, int, lessExpStar>::const_iterator ff = destCounts->find(e);
 
                 if (ff == destCounts->end()) {
                     change |= doPropagateTo(e, def, settings);
@@ -472,7 +483,7 @@ bool Statement::isNullStatement() const
 }
 
 
-void Statement::bypass()
+bool Statement::bypass()
 {
     // Use the Part modifier so we don't change the top level of LHS of assigns etc
     CallBypasser cb(this);
@@ -483,6 +494,8 @@ void Statement::bypass()
     if (cb.isTopChanged()) {
         simplify(); // E.g. m[esp{20}] := blah -> m[esp{-}-20+4] := blah
     }
+
+    return cb.isModified();
 }
 
 
@@ -12,6 +12,7 @@
 
 #include "boomerang/ssl/exp/ExpHelp.h"
 #include "boomerang/util/Address.h"
+#include "boomerang/util/MemoryArena.h"
 
 #include <list>
 #include <map>
@@ -27,6 +28,7 @@ class StmtExpVisitor;
 class StmtModifier;
 class StmtPartModifier;
 class LocationSet;
+class HashedLocationSet;
 class Assignment;
 class Settings;
 
@@ -104,6 +106,16 @@ public:
     Statement &operator=(const Statement &other) = default;
     Statement &operator=(Statement &&other) = default;
 
+public:
+    /// Statements are allocated from the current memory arena, if there is one.
+    /// \sa MemoryArena
+    static void *operator new(std::size_t size) { return MemoryArena::allocateObject(size); }
+    static void *operator new(std::size_t, void *ptr) { return ptr; }
+    static void operator delete(void *ptr, std::size_t size)
+    {
+        MemoryArena::deallocateObject(ptr, size);
+    }
+
 public:
     /// Make copy of self, and make the copy a derived object if needed.
     virtual Statement *clone() const = 0;
@@ -238,8 +250,8 @@ public:
      * \param usedByDomPhi is a set of subscripted locations used in phi statements
      * \returns true if a change
      */
-    bool propagateTo(Settings *settings, ExpIntMap *destCounts = nullptr,
-                     LocationSet *usedByDomPhi = nullptr, bool force = false);
+    bool propagateTo(Settings *settings, const ExpIntMap *destCounts = nullptr,
+                     HashedLocationSet *usedByDomPhi = nullptr, bool force = false);
 
     /// Experimental: may want to propagate flags first,
     /// without tests about complexity or the propagation limiting heuristic
@@ -269,9 +281,15 @@ public:
      */
     void addUsedLocs(LocationSet &used, bool countCols = false, bool memOnly = false);
 
+    /// Update the def-use index of the enclosing procedure, if it is up to date,
+    /// after a reference in this statement was changed to a different definition.
+    /// \sa RefExp::setDef
+    void updateUsedDefs();
+
     /// Fix references to the returns of call statements
     /// Bypass calls for references in this statement
-    void bypass();
+    /// \returns true if any reference was bypassed
+    bool bypass();
 
     /// Get the type for the definition, if any, for expression e in this statement
     /// Overridden only by Assignment and CallStatement, and ReturnStatement.
@@ -23,6 +23,13 @@ BooleanType::~BooleanType()
 }
 
 
+std::shared_ptr<BooleanType> BooleanType::get()
+{
+    static const std::shared_ptr<BooleanType> boolType = std::make_shared<BooleanType>();
+    return boolType;
+}
+
+
 SharedType BooleanType::clone() const
 {
     return std::make_shared<BooleanType>();
@@ -26,7 +26,8 @@ public:
     BooleanType &operator=(BooleanType &&other) = default;
 
 public:
-    static std::shared_ptr<BooleanType> get() { return std::make_shared<BooleanType>(); }
+    /// \returns the boolean type. Since it has no properties, it is shared between all users.
+    static std::shared_ptr<BooleanType> get();
 
     /// \copydoc Type::operator==
     virtual bool operator==(const Type &other) const override;
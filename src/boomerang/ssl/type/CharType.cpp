@@ -24,6 +24,13 @@ CharType::~CharType()
 }
 
 
+std::shared_ptr<CharType> CharType::get()
+{
+    static const std::shared_ptr<CharType> charType = std::make_shared<CharType>();
+    return charType;
+}
+
+
 SharedType CharType::clone() const
 {
     return CharType::get();
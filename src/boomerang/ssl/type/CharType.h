@@ -27,7 +27,8 @@ public:
     CharType &operator=(CharType &&other) = default;
 
 public:
-    static std::shared_ptr<CharType> get() { return std::make_shared<CharType>(); }
+    /// \returns the char type. Since it has no properties, it is shared between all users.
+    static std::shared_ptr<CharType> get();
 
     /// \copydoc Type::operator==
     virtual bool operator==(const Type &other) const override;
@@ -12,6 +12,8 @@
 #include "boomerang/ssl/type/ArrayType.h"
 #include "boomerang/ssl/type/SizeType.h"
 
+#include <vector>
+
 
 FloatType::FloatType(Size sz)
     : Type(TypeClass::Float)
@@ -22,7 +24,18 @@ FloatType::FloatType(Size sz)
 
 std::shared_ptr<FloatType> FloatType::get(Size sz)
 {
-    return std::make_shared<FloatType>(sz);
+    static const std::vector<std::shared_ptr<FloatType>> sharedTypes = []() {
+        std::vector<std::shared_ptr<FloatType>> types;
+        types.reserve(MAX_SHARED_SIZE + 1);
+
+        for (Size size = 0; size <= MAX_SHARED_SIZE; ++size) {
+            types.push_back(std::make_shared<FloatType>(size));
+        }
+
+        return types;
+    }();
+
+    return sz <= MAX_SHARED_SIZE ? sharedTypes[sz] : std::make_shared<FloatType>(sz);
 }
 
 
@@ -33,7 +46,7 @@ FloatType::~FloatType()
 
 SharedType FloatType::clone() const
 {
-    return FloatType::get(m_size);
+    return std::make_shared<FloatType>(m_size);
 }
 
 
@@ -43,12 +56,6 @@ Type::Size FloatType::getSize() const
 }
 
 
-void FloatType::setSize(Type::Size sz)
-{
-    m_size = sz;
-}
-
-
 bool FloatType::operator==(const Type &other) const
 {
     if (!other.isFloat()) {
@@ -23,10 +23,12 @@ public:
 
     virtual ~FloatType() override;
 
-    FloatType &operator=(const FloatType &other) = default;
-    FloatType &operator=(FloatType &&other) = default;
+    FloatType &operator=(const FloatType &other) = delete;
+    FloatType &operator=(FloatType &&other) = delete;
 
 public:
+    /// \returns a floating point type with the given size.
+    /// Float types cannot be modified, so types of common sizes are shared.
     static std::shared_ptr<FloatType> get(Size numBits);
 
     /// \copydoc Type::operator==
@@ -41,9 +43,6 @@ public:
     /// \copydoc Type::getSize
     virtual Size getSize() const override;
 
-    /// \copydoc Type::setSize
-    virtual void setSize(Size sz) override;
-
     /// \copydoc Type::getCtype
     virtual QString getCtype(bool final = false) const override;
 
@@ -12,6 +12,9 @@
 #include "boomerang/ssl/type/SizeType.h"
 #include "boomerang/util/log/Log.h"
 
+#include <algorithm>
+#include <vector>
+
 
 IntegerType::IntegerType(Size numBits, Sign sign)
     : Type(TypeClass::Integer)
@@ -21,33 +24,59 @@ IntegerType::IntegerType(Size numBits, Sign sign)
 }
 
 
-std::shared_ptr<IntegerType> IntegerType::get(Size numBits, Sign sign)
+/// \returns \p sign after a hint that the integer is signed
+static Sign hintAsSigned(Sign sign)
 {
-    return std::make_shared<IntegerType>(numBits, sign);
+    return std::min((Sign)((int)sign + 1), Sign::SignedStrong);
 }
 
 
-SharedType IntegerType::clone() const
+/// \returns \p sign after a hint that the integer is unsigned
+static Sign hintAsUnsigned(Sign sign)
 {
-    return IntegerType::get(m_size, m_sign);
+    return std::max((Sign)((int)sign - 1), Sign::UnsignedStrong);
 }
 
 
-Type::Size IntegerType::getSize() const
+/// Number of different values of Sign
+static constexpr int NUM_SIGNS = static_cast<int>(Sign::SignedStrong) -
+                                 static_cast<int>(Sign::UnsignedStrong) + 1;
+
+
+std::shared_ptr<IntegerType> IntegerType::get(Size numBits, Sign sign)
 {
-    return m_size;
+    static const std::vector<std::shared_ptr<IntegerType>> sharedTypes = []() {
+        std::vector<std::shared_ptr<IntegerType>> types;
+        types.reserve((MAX_SHARED_SIZE + 1) * NUM_SIGNS);
+
+        for (Size size = 0; size <= MAX_SHARED_SIZE; ++size) {
+            for (int s = static_cast<int>(Sign::UnsignedStrong);
+                 s <= static_cast<int>(Sign::SignedStrong); ++s) {
+                types.push_back(std::make_shared<IntegerType>(size, static_cast<Sign>(s)));
+            }
+        }
+
+        return types;
+    }();
+
+    if (numBits > MAX_SHARED_SIZE) {
+        return std::make_shared<IntegerType>(numBits, sign);
+    }
+
+    return sharedTypes[numBits * NUM_SIGNS + static_cast<int>(sign) -
+                       static_cast<int>(Sign::UnsignedStrong)];
 }
 
 
-void IntegerType::hintAsSigned()
+SharedType IntegerType::clone() const
 {
-    m_sign = std::min((Sign)((int)m_sign + 1), Sign::SignedStrong);
+    return std::make_shared<IntegerType>(m_size, m_sign);
 }
 
 
-void IntegerType::hintAsUnsigned()
+Type::Size IntegerType::getSize() const
 {
-    m_sign = std::max((Sign)((int)m_sign - 1), Sign::UnsignedStrong);
+    return m_size;
 }
 
 
@@ -135,46 +164,44 @@ SharedType IntegerType::meetWith(SharedType other, bool &changed, bool useHighes
 
     if (other->resolvesToInteger()) {
         std::shared_ptr<IntegerType> otherInt = other->as<IntegerType>();
-        std::shared_ptr<IntegerType> result   = this->clone()->as<IntegerType>();
 
         // Signedness
+        Sign sign = m_sign;
         if (otherInt->isSigned()) {
-            result->hintAsSigned();
+            sign = hintAsSigned(sign);
         }
         else if (otherInt->isUnsigned()) {
-            result->hintAsUnsigned();
+            sign = hintAsUnsigned(sign);
         }
 
+        // Size. Assume 0 indicates unknown size
+        const IntegerType result(std::max(m_size, otherInt->m_size), sign);
+
         // Changed from signed to not necessarily signed
-        changed |= result->isSigned() != isSigned();
+        changed |= result.isSigned() != isSigned();
         // Changed from unsigned to not necessarily unsigned
-        changed |= result->isUnsigned() != isUnsigned();
-
-        // Size. Assume 0 indicates unknown size
-        result->m_size = std::max(m_size, otherInt->m_size);
-        changed |= (result->m_size != m_size);
+        changed |= result.isUnsigned() != isUnsigned();
+        changed |= (result.m_size != m_size);
 
-        return result;
+        return IntegerType::get(result.m_size, result.m_sign);
     }
     else if (other->resolvesToSize()) {
-        std::shared_ptr<IntegerType> result = std::dynamic_pointer_cast<IntegerType>(this->clone());
-        std::shared_ptr<SizeType> other_sz  = other->as<SizeType>();
+        std::shared_ptr<SizeType> other_sz = other->as<SizeType>();
 
         if (m_size == 0) { // Doubt this will ever happen
-            result->m_size = other_sz->getSize();
-            changed        = true;
-            return result;
+            changed = true;
+            return IntegerType::get(other_sz->getSize(), m_sign);
         }
 
         if (m_size == other_sz->getSize()) {
-            return result;
+            return IntegerType::get(m_size, m_sign);
         }
 
         LOG_VERBOSE("Integer size %1 meet with SizeType size %2!", m_size, other_sz->getSize());
 
-        result->m_size = std::max(m_size, other_sz->getSize());
-        changed        = result->m_size != m_size;
-        return result;
+        const Size newSize = std::max(m_size, other_sz->getSize());
+        changed            = newSize != m_size;
+        return IntegerType::get(newSize, m_sign);
     }
 
     return createUnion(other, changed, useHighestPtr);
@@ -23,10 +23,12 @@ public:
 
     virtual ~IntegerType() override = default;
 
-    IntegerType &operator=(const IntegerType &other) = default;
-    IntegerType &operator=(IntegerType &&other) = default;
+    IntegerType &operator=(const IntegerType &other) = delete;
+    IntegerType &operator=(IntegerType &&other) = delete;
 
 public:
+    /// \returns an integer type with the given size and signedness.
+    /// Integer types cannot be modified, so types of common sizes are shared.
     static std::shared_ptr<IntegerType> get(Size numBits, Sign sign = Sign::Unknown);
 
     /// \copydoc Type::operator==
@@ -47,9 +49,6 @@ public:
     /// \copydoc Type::getSize
     virtual Size getSize() const override;
 
-    /// \copydoc Type::setSize
-    virtual void setSize(Size sz) override { m_size = sz; }
-
     /// \copydoc Type::meetWith
     virtual SharedType meetWith(SharedType other, bool &changed, bool useHighestPtr) const override;
 
@@ -69,11 +68,6 @@ public:
     /// \returns true if we don't know the sign yet
     bool isSignUnknown() const { return m_sign == Sign::Unknown; }
 
-    /// A hint for signedness
-    void hintAsSigned();
-    void hintAsUnsigned();
-
-    void setSignedness(Sign sign) { m_sign = sign; }
     Sign getSign() const { return m_sign; }
 
 protected:
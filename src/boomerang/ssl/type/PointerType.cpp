@@ -58,13 +58,6 @@ Type::Size PointerType::getSize() const
 }
 
 
-void PointerType::setSize(Type::Size sz)
-{
-    Q_UNUSED(sz);
-    assert(sz == STD_SIZE);
-}
-
-
 bool PointerType::operator==(const Type &other) const
 {
     if (!other.isPointer()) {
@@ -43,9 +43,6 @@ public:
     /// \copydoc Type::getSize
     virtual Size getSize() const override;
 
-    /// \copydoc Type::setSize
-    virtual void setSize(Size sz) override;
-
     /// \copydoc Type::getCtype
     virtual QString getCtype(bool final = false) const override;
 
@@ -10,8 +10,11 @@
 #include "SizeType.h"
 
 #include "boomerang/ssl/type/ArrayType.h"
+#include "boomerang/ssl/type/IntegerType.h"
 #include "boomerang/util/log/Log.h"
 
+#include <vector>
+
 
 SizeType::SizeType()
     : Type(TypeClass::Size)
@@ -34,7 +37,7 @@ SizeType::~SizeType()
 
 SharedType SizeType::clone() const
 {
-    return SizeType::get(m_size);
+    return std::make_shared<SizeType>(m_size);
 }
 
 
@@ -62,19 +65,24 @@ bool SizeType::operator<(const Type &other) const
 
 std::shared_ptr<SizeType> SizeType::get(Type::Size sz)
 {
-    return std::make_shared<SizeType>(sz);
-}
+    static const std::vector<std::shared_ptr<SizeType>> sharedTypes = []() {
+        std::vector<std::shared_ptr<SizeType>> types;
+        types.reserve(MAX_SHARED_SIZE + 1);
 
+        for (Size size = 0; size <= MAX_SHARED_SIZE; ++size) {
+            types.push_back(std::make_shared<SizeType>(size));
+        }
 
-std::shared_ptr<SizeType> SizeType::get()
-{
-    return std::make_shared<SizeType>();
+        return types;
+    }();
+
+    return sz <= MAX_SHARED_SIZE ? sharedTypes[sz] : std::make_shared<SizeType>(sz);
 }
 
 
-void SizeType::setSize(Size sz)
+std::shared_ptr<SizeType> SizeType::get()
 {
-    m_size = sz;
+    return SizeType::get(0);
 }
 
 
@@ -107,24 +115,21 @@ SharedType SizeType::meetWith(SharedType other, bool &changed, bool useHighestPt
     }
 
     if (other->resolvesToSize()) {
-        SharedType result = this->clone();
-
         if (other->as<SizeType>()->m_size != m_size) {
             LOG_VERBOSE("Size %1 meet with size %2!", m_size, other->as<SizeType>()->m_size);
         }
 
-        const Size newSize = std::max(result->getSize(), other->as<SizeType>()->getSize());
-        changed |= (newSize != result->getSize());
-        result->setSize(newSize);
-        return result;
+        const Size newSize = std::max(m_size, other->as<SizeType>()->getSize());
+        changed |= (newSize != m_size);
+        return SizeType::get(newSize);
     }
 
     changed = true;
 
     if (other->resolvesToInteger()) {
         if (other->getSize() == 0) {
-            other->setSize(m_size);
-            return other->clone();
+            // Do not modify other; it might be shared.
+            return IntegerType::get(m_size, other->as<IntegerType>()->getSign());
         }
 
         if (other->getSize() != m_size) {
@@ -28,10 +28,12 @@ public:
 
     virtual ~SizeType() override;
 
-    SizeType &operator=(const SizeType &other) = default;
-    SizeType &operator=(SizeType &&other) = default;
+    SizeType &operator=(const SizeType &other) = delete;
+    SizeType &operator=(SizeType &&other) = delete;
 
 public:
+    /// \returns a size type with the given size.
+    /// Size types cannot be modified, so types of common sizes are shared.
     static std::shared_ptr<SizeType> get();
     static std::shared_ptr<SizeType> get(Size sz);
 
@@ -47,9 +49,6 @@ public:
     /// \copydoc Type::getSize
     virtual Size getSize() const override;
 
-    /// \copydoc Type::setSize
-    virtual void setSize(Size sz) override;
-
     /// \copydoc Type::isComplete
     virtual bool isComplete() override;
 
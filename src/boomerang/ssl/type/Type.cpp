@@ -37,11 +37,16 @@
 
 #include <cassert>
 #include <cstring>
+#include <shared_mutex>
 
 
 /// For NamedType
 static QMap<QString, SharedType> g_namedTypes;
 
+/// Protects g_namedTypes. Named types are looked up concurrently during decompilation,
+/// but only declared while loading signatures.
+static std::shared_mutex g_namedTypesMutex;
+
 
 Type::Type(TypeClass _class)
     : m_id(_class)
@@ -54,12 +59,6 @@ Type::~Type()
 }
 
 
-void Type::setSize(Type::Size)
-{
-    assert(false); /* Redefined in subclasses. */
-}
-
-
 bool Type::isCString() const
 {
     return (resolvesToPointer() && this->as<PointerType>()->getPointsTo()->resolvesToChar()) ||
@@ -75,11 +74,17 @@ bool Type::operator!=(const Type &other) const
 
 void Type::addNamedType(const QString &name, SharedType type)
 {
-    if (g_namedTypes.find(name) != g_namedTypes.end()) {
-        if (!(*type == *g_namedTypes[name])) {
+    // Note: Do not compare or clone types while holding the lock,
+    // since this might look up named types.
+    SharedType existing = getNamedType(name);
+
+    if (existing) {
+        if (!(*type == *existing)) {
             LOG_WARN("Redefinition of type %1", name);
             LOG_WARN(" type     = %1", type->getCtype());
-            LOG_WARN(" previous = %1", g_namedTypes[name]->getCtype());
+            LOG_WARN(" previous = %1", existing->getCtype());
+
+            std::unique_lock<std::shared_mutex> lock(g_namedTypesMutex);
             g_namedTypes[name] = type; // WARN: was *type==*namedTypes[name], verify !
         }
     }
@@ -89,18 +94,18 @@ void Type::addNamedType(const QString &name, SharedType type)
         // typedef a b;
         // we then need to define b as int
         // we create clones to keep the GC happy
-        if (g_namedTypes.find(type->getCtype()) != g_namedTypes.end()) {
-            g_namedTypes[name] = g_namedTypes[type->getCtype()]->clone();
-        }
-        else {
-            g_namedTypes[name] = type->clone();
-        }
+        SharedType aliased = getNamedType(type->getCtype());
+        SharedType newType = aliased ? aliased->clone() : type->clone();
+
+        std::unique_lock<std::shared_mutex> lock(g_namedTypesMutex);
+        g_namedTypes[name] = newType;
     }
 }
 
 
 SharedType Type::getNamedType(const QString &name)
 {
+    std::shared_lock<std::shared_mutex> lock(g_namedTypesMutex);
     auto iter = g_namedTypes.find(name);
 
     return (iter != g_namedTypes.end()) ? *iter : nullptr;
@@ -109,6 +114,7 @@ SharedType Type::getNamedType(const QString &name)
 
 void Type::clearNamedTypes()
 {
+    std::unique_lock<std::shared_mutex> lock(g_namedTypesMutex);
     g_namedTypes.clear();
 }
 
@@ -286,6 +292,10 @@ SharedType Type::createUnion(SharedType other, bool &changed, bool useHighestPtr
 
 bool Type::isCompatibleWith(const Type &other, bool all /* = false */) const
 {
+    if (this == &other) {
+        return true; // e.g. shared integer types
+    }
+
     // Note: to prevent infinite recursion, CompoundType, ArrayType, and UnionType
     // implement this function as a delegation to isCompatible()
     if (other.resolvesToCompound() || other.resolvesToArray() || other.resolvesToUnion()) {
@@ -69,6 +69,10 @@ class BOOMERANG_API Type : public std::enable_shared_from_this<Type>
 public:
     typedef uint64 Size;
 
+    /// Integer, float and size types of at most this size (in bits) are immutable
+    /// and shared between all users (see e.g. IntegerType::get).
+    static constexpr Size MAX_SHARED_SIZE = 128;
+
 public:
     // Constructors
     Type(TypeClass id);
@@ -157,9 +161,6 @@ public:
     /// Does not include struct padding.
     Size getSizeInBytes() const { return (getSize() + 7) / 8; }
 
-    /// Changes the bit size of this type.
-    virtual void setSize(Size newSize);
-
 public:
     /// Resolve the original type across named types.
     /// If the type is not named, return this.
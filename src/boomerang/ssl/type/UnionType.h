@@ -27,6 +27,8 @@ struct BOOMERANG_API lessType
 /// between unrelated types.
 class BOOMERANG_API UnionType : public Type
 {
+    friend class SaveFileReader;
+
 public:
     typedef std::pair<SharedType, QString> Member;
 
@@ -82,6 +84,9 @@ public:
     /// \returns the number of distinct types in this union.
     size_t getNumTypes() const;
 
+    /// \returns the members of this union.
+    const UnionEntries &getEntries() const { return m_entries; }
+
     /// \returns true if this type is already in the union.
     bool hasType(SharedType ty);
 
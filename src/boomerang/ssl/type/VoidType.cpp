@@ -23,6 +23,13 @@ VoidType::~VoidType()
 }
 
 
+std::shared_ptr<VoidType> VoidType::get()
+{
+    static const std::shared_ptr<VoidType> voidType = std::make_shared<VoidType>();
+    return voidType;
+}
+
+
 SharedType VoidType::clone() const
 {
     return VoidType::get();
@@ -27,7 +27,8 @@ public:
     VoidType &operator=(VoidType &&other) = default;
 
 public:
-    static std::shared_ptr<VoidType> get() { return std::make_shared<VoidType>(); }
+    /// \returns the void type. Since it has no properties, it is shared between all users.
+    static std::shared_ptr<VoidType> get();
 
     /// \copydoc Type::operator==
     virtual bool operator==(const Type &other) const override;
@@ -0,0 +1,152 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BitSet.h"
+
+#include "boomerang/util/OStream.h"
+
+#include <algorithm>
+#include <bitset>
+
+
+BitSet::BitSet(std::size_t numBits)
+{
+    resize(numBits);
+}
+
+
+bool BitSet::operator==(const BitSet &other) const
+{
+    const std::size_t common = std::min(m_words.size(), other.m_words.size());
+
+    if (!std::equal(m_words.begin(), m_words.begin() + common, other.m_words.begin())) {
+        return false;
+    }
+
+    // The remaining words of the larger set must not have any bits set
+    const std::vector<Word> &larger = m_words.size() > common ? m_words : other.m_words;
+    return std::all_of(larger.begin() + common, larger.end(), [](Word w) { return w == 0; });
+}
+
+
+BitSet &BitSet::operator|=(const BitSet &other)
+{
+    if (other.m_numBits > m_numBits) {
+        resize(other.m_numBits);
+    }
+
+    for (std::size_t i = 0; i < other.m_words.size(); i++) {
+        m_words[i] |= other.m_words[i];
+    }
+
+    return *this;
+}
+
+
+void BitSet::resize(std::size_t numBits)
+{
+    if (numBits < m_numBits && numBits % BITS_PER_WORD != 0) {
+        // Clear the bits that are cut off in the last word,
+        // so they are not set again when growing the set
+        m_words[numBits / BITS_PER_WORD] &= bit(numBits) - 1;
+    }
+
+    m_words.resize((numBits + BITS_PER_WORD - 1) / BITS_PER_WORD, 0);
+    m_numBits = numBits;
+}
+
+
+void BitSet::set(std::size_t i)
+{
+    if (i >= m_numBits) {
+        // Grow geometrically to keep repeated growing cheap
+        resize(std::max(i + 1, 2 * m_numBits));
+    }
+
+    m_words[i / BITS_PER_WORD] |= bit(i);
+}
+
+
+void BitSet::reset(std::size_t i)
+{
+    if (i < m_numBits) {
+        m_words[i / BITS_PER_WORD] &= ~bit(i);
+    }
+}
+
+
+void BitSet::reset()
+{
+    std::fill(m_words.begin(), m_words.end(), 0);
+}
+
+
+bool BitSet::none() const
+{
+    return std::all_of(m_words.begin(), m_words.end(), [](Word w) { return w == 0; });
+}
+
+
+std::size_t BitSet::count() const
+{
+    std::size_t n = 0;
+
+    for (Word w : m_words) {
+        n += std::bitset<BITS_PER_WORD>(w).count();
+    }
+
+    return n;
+}
+
+
+std::size_t BitSet::findNext(std::size_t i) const
+{
+    std::size_t wordIdx = i / BITS_PER_WORD;
+
+    if (wordIdx >= m_words.size()) {
+        return npos;
+    }
+
+    // Ignore the bits before i in the first word
+    Word w = m_words[wordIdx] & ~(bit(i) - 1);
+
+    while (w == 0) {
+        if (++wordIdx == m_words.size()) {
+            return npos;
+        }
+
+        w = m_words[wordIdx];
+    }
+
+    std::size_t bitIdx = 0;
+    while ((w & (Word(1) << bitIdx)) == 0) {
+        bitIdx++;
+    }
+
+    return wordIdx * BITS_PER_WORD + bitIdx;
+}
+
+
+QString BitSet::toString() const
+{
+    QString tgt;
+    OStream ost(&tgt);
+
+    const std::size_t first = findFirst();
+
+    for (std::size_t i = first; i != npos; i = findNext(i + 1)) {
+        if (i != first) {
+            ost << ", ";
+        }
+
+        ost << static_cast<int>(i);
+    }
+
+    return tgt;
+}
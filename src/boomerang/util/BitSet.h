@@ -0,0 +1,96 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <QString>
+
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * A set of small non-negative integers (e.g. dense indices of locations),
+ * stored as a bit vector that grows as needed.
+ * Bits beyond the size of the set are treated as cleared.
+ */
+class BOOMERANG_API BitSet
+{
+public:
+    /// Returned by findNext if there is no set bit.
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+public:
+    BitSet() = default;
+    explicit BitSet(std::size_t numBits);
+    BitSet(const BitSet &other) = default;
+    BitSet(BitSet &&other)      = default;
+
+    ~BitSet() = default;
+
+    BitSet &operator=(const BitSet &other) = default;
+    BitSet &operator=(BitSet &&other) = default;
+
+public:
+    /// Two sets are equal if they have the same bits set, regardless of their size.
+    bool operator==(const BitSet &other) const;
+    bool operator!=(const BitSet &other) const { return !(*this == other); }
+
+    /// Set all bits that are set in \p other.
+    BitSet &operator|=(const BitSet &other);
+
+public:
+    /// \returns the number of bits in the set
+    std::size_t size() const { return m_numBits; }
+
+    /// Change the number of bits to \p numBits. New bits are cleared.
+    void resize(std::size_t numBits);
+
+    /// \returns true if bit \p i is set.
+    bool test(std::size_t i) const
+    {
+        return i < m_numBits && (m_words[i / BITS_PER_WORD] & bit(i)) != 0;
+    }
+
+    /// Set bit \p i, growing the set if necessary.
+    void set(std::size_t i);
+
+    /// Clear bit \p i.
+    void reset(std::size_t i);
+
+    /// Clear all bits. The size of the set is not changed.
+    void reset();
+
+    /// \returns true if no bit is set.
+    bool none() const;
+
+    /// \returns the number of set bits.
+    std::size_t count() const;
+
+    /// \returns the index of the first set bit at or after \p i, or npos if there is none.
+    std::size_t findNext(std::size_t i) const;
+
+    /// \returns the index of the first set bit, or npos if no bit is set.
+    std::size_t findFirst() const { return findNext(0); }
+
+    QString toString() const; ///< Print to string for debugging
+
+private:
+    typedef uint64_t Word;
+    static constexpr std::size_t BITS_PER_WORD = 64;
+
+    static Word bit(std::size_t i) { return Word(1) << (i % BITS_PER_WORD); }
+
+private:
+    std::vector<Word> m_words;
+    std::size_t m_numBits = 0;
+};
@@ -12,69 +12,47 @@
 #include "boomerang/ssl/exp/RefExp.h"
 #include "boomerang/util/log/Log.h"
 
-
-ConnectionGraph::iterator ConnectionGraph::begin()
-{
-    return emap.begin();
-}
-
-
-ConnectionGraph::iterator ConnectionGraph::end()
-{
-    return emap.end();
-}
+#include <algorithm>
+#include <numeric>
 
 
 ConnectionGraph::const_iterator ConnectionGraph::begin() const
 {
-    return emap.begin();
+    return getSortedConnections().begin();
 }
 
 
 ConnectionGraph::const_iterator ConnectionGraph::end() const
 {
-    return emap.end();
-}
-
-
-ConnectionGraph::reverse_iterator ConnectionGraph::rbegin()
-{
-    return emap.rbegin();
-}
-
-
-ConnectionGraph::reverse_iterator ConnectionGraph::rend()
-{
-    return emap.rend();
+    return getSortedConnections().end();
 }
 
 
 ConnectionGraph::const_reverse_iterator ConnectionGraph::rbegin() const
 {
-    return emap.rbegin();
+    return getSortedConnections().rbegin();
 }
 
 
 ConnectionGraph::const_reverse_iterator ConnectionGraph::rend() const
 {
-    return emap.rend();
+    return getSortedConnections().rend();
 }
 
 
 bool ConnectionGraph::add(SharedExp a, SharedExp b)
 {
-    iterator ff = emap.find(a);
+    const int ia = getIndex(a);
+    const int ib = getIndex(b);
 
-    while (ff != emap.end() && *ff->first == *a) {
-        if (*ff->second == *b) {
-            return false; // Don't add a second entry
-        }
-
-        ++ff;
+    if (m_matrix.test(bitIndex(ia, ib))) {
+        return false; // Don't add a second entry
     }
 
-    emap.insert({ a, b });
-    emap.insert({ b, a });
+    m_matrix.set(bitIndex(ia, ib));
+    m_adjacent[ia].push_back({ a, b });
+    m_adjacent[ib].push_back({ b, a });
+    m_sortedValid = false;
 
     return true;
 }
@@ -83,11 +61,12 @@ bool ConnectionGraph::add(SharedExp a, SharedExp b)
 std::vector<SharedExp> ConnectionGraph::allConnected(SharedExp a)
 {
     std::vector<SharedExp> res;
-    const_iterator ff = emap.find(a);
+    const int ia = findIndex(a);
 
-    while (ff != emap.end() && *ff->first == *a) {
-        res.push_back(ff->second);
-        ++ff;
+    if (ia != -1) {
+        for (const Connection &conn : m_adjacent[ia]) {
+            res.push_back(conn.second);
+        }
     }
 
     return res;
@@ -115,42 +94,28 @@ void ConnectionGraph::connect(SharedExp a, SharedExp b)
 
 int ConnectionGraph::count(SharedExp e) const
 {
-    const_iterator ff = emap.find(e);
-    int n             = 0;
-
-    while (ff != emap.end() && *ff->first == *e) {
-        ++n;
-        ++ff;
-    }
-
-    return n;
+    const int idx = findIndex(e);
+    return idx != -1 ? static_cast<int>(m_adjacent[idx].size()) : 0;
 }
 
 
 bool ConnectionGraph::isConnected(SharedExp a, const Exp &b) const
 {
-    const_iterator ff = emap.find(a);
+    const int ia = findIndex(a);
 
-    while (ff != emap.end() && *ff->first == *a) {
-        if (*ff->second == b) {
-            return true; // Found the connection
-        }
+    // b is only used for the lookup, so it does not have to be owned
+    const int ib = ia != -1 ? findIndex(SharedConstExp(SharedConstExp(), &b)) : -1;
 
-        ++ff;
-    }
-
-    return false;
+    return ib != -1 && m_matrix.test(bitIndex(ia, ib));
 }
 
 
 bool ConnectionGraph::allRefsHaveDefs() const
 {
-    for (auto it : *this) {
-        const std::shared_ptr<RefExp> ref = std::dynamic_pointer_cast<RefExp>(it.first);
-
-        // we just have to compare the keys
-        // since we always have a -> b and b -> a in the map
-        if (ref && !ref->getDef()) {
+    for (const SharedExp &e : m_exps) {
+        // All expressions that are connected to something are keys
+        // since we always have a -> b and b -> a in the graph
+        if (e->isSubscript() && !e->access<RefExp>()->getDef()) {
             return false;
         }
     }
@@ -165,28 +130,98 @@ void ConnectionGraph::updateConnection(SharedExp a, SharedExp b, SharedExp c)
     assert(b);
     assert(c);
 
-    // find a->b
-    iterator ff = emap.find(a);
+    const int ia = findIndex(a);
+    const int ib = ia != -1 ? findIndex(b) : -1;
 
-    while (ff != emap.end() && *ff->first == *a) {
-        if (*ff->second == *b) {
-            ff->second = c; // Now a->c
-            break;
-        }
+    if (ib == -1 || !m_matrix.test(bitIndex(ia, ib))) {
+        return;
+    }
 
-        ++ff;
+    const int ic = getIndex(c);
+
+    if (ic == ib) {
+        return;
     }
 
-    // find b -> a
-    ff = emap.find(b);
+    // Now a->c, at the position of a->b
+    std::vector<Connection> &aConns = m_adjacent[ia];
+    auto ab = std::find_if(aConns.begin(), aConns.end(), [this, ib](const Connection &conn) {
+        return findIndex(conn.second) == ib;
+    });
 
-    while (ff != emap.end() && *ff->first == *b) {
-        if (*ff->second == *a) {
-            emap.erase(ff);
-            add(c, a); // Now c->a
-            break;
-        }
+    if (m_matrix.test(bitIndex(ia, ic))) {
+        aConns.erase(ab); // already connected to c
+    }
+    else {
+        ab->second = c;
+        m_matrix.set(bitIndex(ia, ic));
+        m_adjacent[ic].push_back({ c, a }); // Now c->a
+    }
+
+    // remove b->a
+    std::vector<Connection> &bConns = m_adjacent[ib];
+    bConns.erase(std::find_if(bConns.begin(), bConns.end(), [this, ia](const Connection &conn) {
+        return findIndex(conn.second) == ia;
+    }));
+
+    m_matrix.reset(bitIndex(ia, ib));
+    m_sortedValid = false;
+}
+
+
+int ConnectionGraph::findIndex(const SharedConstExp &e) const
+{
+    auto it = m_indices.find(e);
+    return it != m_indices.end() ? it->second : -1;
+}
 
-        ++ff;
+
+int ConnectionGraph::getIndex(const SharedExp &e)
+{
+    auto it = m_indices.find(e);
+
+    if (it != m_indices.end()) {
+        return it->second;
     }
+
+    const int idx = static_cast<int>(m_exps.size());
+    m_indices.insert({ e, idx });
+    m_exps.push_back(e);
+    m_adjacent.emplace_back();
+
+    // Adding a row to the lower triangle just appends its bits to the matrix
+    m_matrix.resize(bitIndex(idx, idx) + 1);
+    return idx;
+}
+
+
+std::size_t ConnectionGraph::bitIndex(int i, int j)
+{
+    if (i < j) {
+        std::swap(i, j);
+    }
+
+    return static_cast<std::size_t>(i) * (i + 1) / 2 + j;
+}
+
+
+const std::vector<ConnectionGraph::Connection> &ConnectionGraph::getSortedConnections() const
+{
+    if (m_sortedValid) {
+        return m_sorted;
+    }
+
+    std::vector<int> order(m_exps.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [this](int i, int j) { return lessExpStar()(m_exps[i], m_exps[j]); });
+
+    m_sorted.clear();
+
+    for (int idx : order) {
+        m_sorted.insert(m_sorted.end(), m_adjacent[idx].begin(), m_adjacent[idx].end());
+    }
+
+    m_sortedValid = true;
+    return m_sorted;
 }
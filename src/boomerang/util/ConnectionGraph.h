@@ -11,8 +11,10 @@
 
 
 #include "boomerang/ssl/exp/ExpHelp.h"
+#include "boomerang/util/BitSet.h"
 
-#include <map>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 
@@ -20,30 +22,27 @@
  * A class to store connections in an undirected graph, e.g. for interferences
  * of types or live ranges, or the phi_unite relation that phi statements imply.
  *
- * \internal This is implemented in a std::multimap, even though Appel suggests a bitmap
- * (e.g. std::vector<bool> does this in a space efficient manner),
- * but then you still need maps from expression to bit number.
- * So here a standard map is used, and when a -> b is inserted, b->a is redundantly inserted.
+ * \internal As Appel suggests, connections are stored in a (triangular) bit matrix
+ * over dense indices of the expressions, so looking up a connection does not have
+ * to compare expressions. In addition, the connections of each expression are kept in
+ * the order they were added; when a -> b is inserted, b -> a is redundantly inserted.
+ * Iterating the graph visits the connections ordered by their first expression
+ * (see \ref lessExpStar), and connections of the same expression in the order they were added.
  */
 class BOOMERANG_API ConnectionGraph
 {
-    using ExpExpMap = std::multimap<SharedExp, SharedExp, lessExpStar>;
+    typedef std::pair<SharedExp, SharedExp> Connection;
 
 public:
-    typedef ExpExpMap::iterator iterator;
-    typedef ExpExpMap::const_iterator const_iterator;
-    typedef ExpExpMap::reverse_iterator reverse_iterator;
-    typedef ExpExpMap::const_reverse_iterator const_reverse_iterator;
+    typedef std::vector<Connection>::const_iterator iterator;
+    typedef std::vector<Connection>::const_iterator const_iterator;
+    typedef std::vector<Connection>::const_reverse_iterator reverse_iterator;
+    typedef std::vector<Connection>::const_reverse_iterator const_reverse_iterator;
 
 public:
-    iterator begin();
-    iterator end();
     const_iterator begin() const;
     const_iterator end() const;
 
-    reverse_iterator rbegin();
-    reverse_iterator rend();
-
     const_reverse_iterator rbegin() const;
     const_reverse_iterator rend() const;
 
@@ -78,6 +77,24 @@ public:
 private:
     std::vector<SharedExp> allConnected(SharedExp a);
 
+    /// \returns the index of \p e, or -1 if \p e is not in the graph.
+    int findIndex(const SharedConstExp &e) const;
+
+    /// \returns the index of \p e, adding \p e to the graph if necessary.
+    int getIndex(const SharedExp &e);
+
+    /// \returns the index of the bit of the connection between \p i and \p j
+    static std::size_t bitIndex(int i, int j);
+
+    /// Sort the connections for iteration, if they changed since the last time.
+    const std::vector<Connection> &getSortedConnections() const;
+
 private:
-    ExpExpMap emap; ///< The map
+    std::unordered_map<SharedConstExp, int, hashExpStar, equalExpStar> m_indices;
+    std::vector<SharedExp> m_exps;                   ///< Expressions by index
+    std::vector<std::vector<Connection>> m_adjacent; ///< Connections by index of first expression
+    BitSet m_matrix; ///< Lower triangle (including the diagonal) of the adjacency matrix
+
+    mutable std::vector<Connection> m_sorted; ///< All connections in iteration order
+    mutable bool m_sortedValid = true;
 };
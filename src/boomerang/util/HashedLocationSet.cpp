@@ -0,0 +1,261 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "HashedLocationSet.h"
+
+#include "boomerang/ssl/exp/ExpHelp.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/util/OStream.h"
+
+#include <algorithm>
+
+
+HashedLocationSet::const_iterator::const_iterator(const Entry *entry, const Entry *end)
+    : m_entry(entry)
+    , m_end(end)
+{
+    skipRemoved();
+}
+
+
+HashedLocationSet::const_iterator &HashedLocationSet::const_iterator::operator++()
+{
+    ++m_entry;
+    skipRemoved();
+    return *this;
+}
+
+
+void HashedLocationSet::const_iterator::skipRemoved()
+{
+    while (m_entry != m_end && m_entry->exp == nullptr) {
+        ++m_entry;
+    }
+}
+
+
+HashedLocationSet::HashedLocationSet(const std::initializer_list<SharedExp> &exps)
+{
+    for (const SharedExp &exp : exps) {
+        insert(exp);
+    }
+}
+
+
+HashedLocationSet::const_iterator HashedLocationSet::begin() const
+{
+    return const_iterator(getEntries(), getEntries() + m_numEntries);
+}
+
+
+HashedLocationSet::const_iterator HashedLocationSet::end() const
+{
+    return const_iterator(getEntries() + m_numEntries, getEntries() + m_numEntries);
+}
+
+
+void HashedLocationSet::clear()
+{
+    m_inline.fill(Entry());
+    m_heap.clear();
+    m_slots.clear();
+
+    m_numEntries = 0;
+    m_size       = 0;
+}
+
+
+bool HashedLocationSet::insert(const SharedExp &loc)
+{
+    const std::size_t hash = hashExpStar()(loc);
+
+    if (findLoc(loc, hash) != -1) {
+        return false;
+    }
+
+    // Do not let removed entries pile up
+    if (m_numEntries - m_size > m_size) {
+        compact();
+    }
+
+    Entry entry;
+    entry.hash = hash;
+    entry.exp  = loc;
+
+    addEntry(entry);
+    m_size++;
+    return true;
+}
+
+
+bool HashedLocationSet::remove(const SharedExp &loc)
+{
+    const int idx = findLoc(loc, hashExpStar()(loc));
+
+    if (idx == -1) {
+        return false;
+    }
+
+    // Keep the entry and its slot, so the order of the other entries and the hash table
+    // stay valid.
+    Entry &entry = m_heap.empty() ? m_inline[idx] : m_heap[idx];
+    entry.exp    = nullptr;
+    m_size--;
+    return true;
+}
+
+
+bool HashedLocationSet::contains(const SharedConstExp &loc) const
+{
+    return findLoc(loc, hashExpStar()(loc)) != -1;
+}
+
+
+SharedExp HashedLocationSet::findNS(const SharedExp &e) const
+{
+    if (e == nullptr) {
+        return nullptr;
+    }
+
+    // Definitions of subscripts are not hashed, so all e{...} have the same hash as e{-}
+    const std::size_t hash = hashExpStar()(RefExp::get(e, nullptr));
+
+    const int idx = findEntry(hash, [&e](const SharedExp &loc) {
+        return loc->isSubscript() && *loc->getSubExp1() == *e;
+    });
+
+    return idx != -1 ? getEntries()[idx].exp : nullptr;
+}
+
+
+QString HashedLocationSet::toString() const
+{
+    QString tgt;
+    OStream ost(&tgt);
+
+    for (const_iterator it = begin(); it != end(); ++it) {
+        if (it != begin()) {
+            ost << ", ";
+        }
+
+        ost << *it;
+    }
+
+    return tgt;
+}
+
+
+template<typename Pred>
+int HashedLocationSet::findEntry(std::size_t hash, const Pred &pred) const
+{
+    const Entry *entries = getEntries();
+
+    if (m_slots.empty()) {
+        for (int i = 0; i < m_numEntries; i++) {
+            if (entries[i].exp && entries[i].hash == hash && pred(entries[i].exp)) {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    // All entries with this hash are between the home slot and the next empty slot
+    int found              = -1;
+    const std::size_t mask = m_slots.size() - 1;
+
+    for (std::size_t slot = hash & mask; m_slots[slot] != -1; slot = (slot + 1) & mask) {
+        const int i = m_slots[slot];
+
+        if ((found == -1 || i < found) && entries[i].exp && entries[i].hash == hash &&
+            pred(entries[i].exp)) {
+            found = i;
+        }
+    }
+
+    return found;
+}
+
+
+int HashedLocationSet::findLoc(const SharedConstExp &loc, std::size_t hash) const
+{
+    return findEntry(hash, [&loc](const SharedExp &e) { return equalExpStar()(e, loc); });
+}
+
+
+void HashedLocationSet::addEntry(const Entry &entry)
+{
+    if (m_heap.empty() && m_numEntries < INLINE_CAPACITY) {
+        m_inline[m_numEntries++] = entry;
+        return;
+    }
+    else if (m_heap.empty()) {
+        // Move all entries out of the inline storage
+        m_heap.assign(m_inline.begin(), m_inline.begin() + m_numEntries);
+        m_inline.fill(Entry());
+    }
+
+    m_heap.push_back(entry);
+    m_numEntries++;
+
+    // Keep the load factor of the table below 1/2
+    if (static_cast<std::size_t>(2 * m_numEntries) > m_slots.size()) {
+        rehash(std::max<std::size_t>(4 * INLINE_CAPACITY, 2 * m_slots.size()));
+    }
+    else {
+        const std::size_t mask = m_slots.size() - 1;
+        std::size_t slot       = entry.hash & mask;
+
+        while (m_slots[slot] != -1) {
+            slot = (slot + 1) & mask;
+        }
+
+        m_slots[slot] = m_numEntries - 1;
+    }
+}
+
+
+void HashedLocationSet::rehash(std::size_t numSlots)
+{
+    m_slots.assign(numSlots, -1);
+    const std::size_t mask = numSlots - 1;
+
+    for (int i = 0; i < m_numEntries; i++) {
+        std::size_t slot = m_heap[i].hash & mask;
+
+        while (m_slots[slot] != -1) {
+            slot = (slot + 1) & mask;
+        }
+
+        m_slots[slot] = i;
+    }
+}
+
+
+void HashedLocationSet::compact()
+{
+    std::vector<Entry> entries;
+    entries.reserve(m_size);
+
+    for (int i = 0; i < m_numEntries; i++) {
+        const Entry &entry = getEntries()[i];
+
+        if (entry.exp) {
+            entries.push_back(entry);
+        }
+    }
+
+    clear();
+
+    for (const Entry &entry : entries) {
+        addEntry(entry);
+    }
+
+    m_size = static_cast<int>(entries.size());
+}
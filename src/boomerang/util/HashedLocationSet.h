@@ -0,0 +1,130 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/exp/Exp.h"
+
+#include <QString>
+
+#include <array>
+#include <vector>
+
+
+/**
+ * A set of (possibly subscripted) locations like LocationSet,
+ * for sets that are mostly used for lookups.
+ *
+ * Locations are compared like in LocationSet (see \ref equalExpStar).
+ * The structural hash of each location is computed once when it is inserted.
+ * Sets of up to INLINE_CAPACITY locations are stored inline and searched linearly;
+ * larger sets are indexed by an open addressing hash table.
+ *
+ * Locations are iterated in the order they were inserted, not in the order of LocationSet,
+ * so use LocationSet where the order of the locations affects the output.
+ * Unlike LocationSet, copies of the set share the locations of the original set.
+ */
+class BOOMERANG_API HashedLocationSet
+{
+    struct Entry
+    {
+        std::size_t hash = 0;
+        SharedExp exp; ///< nullptr if the location was removed
+    };
+
+public:
+    class const_iterator
+    {
+    public:
+        const_iterator(const Entry *entry, const Entry *end);
+
+        const SharedExp &operator*() const { return m_entry->exp; }
+        const SharedExp *operator->() const { return &m_entry->exp; }
+
+        const_iterator &operator++();
+
+        bool operator==(const const_iterator &other) const { return m_entry == other.m_entry; }
+        bool operator!=(const const_iterator &other) const { return m_entry != other.m_entry; }
+
+    private:
+        void skipRemoved();
+
+    private:
+        const Entry *m_entry;
+        const Entry *m_end;
+    };
+
+    typedef const_iterator iterator;
+
+    static constexpr int INLINE_CAPACITY = 8;
+
+public:
+    HashedLocationSet() = default;
+    HashedLocationSet(const std::initializer_list<SharedExp> &exps);
+    HashedLocationSet(const HashedLocationSet &other) = default;
+    HashedLocationSet(HashedLocationSet &&other)      = default;
+
+    ~HashedLocationSet() = default;
+
+    HashedLocationSet &operator=(const HashedLocationSet &other) = default;
+    HashedLocationSet &operator=(HashedLocationSet &&other) = default;
+
+public:
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    bool empty() const { return m_size == 0; }
+    int size() const { return m_size; }
+    void clear();
+
+    /// Insert \p loc, unless the set already contains it.
+    /// \returns true if \p loc was inserted.
+    bool insert(const SharedExp &loc);
+
+    /// Remove \p loc from the set.
+    /// \returns true if the set contained \p loc.
+    bool remove(const SharedExp &loc);
+
+    /// \returns true if the set contains \p loc
+    bool contains(const SharedConstExp &loc) const;
+
+    /// \copydoc LocationSet::findNS
+    /// If there is more than one such location, the location inserted first is returned.
+    SharedExp findNS(const SharedExp &e) const;
+
+    QString toString() const; ///< Print to string for debugging
+
+private:
+    const Entry *getEntries() const { return m_heap.empty() ? m_inline.data() : m_heap.data(); }
+
+    /// \returns the index of the first inserted entry with hash \p hash that satisfies \p pred,
+    /// or -1 if there is none.
+    template<typename Pred>
+    int findEntry(std::size_t hash, const Pred &pred) const;
+
+    /// \returns the index of the entry of \p loc with hash \p hash, or -1 if there is none.
+    int findLoc(const SharedConstExp &loc, std::size_t hash) const;
+
+    void addEntry(const Entry &entry);
+
+    /// Rebuild the hash table with \p numSlots slots.
+    void rehash(std::size_t numSlots);
+
+    /// Remove all entries of removed locations.
+    void compact();
+
+private:
+    std::array<Entry, INLINE_CAPACITY> m_inline;
+    std::vector<Entry> m_heap; ///< All entries, if there are more than fit into m_inline
+    std::vector<int> m_slots;  ///< Indices into m_heap, or -1 if the slot is empty
+
+    int m_numEntries = 0; ///< Number of entries, including removed ones
+    int m_size       = 0; ///< Number of locations in the set
+};
@@ -0,0 +1,252 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "MemoryArena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <map>
+#include <new>
+#include <shared_mutex>
+
+
+/// Objects allocated by allocateObject from an arena are prefixed by a reference to their arena.
+typedef std::shared_ptr<MemoryArena> ObjectHeader;
+
+static constexpr std::size_t OBJECT_HEADER_SIZE = ((sizeof(ObjectHeader) +
+                                                    alignof(std::max_align_t) - 1) /
+                                                   alignof(std::max_align_t)) *
+                                                  alignof(std::max_align_t);
+
+static thread_local MemoryArena *g_currentArena = nullptr;
+
+
+/// Address ranges of the blocks of all arenas, so deallocateObject can tell
+/// objects allocated from an arena apart from objects allocated on the heap.
+struct BlockRegistry
+{
+    std::shared_mutex mutex;
+    std::map<std::uintptr_t, std::uintptr_t> blocks; ///< start address -> end address
+};
+
+/// Number of blocks in the registry. As long as no arena is used, objects are released
+/// without looking at the registry.
+static std::atomic<std::size_t> g_numArenaBlocks(0);
+
+
+static BlockRegistry &getBlockRegistry()
+{
+    // Never deleted, so objects can still be released while static objects are destroyed.
+    static BlockRegistry *registry = new BlockRegistry();
+    return *registry;
+}
+
+
+MemoryArena::Scope::Scope(const std::shared_ptr<MemoryArena> &arena)
+    : m_prevArena(g_currentArena)
+{
+    g_currentArena = arena.get();
+}
+
+
+MemoryArena::Scope::~Scope()
+{
+    g_currentArena = m_prevArena;
+}
+
+
+MemoryArena::MemoryArena(std::size_t blockSize)
+    : m_blockSize(blockSize)
+{
+    assert(m_blockSize > 0);
+}
+
+
+MemoryArena::~MemoryArena()
+{
+    assert(g_currentArena != this);
+
+    if (m_blocks.empty()) {
+        return;
+    }
+
+    BlockRegistry &registry = getBlockRegistry();
+    std::unique_lock<std::shared_mutex> lock(registry.mutex);
+
+    for (const std::unique_ptr<char[]> &block : m_blocks) {
+        registry.blocks.erase(reinterpret_cast<std::uintptr_t>(block.get()));
+    }
+
+    g_numArenaBlocks -= m_blocks.size();
+}
+
+
+void *MemoryArena::allocate(std::size_t size, std::size_t alignment)
+{
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const int sizeClass = getSizeClass(size, alignment);
+
+    if (sizeClass < 0) {
+        m_numBytesAllocated += size;
+        return allocateFromBlock(size, alignment);
+    }
+
+    const std::size_t chunkSize = sizeClass * SIZE_CLASS_GRANULARITY;
+    m_numBytesAllocated += chunkSize;
+
+    FreeChunk *chunk = m_freeLists[sizeClass];
+    if (chunk != nullptr) {
+        m_freeLists[sizeClass] = chunk->next;
+        return chunk;
+    }
+
+    return allocateFromBlock(chunkSize, SIZE_CLASS_GRANULARITY);
+}
+
+
+void MemoryArena::deallocate(void *ptr, std::size_t size, std::size_t alignment)
+{
+    if (ptr == nullptr) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const int sizeClass = getSizeClass(size, alignment);
+
+    if (sizeClass < 0) {
+        // large allocations are rare; they are released together with the arena
+        m_numBytesAllocated -= size;
+        return;
+    }
+
+    FreeChunk *chunk       = new (ptr) FreeChunk{ m_freeLists[sizeClass] };
+    m_freeLists[sizeClass] = chunk;
+    m_numBytesAllocated -= sizeClass * SIZE_CLASS_GRANULARITY;
+}
+
+
+std::size_t MemoryArena::getNumBytesAllocated() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numBytesAllocated;
+}
+
+
+MemoryArena *MemoryArena::getCurrent()
+{
+    return g_currentArena;
+}
+
+
+void *MemoryArena::allocateObject(std::size_t size)
+{
+    MemoryArena *arena = getCurrent();
+
+    if (arena == nullptr) {
+        return ::operator new(size);
+    }
+
+    void *mem = arena->allocate(OBJECT_HEADER_SIZE + size, alignof(std::max_align_t));
+    new (mem) ObjectHeader(arena->shared_from_this());
+
+    return static_cast<char *>(mem) + OBJECT_HEADER_SIZE;
+}
+
+
+void MemoryArena::deallocateObject(void *ptr, std::size_t size)
+{
+    if (ptr == nullptr) {
+        return;
+    }
+    else if (!isArenaMemory(ptr)) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    char *mem            = static_cast<char *>(ptr) - OBJECT_HEADER_SIZE;
+    ObjectHeader *header = reinterpret_cast<ObjectHeader *>(mem);
+
+    // Releasing the last reference destroys the arena (and the memory of the header),
+    // so move the reference out of the header first.
+    ObjectHeader arena = std::move(*header);
+    header->~ObjectHeader();
+
+    arena->deallocate(mem, OBJECT_HEADER_SIZE + size, alignof(std::max_align_t));
+}
+
+
+bool MemoryArena::isArenaMemory(const void *ptr)
+{
+    if (g_numArenaBlocks == 0) {
+        return false;
+    }
+
+    const std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(ptr);
+    BlockRegistry &registry   = getBlockRegistry();
+    std::shared_lock<std::shared_mutex> lock(registry.mutex);
+
+    auto it = registry.blocks.upper_bound(addr);
+    if (it == registry.blocks.begin()) {
+        return false;
+    }
+
+    --it;
+    return addr < it->second;
+}
+
+
+int MemoryArena::getSizeClass(std::size_t size, std::size_t alignment)
+{
+    if (size == 0 || size > MAX_SMALL_SIZE || alignment > SIZE_CLASS_GRANULARITY) {
+        return -1;
+    }
+
+    return static_cast<int>((size + SIZE_CLASS_GRANULARITY - 1) / SIZE_CLASS_GRANULARITY);
+}
+
+
+void *MemoryArena::allocateFromBlock(std::size_t size, std::size_t alignment)
+{
+    std::size_t padding = (alignment - reinterpret_cast<std::uintptr_t>(m_current) % alignment) %
+                          alignment;
+
+    if (m_current == nullptr || padding + size > m_remaining) {
+        addBlock(size + alignment);
+        padding = (alignment - reinterpret_cast<std::uintptr_t>(m_current) % alignment) %
+                  alignment;
+    }
+
+    void *result = m_current + padding;
+    m_current += padding + size;
+    m_remaining -= padding + size;
+
+    return result;
+}
+
+
+void MemoryArena::addBlock(std::size_t minSize)
+{
+    const std::size_t size = std::max(minSize, m_blockSize);
+
+    m_blocks.emplace_back(new char[size]);
+    m_current   = m_blocks.back().get();
+    m_remaining = size;
+    m_numBytesReserved += size;
+
+    BlockRegistry &registry = getBlockRegistry();
+    std::unique_lock<std::shared_mutex> lock(registry.mutex);
+
+    registry.blocks[reinterpret_cast<std::uintptr_t>(m_current)] =
+        reinterpret_cast<std::uintptr_t>(m_current + size);
+    g_numArenaBlocks++;
+}
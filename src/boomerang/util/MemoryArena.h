@@ -0,0 +1,204 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+/**
+ * A bump allocator. Memory is handed out sequentially from large blocks
+ * and is only returned to the system as a whole when the arena is destroyed.
+ * Small allocations that are released are put on a free list for their size class
+ * and are reused by later allocations of the same size class, so temporary objects
+ * do not accumulate for the lifetime of the arena.
+ *
+ * Every object allocated from an arena keeps the arena alive, so the arena
+ * can be dropped at any time by its owner (e.g. when a procedure is re-decoded);
+ * the memory is released in one go as soon as the last object allocated from it is destroyed.
+ *
+ * Objects are allocated from the arena of the current thread (see \ref Scope).
+ * If there is no current arena, objects are allocated on the heap as usual, without any
+ * overhead. Only objects allocated from an arena are prefixed by a reference to the arena.
+ * Objects may be released from any thread.
+ */
+class BOOMERANG_API MemoryArena : public std::enable_shared_from_this<MemoryArena>
+{
+public:
+    /// Makes an arena the current arena of the calling thread for the lifetime of the scope.
+    class BOOMERANG_API Scope
+    {
+    public:
+        /// \param arena the new current arena. If nullptr, objects will be allocated on the heap.
+        explicit Scope(const std::shared_ptr<MemoryArena> &arena);
+        Scope(const Scope &other) = delete;
+        Scope(Scope &&other)      = delete;
+
+        ~Scope();
+
+        Scope &operator=(const Scope &other) = delete;
+        Scope &operator=(Scope &&other) = delete;
+
+    private:
+        MemoryArena *m_prevArena;
+    };
+
+public:
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    /// Granularity and alignment of small allocations
+    static constexpr std::size_t SIZE_CLASS_GRANULARITY = 16;
+
+    /// Largest allocation that is reused after it has been released
+    static constexpr std::size_t MAX_SMALL_SIZE = 512;
+
+public:
+    explicit MemoryArena(std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+    MemoryArena(const MemoryArena &other) = delete;
+    MemoryArena(MemoryArena &&other)      = delete;
+
+    ~MemoryArena();
+
+    MemoryArena &operator=(const MemoryArena &other) = delete;
+    MemoryArena &operator=(MemoryArena &&other) = delete;
+
+public:
+    /// \returns \p size bytes of uninitialized memory aligned to \p alignment.
+    void *allocate(std::size_t size, std::size_t alignment);
+
+    /// Release memory obtained from \ref allocate with the same \p size and \p alignment.
+    void deallocate(void *ptr, std::size_t size, std::size_t alignment);
+
+    /// \returns the number of bytes currently handed out by this arena.
+    std::size_t getNumBytesAllocated() const;
+
+    /// \returns the number of bytes reserved from the system by this arena.
+    std::size_t getNumBytesReserved() const { return m_numBytesReserved; }
+
+public:
+    /// \returns the current arena of the calling thread, or nullptr if there is none.
+    static MemoryArena *getCurrent();
+
+    /**
+     * Allocate memory for an object of \p size bytes from the current arena,
+     * or from the heap if there is no current arena.
+     * Intended to be used by class specific operator new.
+     * The memory must be released by \ref deallocateObject.
+     */
+    static void *allocateObject(std::size_t size);
+
+    /// Release memory of an object of \p size bytes obtained from \ref allocateObject.
+    static void deallocateObject(void *ptr, std::size_t size);
+
+    /// \returns true if \p ptr points into a block of any existing arena.
+    static bool isArenaMemory(const void *ptr);
+
+    /// Create a shared object in the current arena, or on the heap if there is no current arena.
+    template<typename T, typename... Args>
+    static std::shared_ptr<T> makeShared(Args &&... args);
+
+private:
+    /// \returns the free list index for an allocation of \p size bytes aligned to \p alignment,
+    /// or -1 if the allocation is not reused.
+    static int getSizeClass(std::size_t size, std::size_t alignment);
+
+    /// Allocate \p size bytes from the current block. Requires m_mutex to be locked.
+    void *allocateFromBlock(std::size_t size, std::size_t alignment);
+
+    /// Reserve a new block of at least \p minSize bytes
+    void addBlock(std::size_t minSize);
+
+private:
+    /// Memory released by an object is linked into the free list of its size class.
+    struct FreeChunk
+    {
+        FreeChunk *next;
+    };
+
+    mutable std::mutex m_mutex;
+
+    std::size_t m_blockSize;
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    char *m_current         = nullptr; ///< Next free byte in the current block
+    std::size_t m_remaining = 0;       ///< Number of free bytes in the current block
+
+    FreeChunk *m_freeLists[MAX_SMALL_SIZE / SIZE_CLASS_GRANULARITY + 1] = {};
+
+    std::size_t m_numBytesAllocated = 0;
+    std::size_t m_numBytesReserved  = 0;
+};
+
+
+/**
+ * Standard allocator allocating from a MemoryArena, for use with std::allocate_shared.
+ * Released memory is reused by the arena for later allocations.
+ */
+template<typename T>
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+
+public:
+    explicit ArenaAllocator(std::shared_ptr<MemoryArena> arena)
+        : m_arena(std::move(arena))
+    {
+    }
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other)
+        : m_arena(other.getArena())
+    {
+    }
+
+public:
+    T *allocate(std::size_t n)
+    {
+        return static_cast<T *>(m_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *ptr, std::size_t n) { m_arena->deallocate(ptr, n * sizeof(T), alignof(T)); }
+
+    const std::shared_ptr<MemoryArena> &getArena() const { return m_arena; }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U> &other) const
+    {
+        return m_arena == other.getArena();
+    }
+
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U> &other) const
+    {
+        return m_arena != other.getArena();
+    }
+
+private:
+    std::shared_ptr<MemoryArena> m_arena;
+};
+
+
+template<typename T, typename... Args>
+std::shared_ptr<T> MemoryArena::makeShared(Args &&... args)
+{
+    MemoryArena *arena = getCurrent();
+
+    if (arena == nullptr) {
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    }
+
+    return std::allocate_shared<T>(ArenaAllocator<T>(arena->shared_from_this()),
+                                   std::forward<Args>(args)...);
+}
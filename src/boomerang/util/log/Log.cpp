@@ -17,12 +17,27 @@
 #include "boomerang/util/Util.h"
 #include "boomerang/util/log/ConsoleLogSink.h"
 #include "boomerang/util/log/FileLogSink.h"
+#include "boomerang/util/log/LogWriter.h"
 
 #include <QDir>
 #include <QFileInfo>
 
 
-static Log *g_log = nullptr;
+std::atomic<LogLevel> Log::s_defaultLevel(LogLevel::Default);
+
+
+/// Substitutes captured log arguments, in the same way as QString::arg
+struct LogArgFormatter
+{
+    const QString &msg;
+
+    QString operator()(const QString &arg) const { return msg.arg(arg); }
+    QString operator()(qlonglong arg) const { return msg.arg(arg); }
+    QString operator()(qulonglong arg) const { return msg.arg(arg); }
+    QString operator()(double arg) const { return msg.arg(arg); }
+    QString operator()(QChar arg) const { return msg.arg(arg); }
+    QString operator()(Address arg) const { return msg.arg(arg.toString()); }
+};
 
 
 Log::Log(LogLevel level)
@@ -47,31 +62,35 @@ Log::~Log()
 
 Log &Log::getOrCreateLog()
 {
-    if (!g_log) {
-        g_log = new Log(LogLevel::Default);
-    }
-
-    return *g_log;
+    static Log *defaultLog = new Log(LogLevel::Default);
+    return *defaultLog;
 }
 
 
 void Log::flush()
 {
-    for (std::unique_ptr<ILogSink> &s : m_sinks) {
-        s->flush();
+    if (LogWriter *writer = LogWriter::getIfStarted()) {
+        writer->flush();
     }
+
+    flushSinks();
 }
 
 
 void Log::log(LogLevel level, const char *file, int line, const QString &msg)
 {
-    const QStringList msgLines = msg.split('\n');
-
-    for (const QString &msgLine : msgLines) {
-        logDirect(level, file, line, msgLine);
+    if (!canLog(level)) {
+        return;
     }
 
-    flush();
+    LogRecord record;
+    record.log   = this;
+    record.level = level;
+    record.file  = file;
+    record.line  = line;
+    record.msg   = msg;
+
+    submit(std::move(record));
 }
 
 
@@ -81,14 +100,10 @@ void Log::logDirect(LogLevel level, const char *file, int line, const QString &m
         return;
     }
 
-    char prettyFile[40]; // truncated file name
-    truncateFileName(prettyFile, 40, file);
-
-    QString header  = "%1 | %2 | %3 | %4\n";
-    QString logLine = header.arg(levelToString(level)).arg(prettyFile).arg(line, 4).arg(msg);
-    this->write(logLine);
+    writeLine(level, file, line, msg);
 
     if (level == LogLevel::Fatal) {
+        flush();
         abort();
     }
 }
@@ -98,6 +113,11 @@ void Log::addLogSink(std::unique_ptr<ILogSink> s)
 {
     assert(s != nullptr);
 
+    // Pending messages still go to the old sinks
+    flush();
+
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+
     if (std::find(m_sinks.begin(), m_sinks.end(), s) == m_sinks.end()) {
         m_sinks.push_back(std::move(s));
     }
@@ -112,6 +132,10 @@ void Log::addDefaultLogSinks(const QString &outputDir)
     addLogSink(std::make_unique<FileLogSink>(fi.absoluteFilePath()));
 
     writeLogHeader();
+
+    // This is only done by the applications, so we do not replace the crash handlers
+    // of e.g. the test framework.
+    LogWriter::installCrashHandler();
 }
 
 
@@ -119,6 +143,7 @@ void Log::removeAllSinks()
 {
     flush();
 
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
     m_sinks.clear();
 }
 
@@ -126,6 +151,11 @@ void Log::removeAllSinks()
 Log &Log::setLogLevel(LogLevel level)
 {
     m_level = level;
+
+    if (this == &getOrCreateLog()) {
+        s_defaultLevel = level;
+    }
+
     return *this;
 }
 
@@ -144,8 +174,10 @@ bool Log::canLog(LogLevel level) const
 
 void Log::writeLogHeader()
 {
+    std::unique_lock<std::recursive_mutex> lock(m_writeMutex);
     this->write("Level | File                                    | Line | Message\n");
     this->write(QString(100, '=') + "\n");
+    lock.unlock();
 
     LOG_MSG("This is Boomerang " BOOMERANG_VERSION);
     LOG_MSG("Log initialized.");
@@ -170,48 +202,100 @@ void Log::truncateFileName(char *dstBuffer, size_t dstCharacters, const char *fi
 }
 
 
-QString Log::collectArg(const QString &msg, const Statement *s)
+LogArg Log::captureArg(const Statement *s)
 {
-    return msg.arg(s->toString());
+    return s->toString();
 }
 
 
-QString Log::collectArg(const QString &msg, const SharedConstExp &e)
+LogArg Log::captureArg(const SharedConstExp &e)
 {
     QString tgt;
     OStream os(&tgt);
     os << e;
-    return msg.arg(tgt);
+    return tgt;
+}
+
+
+LogArg Log::captureArg(const SharedType &ty)
+{
+    return ty->toString();
 }
 
 
-QString Log::collectArg(const QString &msg, const SharedType &ty)
+LogArg Log::captureArg(const Type &ty)
 {
-    return msg.arg(ty->toString());
+    return ty.toString();
 }
 
 
-QString Log::collectArg(const QString &msg, const Type &ty)
+LogArg Log::captureArg(const RTL *r)
 {
-    return msg.arg(ty.toString());
+    return r->toString();
 }
 
 
-QString Log::collectArg(const QString &msg, const RTL *r)
+LogArg Log::captureArg(const LocationSet *l)
 {
-    return msg.arg(r->toString());
+    return l->toString();
 }
 
 
-QString Log::collectArg(const QString &msg, Address a)
+void Log::submit(LogRecord &&record)
 {
-    return msg.arg(a.toString());
+    const LogLevel level = record.level;
+
+    if (!LogWriter::get().submit(std::move(record))) {
+        // The record was not queued, e.g. while the program exits.
+        writeRecord(record);
+        flushSinks();
+    }
+
+    if (level == LogLevel::Fatal) {
+        flush();
+        abort();
+    }
 }
 
 
-QString Log::collectArg(const QString &msg, const LocationSet *l)
+void Log::writeRecord(const LogRecord &record)
 {
-    return msg.arg(l->toString());
+    QString msg = record.msg;
+
+    for (int i = 0; i < record.numArgs; i++) {
+        msg = std::visit(LogArgFormatter{ msg }, record.args[i]);
+    }
+
+    const QStringList msgLines = msg.split('\n');
+
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+
+    for (const QString &msgLine : msgLines) {
+        writeLine(record.level, record.file, record.line, msgLine);
+    }
+}
+
+
+void Log::writeLine(LogLevel level, const char *file, int line, const QString &msg)
+{
+    char prettyFile[40]; // truncated file name
+    truncateFileName(prettyFile, 40, file);
+
+    QString header  = "%1 | %2 | %3 | %4\n";
+    QString logLine = header.arg(levelToString(level)).arg(prettyFile).arg(line, 4).arg(msg);
+
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+    this->write(logLine);
+}
+
+
+void Log::flushSinks()
+{
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+
+    for (std::unique_ptr<ILogSink> &s : m_sinks) {
+        s->flush();
+    }
 }
 
 
@@ -13,11 +13,16 @@
 #include "boomerang/util/Address.h"
 #include "boomerang/util/Types.h"
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <variant>
 #include <vector>
 
 
 class ILogSink;
+class Log;
 class Statement;
 class Exp;
 class LocationSet;
@@ -42,6 +47,28 @@ enum class LogLevel
 };
 
 
+/// An argument of a log message, captured when the message is logged.
+typedef std::variant<QString, qlonglong, qulonglong, double, QChar, Address> LogArg;
+
+
+/**
+ * A log message whose arguments have not been substituted yet.
+ * Records are formatted and written by the \ref LogWriter thread.
+ */
+struct LogRecord
+{
+    static constexpr int MAX_ARGS = 10;
+
+    Log *log         = nullptr; ///< The log to write the message to
+    LogLevel level   = LogLevel::Default;
+    const char *file = nullptr;
+    int line         = 0;
+    QString msg;
+    std::array<LogArg, MAX_ARGS> args;
+    int numArgs = 0;
+};
+
+
 /**
  * Class for logging messages, warnings and errors.
  * Logs can have multiple LogSinks to enable writing to multiple targets simultaneously.
@@ -49,6 +76,12 @@ enum class LogLevel
  * Log messages have different levels (see \ref LogLevel).
  * The default behavior is to omit verbose log messages from being logged;
  * this behavior can be overridden by calling \ref setLogLevel.
+ *
+ * Messages are not formatted by the logging thread. Instead, the message and its arguments
+ * are captured in a \ref LogRecord, which is formatted and written to the log sinks
+ * by the \ref LogWriter thread. Arguments that refer to the IR (statements, expressions etc.)
+ * are converted to strings when they are captured, since the IR may change afterwards.
+ * Call \ref flush to wait until all messages have been written.
  */
 class BOOMERANG_API Log
 {
@@ -74,6 +107,7 @@ public:
 
     /**
      * Log a message to all log sinks.
+     * Multi-line messages are split into separate log lines.
      *
      * \param level Log level, see \ref LogLevel
      * \param file  Source file from which this function was called, usually __FILE__
@@ -83,6 +117,7 @@ public:
     void log(LogLevel level, const char *file, int line, const QString &msg);
 
     /// Same as \ref Log::log, but does not split multiline strings
+    /// and writes the message immediately.
     void logDirect(LogLevel level, const char *file, int line, const QString &msg);
 
     /**
@@ -97,15 +132,37 @@ public:
     template<typename... Args>
     void log(LogLevel level, const char *file, int line, const QString &msg, Args... args)
     {
+        static_assert(sizeof...(Args) <= LogRecord::MAX_ARGS, "Too many log message arguments");
+
         if (!canLog(level)) {
             return;
         }
 
-        log(level, file, line, collectArgs(msg, args...));
+        LogRecord record;
+        record.log     = this;
+        record.level   = level;
+        record.file    = file;
+        record.line    = line;
+        record.msg     = msg;
+        record.numArgs = sizeof...(Args);
+
+        int i = 0;
+        ((record.args[i++] = captureArg(args)), ...);
+
+        submit(std::move(record));
     }
 
+    /// Wait until all messages logged so far are written, and flush all log sinks.
     void flush();
 
+    /// \returns true if messages with level \p level are logged by the default log.
+    /// This is a single atomic load, so the LOG_* macros can check it before evaluating
+    /// any arguments.
+    static bool isEnabled(LogLevel level)
+    {
+        return level <= s_defaultLevel.load(std::memory_order_relaxed);
+    }
+
     /// Add a log sink / target. Takes ownership of the pointer.
     void addLogSink(std::unique_ptr<ILogSink> s);
     void addDefaultLogSinks(const QString &outputDir);
@@ -116,9 +173,23 @@ public:
     LogLevel getLogLevel() const;
 
 private:
+    friend class LogWriter;
+
     /// Check if logging is allowed with level \p level
     bool canLog(LogLevel level) const;
 
+    /// Pass \p record to the log writer thread, or write it if there is none.
+    void submit(LogRecord &&record);
+
+    /// Substitute the arguments of \p record and write it to all log sinks.
+    void writeRecord(const LogRecord &record);
+
+    /// Write a single log line with header to all log sinks.
+    void writeLine(LogLevel level, const char *file, int line, const QString &msg);
+
+    /// Flush all log sinks without waiting for pending messages.
+    void flushSinks();
+
     /// Write a header with column captions
     void writeLogHeader();
 
@@ -133,53 +204,41 @@ private:
     void truncateFileName(char *dstBuffer, size_t dstCharacters, const char *fileName);
 
     /**
-     * Replace format arguments in \p msg.
+     * Capture a format argument of a log message.
      * \sa QString::arg
      */
     template<typename T>
-    QString collectArg(const QString &msg, const std::shared_ptr<T> &arg)
+    static LogArg captureArg(const std::shared_ptr<T> &arg)
     {
         QString tgt;
         OStream os(&tgt);
         os << arg;
-        return msg.arg(tgt);
+        return tgt;
     }
 
-    QString collectArg(const QString &msg, const char *arg) { return msg.arg(arg); }
-    QString collectArg(const QString &msg, const QString &arg) { return msg.arg(arg); }
-    QString collectArg(const QString &msg, const Statement *s);
-    QString collectArg(const QString &msg, const SharedConstExp &e);
-    QString collectArg(const QString &msg, const SharedType &ty);
-    QString collectArg(const QString &msg, const Type &ty);
-    QString collectArg(const QString &msg, const RTL *r);
-    QString collectArg(const QString &msg, const LocationSet *l);
-
-    QString collectArg(const QString &msg, char arg) { return msg.arg(arg); }
-    QString collectArg(const QString &msg, sint16 arg) { return msg.arg(arg); }
-    QString collectArg(const QString &msg, sint32 arg) { return msg.arg(arg); }
-    QString collectArg(const QString &msg, sint64 arg) { return msg.arg(arg); }
-
-    QString collectArg(const QString &msg, uint8 arg) { return msg.arg(arg); }
-    QString collectArg(const QString &msg, uint16 arg) { return msg.arg(arg); }
-    QString collectArg(const QString &msg, uint32 arg) { return msg.arg(arg); }
-    QString collectArg(const QString &msg, uint64 arg) { return msg.arg(arg); }
+    static LogArg captureArg(const char *arg) { return QString(arg); }
+    static LogArg captureArg(const QString &arg) { return arg; }
+    static LogArg captureArg(const Statement *s);
+    static LogArg captureArg(const SharedConstExp &e);
+    static LogArg captureArg(const SharedType &ty);
+    static LogArg captureArg(const Type &ty);
+    static LogArg captureArg(const RTL *r);
+    static LogArg captureArg(const LocationSet *l);
 
-    QString collectArg(const QString &msg, float arg) { return msg.arg(arg); }
-    QString collectArg(const QString &msg, double arg) { return msg.arg(arg); }
+    static LogArg captureArg(char arg) { return QChar(QLatin1Char(arg)); }
+    static LogArg captureArg(sint16 arg) { return qlonglong(arg); }
+    static LogArg captureArg(sint32 arg) { return qlonglong(arg); }
+    static LogArg captureArg(sint64 arg) { return qlonglong(arg); }
 
-    QString collectArg(const QString &msg, Address addr);
+    static LogArg captureArg(uint8 arg) { return qulonglong(arg); }
+    static LogArg captureArg(uint16 arg) { return qulonglong(arg); }
+    static LogArg captureArg(uint32 arg) { return qulonglong(arg); }
+    static LogArg captureArg(uint64 arg) { return qulonglong(arg); }
 
-    template<typename Arg>
-    QString collectArgs(const QString &msg, Arg arg)
-    {
-        return collectArg(msg, arg);
-    }
+    static LogArg captureArg(float arg) { return double(arg); }
+    static LogArg captureArg(double arg) { return arg; }
 
-    template<typename Arg, typename... Args>
-    QString collectArgs(QString msg, Arg arg, Args... args)
-    {
-        return collectArgs(collectArg(msg, arg), args...);
-    }
+    static LogArg captureArg(Address addr) { return addr; }
 
     /// Write the raw string \p msg to all log sinks.
     void write(const QString &msg);
@@ -193,17 +252,30 @@ private:
      * to have a sensible file name
      */
     size_t m_fileNameOffset;
-    LogLevel m_level = LogLevel::Default;
+    std::atomic<LogLevel> m_level;
     std::vector<std::unique_ptr<ILogSink>> m_sinks;
+
+    /// Serializes writes from different threads so that log lines are not interleaved.
+    std::recursive_mutex m_writeMutex;
+
+    /// Log level of the default log, see \ref isEnabled
+    static std::atomic<LogLevel> s_defaultLevel;
 };
 
 
+/// Log a message to the default log if \p level is enabled.
+/// The arguments are not evaluated otherwise.
+#define LOG_AT_LEVEL(level, ...)                                                                   \
+    do {                                                                                           \
+        if (Log::isEnabled(level)) {                                                               \
+            Log::getOrCreateLog().log(level, __FILE__, __LINE__, __VA_ARGS__);                     \
+        }                                                                                          \
+    } while (false)
+
 /// Usage: LOG_ERROR("%1, we have a problem", "Houston");
-#define LOG_FATAL(...) Log::getOrCreateLog().log(LogLevel::Fatal, __FILE__, __LINE__, __VA_ARGS__)
-#define LOG_ERROR(...) Log::getOrCreateLog().log(LogLevel::Error, __FILE__, __LINE__, __VA_ARGS__)
-#define LOG_WARN(...) Log::getOrCreateLog().log(LogLevel::Warning, __FILE__, __LINE__, __VA_ARGS__)
-#define LOG_MSG(...) Log::getOrCreateLog().log(LogLevel::Default, __FILE__, __LINE__, __VA_ARGS__)
-#define LOG_VERBOSE(...)                                                                           \
-    Log::getOrCreateLog().log(LogLevel::Verbose1, __FILE__, __LINE__, __VA_ARGS__)
-#define LOG_VERBOSE2(...)                                                                          \
-    Log::getOrCreateLog().log(LogLevel::Verbose2, __FILE__, __LINE__, __VA_ARGS__)
+#define LOG_FATAL(...) LOG_AT_LEVEL(LogLevel::Fatal, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT_LEVEL(LogLevel::Error, __VA_ARGS__)
+#define LOG_WARN(...) LOG_AT_LEVEL(LogLevel::Warning, __VA_ARGS__)
+#define LOG_MSG(...) LOG_AT_LEVEL(LogLevel::Default, __VA_ARGS__)
+#define LOG_VERBOSE(...) LOG_AT_LEVEL(LogLevel::Verbose1, __VA_ARGS__)
+#define LOG_VERBOSE2(...) LOG_AT_LEVEL(LogLevel::Verbose2, __VA_ARGS__)
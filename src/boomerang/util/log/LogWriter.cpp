@@ -0,0 +1,450 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "LogWriter.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+
+#ifdef _WIN32
+#    include <io.h>
+#else
+#    include <time.h>
+#    include <unistd.h>
+#endif
+
+
+/// How long the writer thread waits for new records before it checks again by itself.
+/// Since notifying it is not async-signal-safe, this is also the time it may take
+/// until the writer thread notices a crash.
+static constexpr std::chrono::milliseconds WRITER_POLL_INTERVAL(100);
+
+/// How long the crash handler waits for the writer thread to write the queued records.
+static constexpr std::chrono::milliseconds CRASH_FLUSH_TIMEOUT(1000);
+
+/// How often the crash handler checks whether the queued records were written.
+static constexpr std::chrono::milliseconds CRASH_FLUSH_CHECK_INTERVAL(10);
+
+
+/**
+ * A single producer, single consumer queue of log records.
+ * The producer is the thread that owns the buffer, the consumer is the thread
+ * holding LogWriter::m_writeMutex.
+ */
+class LogRingBuffer
+{
+public:
+    static constexpr std::size_t CAPACITY = 256;
+
+public:
+    /// Called by the owning thread only.
+    /// \returns false if the buffer is full. \p record is not moved from in this case.
+    bool push(LogRecord &&record)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+
+        if (head - m_tail.load(std::memory_order_acquire) == CAPACITY) {
+            return false;
+        }
+
+        m_records[head % CAPACITY] = std::move(record);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// \returns false if the buffer is empty.
+    bool pop(LogRecord &record)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail == m_head.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        record = std::move(m_records[tail % CAPACITY]);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const
+    {
+        return m_tail.load(std::memory_order_acquire) == m_head.load(std::memory_order_acquire);
+    }
+
+public:
+    std::atomic<bool> abandoned{ false }; ///< True when the owning thread exited
+
+private:
+    std::array<LogRecord, CAPACITY> m_records;
+    std::atomic<std::size_t> m_head{ 0 }; ///< Index of the next record to push
+    std::atomic<std::size_t> m_tail{ 0 }; ///< Index of the next record to pop
+};
+
+
+/// Owns the ring buffer of a thread, until the thread exits.
+/// The buffer itself is kept by the writer until it is empty.
+struct ThreadLogBuffer
+{
+    ~ThreadLogBuffer()
+    {
+        if (buffer) {
+            buffer->abandoned = true;
+        }
+    }
+
+    std::shared_ptr<LogRingBuffer> buffer;
+};
+
+
+static thread_local ThreadLogBuffer g_threadBuffer;
+static std::atomic<LogWriter *> g_writer(nullptr);
+
+
+/// Buffer for the message written by the crash handler, so it does not need to allocate memory
+static char g_crashMessage[128];
+
+
+/// Append \p str to the crash message at \p pos. Async-signal-safe.
+static char *appendCrashMessage(char *pos, const char *str)
+{
+    char *const end = g_crashMessage + sizeof(g_crashMessage) - 1;
+
+    while (*str != '\0' && pos < end) {
+        *pos++ = *str++;
+    }
+
+    return pos;
+}
+
+
+/// Append the decimal representation of \p value to the crash message at \p pos.
+/// Async-signal-safe.
+static char *appendCrashMessage(char *pos, uint64_t value)
+{
+    char digits[21];
+    char *digit = digits + sizeof(digits) - 1;
+    *digit      = '\0';
+
+    do {
+        *--digit = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    return appendCrashMessage(pos, digit);
+}
+
+
+/// Sleep for \p duration. Async-signal-safe on POSIX systems.
+static void sleepInCrashHandler(std::chrono::milliseconds duration)
+{
+#ifdef _WIN32
+    std::this_thread::sleep_for(duration);
+#else
+    struct timespec ts = {};
+    ts.tv_sec          = static_cast<time_t>(duration.count() / 1000);
+    ts.tv_nsec         = static_cast<long>((duration.count() % 1000) * 1000000);
+
+    // Restart if interrupted by another signal
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+    }
+#endif
+}
+
+
+static void handleFatalSignal(int sig)
+{
+    if (LogWriter *writer = LogWriter::getIfStarted()) {
+        writer->flushOnCrash(sig);
+    }
+
+    // The default handler was restored before this handler was called,
+    // so this terminates with the default behaviour, e.g. for core dumps.
+    std::raise(sig);
+}
+
+
+LogWriter::LogWriter()
+    : m_running(true)
+    , m_sleeping(false)
+    , m_crashed(false)
+    , m_numSubmitted(0)
+    , m_numWritten(0)
+{
+    m_thread = std::thread(&LogWriter::run, this);
+}
+
+
+LogWriter &LogWriter::get()
+{
+    static LogWriter *writer = [] {
+        // Never deleted, so logs can still be written while static objects are destroyed.
+        LogWriter *w = new LogWriter();
+        g_writer     = w;
+
+        std::atexit([] { g_writer.load()->stop(); });
+        return w;
+    }();
+
+    return *writer;
+}
+
+
+LogWriter *LogWriter::getIfStarted()
+{
+    return g_writer.load();
+}
+
+
+void LogWriter::installCrashHandler()
+{
+    for (int sig : { SIGSEGV, SIGILL, SIGFPE, SIGABRT }) {
+#ifdef _WIN32
+        // The handler is reset to SIG_DFL before it is called.
+        std::signal(sig, handleFatalSignal);
+#else
+        struct sigaction action = {};
+        action.sa_handler       = handleFatalSignal;
+        action.sa_flags         = SA_RESETHAND;
+        sigemptyset(&action.sa_mask);
+        sigaction(sig, &action, nullptr);
+#endif
+    }
+}
+
+
+bool LogWriter::submit(LogRecord &&record)
+{
+    if (!m_running || std::this_thread::get_id() == m_thread.get_id()) {
+        return false;
+    }
+
+    LogRingBuffer *buffer = getThreadBuffer();
+
+    while (!buffer->push(std::move(record))) {
+        // The buffer is full; wait for the writer to make room
+        wakeUp();
+        std::this_thread::yield();
+
+        if (!m_running) {
+            return false;
+        }
+    }
+
+    m_numSubmitted++;
+
+    if (!m_running) {
+        // The writer stopped before it saw the record
+        writeQueued();
+        return true;
+    }
+
+    wakeUp();
+    return true;
+}
+
+
+void LogWriter::flush()
+{
+    if (!m_running || std::this_thread::get_id() == m_thread.get_id()) {
+        return;
+    }
+
+    const uint64_t target = m_numSubmitted.load();
+
+    {
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        m_recordsQueued.notify_one();
+    }
+
+    std::unique_lock<std::mutex> lock(m_stateMutex);
+    m_recordsWritten.wait(lock, [this, target] { return m_numWritten >= target || !m_running; });
+}
+
+
+void LogWriter::stop()
+{
+    if (!m_running.exchange(false)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        m_recordsQueued.notify_one();
+        m_recordsWritten.notify_all();
+    }
+
+    m_thread.join();
+    writeQueued();
+}
+
+
+void LogWriter::flushOnCrash(int sig)
+{
+    // If the writer thread itself crashed, its state cannot be trusted.
+    if (std::this_thread::get_id() == m_thread.get_id()) {
+        return;
+    }
+
+    // Records queued by other threads after this point are not waited for.
+    const uint64_t numSubmitted = m_numSubmitted.load();
+    if (numSubmitted <= m_numWritten.load()) {
+        return;
+    }
+
+    // Signalling m_recordsQueued is not async-signal-safe; the writer thread
+    // notices the flag after at most WRITER_POLL_INTERVAL.
+    m_crashed = true;
+
+    for (auto waited = std::chrono::milliseconds(0);
+         m_running && m_numWritten.load() < numSubmitted && waited < CRASH_FLUSH_TIMEOUT;
+         waited += CRASH_FLUSH_CHECK_INTERVAL) {
+        sleepInCrashHandler(CRASH_FLUSH_CHECK_INTERVAL);
+    }
+
+    const uint64_t numWritten = m_numWritten.load();
+    if (numSubmitted <= numWritten) {
+        return;
+    }
+
+    char *pos = g_crashMessage;
+    pos       = appendCrashMessage(pos, "Fatal signal ");
+    pos       = appendCrashMessage(pos, static_cast<uint64_t>(sig));
+    pos       = appendCrashMessage(pos, ": up to ");
+    pos       = appendCrashMessage(pos, numSubmitted - numWritten);
+    pos       = appendCrashMessage(pos, " queued log messages were not written.\n");
+
+#ifdef _WIN32
+    _write(2, g_crashMessage, static_cast<unsigned int>(pos - g_crashMessage));
+#else
+    const ssize_t unused = write(STDERR_FILENO, g_crashMessage, pos - g_crashMessage);
+    Q_UNUSED(unused);
+#endif
+}
+
+
+void LogWriter::run()
+{
+    while (m_running) {
+        if (writeQueued() > 0) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_stateMutex);
+        m_sleeping = true;
+
+        // Records queued after the last check but before m_sleeping was set
+        // did not wake us up, so check again. After a crash, check more often
+        // until the crash handler terminates the program.
+        if (m_running && !hasQueued()) {
+            m_recordsQueued.wait_for(lock, m_crashed ? CRASH_FLUSH_CHECK_INTERVAL
+                                                     : WRITER_POLL_INTERVAL);
+        }
+
+        m_sleeping = false;
+    }
+}
+
+
+LogRingBuffer *LogWriter::getThreadBuffer()
+{
+    if (!g_threadBuffer.buffer) {
+        g_threadBuffer.buffer = std::make_shared<LogRingBuffer>();
+
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        m_buffers.push_back(g_threadBuffer.buffer);
+    }
+
+    return g_threadBuffer.buffer.get();
+}
+
+
+void LogWriter::wakeUp()
+{
+    // Pairs with setting m_sleeping before checking the buffers in run()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (m_sleeping) {
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        m_recordsQueued.notify_one();
+    }
+}
+
+
+bool LogWriter::hasQueued()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::lock_guard<std::mutex> lock(m_buffersMutex);
+
+    return std::any_of(m_buffers.begin(), m_buffers.end(),
+                       [](const std::shared_ptr<LogRingBuffer> &buf) { return !buf->empty(); });
+}
+
+
+std::size_t LogWriter::writeQueued()
+{
+    std::size_t numWritten = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        numWritten = writeBuffers();
+    }
+
+    if (numWritten > 0) {
+        m_numWritten += numWritten;
+
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        m_recordsWritten.notify_all();
+    }
+
+    return numWritten;
+}
+
+
+std::size_t LogWriter::writeBuffers()
+{
+    std::vector<std::shared_ptr<LogRingBuffer>> buffers;
+
+    {
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+
+        // Buffers of threads that exited are not needed anymore once they are empty
+        m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+                                       [](const std::shared_ptr<LogRingBuffer> &buf) {
+                                           return buf->abandoned && buf->empty();
+                                       }),
+                        m_buffers.end());
+
+        buffers = m_buffers;
+    }
+
+    std::size_t numWritten = 0;
+    LogRecord record;
+
+    for (const std::shared_ptr<LogRingBuffer> &buffer : buffers) {
+        // Do not write more than one buffer full at a time,
+        // so records of other threads are not held back by a busy thread.
+        for (std::size_t i = 0; i < LogRingBuffer::CAPACITY && buffer->pop(record); i++) {
+            record.log->writeRecord(record);
+            m_unflushedLogs.insert(record.log);
+            numWritten++;
+        }
+    }
+
+    // Flush before the records count as written, so logs waiting in Log::flush
+    // (e.g. when they are destroyed) are not accessed anymore afterwards.
+    for (Log *log : m_unflushedLogs) {
+        log->flushSinks();
+    }
+
+    m_unflushedLogs.clear();
+    return numWritten;
+}
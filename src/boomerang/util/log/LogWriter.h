@@ -0,0 +1,132 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/util/log/Log.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+
+class LogRingBuffer;
+
+
+/**
+ * Formats and writes log records on a background thread.
+ *
+ * Each logging thread queues its records in its own fixed size ring buffer, so queueing
+ * a record does not take a lock. If the buffer of a thread is full, the thread waits
+ * until the writer thread has made room. Records of one thread are written in the order
+ * they were logged; records of different threads are not ordered.
+ *
+ * The writer is started when the first record is logged and stopped when the program exits,
+ * after writing all queued records. Records logged after that are written by the logging
+ * thread itself.
+ */
+class BOOMERANG_API LogWriter
+{
+public:
+    LogWriter(const LogWriter &other) = delete;
+    LogWriter(LogWriter &&other)      = delete;
+
+    LogWriter &operator=(const LogWriter &other) = delete;
+    LogWriter &operator=(LogWriter &&other) = delete;
+
+public:
+    /// \returns the log writer, starting it if necessary.
+    static LogWriter &get();
+
+    /// \returns the log writer if it was started, or nullptr if nothing was logged yet.
+    static LogWriter *getIfStarted();
+
+    /**
+     * Install handlers for fatal signals (e.g. segmentation faults) that give the writer
+     * thread a chance to write the queued log records before the program terminates.
+     */
+    static void installCrashHandler();
+
+public:
+    /**
+     * Queue \p record to be written by the writer thread.
+     * \returns false if the record was not queued (and not moved from), e.g. when
+     * the writer was stopped or this is the writer thread. The caller has to write
+     * the record itself then.
+     */
+    bool submit(LogRecord &&record);
+
+    /// Wait until all records queued before are written and their logs are flushed.
+    void flush();
+
+    /// Write all queued records and stop the writer thread.
+    void stop();
+
+    /**
+     * Called by the handler of the fatal signal \p sig.
+     * Formatting records is not async-signal-safe, so the handler does not write them itself.
+     * Instead, it asks the writer thread to write all queued records and waits for it
+     * for a bounded time (one second). If records are still unwritten after that
+     * (e.g. because the crashed thread holds a lock the writer needs), their number
+     * is written to stderr, using only preallocated memory and write(2).
+     * Does nothing if the writer thread itself crashed.
+     */
+    void flushOnCrash(int sig);
+
+private:
+    LogWriter();
+    ~LogWriter() = default;
+
+    /// The writer thread.
+    void run();
+
+    /// \returns the ring buffer of the calling thread
+    LogRingBuffer *getThreadBuffer();
+
+    /// Wake up the writer thread if it waits for new records.
+    void wakeUp();
+
+    /// \returns true if there are queued records.
+    bool hasQueued();
+
+    /**
+     * Write all queued records and flush their logs.
+     * \returns the number of records written
+     */
+    std::size_t writeQueued();
+
+    /// Same as writeQueued, but the caller must hold m_writeMutex.
+    std::size_t writeBuffers();
+
+private:
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_sleeping;
+    std::atomic<bool> m_crashed; ///< Set by flushOnCrash; the writer thread checks more often then
+
+    /// Held while records are written, by the writer thread or another thread
+    std::mutex m_writeMutex;
+
+    std::mutex m_buffersMutex; ///< Protects m_buffers
+    std::vector<std::shared_ptr<LogRingBuffer>> m_buffers;
+
+    std::unordered_set<Log *> m_unflushedLogs; ///< Logs written to since they were flushed
+
+    std::atomic<uint64_t> m_numSubmitted; ///< Number of records queued
+    std::atomic<uint64_t> m_numWritten;   ///< Number of records written and flushed
+
+    std::mutex m_stateMutex;
+    std::condition_variable m_recordsQueued; ///< Notified when records are queued
+    std::condition_variable m_recordsWritten;
+};
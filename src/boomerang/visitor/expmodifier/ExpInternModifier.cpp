@@ -0,0 +1,84 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ExpInternModifier.h"
+
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/ExpInterner.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/exp/Ternary.h"
+#include "boomerang/ssl/exp/TypedExp.h"
+
+
+ExpInternModifier::ExpInternModifier(ExpInterner *interner)
+    : m_interner(interner)
+{
+}
+
+
+SharedExp ExpInternModifier::postModify(const std::shared_ptr<Unary> &exp)
+{
+    return intern(exp);
+}
+
+
+SharedExp ExpInternModifier::postModify(const std::shared_ptr<Binary> &exp)
+{
+    return intern(exp);
+}
+
+
+SharedExp ExpInternModifier::postModify(const std::shared_ptr<Ternary> &exp)
+{
+    return intern(exp);
+}
+
+
+SharedExp ExpInternModifier::postModify(const std::shared_ptr<TypedExp> &exp)
+{
+    return intern(exp);
+}
+
+
+SharedExp ExpInternModifier::postModify(const std::shared_ptr<RefExp> &exp)
+{
+    return intern(exp);
+}
+
+
+SharedExp ExpInternModifier::postModify(const std::shared_ptr<Location> &exp)
+{
+    return intern(exp);
+}
+
+
+SharedExp ExpInternModifier::postModify(const std::shared_ptr<Const> &exp)
+{
+    return intern(exp);
+}
+
+
+SharedExp ExpInternModifier::postModify(const std::shared_ptr<Terminal> &exp)
+{
+    return intern(exp);
+}
+
+
+SharedExp ExpInternModifier::intern(const SharedExp &exp)
+{
+    SharedExp canonical = m_interner->intern(exp);
+    if (canonical != exp) {
+        m_modified = true;
+    }
+
+    return canonical;
+}
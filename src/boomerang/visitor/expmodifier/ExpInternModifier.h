@@ -0,0 +1,61 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/visitor/expmodifier/ExpModifier.h"
+
+
+class ExpInterner;
+
+
+/**
+ * Replaces all subexpressions of an expression by their canonical nodes.
+ * Children are interned before their parents, so a node is never modified
+ * once it has become canonical.
+ */
+class BOOMERANG_API ExpInternModifier : public ExpModifier
+{
+public:
+    ExpInternModifier(ExpInterner *interner);
+    virtual ~ExpInternModifier() = default;
+
+public:
+    /// \copydoc ExpModifier::postModify
+    SharedExp postModify(const std::shared_ptr<Unary> &exp) override;
+
+    /// \copydoc ExpModifier::postModify
+    SharedExp postModify(const std::shared_ptr<Binary> &exp) override;
+
+    /// \copydoc ExpModifier::postModify
+    SharedExp postModify(const std::shared_ptr<Ternary> &exp) override;
+
+    /// \copydoc ExpModifier::postModify
+    SharedExp postModify(const std::shared_ptr<TypedExp> &exp) override;
+
+    /// \copydoc ExpModifier::postModify
+    SharedExp postModify(const std::shared_ptr<RefExp> &exp) override;
+
+    /// \copydoc ExpModifier::postModify
+    SharedExp postModify(const std::shared_ptr<Location> &exp) override;
+
+    /// \copydoc ExpModifier::postModify
+    SharedExp postModify(const std::shared_ptr<Const> &exp) override;
+
+    /// \copydoc ExpModifier::postModify
+    SharedExp postModify(const std::shared_ptr<Terminal> &exp) override;
+
+private:
+    /// \returns the canonical node for \p exp
+    SharedExp intern(const SharedExp &exp);
+
+private:
+    ExpInterner *m_interner;
+};
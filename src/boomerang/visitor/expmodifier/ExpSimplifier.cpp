@@ -192,12 +192,12 @@ SharedExp ExpSimplifier::postModify(const std::shared_ptr<Binary> &exp)
     if (exp->getOper() == opEquals && *exp->getSubExp1() == *exp->getSubExp2()) {
         // x == x: result is true
         changed = true;
-        return std::make_shared<Terminal>(opTrue);
+        return Terminal::get(opTrue);
     }
     else if (exp->getOper() == opNotEqual && *exp->getSubExp1() == *exp->getSubExp2()) {
         // x != x: result is false
         changed = true;
-        return std::make_shared<Terminal>(opFalse);
+        return Terminal::get(opFalse);
     }
 
     // Might want to commute to put an integer constant on the RHS
@@ -546,13 +546,10 @@ SharedExp ExpSimplifier::postModify(const std::shared_ptr<Binary> &exp)
         }
     }
 
-    // For (a || b) or (a && b) recurse on a and b
+    // (a || a) or (a && a), becomes a. Note that a has already been simplified.
     if ((exp->getOper() == opOr) || (exp->getOper() == opAnd)) {
-        exp->refSubExp1() = exp->getSubExp1()->acceptModifier(this);
-        exp->refSubExp2() = exp->getSubExp2()->acceptModifier(this);
-
-        if (!m_modified && *exp->getSubExp1() == *exp->getSubExp2()) {
-            m_modified = true;
+        if (*exp->getSubExp1() == *exp->getSubExp2()) {
+            changed = true;
             return exp->getSubExp1();
         }
         return res;
@@ -22,6 +22,9 @@
  *  - Folding of constant ternary expressions
  *  - Replacing left/right shift by multiplication/division
  *
+ * The rules are applied bottom-up by Exp::simplify, so they can assume that
+ * all sub-expressions are already simplified.
+ *
  * Read the code and the tests for full details.
  * \sa Exp::simplify
  */
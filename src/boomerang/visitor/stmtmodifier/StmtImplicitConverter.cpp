@@ -32,7 +32,7 @@ void StmtImplicitConverter::visit(PhiAssign *stmt, bool &visitChildren)
         assert(exp.getSubExp1() != nullptr);
 
         if (exp.getDef() == nullptr) {
-            exp.setDef(m_cfg->findOrCreateImplicitAssign(exp.getSubExp1()));
+            exp.setDef(m_cfg->findOrCreateImplicitAssign(exp.getSubExp1()), stmt);
         }
     }
 
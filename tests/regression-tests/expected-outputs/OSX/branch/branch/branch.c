@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "branch.h"
 
 
 /** address: 0x00001b24 */
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "condcodexform.h"
 
 __size32 global_0x00002020;// 4 bytes
 __size32 global_0x00002024;// 4 bytes
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "manyparams.h"
 
 union { double; __size32; } global_0x00001fe8;
 int global_0x00001fec = 0x9999999a;
@@ -0,0 +1,3 @@
+#pragma once
+
+int main(int argc, char *argv[]);
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "fromssa2.h"
 
 
 /** address: 0x00001d34 */
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "funcptr.h"
 
 void(*global_0x00002024)(void);
 
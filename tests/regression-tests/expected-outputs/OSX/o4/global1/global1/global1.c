@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "global1.h"
 
 int a;
 int b;
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "global2.h"
 
 int b;
 
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "minmax.h"
 
 
 /** address: 0x00001d30 */
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "uns.h"
 
 
 /** address: 0x00001c98 */
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "ohello.h"
 
 
 /** address: 0x00002cf4 */
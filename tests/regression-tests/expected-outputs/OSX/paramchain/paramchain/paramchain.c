@@ -1,6 +1,4 @@
-int main(int argc, char *argv[]);
-void passem(__size32 param1, __size32 param2, __size32 param3, __size32 *param4);
-void addem(__size32 param1, __size32 param2, __size32 param3, __size32 *param4);
+#include "paramchain.h"
 
 
 /** address: 0x00001d44 */
@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-void proc1(int param1, char *param2, int param3);
+#include "phi2.h"
 
 
 /** address: 0x00001d18 */
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "sumarray.h"
 
 __size32 a[];
 
@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 proc1(__size32 param1, __size32 param2);
+#include "twoproc.h"
 
 
 /** address: 0x00001d80 */
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "hello-clang4-dynamic.h"
 
 
 /** address: 0x080483f0 */
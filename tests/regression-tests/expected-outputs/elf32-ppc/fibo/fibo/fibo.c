@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 fib(int param1, __size32 param2);
+#include "fibo.h"
 
 
 /** address: 0x100004a8 */
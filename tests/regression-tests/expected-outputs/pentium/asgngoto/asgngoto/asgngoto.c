@@ -1,6 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 atexit(atexitfunc param1);
-void MAIN__(__size32 param1);
+#include "asgngoto.h"
 
 
 /** address: 0x08048824 */
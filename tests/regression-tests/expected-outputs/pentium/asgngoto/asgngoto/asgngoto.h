@@ -0,0 +1,5 @@
+#pragma once
+
+int main(int argc, char *argv[]);
+__size32 atexit(atexitfunc param1);
+void MAIN__(__size32 param1);
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "branch-linux.h"
 
 
 /** address: 0x08048410 */
@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 bswap(int param1);
+#include "bswap.h"
 
 
 /** address: 0x0804837a */
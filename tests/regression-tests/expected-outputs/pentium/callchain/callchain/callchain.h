@@ -0,0 +1,7 @@
+#pragma once
+
+int main(int argc, char *argv[]);
+__size32 add15(__size32 param1);
+__size32 add10(__size32 param1);
+__size32 add5(__size32 param1);
+void printarg(int param1);
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "chararray.h"
 
 
 /** address: 0x08048334 */
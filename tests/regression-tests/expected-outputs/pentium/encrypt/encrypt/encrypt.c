@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-void rux_encrypt(void *param1);
+#include "encrypt.h"
 
 
 /** address: 0x08048460 */
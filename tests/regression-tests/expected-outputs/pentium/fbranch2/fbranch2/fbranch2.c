@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "fbranch2.h"
 
 
 /** address: 0x080483e4 */
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "fbranch_sahf.h"
 
 
 /** address: 0x08049190 */
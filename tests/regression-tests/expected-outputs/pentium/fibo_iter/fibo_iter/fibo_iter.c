@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 fib(int param1);
+#include "fibo_iter.h"
 
 
 /** address: 0x0804838c */
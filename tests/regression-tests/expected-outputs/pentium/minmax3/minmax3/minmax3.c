@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-void test(int param1);
+#include "minmax3.h"
 
 
 /** address: 0x0804836f */
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "nestedswitch.h"
 
 
 /** address: 0x0804837c */
@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 cparam(int param1, __size32 param2);
+#include "param1.h"
 
 
 /** address: 0x08048394 */
@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 proc1(size_t param1, int param2, char *param3);
+#include "phi2.h"
 
 
 /** address: 0x080483cf */
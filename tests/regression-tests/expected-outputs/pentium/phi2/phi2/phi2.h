@@ -0,0 +1,4 @@
+#pragma once
+
+int main(int argc, char *argv[]);
+__size32 proc1(size_t param1, int param2, char *param3);
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "printpi.h"
 
 
 /** address: 0x08048328 */
@@ -0,0 +1,14 @@
+#pragma once
+
+int main(int argc, char *argv[]);
+__size32 b(int param1);
+__size32 c(unsigned int param1);
+__size32 d(int param1);
+__size32 f(int param1);
+__size32 h(int param1);
+__size32 j(int param1);
+__size32 l(union { int; __size32 *; } param1);
+__size32 e(int param1);
+__size32 g(union { int; __size32 *; } param1);
+__size32 i(int param1);
+__size32 k(int param1);
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "regalias2.h"
 
 
 /** address: 0x08048370 */
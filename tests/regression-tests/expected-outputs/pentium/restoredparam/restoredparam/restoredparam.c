@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 twice(__size32 param1);
+#include "restoredparam.h"
 
 
 /** address: 0x0804837c */
@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 test(int param1, int param2, int param3);
+#include "short2.h"
 
 
 /** address: 0x08048398 */
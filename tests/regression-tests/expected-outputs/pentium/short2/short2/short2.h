@@ -0,0 +1,4 @@
+#pragma once
+
+int main(int argc, char *argv[]);
+__size32 test(int param1, int param2, int param3);
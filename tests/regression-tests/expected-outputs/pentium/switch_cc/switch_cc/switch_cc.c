@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "switch_cc.h"
 
 
 /** address: 0x080488f0 */
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "switch_gcc.h"
 
 
 /** address: 0x08048918 */
@@ -1,6 +1,4 @@
-int main(int argc, char *argv[]);
-void mid(__size32 param1);
-void fst(__size32 param1);
+#include "testarray2.h"
 
 
 /** address: 0x080483ac */
@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-void twofib(__size32 param3, __size32 param4, __size32 *param3, __size32 param4);
+#include "twofib.h"
 
 
 /** address: 0x080483f5 */
@@ -0,0 +1,4 @@
+#pragma once
+
+int main(int argc, char *argv[]);
+void twofib(__size32 param3, __size32 param4, __size32 *param3, __size32 param4);
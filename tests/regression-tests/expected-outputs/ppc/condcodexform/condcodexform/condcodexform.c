@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "condcodexform.h"
 
 
 /** address: 0x100004f8 */
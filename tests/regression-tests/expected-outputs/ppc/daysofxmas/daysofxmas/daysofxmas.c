@@ -1,4 +1,4 @@
-int main(union { int; char *[] *; } argc, union { int; char *[] *; } argv);
+#include "daysofxmas.h"
 
 
 /** address: 0x10000418 */
@@ -0,0 +1,3 @@
+#pragma once
+
+int main(union { int; char *[] *; } argc, union { int; char *[] *; } argv);
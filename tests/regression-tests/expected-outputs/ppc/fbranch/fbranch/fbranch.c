@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "fbranch.h"
 
 
 /** address: 0x10000440 */
@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 fib(int param1);
+#include "fib.h"
 
 
 /** address: 0x10000418 */
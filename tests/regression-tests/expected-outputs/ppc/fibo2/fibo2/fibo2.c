@@ -1,6 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 fib1();
-__size32 fib2(int param1);
+#include "fibo2.h"
 
 
 /** address: 0x10000504 */
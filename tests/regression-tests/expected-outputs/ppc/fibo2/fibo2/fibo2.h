@@ -0,0 +1,5 @@
+#pragma once
+
+int main(int argc, char *argv[]);
+__size32 fib1();
+__size32 fib2(int param1);
@@ -1,6 +1,4 @@
-int main(int argc, union { long long; char *[] *; } argv);
-void foo1(long long param1);
-void foo2(long long param1);
+#include "global3.h"
 
 int b = 7;
 
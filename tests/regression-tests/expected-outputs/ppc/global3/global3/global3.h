@@ -0,0 +1,5 @@
+#pragma once
+
+int main(int argc, union { long long; char *[] *; } argv);
+void foo1(long long param1);
+void foo2(long long param1);
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "manyparams.h"
 
 
 /** address: 0x10000418 */
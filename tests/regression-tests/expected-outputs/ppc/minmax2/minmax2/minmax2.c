@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-void test(int param1);
+#include "minmax2.h"
 
 
 /** address: 0x1000048c */
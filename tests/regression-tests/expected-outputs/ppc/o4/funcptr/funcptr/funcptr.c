@@ -1,6 +1,4 @@
-int main(int argc, char *argv[]);
-void hello();
-void world();
+#include "funcptr.h"
 
 
 /** address: 0x10000440 */
@@ -0,0 +1,5 @@
+#pragma once
+
+int main(int argc, char *argv[]);
+void hello();
+void world();
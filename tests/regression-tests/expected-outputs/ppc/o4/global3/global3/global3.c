@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "global3.h"
 
 int b = 7;
 
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "paramchain.h"
 
 
 /** address: 0x10000438 */
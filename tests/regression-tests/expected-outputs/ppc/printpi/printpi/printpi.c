@@ -1,4 +1,4 @@
-int main(int argc, union { double; char *[] *; } argv);
+#include "printpi.h"
 
 
 /** address: 0x10000418 */
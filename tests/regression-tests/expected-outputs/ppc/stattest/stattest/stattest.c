@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 __stat();
+#include "stattest.h"
 
 
 /** address: 0x10000440 */
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "sumarray.h"
 
 __size32 a[10] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
 
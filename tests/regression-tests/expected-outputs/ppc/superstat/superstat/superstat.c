@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 __stat();
+#include "superstat.h"
 
 
 /** address: 0x10000440 */
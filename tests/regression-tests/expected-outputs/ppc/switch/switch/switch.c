@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "switch.h"
 
 
 /** address: 0x10000418 */
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "andn.h"
 
 
 /** address: 0x0001066c */
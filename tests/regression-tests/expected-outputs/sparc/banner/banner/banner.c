@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "banner.h"
 
 
 /** address: 0x00010704 */
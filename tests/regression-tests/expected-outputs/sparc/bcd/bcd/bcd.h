@@ -0,0 +1,14 @@
+#pragma once
+
+int main(int argc, char *argv[]);
+__size32 proc_0x00000960(__size32 param1, __size32 param2);
+void proc_0x00012090();
+void proc_0x000120a8();
+void proc_0x00000980(__size32 param1, __size32 param2, __size32 param3, __size32 param4, __size32 param5, __size32 param6, __size32 param7);
+void proc_0x00012060();
+void proc_0x0001203c();
+void proc_0x0001206c();
+void proc_0x00012078();
+void proc_0x000120b4();
+void proc_0x00012030();
+void proc_0x0001209c();
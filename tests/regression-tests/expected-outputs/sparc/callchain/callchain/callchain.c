@@ -1,8 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 add15(__size32 param1);
-__size32 add10(__size32 param1);
-__size32 add5(__size32 param1);
-void printarg(int param1);
+#include "callchain.h"
 
 
 /** address: 0x00010b64 */
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "condcodexform_gcc.h"
 
 
 /** address: 0x00010bac */
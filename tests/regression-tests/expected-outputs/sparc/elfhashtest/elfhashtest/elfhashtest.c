@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 elf_hash(char *param1, int param2);
+#include "elfhashtest.h"
 
 
 /** address: 0x00010678 */
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "fbranch.h"
 
 union { int; float; } global_0x00010938;
 
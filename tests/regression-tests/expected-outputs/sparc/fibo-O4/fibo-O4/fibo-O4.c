@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 fib(int param1);
+#include "fibo-O4.h"
 
 
 /** address: 0x00010ad0 */
@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-void fib1();
+#include "fibo2.h"
 
 
 /** address: 0x00010738 */
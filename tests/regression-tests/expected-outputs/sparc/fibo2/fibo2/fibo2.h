@@ -0,0 +1,4 @@
+#pragma once
+
+int main(int argc, char *argv[]);
+void fib1();
@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 fib(int param1, int param2);
+#include "fibo3.h"
 
 
 /** address: 0x0001071c */
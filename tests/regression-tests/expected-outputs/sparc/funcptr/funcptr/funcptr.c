@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-void hello();
+#include "funcptr.h"
 
 
 /** address: 0x000106e0 */
@@ -1,6 +1,4 @@
-int main(int argc, char *argv[]);
-void foo1();
-void foo2();
+#include "global1.h"
 
 int a = 5;
 int b = 7;
@@ -1,6 +1,4 @@
-int main(int argc, char *argv[]);
-void foo1();
-void foo2();
+#include "global2.h"
 
 union { double; __size32; } a;
 int b = 7;
@@ -1,6 +1,4 @@
-int main(int argc, char *argv[]);
-void foo1();
-void foo2();
+#include "global3.h"
 
 long long a = 0x7048860ddf79LL;
 int b = 7;
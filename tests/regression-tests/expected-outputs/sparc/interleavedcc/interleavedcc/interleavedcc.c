@@ -1,5 +1,4 @@
-int main(int argc, char *argv[]);
-__size32 interleaved(int param1, __size32 param2, __size32 param3);
+#include "interleavedcc.h"
 
 
 /** address: 0x00010acc */
@@ -0,0 +1,4 @@
+#pragma once
+
+int main(int argc, char *argv[]);
+__size32 interleaved(int param1, __size32 param2, __size32 param3);
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "minmax2.h"
 
 
 /** address: 0x00010670 */
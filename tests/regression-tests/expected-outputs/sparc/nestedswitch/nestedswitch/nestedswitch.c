@@ -1,4 +1,4 @@
-int main(unsigned int argc, char *argv[]);
+#include "nestedswitch.h"
 
 
 /** address: 0x000106a4 */
@@ -0,0 +1,3 @@
+#pragma once
+
+int main(unsigned int argc, char *argv[]);
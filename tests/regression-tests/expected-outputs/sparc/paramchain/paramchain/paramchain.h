@@ -0,0 +1,5 @@
+#pragma once
+
+int main(int argc, char *argv[]);
+void passem(__size32 param1, __size32 param2, __size32 param3, __size32 *param4);
+void addem(__size32 param1, __size32 param2, __size32 param3, __size32 *param4);
@@ -0,0 +1,4 @@
+#pragma once
+
+int main(int argc, char *argv[]);
+void proc1(int param1, char *param2, int param3);
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "printpi.h"
 
 float global_0x0001078c = 3.1415925;
 
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "superstat.h"
 
 
 /** address: 0x000106a8 */
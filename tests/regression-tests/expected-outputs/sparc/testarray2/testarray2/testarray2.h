@@ -0,0 +1,5 @@
+#pragma once
+
+int main(int argc, char *argv[]);
+void mid(__size32 param1);
+void fst(__size32 param1);
@@ -1,4 +1,4 @@
-int main(int argc, char *argv[]);
+#include "typetest.h"
 
 
 /** address: 0x00401bfc */
@@ -14,11 +14,14 @@
 #include "boomerang/util/LocationSet.h"
 #include "boomerang/util/log/Log.h"
 
+#include <QStandardPaths>
+
 
 TestProject::TestProject()
 {
     getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
     getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    getSettings()->signatureCacheDir = m_signatureCacheDir.path();
 }
 
 
@@ -26,6 +29,9 @@ void BoomerangTest::initTestCase()
 {
     Log::getOrCreateLog();
 
+    // Projects that are not TestProjects must not write to the user's directories either
+    QStandardPaths::setTestModeEnabled(true);
+
     qRegisterMetaType<SharedTypeWrapper>();
     qRegisterMetaType<SharedExpWrapper>();
 }
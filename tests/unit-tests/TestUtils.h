@@ -15,6 +15,7 @@
 #include "boomerang/ssl/exp/Exp.h"
 #include "boomerang/db/BasicBlock.h"
 
+#include <QTemporaryDir>
 #include <QTest>
 
 
@@ -25,6 +26,10 @@ class TestProject : public Project
 {
 public:
     TestProject();
+
+private:
+    /// Keeps precompiled signature catalogs out of the user's cache directory
+    QTemporaryDir m_signatureCacheDir;
 };
 
 
@@ -0,0 +1,110 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "CapstoneX86DecoderTest.h"
+
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/ifc/IFrontEnd.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/util/Types.h"
+
+
+#define HELLO_PENTIUM \
+    (m_project.getSettings()->getDataDirectory().absoluteFilePath("samples/pentium/hello"))
+
+
+struct InstructionData
+{
+public:
+    Byte data[16];
+};
+
+Q_DECLARE_METATYPE(InstructionData)
+
+#define TEST_DECODE(name, data)                                                                    \
+    QTest::newRow(name) << InstructionData{ data };
+
+
+static const InstructionData benchmarkInstructions[] = {
+    { "\x55" },                         // push ebp
+    { "\x89\xe5" },                     // mov ebp, esp
+    { "\x83\xec\x08" },                 // sub esp, 8
+    { "\x8b\x45\x08" },                 // mov eax, dword ptr [ebp + 8]
+    { "\x01\xd8" },                     // add eax, ebx
+    { "\x85\xc0" },                     // test eax, eax
+    { "\x0f\x94\xc0" },                 // sete al
+    { "\xc7\x04\x24\x00\x00\x00\x00" }, // mov dword ptr [esp], 0
+    { "\x31\xc0" },                     // xor eax, eax
+    { "\xc9" },                         // leave
+    { "\xc3" },                         // ret
+};
+
+
+void CapstoneX86DecoderTest::initTestCase()
+{
+    QVERIFY(m_project.loadBinaryFile(HELLO_PENTIUM));
+    QVERIFY(m_project.getProg()->getFrontEnd() != nullptr);
+
+    m_decoder = m_project.getProg()->getFrontEnd()->getDecoder();
+    QVERIFY(m_decoder != nullptr);
+}
+
+
+void CapstoneX86DecoderTest::testDecodeTwice()
+{
+    QFETCH(InstructionData, insnData);
+
+    const Address sourceAddr = Address(0x1000);
+    const ptrdiff_t diff     = (HostAddress(&insnData) - sourceAddr).value();
+
+    DecodeResult first;
+    QVERIFY(m_decoder->decodeInstruction(sourceAddr, diff, first));
+    QVERIFY(first.valid);
+
+    DecodeResult second;
+    QVERIFY(m_decoder->decodeInstruction(sourceAddr, diff, second));
+    QVERIFY(second.valid);
+
+    QCOMPARE(second.numBytes, first.numBytes);
+    QCOMPARE(second.rtl->toString(), first.rtl->toString());
+}
+
+
+void CapstoneX86DecoderTest::testDecodeTwice_data()
+{
+    QTest::addColumn<InstructionData>("insnData");
+
+    TEST_DECODE("push ebp",                  "\x55");
+    TEST_DECODE("mov ebp, esp",              "\x89\xe5");
+    TEST_DECODE("mov eax, dword [ebp + 8]",  "\x8b\x45\x08");
+    TEST_DECODE("mov ax, word [ebp + 8]",    "\x66\x8b\x45\x08");
+    TEST_DECODE("sete al",                   "\x0f\x94\xc0");
+    TEST_DECODE("rep movsd",                 "\xf3\xa5");
+    TEST_DECODE("call +0",                   "\xe8\x00\x00\x00\x00");
+    TEST_DECODE("ret",                       "\xc3");
+}
+
+
+void CapstoneX86DecoderTest::benchmarkDecode()
+{
+    const Address sourceAddr = Address(0x1000);
+
+    QBENCHMARK {
+        for (const InstructionData &insnData : benchmarkInstructions) {
+            const ptrdiff_t diff = (HostAddress(&insnData) - sourceAddr).value();
+
+            DecodeResult result;
+            QVERIFY(m_decoder->decodeInstruction(sourceAddr, diff, result));
+        }
+    }
+}
+
+
+QTEST_GUILESS_MAIN(CapstoneX86DecoderTest)
@@ -0,0 +1,33 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+class CapstoneX86DecoderTest : public BoomerangTestWithPlugins
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    /// Decoding the same instruction twice must give the same semantics
+    /// regardless of whether the instruction template was cached.
+    void testDecodeTwice();
+    void testDecodeTwice_data();
+
+    /// Measure decoding throughput
+    void benchmarkDecode();
+
+private:
+    IDecoder *m_decoder = nullptr;
+};
@@ -0,0 +1,121 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "SignatureDatabaseTest.h"
+
+#include "boomerang-plugins/symbol/c/SignatureDatabase.h"
+
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/type/IntegerType.h"
+
+#include <QFile>
+
+
+void SignatureDatabaseTest::init()
+{
+    QVERIFY(m_dir.isValid());
+    Type::clearNamedTypes();
+}
+
+
+void SignatureDatabaseTest::cleanup()
+{
+    Type::clearNamedTypes();
+}
+
+
+bool SignatureDatabaseTest::writeDatabase(const QString &filePath, const QByteArray &key)
+{
+    SignatureDatabase::SignatureMap signatures;
+
+    std::shared_ptr<Signature> foo = Signature::instantiate(Machine::PENTIUM, CallConv::C, "foo");
+    foo->addParameter("n", Location::param("n"), IntegerType::get(32, Sign::Signed));
+    signatures["foo"] = foo;
+
+    std::shared_ptr<Signature> bar = Signature::instantiate(Machine::PENTIUM, CallConv::C, "bar");
+    signatures["bar"] = bar;
+
+    SignatureDatabase::NamedTypeList namedTypes;
+    namedTypes.push_back({ "myint", IntegerType::get(16, Sign::Unsigned) });
+
+    return SignatureDatabase::write(filePath, key, signatures, namedTypes);
+}
+
+
+void SignatureDatabaseTest::testRoundTrip()
+{
+    const QString dbPath = m_dir.filePath("roundtrip.sigdb");
+    QVERIFY(writeDatabase(dbPath, "key"));
+    Type::clearNamedTypes();
+
+    SignatureDatabase db;
+    QVERIFY(db.open(dbPath, "key"));
+
+    std::shared_ptr<Signature> foo = db.getSignature("foo");
+    QVERIFY(foo != nullptr);
+    QCOMPARE(foo->getName(), QString("foo"));
+    QCOMPARE(foo->getNumParams(), 1);
+    QCOMPARE(foo->getParamName(0), QString("n"));
+    QVERIFY(*foo->getParamType(0) == *IntegerType::get(32, Sign::Signed));
+
+    std::shared_ptr<Signature> bar = db.getSignature("bar");
+    QVERIFY(bar != nullptr);
+    QCOMPARE(bar->getName(), QString("bar"));
+    QCOMPARE(bar->getNumParams(), 0);
+
+    QVERIFY(db.getSignature("baz") == nullptr);
+
+    // Looking up a signature twice gives the same object
+    QVERIFY(db.getSignature("foo") == foo);
+
+    SharedType myint = Type::getNamedType("myint");
+    QVERIFY(myint != nullptr);
+    QVERIFY(*myint == *IntegerType::get(16, Sign::Unsigned));
+}
+
+
+void SignatureDatabaseTest::testKeyMismatch()
+{
+    const QString dbPath = m_dir.filePath("key.sigdb");
+    QVERIFY(writeDatabase(dbPath, "key"));
+    Type::clearNamedTypes();
+
+    SignatureDatabase db;
+    QVERIFY(!db.open(dbPath, "otherkey"));
+    QVERIFY(Type::getNamedType("myint") == nullptr);
+}
+
+
+void SignatureDatabaseTest::testTruncated()
+{
+    const QString dbPath = m_dir.filePath("truncated.sigdb");
+    QVERIFY(writeDatabase(dbPath, "key"));
+    Type::clearNamedTypes();
+
+    QFile file(dbPath);
+    QVERIFY(file.open(QFile::ReadOnly));
+    const QByteArray contents = file.readAll();
+    file.close();
+
+    // Truncated in the signature data and in the header
+    for (int size : { contents.size() - 1, 8 }) {
+        QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+        QCOMPARE(file.write(contents.left(size)), static_cast<qint64>(size));
+        file.close();
+
+        SignatureDatabase db;
+        QVERIFY(!db.open(dbPath, "key"));
+    }
+
+    QVERIFY(Type::getNamedType("myint") == nullptr);
+}
+
+
+QTEST_GUILESS_MAIN(SignatureDatabaseTest)
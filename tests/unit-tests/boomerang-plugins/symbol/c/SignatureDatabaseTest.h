@@ -0,0 +1,41 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+#include <QTemporaryDir>
+
+
+class SignatureDatabaseTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    /// Signatures and types written to a database must be read back unchanged
+    void testRoundTrip();
+
+    /// Databases compiled from different signature files must be rejected
+    void testKeyMismatch();
+
+    /// Incomplete database files must be rejected
+    void testTruncated();
+
+private:
+    /// Write a database with a few signatures and types to \p filePath
+    bool writeDatabase(const QString &filePath, const QByteArray &key);
+
+private:
+    QTemporaryDir m_dir;
+};
@@ -0,0 +1,58 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "DFATypeRecoveryTest.h"
+
+#include "boomerang-plugins/type/dfa/DFATypeAnalyzer.h"
+
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/passes/PassManager.h"
+#include "boomerang/ssl/statements/Statement.h"
+#include "boomerang/util/StatementList.h"
+
+
+#define FIB_PENTIUM    (m_project.getSettings()->getDataDirectory().absoluteFilePath("samples/pentium/fib"))
+
+
+void DFATypeRecoveryTest::testFixpoint()
+{
+    QVERIFY(m_project.loadBinaryFile(FIB_PENTIUM));
+    QVERIFY(m_project.decodeBinaryFile());
+    QVERIFY(m_project.getTypeRecoveryEngine() != nullptr);
+
+    UserProc *proc = static_cast<UserProc *>(m_project.getProg()->getFunctionByName("fib"));
+    QVERIFY(proc != nullptr);
+
+    PassManager::get()->executePass(PassID::StatementInit, proc);
+    PassManager::get()->executePass(PassID::Dominators, proc);
+    PassManager::get()->executePass(PassID::CallDefineUpdate, proc);
+    PassManager::get()->executePass(PassID::PhiPlacement, proc);
+    PassManager::get()->executePass(PassID::BlockVarRename, proc);
+    PassManager::get()->executePass(PassID::StatementPropagation, proc);
+
+    QVERIFY(PassManager::get()->executePass(PassID::LocalTypeAnalysis, proc));
+    const QString analyzed = proc->toString();
+
+    StatementList stmts;
+    proc->getStatements(stmts);
+
+    DFATypeAnalyzer ana;
+    for (Statement *stmt : stmts) {
+        ana.resetChanged();
+        stmt->accept(&ana);
+        QVERIFY2(!ana.hasChanged(), qPrintable(stmt->toString()));
+    }
+
+    QCOMPARE(proc->toString(), analyzed);
+}
+
+
+QTEST_GUILESS_MAIN(DFATypeRecoveryTest)
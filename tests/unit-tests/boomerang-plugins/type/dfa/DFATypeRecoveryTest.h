@@ -0,0 +1,25 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+class DFATypeRecoveryTest : public BoomerangTestWithPlugins
+{
+    Q_OBJECT
+
+private slots:
+    /// The worklist must reach the same types as analyzing all statements
+    /// until no type changes any more, i.e. a further round over all statements
+    /// must not change any type.
+    void testFixpoint();
+};
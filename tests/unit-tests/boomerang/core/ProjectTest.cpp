@@ -13,6 +13,35 @@
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/proc/UserProc.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QMap>
+
+
+/// \returns the resident anonymous memory of this process in bytes, or -1 if it is not known.
+/// Unlike the pages of a file mapping, anonymous pages cannot be shared or dropped by the OS.
+static qint64 getAnonymousRSS()
+{
+    QFile status("/proc/self/status");
+    if (!status.open(QFile::ReadOnly | QFile::Text)) {
+        return -1;
+    }
+
+    for (QByteArray line = status.readLine(); !line.isEmpty(); line = status.readLine()) {
+        if (line.startsWith("RssAnon:")) {
+            // e.g. "RssAnon:     1234 kB"
+            const QList<QByteArray> fields = line.simplified().split(' ');
+            return fields.size() >= 2 ? fields[1].toLongLong() * 1024 : -1;
+        }
+    }
+
+    return -1;
+}
 
 
 void ProjectTest::testLoadBinaryFile()
@@ -34,12 +63,159 @@ void ProjectTest::testLoadBinaryFile()
 }
 
 
+void ProjectTest::testLoadMappedBinaryFile()
+{
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.getSettings()->mapBinaryFiles = true;
+    project.loadPlugins();
+
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+    QVERIFY(project.getLoadedBinaryFile()->getImage()->isMapped());
+    QVERIFY(project.getLoadedBinaryFile()->getImage()->getNumSections() > 0);
+
+    project.getSettings()->mapBinaryFiles = false;
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+    QVERIFY(!project.getLoadedBinaryFile()->getImage()->isMapped());
+}
+
+
+void ProjectTest::benchmarkLoadBinaryFile()
+{
+    QFETCH(bool, mapFile);
+
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.getSettings()->mapBinaryFiles = mapFile;
+    project.loadPlugins();
+
+    QBENCHMARK {
+        QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+    }
+}
+
+
+void ProjectTest::benchmarkLoadBinaryFile_data()
+{
+    QTest::addColumn<bool>("mapFile");
+
+    QTest::newRow("read") << false;
+    QTest::newRow("mmap") << true;
+}
+
+
+void ProjectTest::benchmarkLoadBinaryFileMemory()
+{
+    QFETCH(bool, mapFile);
+
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.getSettings()->mapBinaryFiles = mapFile;
+    project.loadPlugins();
+
+    const qint64 rssBefore = getAnonymousRSS();
+    if (rssBefore < 0) {
+        QSKIP("Resident memory cannot be measured on this platform");
+    }
+
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-static")));
+
+    // Report the anonymous resident memory used by the loaded file instead of the time
+    QTest::setBenchmarkResult(getAnonymousRSS() - rssBefore, QTest::BytesAllocated);
+}
+
+
+void ProjectTest::benchmarkLoadBinaryFileMemory_data()
+{
+    benchmarkLoadBinaryFile_data();
+}
+
+
 void ProjectTest::testLoadSaveFile()
 {
     Project project;
     project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
     project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
     QVERIFY(!project.loadSaveFile("invalid"));
+
+    project.loadPlugins();
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+    QVERIFY(project.decodeBinaryFile());
+
+    const QString saveFilePath = QDir::temp().absoluteFilePath("ProjectTest-hello.bms");
+    QVERIFY(project.writeSaveFile(saveFilePath));
+
+    const UserProc *main = static_cast<UserProc *>(project.getProg()->getFunctionByName("main"));
+    QVERIFY(main != nullptr);
+
+    StatementList stmts;
+    main->getStatements(stmts);
+
+    Project loaded;
+    loaded.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    loaded.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    loaded.loadPlugins();
+
+    QVERIFY(loaded.loadSaveFile(saveFilePath));
+    QVERIFY(loaded.isBinaryLoaded());
+    QCOMPARE(loaded.getProg()->getNumFunctions(false), project.getProg()->getNumFunctions(false));
+
+    // procedure bodies are loaded on first access
+    UserProc *loadedMain = static_cast<UserProc *>(loaded.getProg()->getFunctionByName("main"));
+    QVERIFY(loadedMain != nullptr);
+    QVERIFY(!loadedMain->isBodyLoaded());
+    QCOMPARE(loadedMain->getStatus(), main->getStatus());
+
+    StatementList loadedStmts;
+    loadedMain->getStatements(loadedStmts);
+    QVERIFY(loadedMain->isBodyLoaded());
+    QCOMPARE(loadedStmts.size(), stmts.size());
+    QCOMPARE(loadedMain->getCFG()->getNumBBs(), main->getCFG()->getNumBBs());
+    QVERIFY(loadedMain->getCFG()->isWellFormed());
+
+    QVERIFY(loaded.decompileBinaryFile());
+    QVERIFY(QFile::remove(saveFilePath));
+}
+
+
+void ProjectTest::testLoadSaveFileCallers()
+{
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.loadPlugins();
+
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+    QVERIFY(project.decodeBinaryFile());
+    QVERIFY(project.decompileBinaryFile());
+
+    const QString saveFilePath = QDir::temp().absoluteFilePath("ProjectTest-callers.bms");
+    QVERIFY(project.writeSaveFile(saveFilePath));
+
+    const Function *printf = project.getProg()->getFunctionByName("printf");
+    QVERIFY(printf != nullptr);
+    QVERIFY(!printf->getCallers().empty());
+
+    Project loaded;
+    loaded.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    loaded.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    loaded.loadPlugins();
+    QVERIFY(loaded.loadSaveFile(saveFilePath));
+
+    UserProc *loadedMain = static_cast<UserProc *>(loaded.getProg()->getFunctionByName("main"));
+    QVERIFY(loadedMain != nullptr);
+    QVERIFY(!loadedMain->isBodyLoaded());
+
+    // the callers are complete without loading the calling procedures explicitly
+    const Function *loadedPrintf = loaded.getProg()->getFunctionByName("printf");
+    QVERIFY(loadedPrintf != nullptr);
+    QCOMPARE(loadedPrintf->getCallers().size(), printf->getCallers().size());
+    QVERIFY(loadedMain->isBodyLoaded());
+
+    QVERIFY(QFile::remove(saveFilePath));
 }
 
 
@@ -104,6 +280,54 @@ void ProjectTest::testDecompileBinaryFile()
 }
 
 
+void ProjectTest::testDecompilationCache()
+{
+    QDir cacheDir(QDir::temp().absoluteFilePath("ProjectTest-cache"));
+    cacheDir.removeRecursively();
+
+    std::size_t numStmts[2] = { 0, 0 };
+    int numHits[2]          = { 0, 0 };
+    int numMisses[2]        = { 0, 0 };
+
+    // The first decompilation fills the cache, the second one uses it.
+    for (std::size_t i = 0; i < 2; ++i) {
+        Project project;
+        project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+        project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+        project.getSettings()->decompilationCacheDir = cacheDir.absolutePath();
+        project.loadPlugins();
+
+        QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+        QVERIFY(project.decodeBinaryFile());
+        QVERIFY(project.decompileBinaryFile());
+        QVERIFY(!cacheDir.entryList(QDir::Files).isEmpty());
+
+        UserProc *main = static_cast<UserProc *>(project.getProg()->getFunctionByName("main"));
+        QVERIFY(main != nullptr);
+        QVERIFY(main->isDecompiled());
+
+        StatementList stmts;
+        main->getStatements(stmts);
+        numStmts[i] = stmts.size();
+
+        QVERIFY(project.getProg()->isWellFormed());
+        QVERIFY(project.generateCode());
+
+        numHits[i]   = project.getNumCacheHits();
+        numMisses[i] = project.getNumCacheMisses();
+    }
+
+    QCOMPARE(numStmts[1], numStmts[0]);
+
+    // all procedures are unchanged, so all of them are restored by the second run
+    QCOMPARE(numHits[0], 0);
+    QVERIFY(numMisses[0] > 0);
+    QCOMPARE(numHits[1], numMisses[0]);
+    QCOMPARE(numMisses[1], 0);
+    QVERIFY(cacheDir.removeRecursively());
+}
+
+
 void ProjectTest::testGenerateCode()
 {
     Project project;
@@ -122,4 +346,46 @@ void ProjectTest::testGenerateCode()
 }
 
 
+void ProjectTest::testGenerateCodeParallel()
+{
+    const int threadCounts[2] = { 1, 4 };
+    QMap<QString, QByteArray> outputs[2];
+
+    for (int i = 0; i < 2; ++i) {
+        QDir outputDir(QDir::temp().absoluteFilePath(
+            QString("ProjectTest-codegen-%1").arg(threadCounts[i])));
+        outputDir.removeRecursively();
+        QVERIFY(outputDir.mkpath("."));
+
+        Project project;
+        project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+        project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+        project.getSettings()->setOutputDirectory(outputDir.absolutePath());
+        project.getSettings()->numThreads = threadCounts[i];
+        project.loadPlugins();
+
+        QVERIFY(project.loadBinaryFile(getFullSamplePath("pentium/recursion2")));
+        QVERIFY(project.decodeBinaryFile());
+        QVERIFY(project.decompileBinaryFile());
+        QVERIFY(project.generateCode());
+
+        QDirIterator it(outputDir.absolutePath(), QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            QFile file(it.next());
+            QVERIFY(file.open(QFile::ReadOnly));
+            outputs[i][outputDir.relativeFilePath(file.fileName())] = file.readAll();
+        }
+
+        QVERIFY(outputDir.removeRecursively());
+    }
+
+    QVERIFY(!outputs[0].isEmpty());
+    QCOMPARE(outputs[1].keys(), outputs[0].keys());
+
+    for (const QString &fileName : outputs[0].keys()) {
+        QCOMPARE(outputs[1][fileName], outputs[0][fileName]);
+    }
+}
+
+
 QTEST_GUILESS_MAIN(ProjectTest)
@@ -24,8 +24,21 @@ private slots:
     /// Test the import binary function.
     void testLoadBinaryFile();
 
+    /// Test loading a memory-mapped binary file
+    void testLoadMappedBinaryFile();
+
+    /// Measure the time to load a binary file, with and without memory mapping
+    void benchmarkLoadBinaryFile();
+    void benchmarkLoadBinaryFile_data();
+
+    /// Measure the resident memory used by a loaded binary file,
+    /// with and without memory mapping
+    void benchmarkLoadBinaryFileMemory();
+    void benchmarkLoadBinaryFileMemory_data();
+
     // test loading/writing to/from a save file
     void testLoadSaveFile();
+    void testLoadSaveFileCallers();
     void testWriteSaveFile();
 
     // test whether a binary is loaded after loading unloading
@@ -33,5 +46,9 @@ private slots:
 
     void testDecodeBinaryFile();
     void testDecompileBinaryFile();
+    void testDecompilationCache();
     void testGenerateCode();
+
+    /// Test that the generated code does not depend on the number of threads
+    void testGenerateCodeParallel();
 };
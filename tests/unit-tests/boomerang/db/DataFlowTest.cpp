@@ -151,6 +151,69 @@ void DataFlowTest::testCalculateDominatorsComplex()
 }
 
 
+void DataFlowTest::testCalculateDominatorsDeep()
+{
+    // A long chain of BBs that loops back to the entry.
+    // Must not exhaust the stack when numbering the BBs.
+    const int numBBs = 100000;
+
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+    DataFlow *df = proc.getDataFlow();
+
+    std::vector<BasicBlock *> bbs;
+    for (int i = 0; i < numBBs; i++) {
+        bbs.push_back(cfg->createBB(BBType::Oneway, createRTLs(Address(0x1000 + i), 1)));
+
+        if (i > 0) {
+            cfg->addEdge(bbs[i - 1], bbs[i]);
+        }
+    }
+
+    cfg->addEdge(bbs.back(), bbs.front());
+    proc.setEntryBB();
+
+    QVERIFY(df->calculateDominators());
+
+    for (int i = 1; i < numBBs; i += 1000) {
+        QCOMPARE(df->getDominator(bbs[i]), bbs[i - 1]);
+        QCOMPARE(df->getDominanceFrontier(bbs[i]), std::set<const BasicBlock *>({ bbs.front() }));
+    }
+
+    QCOMPARE(df->getDominanceFrontier(bbs.back()), std::set<const BasicBlock *>({ bbs.front() }));
+}
+
+
+void DataFlowTest::testCalculateDominatorsModified()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+    DataFlow *df = proc.getDataFlow();
+
+    BasicBlock *a = cfg->createBB(BBType::Oneway, createRTLs(Address(0x1000), 1));
+    BasicBlock *b = cfg->createBB(BBType::Oneway, createRTLs(Address(0x1001), 1));
+    BasicBlock *c = cfg->createBB(BBType::Ret,    createRTLs(Address(0x1002), 1));
+
+    cfg->addEdge(a, b);
+    cfg->addEdge(b, c);
+    proc.setEntryBB();
+
+    QVERIFY(df->calculateDominators());
+    QCOMPARE(df->getDominator(c), b);
+
+    // unchanged CFG
+    QVERIFY(df->calculateDominators());
+    QCOMPARE(df->getDominator(c), b);
+    QCOMPARE(df->getDominanceFrontier(b), std::set<const BasicBlock *>({}));
+
+    cfg->addEdge(a, c);
+
+    QVERIFY(df->calculateDominators());
+    QCOMPARE(df->getDominator(c), a);
+    QCOMPARE(df->getDominanceFrontier(b), std::set<const BasicBlock *>({ c }));
+}
+
+
 void DataFlowTest::testPlacePhi()
 {
     QVERIFY(m_project.loadBinaryFile(FRONTIER_PENTIUM));
@@ -177,10 +240,10 @@ void DataFlowTest::testPlacePhi()
     OStream actual(&actualStr);
 
     // r24 == eax
-    std::set<int>& A_phi = df->getA_phi(Location::regOf(REG_PENT_EAX));
+    const BitSet& A_phi = df->getA_phi(Location::regOf(REG_PENT_EAX));
 
-    for (int bb : A_phi) {
-        actual << bb << " ";
+    for (std::size_t bb = A_phi.findFirst(); bb != BitSet::npos; bb = A_phi.findNext(bb + 1)) {
+        actual << static_cast<int>(bb) << " ";
     }
 
     QCOMPARE(actualStr, QString("8 10 15 20 21 "));
@@ -209,10 +272,10 @@ void DataFlowTest::testPlacePhi2()
     QString     actual_st;
     OStream actual(&actual_st);
     SharedExp               e = Location::regOf(REG_PENT_EAX);
-    std::set<int>&          s = df->getA_phi(e);
+    const BitSet&           s = df->getA_phi(e);
 
-    for (std::set<int>::iterator pp = s.begin(); pp != s.end(); ++pp) {
-        actual << *pp << " ";
+    for (std::size_t bb = s.findFirst(); bb != BitSet::npos; bb = s.findNext(bb + 1)) {
+        actual << static_cast<int>(bb) << " ";
     }
 
     QCOMPARE(actual_st, QString("4 "));
@@ -25,6 +25,10 @@ private slots:
     void testCalculateDominators1();
     void testCalculateDominators2();
     void testCalculateDominatorsComplex();
+    void testCalculateDominatorsDeep();
+
+    /// Test that dominators are recalculated when the CFG changes
+    void testCalculateDominatorsModified();
 
     /// Test the placing of phi functions
     void testPlacePhi();
@@ -12,14 +12,18 @@
 #include "boomerang-plugins/frontend/x86/PentiumFrontEnd.h"
 
 #include "boomerang/core/Settings.h"
+#include "boomerang/db/BasicBlock.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/binary/BinarySection.h"
 #include "boomerang/db/binary/BinarySymbol.h"
 #include "boomerang/db/binary/BinarySymbolTable.h"
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/proc/LibProc.h"
+#include "boomerang/db/proc/UserProc.h"
 #include "boomerang/db/signature/Signature.h"
+#include "boomerang/ssl/RTL.h"
 #include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/statements/ReturnStatement.h"
 #include "boomerang/ssl/type/ArrayType.h"
 #include "boomerang/ssl/type/CharType.h"
 #include "boomerang/ssl/type/FloatType.h"
@@ -254,6 +258,34 @@ void ProgTest::testIsWellFormed()
 
     Prog testProg("test", nullptr);
     QVERIFY(testProg.isWellFormed());
+
+}
+
+
+void ProgTest::testIsWellFormedIncremental()
+{
+    Prog prog("test", &m_project);
+
+    UserProc *proc = static_cast<UserProc *>(prog.getOrCreateFunction(Address(0x1000)));
+    QVERIFY(proc != nullptr);
+    QVERIFY(prog.isWellFormed());
+
+    BasicBlock *incompleteBB = proc->getCFG()->createIncompleteBB(Address(0x1000));
+    QVERIFY(!prog.isWellFormed());
+    QVERIFY(!prog.isWellFormed()); // still malformed, even if not modified
+
+    std::unique_ptr<RTLList> rtls(new RTLList);
+    rtls->push_back(std::unique_ptr<RTL>(new RTL(Address(0x1000), { new ReturnStatement })));
+    QCOMPARE(proc->getCFG()->createBB(BBType::Ret, std::move(rtls)), incompleteBB);
+    QVERIFY(prog.isWellFormed());
+
+    proc->getCFG()->createIncompleteBB(Address(0x2000));
+    QVERIFY(!proc->getCFG()->isWellFormed()); // checking the CFG directly must not hide it
+    QVERIFY(!prog.isWellFormed());
+
+    m_project.getSettings()->checkAllCFGs = true;
+    QVERIFY(!prog.isWellFormed());
+    m_project.getSettings()->checkAllCFGs = false;
 }
 
 
@@ -39,6 +39,7 @@ private slots:
     void testGetNumFunctions();
 
     void testIsWellFormed();
+    void testIsWellFormedIncremental();
     void testIsWin32();
     void testGetRegNameByNum();
     void testGetRegSizeByNum();
@@ -305,4 +305,39 @@ void ProcCFGTest::testIsWellFormed()
 }
 
 
+void ProcCFGTest::testIsModified()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *cfg = proc.getCFG();
+
+    QVERIFY(!cfg->isModified());
+
+    BasicBlock *bb1 = cfg->createBB(BBType::Oneway, createRTLs(Address(0x1000), 1));
+    QVERIFY(cfg->isModified());
+    QVERIFY(cfg->isWellFormed());
+    QVERIFY(!cfg->isModified());
+
+    BasicBlock *bb2 = cfg->createIncompleteBB(Address(0x2000));
+    QVERIFY(cfg->isModified());
+    QVERIFY(!cfg->isWellFormed());
+    QVERIFY(!cfg->isModified());
+    QVERIFY(!cfg->isWellFormed()); // cached result
+
+    // modifying edges of a BB directly also marks the CFG as modified
+    bb1->addSuccessor(bb2);
+    QVERIFY(cfg->isModified());
+    QVERIFY(!cfg->isWellFormed());
+
+    cfg->createBB(BBType::Ret, createRTLs(Address(0x2000), 1)); // complete the BB
+    bb2->addPredecessor(bb1);
+    QVERIFY(cfg->isModified());
+    QVERIFY(cfg->isWellFormed());
+    QVERIFY(cfg->isWellFormed(true));
+
+    bb1->removeAllSuccessors();
+    QVERIFY(cfg->isModified());
+    QVERIFY(!cfg->isWellFormed());
+}
+
+
 QTEST_GUILESS_MAIN(ProcCFGTest)
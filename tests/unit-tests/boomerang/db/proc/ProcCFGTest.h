@@ -31,4 +31,5 @@ private slots:
     void testRemoveBB();
     void testAddEdge();
     void testIsWellFormed();
+    void testIsModified();
 };
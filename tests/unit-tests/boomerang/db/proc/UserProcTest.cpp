@@ -133,6 +133,113 @@ void UserProcTest::testInsertStatementAfter()
 }
 
 
+void UserProcTest::testDefUseIndex()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+
+    Assign *as1 = new Assign(VoidType::get(), Location::regOf(REG_PENT_EAX), Const::get(5));
+    Assign *as2 = new Assign(VoidType::get(), Location::regOf(REG_PENT_ECX),
+                             RefExp::get(Location::regOf(REG_PENT_EAX), as1));
+    as1->setProc(&proc);
+    as2->setProc(&proc);
+
+    std::unique_ptr<RTLList> bbRTLs(new RTLList);
+    bbRTLs->push_back(std::unique_ptr<RTL>(new RTL(Address(0x1000), { as1, as2 })));
+    proc.getCFG()->createBB(BBType::Fall, std::move(bbRTLs));
+
+    QVERIFY(!proc.isDefUseIndexValid());
+    DefUseIndex &index = proc.getDefUseIndex();
+    QVERIFY(proc.isDefUseIndexValid());
+
+    QCOMPARE(index.getUsers(as1), std::vector<Statement *>({ as2 }));
+    QVERIFY(index.getUsers(as2).empty());
+    QCOMPARE(index.getUsedDefs(as2), std::vector<const Statement *>({ as1 }));
+
+    // insertion
+    Assign *as3 = proc.insertAssignAfter(as2, Location::regOf(REG_PENT_EDX),
+                                         RefExp::get(Location::regOf(REG_PENT_ECX), as2));
+    QCOMPARE(index.getUsers(as2), std::vector<Statement *>({ as3 }));
+    QVERIFY(index.verify(&proc));
+
+    // modification
+    as3->setRight(RefExp::get(Location::regOf(REG_PENT_EAX), as1));
+    QVERIFY(!index.verify(&proc));
+    index.updateStatement(as3);
+    QVERIFY(index.verify(&proc));
+    QCOMPARE(index.getUsers(as1), std::vector<Statement *>({ as2, as3 }));
+    QCOMPARE(index.getNumDirectUsers(as1), 2);
+    QVERIFY(!index.isUsed(as2));
+
+    // removal
+    QVERIFY(proc.removeStatement(as2));
+    QCOMPARE(index.getUsers(as1), std::vector<Statement *>({ as3 }));
+    QVERIFY(index.verify(&proc));
+    delete as2;
+
+    // removing a statement twice
+    proc.getDefUseIndex().removeStatement(as3);
+    proc.getDefUseIndex().removeStatement(as3);
+    QVERIFY(index.getUsers(as1).empty());
+    QCOMPARE(index.getNumDirectUsers(as1), 0);
+    proc.getDefUseIndex().addStatement(as3);
+
+    // changing the definition of a reference
+    as3->getRight()->access<RefExp>()->setDef(nullptr, as3);
+    QVERIFY(proc.isDefUseIndexValid());
+    QVERIFY(index.getUsers(as1).empty());
+    QVERIFY(index.verify(&proc));
+
+    // invalidating the indices of all procedures
+    DefUseIndex::invalidateAll();
+    QVERIFY(!proc.isDefUseIndexValid());
+    proc.getDefUseIndex();
+    QVERIFY(proc.isDefUseIndexValid());
+
+    proc.invalidateDefUseIndex();
+    QVERIFY(!proc.isDefUseIndexValid());
+}
+
+
+void UserProcTest::testDefUseIndexChanges()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+
+    Assign *as1 = new Assign(VoidType::get(), Location::regOf(REG_PENT_EAX), Const::get(5));
+    Assign *as2 = new Assign(VoidType::get(), Location::regOf(REG_PENT_ECX),
+                             RefExp::get(Location::regOf(REG_PENT_EAX), as1));
+    as1->setProc(&proc);
+    as2->setProc(&proc);
+
+    std::unique_ptr<RTLList> bbRTLs(new RTLList);
+    bbRTLs->push_back(std::unique_ptr<RTL>(new RTL(Address(0x1000), { as1, as2 })));
+    proc.getCFG()->createBB(BBType::Fall, std::move(bbRTLs));
+
+    // all statements are new
+    DefUseIndex &index = proc.getDefUseIndex();
+    QCOMPARE(index.getChangedStatements(), std::vector<Statement *>({ as1, as2 }));
+    index.clearChangedStatements();
+    QVERIFY(index.getChangedStatements().empty());
+
+    const SharedExp eax1 = RefExp::get(Location::regOf(REG_PENT_EAX), as1);
+    QCOMPARE(index.getDestCounts().at(eax1), 1);
+    QCOMPARE(index.getDestCounts(as2).at(eax1), 1);
+
+    // a new use
+    Assign *as3 = proc.insertAssignAfter(as2, Location::regOf(REG_PENT_EDX),
+                                         RefExp::get(Location::regOf(REG_PENT_EAX), as1));
+    QCOMPARE(index.getChangedStatements(), std::vector<Statement *>({ as3 }));
+    QCOMPARE(index.getDestCounts().at(eax1), 2);
+    index.clearChangedStatements();
+
+    // After removing a use, the remaining user might be propagated to
+    QVERIFY(proc.removeStatement(as3));
+    delete as3;
+    QCOMPARE(index.getDestCounts().at(eax1), 1);
+    QCOMPARE(index.getChangedStatements(), std::vector<Statement *>({ as2 }));
+    QVERIFY(index.verify(&proc));
+}
+
+
 void UserProcTest::testAddParameterToSignature()
 {
     UserProc proc(Address(0x1000), "test", nullptr);
@@ -639,6 +746,47 @@ void UserProcTest::testAddCallee()
 }
 
 
+void UserProcTest::testBodyLoader()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    UserProc callee(Address(0x2000), "callee", nullptr);
+
+    int numLoads = 0;
+    auto loader  = [&numLoads, &callee](UserProc *p) {
+        numLoads++;
+        p->addLocal(IntegerType::get(32, Sign::Signed), "foo", Location::regOf(REG_PENT_EAX));
+        p->addCallee(&callee);
+    };
+
+    proc.setBodyLoader(loader);
+    QVERIFY(!proc.isBodyLoaded());
+
+    // modifying the body loads it first
+    proc.addCallee(&callee);
+    QVERIFY(proc.isBodyLoaded());
+    QCOMPARE(numLoads, 1);
+    QCOMPARE(proc.getCallees().size(), static_cast<size_t>(1));
+    QCOMPARE(proc.lookupSym(Location::regOf(REG_PENT_EAX), VoidType::get()), QString("foo"));
+
+    proc.clearBody();
+    QVERIFY(proc.getCallees().empty());
+    QVERIFY(proc.getLocals().empty());
+    QVERIFY(proc.getSymbolMap().empty());
+
+    // a body that has not been loaded is discarded without loading it
+    proc.setBodyLoader(loader);
+    proc.clearBody();
+    QVERIFY(proc.isBodyLoaded());
+    QCOMPARE(numLoads, 1);
+    QVERIFY(proc.getLocals().empty());
+
+    // looking up symbols loads the body
+    proc.setBodyLoader(loader);
+    QCOMPARE(proc.lookupSym(Location::regOf(REG_PENT_EAX), VoidType::get()), QString("foo"));
+    QCOMPARE(numLoads, 2);
+}
+
+
 void UserProcTest::testPreservesExp()
 {
     QVERIFY(m_project.loadBinaryFile(SAMPLE("pentium/fib")));
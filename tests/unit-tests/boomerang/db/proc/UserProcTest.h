@@ -22,6 +22,8 @@ private slots:
     void testRemoveStatement();
     void testInsertAssignAfter();
     void testInsertStatementAfter();
+    void testDefUseIndex();
+    void testDefUseIndexChanges();
 
     void testAddParameterToSignature();
     void testInsertParameter();
@@ -48,6 +50,7 @@ private slots:
 
     void testMarkAsNonChildless();
     void testAddCallee();
+    void testBodyLoader();
     void testPreservesExp();
     void testPreservesExpWithOffset();
     void testPromoteSignature();
@@ -0,0 +1,150 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProcSchedulerTest.h"
+
+
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/decomp/ProcScheduler.h"
+
+#include <map>
+#include <mutex>
+#include <thread>
+
+
+/**
+ * Creates the following call graph:
+ *   main -> a, d (library), e
+ *   a    -> b
+ *   b    -> a, c
+ * a and b form a recursion group.
+ */
+static void createCallGraph(Prog &prog)
+{
+    Module *mod = prog.getRootModule();
+
+    UserProc *mainProc = static_cast<UserProc *>(mod->createFunction("main", Address(0x1000)));
+    UserProc *a        = static_cast<UserProc *>(mod->createFunction("a", Address(0x2000)));
+    UserProc *b        = static_cast<UserProc *>(mod->createFunction("b", Address(0x3000)));
+    UserProc *c        = static_cast<UserProc *>(mod->createFunction("c", Address(0x4000)));
+    Function *d        = mod->createFunction("d", Address(0x5000), true);
+    UserProc *e        = static_cast<UserProc *>(mod->createFunction("e", Address(0x6000)));
+
+    mainProc->addCallee(a);
+    mainProc->addCallee(d);
+    mainProc->addCallee(e);
+    a->addCallee(b);
+    b->addCallee(a);
+    b->addCallee(c);
+}
+
+
+/// \returns the names of the procs in \p group, separated by ','
+static QString groupToString(const ProcScheduler::ProcGroup &group)
+{
+    QStringList names;
+    for (UserProc *proc : group) {
+        names.append(proc->getName());
+    }
+
+    return names.join(",");
+}
+
+
+void ProcSchedulerTest::testGetCallGraphSCCs()
+{
+    Prog prog("test", &m_project);
+    createCallGraph(prog);
+
+    ProcScheduler scheduler(&prog, 1);
+    const std::vector<ProcScheduler::ProcGroup> sccs = scheduler.getCallGraphSCCs();
+
+    QCOMPARE(sccs.size(), static_cast<size_t>(4));
+    QCOMPARE(groupToString(sccs[0]), QString("c"));
+    QCOMPARE(groupToString(sccs[1]), QString("a,b"));
+    QCOMPARE(groupToString(sccs[2]), QString("e"));
+    QCOMPARE(groupToString(sccs[3]), QString("main"));
+}
+
+
+void ProcSchedulerTest::testRunBottomUpSerial()
+{
+    Prog prog("test", &m_project);
+    createCallGraph(prog);
+
+    QStringList order;
+    ProcScheduler scheduler(&prog, 1);
+    QCOMPARE(scheduler.getNumThreads(), 1);
+
+    scheduler.runBottomUp([&order](UserProc *proc) { order.append(proc->getName()); });
+
+    QCOMPARE(order.join(","), QString("c,a,b,e,main"));
+}
+
+
+void ProcSchedulerTest::testRunBottomUpParallel()
+{
+    for (int run = 0; run < 20; ++run) {
+        Prog prog("test", &m_project);
+        createCallGraph(prog);
+
+        std::mutex mutex;
+        QStringList order;
+        std::map<QString, std::thread::id> threadOf;
+        std::map<std::thread::id, QStringList> orderOnThread;
+
+        ProcScheduler scheduler(&prog, 4);
+        QCOMPARE(scheduler.getNumThreads(), 4);
+
+        scheduler.runBottomUp([&](UserProc *proc) {
+            std::lock_guard<std::mutex> guard(mutex);
+            order.append(proc->getName());
+            threadOf[proc->getName()] = std::this_thread::get_id();
+            orderOnThread[std::this_thread::get_id()].append(proc->getName());
+        });
+
+        QCOMPARE(order.size(), 5);
+
+        // callees before callers
+        QVERIFY(order.indexOf("c") < order.indexOf("a"));
+        QVERIFY(order.indexOf("c") < order.indexOf("b"));
+        QVERIFY(order.indexOf("a") < order.indexOf("main"));
+        QVERIFY(order.indexOf("b") < order.indexOf("main"));
+        QVERIFY(order.indexOf("e") < order.indexOf("main"));
+
+        // the recursion group is processed by a single worker, in module order, as a unit
+        QVERIFY(threadOf["a"] == threadOf["b"]);
+        const QStringList &groupThreadOrder = orderOnThread[threadOf["a"]];
+        QCOMPARE(groupThreadOrder.indexOf("b"), groupThreadOrder.indexOf("a") + 1);
+    }
+}
+
+
+void ProcSchedulerTest::testRunUnordered()
+{
+    Prog prog("test", &m_project);
+    createCallGraph(prog);
+
+    std::mutex mutex;
+    QStringList procs;
+
+    ProcScheduler scheduler(&prog, 4);
+    scheduler.runUnordered([&](UserProc *proc) {
+        std::lock_guard<std::mutex> guard(mutex);
+        procs.append(proc->getName());
+    });
+
+    procs.sort();
+    QCOMPARE(procs.join(","), QString("a,b,c,e,main"));
+}
+
+
+QTEST_GUILESS_MAIN(ProcSchedulerTest)
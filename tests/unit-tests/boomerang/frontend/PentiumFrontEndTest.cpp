@@ -11,7 +11,10 @@
 
 #include "boomerang-plugins/frontend/x86/PentiumFrontEnd.h"
 
+#include "boomerang/core/Settings.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/UserProc.h"
 #include "boomerang/ifc/IDecoder.h"
 #include "boomerang/ssl/RTL.h"
 #include "boomerang/util/Types.h"
@@ -216,4 +219,39 @@ void FrontPentTest::testFindMain()
 }
 
 
+void FrontPentTest::testParallelDecode()
+{
+    const QString serial = decodeWithThreads(FEDORA2_TRUE, 1);
+    QVERIFY(!serial.isEmpty());
+
+    const QString parallel = decodeWithThreads(FEDORA2_TRUE, 4);
+    QCOMPARE(parallel, serial);
+}
+
+
+QString FrontPentTest::decodeWithThreads(const QString &binaryFile, int numThreads)
+{
+    m_project.getSettings()->numThreads = numThreads;
+
+    if (!m_project.loadBinaryFile(binaryFile) || !m_project.decodeBinaryFile()) {
+        return "";
+    }
+
+    QString result;
+    OStream os(&result);
+
+    for (const auto &module : m_project.getProg()->getModuleList()) {
+        for (Function *func : *module) {
+            os << func->getName() << " " << func->getEntryAddress() << "\n";
+
+            if (!func->isLib()) {
+                static_cast<UserProc *>(func)->print(os);
+            }
+        }
+    }
+
+    return result;
+}
+
+
 QTEST_GUILESS_MAIN(FrontPentTest)
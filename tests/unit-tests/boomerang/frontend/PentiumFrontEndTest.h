@@ -24,4 +24,10 @@ private slots:
     void testFindMain();
     void testBranch();
 
+    /// Decoding with multiple threads must give the same result as decoding with one thread.
+    void testParallelDecode();
+
+private:
+    /// Decode \p binaryFile using \p numThreads threads and return the decoded procedures
+    QString decodeWithThreads(const QString &binaryFile, int numThreads);
 };
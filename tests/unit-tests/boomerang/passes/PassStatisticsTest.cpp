@@ -0,0 +1,87 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "PassStatisticsTest.h"
+
+
+#include "boomerang/passes/PassManager.h"
+#include "boomerang/passes/PassStatistics.h"
+
+#include <QDir>
+#include <QFile>
+
+
+void PassStatisticsTest::testAddInvocation()
+{
+    IPass *propagation = PassManager::get()->getPass(PassID::StatementPropagation);
+    IPass *rename      = PassManager::get()->getPass(PassID::BlockVarRename);
+
+    PassStatistics stats;
+    stats.addInvocation(propagation, "main", 1000, true, 10, 8);
+    stats.addInvocation(propagation, "main", 500, false, 8, 8);
+    stats.addInvocation(propagation, "foo", 200, true, 5, 4);
+    stats.addInvocation(rename, "foo", 300, true, 5, 5);
+
+    const PassStats total = stats.getPassStats(PassID::StatementPropagation);
+    QCOMPARE(total.numInvocations, static_cast<quint64>(3));
+    QCOMPARE(total.numChanged, static_cast<quint64>(2));
+    QCOMPARE(total.timeNs, static_cast<qint64>(1700));
+    QCOMPARE(total.stmtsBefore, static_cast<quint64>(23));
+    QCOMPARE(total.stmtsAfter, static_cast<quint64>(20));
+
+    const PassStats mainStats = stats.getPassStats(PassID::StatementPropagation, "main");
+    QCOMPARE(mainStats.numInvocations, static_cast<quint64>(2));
+    QCOMPARE(mainStats.numChanged, static_cast<quint64>(1));
+    QCOMPARE(mainStats.timeNs, static_cast<qint64>(1500));
+
+    QCOMPARE(stats.getPassStats(PassID::BlockVarRename, "main").numInvocations,
+             static_cast<quint64>(0));
+    QCOMPARE(stats.getPassStats(PassID::BlockVarRename, "foo").numInvocations,
+             static_cast<quint64>(1));
+
+    stats.clear();
+    QCOMPARE(stats.getPassStats(PassID::StatementPropagation).numInvocations,
+             static_cast<quint64>(0));
+}
+
+
+void PassStatisticsTest::testWriteToFile()
+{
+    PassStatistics stats;
+    stats.addInvocation(PassManager::get()->getPass(PassID::StatementPropagation), "main", 1000,
+                        true, 10, 8);
+
+    const QString jsonPath = QDir::temp().absoluteFilePath("PassStatisticsTest.json");
+    QVERIFY(stats.writeToFile(jsonPath));
+
+    QFile jsonFile(jsonPath);
+    QVERIFY(jsonFile.open(QFile::ReadOnly));
+    const QString json = jsonFile.readAll();
+    jsonFile.close();
+
+    QVERIFY(json.contains("\"name\": \"main\""));
+    QVERIFY(json.contains("\"invocations\": 1"));
+    QVERIFY(QFile::remove(jsonPath));
+
+    const QString csvPath = QDir::temp().absoluteFilePath("PassStatisticsTest.csv");
+    QVERIFY(stats.writeToFile(csvPath));
+
+    QFile csvFile(csvPath);
+    QVERIFY(csvFile.open(QFile::ReadOnly));
+    const QStringList lines = QString(csvFile.readAll()).split('\n', QString::SkipEmptyParts);
+    csvFile.close();
+
+    QCOMPARE(lines.size(), 3); // header, total, main
+    QCOMPARE(lines[0], QString("procedure,pass,invocations,changed,timeMs,stmtsBefore,stmtsAfter"));
+    QVERIFY(lines[2].startsWith("\"main\","));
+    QVERIFY(QFile::remove(csvPath));
+}
+
+
+QTEST_GUILESS_MAIN(PassStatisticsTest)
@@ -0,0 +1,44 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "StatementPropagationPassTest.h"
+
+
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/passes/PassManager.h"
+
+
+#define FIB_PENTIUM    (m_project.getSettings()->getDataDirectory().absoluteFilePath("samples/pentium/fib"))
+
+
+void StatementPropagationPassTest::testFixpoint()
+{
+    QVERIFY(m_project.loadBinaryFile(FIB_PENTIUM));
+    QVERIFY(m_project.decodeBinaryFile());
+
+    UserProc *proc = static_cast<UserProc *>(m_project.getProg()->getFunctionByName("fib"));
+    QVERIFY(proc != nullptr);
+
+    PassManager::get()->executePass(PassID::StatementInit, proc);
+    PassManager::get()->executePass(PassID::Dominators, proc);
+    PassManager::get()->executePass(PassID::CallDefineUpdate, proc);
+    PassManager::get()->executePass(PassID::PhiPlacement, proc);
+    PassManager::get()->executePass(PassID::BlockVarRename, proc);
+
+    QVERIFY(PassManager::get()->executePass(PassID::StatementPropagation, proc));
+    const QString propagated = proc->toString();
+
+    QVERIFY(!PassManager::get()->executePass(PassID::StatementPropagation, proc));
+    QCOMPARE(proc->toString(), propagated);
+}
+
+
+QTEST_GUILESS_MAIN(StatementPropagationPassTest)
@@ -0,0 +1,24 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+class StatementPropagationPassTest : public BoomerangTestWithPlugins
+{
+    Q_OBJECT
+
+private slots:
+    /// A single execution of the pass must propagate as far as repeated executions,
+    /// i.e. it must keep the use counts of locations up to date while propagating.
+    void testFixpoint();
+};
@@ -0,0 +1,171 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ExpInternerTest.h"
+
+
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/ExpInterner.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/type/IntegerType.h"
+#include "boomerang/visitor/expmodifier/ExpInternModifier.h"
+#include "boomerang/visitor/stmtmodifier/StmtModifier.h"
+
+#include <set>
+
+
+void ExpInternerTest::testIntern()
+{
+    ExpInterner interner;
+
+    SharedExp e1 = Binary::get(opPlus, Location::regOf(REG_PENT_ESP), Const::get(4));
+    SharedExp e2 = Binary::get(opPlus, Location::regOf(REG_PENT_ESP), Const::get(4));
+
+    SharedExp i1 = interner.intern(e1);
+    SharedExp i2 = interner.intern(e2);
+
+    QVERIFY(i1 == i2);
+    QVERIFY(*i1 == *e1);
+    QVERIFY(interner.isInterned(i1));
+    QVERIFY(!interner.isInterned(Const::get(4)));
+    QCOMPARE(interner.getHash(i1), interner.getHash(i2));
+
+    // r[28], 28, 4, r[28] + 4
+    QCOMPARE(interner.getNumNodes(), static_cast<std::size_t>(4));
+
+    // interning a canonical node again is a no-op
+    QVERIFY(interner.intern(i1) == i1);
+
+    interner.clear();
+    QCOMPARE(interner.getNumNodes(), static_cast<std::size_t>(0));
+    QVERIFY(!interner.isInterned(i1));
+}
+
+
+void ExpInternerTest::testReuseSubExp()
+{
+    ExpInterner interner;
+
+    SharedExp esp = interner.intern(Location::regOf(REG_PENT_ESP));
+    SharedExp sum = interner.intern(Binary::get(opPlus, esp, Const::get(4)));
+
+    QVERIFY(sum->getSubExp1() == esp);
+
+    // all children are canonical, so the node itself becomes canonical
+    SharedExp memof = Location::memOf(sum);
+    QVERIFY(interner.intern(memof) == memof);
+
+    // children that are not canonical are replaced, the original is not modified
+    SharedExp other = Location::memOf(Binary::get(opPlus, Location::regOf(REG_PENT_ESP),
+                                                  Const::get(4)));
+    SharedExp canonical = interner.intern(other);
+
+    QVERIFY(canonical == memof);
+    QVERIFY(other->getSubExp1() != sum);
+}
+
+
+void ExpInternerTest::testDistinct()
+{
+    ExpInterner interner;
+
+    // different definitions
+    Assign as1(Location::regOf(REG_PENT_EAX), Const::get(0));
+    Assign as2(Location::regOf(REG_PENT_EAX), Const::get(1));
+
+    SharedExp ref1 = interner.intern(RefExp::get(Location::regOf(REG_PENT_EAX), &as1));
+    SharedExp ref2 = interner.intern(RefExp::get(Location::regOf(REG_PENT_EAX), &as2));
+    QVERIFY(ref1 != ref2);
+    QVERIFY(ref1->getSubExp1() == ref2->getSubExp1());
+
+    // different representation of the same value
+    SharedExp c1 = interner.intern(Const::get(5));
+    SharedExp c2 = interner.intern(Const::get(Address(5)));
+    QVERIFY(*c1 == *c2);
+    QVERIFY(c1 != c2);
+
+    // different types
+    SharedExp c3 = interner.intern(Const::get(5, IntegerType::get(32, Sign::Signed)));
+    SharedExp c4 = interner.intern(Const::get(5, IntegerType::get(16, Sign::Signed)));
+    QVERIFY(c3 != c4);
+    QVERIFY(c3 == interner.intern(Const::get(5, IntegerType::get(32, Sign::Signed))));
+}
+
+
+void ExpInternerTest::testWildcards()
+{
+    ExpInterner interner;
+
+    SharedExp wild = Location::memOf(Terminal::get(opWild));
+    QVERIFY(interner.intern(wild) == wild);
+    QVERIFY(!interner.isInterned(wild));
+
+    SharedExp wildRef = RefExp::get(Location::regOf(REG_PENT_EAX), STMT_WILD);
+    QVERIFY(interner.intern(wildRef) == wildRef);
+    QVERIFY(!interner.isInterned(wildRef));
+}
+
+
+void ExpInternerTest::testCompare()
+{
+    ExpInterner interner;
+
+    SharedExp a = interner.intern(Binary::get(opMinus, Location::regOf(REG_PENT_EBX),
+                                              Const::get(8)));
+    SharedExp b = interner.intern(Binary::get(opMinus, Location::regOf(REG_PENT_EBX),
+                                              Const::get(8)));
+    SharedExp c = interner.intern(Binary::get(opMinus, Location::regOf(REG_PENT_EBX),
+                                              Const::get(12)));
+
+    QVERIFY(*a == *b);
+    QVERIFY(!(*a < *b));
+    QVERIFY(*a < *c);
+
+    std::set<SharedExp, lessExpStar> exps = { a, b, c };
+    QCOMPARE(exps.size(), static_cast<std::size_t>(2));
+}
+
+
+void ExpInternerTest::testInternModifier()
+{
+    ExpInterner interner;
+    ExpInternModifier internModifier(&interner);
+    StmtModifier stmtModifier(&internModifier);
+
+    // r24 := r24 + 1
+    Assign asgn1(Location::regOf(REG_PENT_EAX),
+                 Binary::get(opPlus, Location::regOf(REG_PENT_EAX), Const::get(1)));
+    // r25 := r24 + 1
+    Assign asgn2(Location::regOf(REG_PENT_ECX),
+                 Binary::get(opPlus, Location::regOf(REG_PENT_EAX), Const::get(1)));
+
+    const QString before1 = asgn1.toString();
+    const QString before2 = asgn2.toString();
+
+    asgn1.accept(&stmtModifier);
+    asgn2.accept(&stmtModifier);
+
+    QCOMPARE(asgn1.toString(), before1);
+    QCOMPARE(asgn2.toString(), before2);
+
+    QVERIFY(interner.isInterned(asgn1.getLeft()));
+    QVERIFY(interner.isInterned(asgn1.getRight()));
+    QVERIFY(asgn1.getRight() == asgn2.getRight());
+    QVERIFY(asgn1.getRight()->getSubExp1() == asgn1.getLeft());
+
+    // r24, r25, 24, 25, 1, r24 + 1
+    QCOMPARE(interner.getNumNodes(), static_cast<std::size_t>(6));
+}
+
+
+QTEST_GUILESS_MAIN(ExpInternerTest)
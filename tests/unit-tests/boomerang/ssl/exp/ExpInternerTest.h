@@ -0,0 +1,41 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+/**
+ * Tests for hash-consing of expressions
+ */
+class ExpInternerTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    /// Test that structurally identical expressions are shared
+    void testIntern();
+
+    /// Test that canonical sub-expressions are re-used without copying them
+    void testReuseSubExp();
+
+    /// Test that expressions that are equal but not identical are not merged
+    void testDistinct();
+
+    /// Test that wildcards are not interned
+    void testWildcards();
+
+    /// Test comparison of shared expressions
+    void testCompare();
+
+    /// Test interning all expressions of statements
+    void testInternModifier();
+};
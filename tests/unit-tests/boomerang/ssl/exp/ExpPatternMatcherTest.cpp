@@ -0,0 +1,148 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ExpPatternMatcherTest.h"
+
+
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/ExpPatternMatcher.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/statements/Assign.h"
+
+
+void ExpPatternMatcherTest::testMatch()
+{
+    // clang-format off
+    const ExpPatternMatcher matcher = {
+        // m[m[<expr> + K1] + K2]
+        Location::memOf(Binary::get(opPlus,
+                                    Location::memOf(Binary::get(opPlus,
+                                                                Terminal::get(opWild),
+                                                                Terminal::get(opWildIntConst))),
+                                    Terminal::get(opWildIntConst))),
+        // m[<expr> * 4 + K]
+        Location::memOf(Binary::get(opPlus,
+                                    Binary::get(opMult, Terminal::get(opWild), Const::get(4)),
+                                    Terminal::get(opWildIntConst))),
+        // m[<expr>]
+        Location::memOf(Terminal::get(opWild))
+    };
+    // clang-format on
+
+    QCOMPARE(matcher.getNumPatterns(), 3);
+
+    ExpPatternMatcher::Bindings bindings;
+
+    // m[m[r24 + 8] + 12]
+    SharedExp e = Location::memOf(Binary::get(
+        opPlus, Location::memOf(Binary::get(opPlus, Location::regOf(REG_PENT_EAX), Const::get(8))),
+        Const::get(12)));
+
+    QCOMPARE(matcher.match(e, &bindings), 0);
+    QCOMPARE(bindings.size(), static_cast<std::size_t>(3));
+    QCOMPARE(*bindings[0], *Location::regOf(REG_PENT_EAX));
+    QCOMPARE(*bindings[1], *Const::get(8));
+    QCOMPARE(*bindings[2], *Const::get(12));
+
+    // m[r24 * 4 + 0x1000]
+    e = Location::memOf(
+        Binary::get(opPlus, Binary::get(opMult, Location::regOf(REG_PENT_EAX), Const::get(4)),
+                    Const::get(0x1000)));
+
+    QCOMPARE(matcher.match(e, &bindings), 1);
+    QCOMPARE(bindings.size(), static_cast<std::size_t>(2));
+    QCOMPARE(*bindings[0], *Location::regOf(REG_PENT_EAX));
+    QCOMPARE(*bindings[1], *Const::get(0x1000));
+
+    // m[r24 * 8 + 0x1000]: stride does not match, so only m[<expr>] matches
+    e = Location::memOf(
+        Binary::get(opPlus, Binary::get(opMult, Location::regOf(REG_PENT_EAX), Const::get(8)),
+                    Const::get(0x1000)));
+
+    QCOMPARE(matcher.match(e, &bindings), 2);
+    QCOMPARE(bindings.size(), static_cast<std::size_t>(1));
+    QCOMPARE(*bindings[0], *e->getSubExp1());
+
+    // r24 + 4
+    QCOMPARE(matcher.match(Binary::get(opPlus, Location::regOf(REG_PENT_EAX), Const::get(4))), -1);
+}
+
+
+void ExpPatternMatcherTest::testMatchNoSubscript()
+{
+    const ExpPatternMatcher matcher = {
+        Binary::get(opPlus, Terminal::get(opWild), Terminal::get(opWildIntConst)),
+        RefExp::get(Location::memOf(Terminal::get(opWild)), STMT_WILD)
+    };
+
+    Assign def(Location::regOf(REG_PENT_EAX), Const::get(0));
+
+    ExpPatternMatcher::Bindings bindings;
+
+    // r24{def} + 4
+    SharedExp e = Binary::get(opPlus, RefExp::get(Location::regOf(REG_PENT_EAX), &def),
+                              Const::get(4));
+
+    QCOMPARE(matcher.match(e, &bindings), 0);
+    QCOMPARE(bindings.size(), static_cast<std::size_t>(2));
+    QVERIFY(bindings[0]->isSubscript()); // bindings keep their subscripts
+    QCOMPARE(*bindings[1], *Const::get(4));
+
+    // m[r24]{-} and m[r24]
+    QCOMPARE(matcher.match(RefExp::get(Location::memOf(Location::regOf(REG_PENT_EAX)), nullptr)),
+             1);
+    QCOMPARE(matcher.match(Location::memOf(Location::regOf(REG_PENT_EAX))), 1);
+
+    // Same result as matching the patterns one by one
+    for (int i = 0; i < matcher.getNumPatterns(); i++) {
+        QCOMPARE(e->equalNoSubscript(*matcher.getPattern(i)), i == 0);
+    }
+}
+
+
+void ExpPatternMatcherTest::testSearchAll()
+{
+    const ExpPatternMatcher matcher = {
+        Location::memOf(Terminal::get(opWild)),
+        Binary::get(opPlus, Terminal::get(opWild), Terminal::get(opWildIntConst))
+    };
+
+    // m[r24 + 4] + m[r25]{-}
+    SharedExp e = Binary::get(
+        opPlus, Location::memOf(Binary::get(opPlus, Location::regOf(REG_PENT_EAX), Const::get(4))),
+        RefExp::get(Location::memOf(Location::regOf(REG_PENT_ECX)), nullptr));
+
+    std::list<ExpPatternMatcher::Match> result;
+    QVERIFY(matcher.searchAll(e, result));
+    QCOMPARE(result.size(), static_cast<std::size_t>(3));
+
+    auto it = result.begin();
+    QCOMPARE(it->patternIdx, 0);
+    QCOMPARE(*it->exp, *e->getSubExp1());
+
+    ++it;
+    QCOMPARE(it->patternIdx, 1);
+    QCOMPARE(*it->exp, *e->getSubExp1()->getSubExp1());
+    QCOMPARE(*it->bindings[1], *Const::get(4));
+
+    ++it;
+    QCOMPARE(it->patternIdx, 0);
+    QCOMPARE(*it->exp, *Location::memOf(Location::regOf(REG_PENT_ECX)));
+    QCOMPARE(*it->bindings[0], *Location::regOf(REG_PENT_ECX));
+
+    result.clear();
+    QVERIFY(!matcher.searchAll(Location::regOf(REG_PENT_EAX), result));
+    QVERIFY(result.empty());
+}
+
+
+QTEST_GUILESS_MAIN(ExpPatternMatcherTest)
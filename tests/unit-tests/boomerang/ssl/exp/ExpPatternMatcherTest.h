@@ -0,0 +1,32 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+/**
+ * Tests for matching expressions against multiple patterns
+ */
+class ExpPatternMatcherTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    /// Test that the first matching pattern is found and its wildcards are bound
+    void testMatch();
+
+    /// Test that subscripts are ignored like in Exp::equalNoSubscript
+    void testMatchNoSubscript();
+
+    /// Test matching all sub-expressions in one traversal
+    void testSearchAll();
+};
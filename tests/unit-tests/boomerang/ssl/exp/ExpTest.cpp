@@ -25,6 +25,7 @@
 #include "boomerang/util/LocationSet.h"
 
 #include <map>
+#include <unordered_map>
 
 
 Q_DECLARE_METATYPE(LocationSet)
@@ -503,6 +504,37 @@ void ExpTest::testMapOfExp()
 }
 
 
+void ExpTest::testHashMapOfExp()
+{
+    std::unordered_map<SharedConstExp, int, hashExpStar, equalExpStar> m;
+
+    Assign s7(Terminal::get(opNil), Terminal::get(opNil));
+    s7.setNumber(7);
+
+    m[m_rof2] = 200;
+    m[m_99]   = 99;
+    m[Location::memOf(Binary::get(opPlus, Location::regOf(REG_PENT_ESP), Const::get(4)))] = 4;
+
+    m[Location::regOf(REG_SPARC_G2)] = 2; // Should overwrite
+    m[Location::memOf(Binary::get(opPlus,
+                                  RefExp::get(Location::regOf(REG_PENT_ESP), &s7),
+                                  Const::get(4)))] = 5;
+
+    QCOMPARE(m.size(), static_cast<size_t>(4));
+    QCOMPARE(m[m_rof2], 2);
+    QCOMPARE(m[m_99], 99);
+    QCOMPARE(m[Location::memOf(Binary::get(opPlus, Location::regOf(REG_PENT_ESP), Const::get(4)))], 4);
+
+    // Definitions of RefExps and types of TypedExps are not hashed,
+    // but they must not make equal expressions different
+    hashExpStar hash;
+    QCOMPARE(hash(RefExp::get(Location::regOf(REG_PENT_EAX), &s7)),
+             hash(RefExp::get(Location::regOf(REG_PENT_EAX), nullptr)));
+    QCOMPARE(hash(Const::get(-0.0)), hash(Const::get(0.0)));
+    QVERIFY(equalExpStar()(Const::get(-0.0), Const::get(0.0)));
+}
+
+
 void ExpTest::testList()
 {
     QCOMPARE(Binary::get(opList, Terminal::get(opNil), Terminal::get(opNil))->toString(), QString(""));
@@ -99,6 +99,9 @@ private slots:
     /// Test maps of Exp*s; exercises some comparison operators
     void testMapOfExp();
 
+    /// Test hash maps of Exp*s; hashes must be consistent with operator<
+    void testHashMapOfExp();
+
     /// Test the opList creating and printing
     void testList();
 
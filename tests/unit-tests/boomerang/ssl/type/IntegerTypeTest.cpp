@@ -26,6 +26,26 @@ void IntegerTypeTest::testConstruct()
 }
 
 
+void IntegerTypeTest::testGet()
+{
+    // types of common sizes are shared
+    QVERIFY(IntegerType::get(32, Sign::Signed) == IntegerType::get(32, Sign::Signed));
+    QVERIFY(IntegerType::get(32, Sign::Signed) != IntegerType::get(32, Sign::SignedStrong));
+    QVERIFY(IntegerType::get(32, Sign::Signed) != IntegerType::get(16, Sign::Signed));
+
+    std::shared_ptr<IntegerType> i1 = IntegerType::get(256, Sign::Unsigned);
+    QCOMPARE(i1->getSize(), 256);
+    QCOMPARE(i1->getSign(), Sign::Unsigned);
+
+    // meeting a shared type does not modify it
+    bool changed  = false;
+    SharedType i2 = IntegerType::get(32, Sign::Signed)->meetWith(IntegerType::get(32, Sign::Signed),
+                                                                 changed, false);
+    QCOMPARE(i2->as<IntegerType>()->getSign(), Sign::SignedStrong);
+    QCOMPARE(IntegerType::get(32, Sign::Signed)->getSign(), Sign::Signed);
+}
+
+
 void IntegerTypeTest::testEquals()
 {
     QCOMPARE(IntegerType(32, Sign::Signed)   == IntegerType(32, Sign::Signed), true);
@@ -66,6 +86,11 @@ void IntegerTypeTest::testIsComplete()
 
 void IntegerTypeTest::testSigned()
 {
+    const std::shared_ptr<IntegerType> signedInt   = IntegerType::get(32, Sign::Signed);
+    const std::shared_ptr<IntegerType> unsignedInt = IntegerType::get(32, Sign::Unsigned);
+
+    bool changed = false;
+
     IntegerType i1(32, Sign::Unknown);
     QVERIFY(i1.isMaybeSigned());
     QVERIFY(i1.isMaybeUnsigned());
@@ -73,43 +98,46 @@ void IntegerTypeTest::testSigned()
     QVERIFY(!i1.isUnsigned());
     QVERIFY(i1.isSignUnknown());
 
-    i1.hintAsSigned();
-    QVERIFY(i1.getSign() == Sign::Signed);
-    QVERIFY(i1.isMaybeSigned());
-    QVERIFY(!i1.isMaybeUnsigned());
-    QVERIFY(i1.isSigned());
-    QVERIFY(!i1.isUnsigned());
-    QVERIFY(!i1.isSignUnknown());
-
-    i1.hintAsSigned();
-    QVERIFY(i1.getSign() == Sign::SignedStrong);
-    QVERIFY(i1.isMaybeSigned());
-    QVERIFY(!i1.isMaybeUnsigned());
-    QVERIFY(i1.isSigned());
-    QVERIFY(!i1.isUnsigned());
-    QVERIFY(!i1.isSignUnknown());
-
-    i1.hintAsSigned();
-    QVERIFY(i1.getSign() == Sign::SignedStrong);
-
-    i1.setSignedness(Sign::Unsigned);
-    QVERIFY(i1.getSign() == Sign::Unsigned);
-    QVERIFY(!i1.isMaybeSigned());
-    QVERIFY(i1.isMaybeUnsigned());
-    QVERIFY(!i1.isSigned());
-    QVERIFY(i1.isUnsigned());
-    QVERIFY(!i1.isSignUnknown());
-
-    i1.hintAsUnsigned();
-    QVERIFY(i1.getSign() == Sign::UnsignedStrong);
-    QVERIFY(!i1.isMaybeSigned());
-    QVERIFY(i1.isMaybeUnsigned());
-    QVERIFY(!i1.isSigned());
-    QVERIFY(i1.isUnsigned());
-    QVERIFY(!i1.isSignUnknown());
-
-    i1.hintAsUnsigned();
-    QVERIFY(i1.getSign() == Sign::UnsignedStrong);
+    SharedType i2 = i1.meetWith(signedInt, changed, false);
+    QVERIFY(changed);
+    QVERIFY(i2->as<IntegerType>()->getSign() == Sign::Signed);
+    QVERIFY(i2->as<IntegerType>()->isMaybeSigned());
+    QVERIFY(!i2->as<IntegerType>()->isMaybeUnsigned());
+    QVERIFY(i2->as<IntegerType>()->isSigned());
+    QVERIFY(!i2->as<IntegerType>()->isUnsigned());
+    QVERIFY(!i2->as<IntegerType>()->isSignUnknown());
+
+    i2 = i2->meetWith(signedInt, changed, false);
+    QVERIFY(i2->as<IntegerType>()->getSign() == Sign::SignedStrong);
+    QVERIFY(i2->as<IntegerType>()->isMaybeSigned());
+    QVERIFY(!i2->as<IntegerType>()->isMaybeUnsigned());
+    QVERIFY(i2->as<IntegerType>()->isSigned());
+    QVERIFY(!i2->as<IntegerType>()->isUnsigned());
+    QVERIFY(!i2->as<IntegerType>()->isSignUnknown());
+
+    i2 = i2->meetWith(signedInt, changed, false);
+    QVERIFY(i2->as<IntegerType>()->getSign() == Sign::SignedStrong);
+
+    QVERIFY(!unsignedInt->isMaybeSigned());
+    QVERIFY(unsignedInt->isMaybeUnsigned());
+    QVERIFY(!unsignedInt->isSigned());
+    QVERIFY(unsignedInt->isUnsigned());
+    QVERIFY(!unsignedInt->isSignUnknown());
+
+    SharedType i3 = unsignedInt->meetWith(unsignedInt, changed, false);
+    QVERIFY(i3->as<IntegerType>()->getSign() == Sign::UnsignedStrong);
+    QVERIFY(!i3->as<IntegerType>()->isMaybeSigned());
+    QVERIFY(i3->as<IntegerType>()->isMaybeUnsigned());
+    QVERIFY(!i3->as<IntegerType>()->isSigned());
+    QVERIFY(i3->as<IntegerType>()->isUnsigned());
+    QVERIFY(!i3->as<IntegerType>()->isSignUnknown());
+
+    i3 = i3->meetWith(unsignedInt, changed, false);
+    QVERIFY(i3->as<IntegerType>()->getSign() == Sign::UnsignedStrong);
+
+    // the shared types were not modified
+    QVERIFY(signedInt->getSign() == Sign::Signed);
+    QVERIFY(unsignedInt->getSign() == Sign::Unsigned);
 }
 
 
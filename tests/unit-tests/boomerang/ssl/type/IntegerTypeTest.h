@@ -19,6 +19,7 @@ class IntegerTypeTest : public BoomerangTest
 
 private slots:
     void testConstruct();
+    void testGet();
     void testEquals();
     void testLess();
     void testIsComplete();
@@ -0,0 +1,113 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BitSetTest.h"
+
+
+#include "boomerang/util/BitSet.h"
+
+
+void BitSetTest::testSet()
+{
+    BitSet set;
+    QVERIFY(set.none());
+    QVERIFY(!set.test(5));
+
+    set.set(5);
+    QVERIFY(set.test(5));
+    QVERIFY(!set.test(4));
+    QVERIFY(set.size() > 5);
+
+    set.set(100); // grows
+    QVERIFY(set.test(100));
+    QCOMPARE(set.count(), std::size_t(2));
+
+    set.reset(5);
+    QVERIFY(!set.test(5));
+    set.reset(1000); // out of range
+    QCOMPARE(set.count(), std::size_t(1));
+
+    set.reset();
+    QVERIFY(set.none());
+    QVERIFY(set.size() > 100);
+}
+
+
+void BitSetTest::testResize()
+{
+    BitSet set(10);
+    QCOMPARE(set.size(), std::size_t(10));
+
+    set.set(3);
+    set.set(9);
+    set.resize(5);
+    QVERIFY(set.test(3));
+    QVERIFY(!set.test(9));
+
+    // bits that were cut off are not set again
+    set.resize(200);
+    QVERIFY(!set.test(9));
+    QCOMPARE(set.toString(), QString("3"));
+}
+
+
+void BitSetTest::testEquals()
+{
+    BitSet set1(10);
+    BitSet set2(300);
+    QVERIFY(set1 == set2);
+
+    set1.set(7);
+    QVERIFY(set1 != set2);
+
+    set2.set(7);
+    QVERIFY(set1 == set2);
+
+    set2.set(250);
+    QVERIFY(set1 != set2);
+    QVERIFY(set2 != set1);
+}
+
+
+void BitSetTest::testUnion()
+{
+    BitSet set1;
+    set1.set(1);
+    set1.set(64);
+
+    BitSet set2;
+    set2.set(2);
+    set2.set(130);
+
+    set1 |= set2;
+    QCOMPARE(set1.toString(), QString("1, 2, 64, 130"));
+    QCOMPARE(set2.toString(), QString("2, 130"));
+}
+
+
+void BitSetTest::testFindNext()
+{
+    BitSet set;
+    QCOMPARE(set.findFirst(), BitSet::npos);
+
+    set.set(0);
+    set.set(63);
+    set.set(64);
+    set.set(200);
+
+    QCOMPARE(set.findFirst(), std::size_t(0));
+    QCOMPARE(set.findNext(1), std::size_t(63));
+    QCOMPARE(set.findNext(64), std::size_t(64));
+    QCOMPARE(set.findNext(65), std::size_t(200));
+    QCOMPARE(set.findNext(201), BitSet::npos);
+    QCOMPARE(set.findNext(100000), BitSet::npos);
+}
+
+
+QTEST_GUILESS_MAIN(BitSetTest)
@@ -149,4 +149,32 @@ void ConnectionGraphTest::testUpdateConnection()
 }
 
 
+void ConnectionGraphTest::testIteration()
+{
+    ConnectionGraph cg;
+
+    SharedExp a = Location::regOf(REG_PENT_EAX);
+    SharedExp b = Location::regOf(REG_PENT_ECX);
+    SharedExp c = Location::regOf(REG_PENT_EDX);
+
+    cg.add(c, a);
+    cg.add(b, c);
+    cg.add(a, b);
+
+    // ordered by the first expression, then in the order the connections were added
+    QString actual;
+    for (const auto &[from, to] : cg) {
+        actual += from->toString() + "-" + to->toString() + " ";
+    }
+
+    QCOMPARE(actual, QString("r24-r26 r24-r25 r25-r26 r25-r24 r26-r24 r26-r25 "));
+
+    // the order is updated after modifications
+    cg.updateConnection(a, c, b);
+    QVERIFY(!cg.isConnected(a, *c));
+    QCOMPARE(cg.count(a), 1);
+    QCOMPARE(cg.begin()->second->toString(), QString("r25"));
+}
+
+
 QTEST_GUILESS_MAIN(ConnectionGraphTest)
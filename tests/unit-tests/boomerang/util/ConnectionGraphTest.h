@@ -24,4 +24,5 @@ private slots:
     void testIsConnected();
     void testAllRefsHaveDefs();
     void testUpdateConnection();
+    void testIteration();
 };
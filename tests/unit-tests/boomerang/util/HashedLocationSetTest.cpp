@@ -0,0 +1,127 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "HashedLocationSetTest.h"
+
+
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/util/HashedLocationSet.h"
+
+
+void HashedLocationSetTest::testInsert()
+{
+    HashedLocationSet set;
+    QVERIFY(set.empty());
+
+    QVERIFY(set.insert(Location::regOf(REG_PENT_ECX)));
+    QVERIFY(set.insert(Location::regOf(REG_PENT_EAX)));
+    QVERIFY(!set.insert(Location::regOf(REG_PENT_ECX)));
+    QCOMPARE(set.size(), 2);
+
+    // iterated in insertion order
+    QCOMPARE(set.toString(), QString("r25, r24"));
+
+    set.clear();
+    QVERIFY(set.empty());
+    QCOMPARE(set.toString(), QString(""));
+}
+
+
+void HashedLocationSetTest::testRemove()
+{
+    HashedLocationSet set = { Location::regOf(REG_PENT_EAX), Location::regOf(REG_PENT_ECX),
+                              Location::regOf(REG_PENT_EDX) };
+
+    QVERIFY(!set.remove(Location::regOf(REG_PENT_EBX)));
+    QVERIFY(set.remove(Location::regOf(REG_PENT_ECX)));
+    QVERIFY(!set.remove(Location::regOf(REG_PENT_ECX)));
+    QCOMPARE(set.size(), 2);
+    QCOMPARE(set.toString(), QString("r24, r26"));
+
+    // re-inserted locations go to the end
+    QVERIFY(set.insert(Location::regOf(REG_PENT_ECX)));
+    QCOMPARE(set.toString(), QString("r24, r26, r25"));
+}
+
+
+void HashedLocationSetTest::testContains()
+{
+    Assign as(Location::regOf(REG_PENT_EAX), Location::regOf(REG_PENT_ECX));
+
+    HashedLocationSet set;
+    set.insert(RefExp::get(Location::regOf(REG_PENT_EAX), &as));
+
+    QVERIFY(set.contains(RefExp::get(Location::regOf(REG_PENT_EAX), &as)));
+    QVERIFY(!set.contains(RefExp::get(Location::regOf(REG_PENT_EAX), nullptr)));
+    QVERIFY(!set.contains(Location::regOf(REG_PENT_EAX)));
+}
+
+
+void HashedLocationSetTest::testFindNS()
+{
+    HashedLocationSet set;
+    QVERIFY(set.findNS(nullptr) == nullptr);
+
+    set.insert(Location::regOf(REG_PENT_ESI));
+    QVERIFY(set.findNS(Location::regOf(REG_PENT_ESI)) == nullptr);
+
+    set.insert(RefExp::get(Location::regOf(REG_PENT_EDI), nullptr));
+    SharedExp e = set.findNS(Location::regOf(REG_PENT_EDI));
+    QVERIFY(e != nullptr);
+    QCOMPARE(e->toString(), QString("r31{-}"));
+}
+
+
+void HashedLocationSetTest::testLarge()
+{
+    const int numLocs = 10 * HashedLocationSet::INLINE_CAPACITY;
+    HashedLocationSet set;
+
+    for (int i = 0; i < numLocs; i++) {
+        QVERIFY(set.insert(RefExp::get(Location::memOf(Const::get(4 * i)), nullptr)));
+    }
+
+    QCOMPARE(set.size(), numLocs);
+
+    // remove every other location
+    for (int i = 0; i < numLocs; i += 2) {
+        QVERIFY(set.remove(RefExp::get(Location::memOf(Const::get(4 * i)), nullptr)));
+    }
+
+    QCOMPARE(set.size(), numLocs / 2);
+
+    for (int i = 0; i < numLocs; i++) {
+        const SharedExp loc = Location::memOf(Const::get(4 * i));
+        QCOMPARE(set.contains(RefExp::get(loc, nullptr)), i % 2 == 1);
+        QCOMPARE(set.findNS(loc) != nullptr, i % 2 == 1);
+    }
+
+    // iterated in insertion order
+    int i = 1;
+    for (const SharedExp &loc : set) {
+        QCOMPARE(*loc, *RefExp::get(Location::memOf(Const::get(4 * i)), nullptr));
+        i += 2;
+    }
+
+    QCOMPARE(i, numLocs + 1);
+
+    // removed locations can be inserted again
+    for (int j = 0; j < numLocs; j += 2) {
+        QVERIFY(set.insert(RefExp::get(Location::memOf(Const::get(4 * j)), nullptr)));
+    }
+
+    QCOMPARE(set.size(), numLocs);
+    QVERIFY(set.contains(RefExp::get(Location::memOf(Const::get(0)), nullptr)));
+}
+
+
+QTEST_GUILESS_MAIN(HashedLocationSetTest)
@@ -0,0 +1,28 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+class HashedLocationSetTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    void testInsert();
+    void testRemove();
+    void testContains();
+    void testFindNS();
+
+    /// Test sets that do not fit into the inline storage
+    void testLarge();
+};
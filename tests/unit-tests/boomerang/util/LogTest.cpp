@@ -0,0 +1,150 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "LogTest.h"
+
+
+#include "boomerang/ifc/ILogSink.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/util/log/Log.h"
+
+#include <thread>
+
+
+/// Collects the messages of all log lines
+class TestLogSink : public ILogSink
+{
+public:
+    TestLogSink(QStringList &messages)
+        : m_messages(messages)
+    {
+    }
+
+    virtual void write(const QString &s) override
+    {
+        // Strip the header and the line break
+        QString msg = s.section(" | ", 3);
+        msg.chop(1);
+        m_messages.append(msg);
+    }
+
+    virtual void flush() override {}
+
+private:
+    QStringList &m_messages;
+};
+
+
+void LogTest::testLog()
+{
+    QStringList messages;
+    Log log(LogLevel::Default);
+    log.addLogSink(std::make_unique<TestLogSink>(messages));
+
+    log.log(LogLevel::Default, __FILE__, __LINE__, "%1 + %2 = %3", 1, 2u, 3.5);
+    log.log(LogLevel::Warning, __FILE__, __LINE__, "%1 at %2: %3", 'c', Address(0x1000),
+            QString("test"));
+    log.log(LogLevel::Error, __FILE__, __LINE__, "%1", Location::regOf(REG_PENT_EAX));
+    log.flush();
+
+    QCOMPARE(messages, QStringList({ "1 + 2 = 3.5", "c at 0x00001000: test", "r24" }));
+}
+
+
+void LogTest::testMultiLine()
+{
+    QStringList messages;
+    Log log(LogLevel::Default);
+    log.addLogSink(std::make_unique<TestLogSink>(messages));
+
+    log.log(LogLevel::Default, __FILE__, __LINE__, "%1\n%2", "first", "second");
+    log.flush();
+
+    QCOMPARE(messages, QStringList({ "first", "second" }));
+}
+
+
+void LogTest::testLogLevel()
+{
+    QStringList messages;
+    Log log(LogLevel::Warning);
+    log.addLogSink(std::make_unique<TestLogSink>(messages));
+
+    log.log(LogLevel::Default, __FILE__, __LINE__, "message");
+    log.log(LogLevel::Warning, __FILE__, __LINE__, "warning");
+    log.setLogLevel(LogLevel::Verbose1);
+    log.log(LogLevel::Verbose1, __FILE__, __LINE__, "verbose");
+    log.flush();
+
+    QCOMPARE(messages, QStringList({ "warning", "verbose" }));
+}
+
+
+void LogTest::testDisabledLevel()
+{
+    const LogLevel oldLevel = Log::getOrCreateLog().getLogLevel();
+    Log::getOrCreateLog().setLogLevel(LogLevel::Default);
+
+    int numCalls = 0;
+    auto arg     = [&numCalls]() {
+        numCalls++;
+        return numCalls;
+    };
+
+    QVERIFY(!Log::isEnabled(LogLevel::Verbose2));
+    LOG_VERBOSE2("%1", arg());
+    QCOMPARE(numCalls, 0);
+
+    Log::getOrCreateLog().setLogLevel(LogLevel::Verbose2);
+    QVERIFY(Log::isEnabled(LogLevel::Verbose2));
+    LOG_VERBOSE2("%1", arg());
+    QCOMPARE(numCalls, 1);
+
+    Log::getOrCreateLog().setLogLevel(oldLevel);
+}
+
+
+void LogTest::testThreads()
+{
+    const int NUM_THREADS  = 4;
+    const int NUM_MESSAGES = 2000;
+
+    QStringList messages;
+    Log log(LogLevel::Default);
+    log.addLogSink(std::make_unique<TestLogSink>(messages));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; t++) {
+        threads.emplace_back([&log, t]() {
+            for (int i = 0; i < NUM_MESSAGES; i++) {
+                log.log(LogLevel::Default, __FILE__, __LINE__, "%1 %2", t, i);
+            }
+        });
+    }
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    log.flush();
+    QCOMPARE(messages.size(), NUM_THREADS * NUM_MESSAGES);
+
+    // Messages of each thread are written in order
+    std::vector<int> next(NUM_THREADS, 0);
+    for (const QString &msg : messages) {
+        const int t = msg.section(' ', 0, 0).toInt();
+        const int i = msg.section(' ', 1, 1).toInt();
+
+        QCOMPARE(i, next[t]);
+        next[t]++;
+    }
+}
+
+
+QTEST_GUILESS_MAIN(LogTest)
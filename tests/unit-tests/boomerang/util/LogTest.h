@@ -0,0 +1,30 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+class LogTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    void testLog();
+    void testMultiLine();
+    void testLogLevel();
+
+    /// Test that arguments of disabled log levels are not evaluated
+    void testDisabledLevel();
+
+    /// Test logging from multiple threads, with more messages than fit into the buffers
+    void testThreads();
+};
@@ -0,0 +1,157 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "MemoryArenaTest.h"
+
+
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/util/MemoryArena.h"
+
+#include <cstdint>
+
+
+void MemoryArenaTest::testAllocate()
+{
+    MemoryArena arena(64);
+
+    void *p1 = arena.allocate(3, 1);
+    void *p2 = arena.allocate(8, 8);
+    QVERIFY(p1 != nullptr);
+    QVERIFY(p2 != nullptr);
+    QCOMPARE(reinterpret_cast<std::uintptr_t>(p2) % 8, static_cast<std::uintptr_t>(0));
+    // small allocations are rounded up to their size class
+    QCOMPARE(arena.getNumBytesAllocated(), static_cast<std::size_t>(32));
+    QCOMPARE(arena.getNumBytesReserved(), static_cast<std::size_t>(64));
+
+    // larger than a block
+    void *p3 = arena.allocate(100, 16);
+    QVERIFY(p3 != nullptr);
+    QCOMPARE(reinterpret_cast<std::uintptr_t>(p3) % 16, static_cast<std::uintptr_t>(0));
+    QVERIFY(arena.getNumBytesReserved() >= static_cast<std::size_t>(64 + 100));
+}
+
+
+void MemoryArenaTest::testReuse()
+{
+    MemoryArena arena(4096);
+
+    void *p1 = arena.allocate(24, 8);
+    void *p2 = arena.allocate(24, 8);
+    QVERIFY(p1 != p2);
+    QCOMPARE(arena.getNumBytesAllocated(), static_cast<std::size_t>(64));
+
+    arena.deallocate(p1, 24, 8);
+    QCOMPARE(arena.getNumBytesAllocated(), static_cast<std::size_t>(32));
+
+    // same size class
+    QVERIFY(arena.allocate(20, 4) == p1);
+    QCOMPARE(arena.getNumBytesAllocated(), static_cast<std::size_t>(64));
+
+    // different size class
+    void *p3 = arena.allocate(40, 8);
+    QVERIFY(p3 != p1 && p3 != p2);
+
+    // large allocations are not reused
+    void *large = arena.allocate(MemoryArena::MAX_SMALL_SIZE + 1, 8);
+    arena.deallocate(large, MemoryArena::MAX_SMALL_SIZE + 1, 8);
+    QVERIFY(arena.allocate(MemoryArena::MAX_SMALL_SIZE + 1, 8) != large);
+
+    QCOMPARE(arena.getNumBytesReserved(), static_cast<std::size_t>(4096));
+}
+
+
+void MemoryArenaTest::testScope()
+{
+    std::shared_ptr<MemoryArena> arena1 = std::make_shared<MemoryArena>();
+    std::shared_ptr<MemoryArena> arena2 = std::make_shared<MemoryArena>();
+
+    QVERIFY(MemoryArena::getCurrent() == nullptr);
+
+    {
+        MemoryArena::Scope scope1(arena1);
+        QVERIFY(MemoryArena::getCurrent() == arena1.get());
+
+        {
+            MemoryArena::Scope scope2(arena2);
+            QVERIFY(MemoryArena::getCurrent() == arena2.get());
+
+            MemoryArena::Scope scope3(nullptr);
+            QVERIFY(MemoryArena::getCurrent() == nullptr);
+        }
+
+        QVERIFY(MemoryArena::getCurrent() == arena1.get());
+    }
+
+    QVERIFY(MemoryArena::getCurrent() == nullptr);
+}
+
+
+void MemoryArenaTest::testMakeShared()
+{
+    std::shared_ptr<MemoryArena> arena = std::make_shared<MemoryArena>();
+    std::weak_ptr<MemoryArena> weakArena = arena;
+
+    SharedExp exp;
+    {
+        MemoryArena::Scope scope(arena);
+        exp = Binary::get(opPlus, Location::regOf(REG_PENT_ESP), Const::get(4));
+    }
+
+    QVERIFY(arena->getNumBytesAllocated() > 0);
+
+    // objects keep their arena alive
+    arena.reset();
+    QVERIFY(!weakArena.expired());
+    QCOMPARE(exp->getSubExp2()->access<Const>()->getInt(), 4);
+
+    exp.reset();
+    QVERIFY(weakArena.expired());
+}
+
+
+void MemoryArenaTest::testStatements()
+{
+    std::shared_ptr<MemoryArena> arena = std::make_shared<MemoryArena>();
+    std::weak_ptr<MemoryArena> weakArena = arena;
+
+    RTL *rtl = nullptr;
+    {
+        MemoryArena::Scope scope(arena);
+        rtl = new RTL(Address(0x1000),
+                      { new Assign(Location::regOf(REG_PENT_EAX), Const::get(0)) });
+    }
+
+    // allocated outside of the arena
+    Assign *heapAssign = new Assign(Location::regOf(REG_PENT_EBX), Const::get(1));
+    const std::size_t numBytes = arena->getNumBytesAllocated();
+    QVERIFY(numBytes > 0);
+    QVERIFY(MemoryArena::isArenaMemory(rtl));
+    QVERIFY(!MemoryArena::isArenaMemory(heapAssign));
+
+    arena.reset();
+    QVERIFY(!weakArena.expired());
+
+    delete heapAssign;
+    QCOMPARE(weakArena.lock()->getNumBytesAllocated(), numBytes);
+
+    delete rtl;
+    QVERIFY(weakArena.expired());
+
+    // Without any arena, statements are plain heap objects
+    Assign *assign = new Assign(Location::regOf(REG_PENT_ECX), Const::get(2));
+    QVERIFY(!MemoryArena::isArenaMemory(assign));
+    delete assign;
+}
+
+
+QTEST_GUILESS_MAIN(MemoryArenaTest)
@@ -0,0 +1,27 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+class MemoryArenaTest : public BoomerangTest
+{
+public:
+    Q_OBJECT
+
+private slots:
+    void testAllocate();
+    void testReuse();
+    void testScope();
+    void testMakeShared();
+    void testStatements();
+};
@@ -0,0 +1,75 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ExpSimplifierBenchmark.h"
+
+
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/exp/Ternary.h"
+
+
+void ExpSimplifierBenchmark::benchmarkSimplify()
+{
+    QFETCH(bool, simplifyAgain);
+
+    // Typical expressions after propagation, e.g. stack offsets,
+    // flag calls after propagation and branch conditions
+    std::vector<SharedExp> exps;
+
+    for (int i = 0; i < 100; i++) {
+        SharedExp sp = RefExp::get(Location::regOf(REG_PENT_ESP), nullptr);
+
+        exps.push_back(Location::memOf(
+            Binary::get(opPlus, Binary::get(opMinus, sp, Const::get(4)), Const::get(i * 4))));
+        exps.push_back(Binary::get(
+            opAnd,
+            Binary::get(opEquals, Binary::get(opMinus, Location::regOf(REG_PENT_EAX), Const::get(i)),
+                        Const::get(0)),
+            Binary::get(opEquals, Binary::get(opMinus, Location::regOf(REG_PENT_EAX), Const::get(i)),
+                        Const::get(0))));
+        exps.push_back(Ternary::get(opTern, Binary::get(opLess, sp->clone(), Const::get(i)),
+                                    Const::get(1), Const::get(0)));
+        exps.push_back(Unary::get(opLNot, Binary::get(opGtrUns, Location::regOf(REG_PENT_ECX),
+                                                      Binary::get(opMult, Const::get(i),
+                                                                  Const::get(4)))));
+    }
+
+    if (simplifyAgain) {
+        for (SharedExp &exp : exps) {
+            exp = exp->simplify();
+        }
+
+        QBENCHMARK {
+            for (const SharedExp &exp : exps) {
+                exp->simplify();
+            }
+        }
+    }
+    else {
+        QBENCHMARK {
+            for (const SharedExp &exp : exps) {
+                exp->clone()->simplify();
+            }
+        }
+    }
+}
+
+
+void ExpSimplifierBenchmark::benchmarkSimplify_data()
+{
+    QTest::addColumn<bool>("simplifyAgain");
+
+    QTest::newRow("new") << false;
+    QTest::newRow("simplified") << true;
+}
+
+
+QTEST_GUILESS_MAIN(ExpSimplifierBenchmark)
@@ -813,4 +813,62 @@ void ExpSimplifierTest::testSimplify_data()
     }
 }
 
+
+void ExpSimplifierTest::testSimplifyTwice()
+{
+    // r24 + (4 + 8)
+    SharedExp exp = Binary::get(opPlus, Location::regOf(REG_PENT_EAX),
+                                Binary::get(opPlus, Const::get(4), Const::get(8)));
+
+    exp = exp->simplify();
+    QCOMPARE(exp->toString(),
+             Binary::get(opPlus, Location::regOf(REG_PENT_EAX), Const::get(12))->toString());
+    QVERIFY(exp->isSimplified());
+
+    // already simplified
+    QVERIFY(exp->simplify() == exp);
+    QVERIFY(exp->isSimplified());
+
+    // Modifying a sub-expression invalidates the parent as well
+    exp->access<Const, 2>()->setInt(0);
+    QVERIFY(!exp->isSimplified());
+    QVERIFY(!exp->getSubExp2()->isSimplified());
+
+    exp = exp->simplify();
+    QCOMPARE(exp->toString(), Location::regOf(REG_PENT_EAX)->toString());
+
+    // Replacing a sub-expression invalidates the parent
+    SharedExp cmp = Binary::get(opEquals, Location::regOf(REG_PENT_EAX), Const::get(0));
+    cmp           = cmp->simplify();
+    QVERIFY(cmp->isSimplified());
+
+    cmp->setSubExp2(Location::regOf(REG_PENT_EAX));
+    QVERIFY(!cmp->isSimplified());
+    QCOMPARE(cmp->simplify()->toString(), Terminal::get(opTrue)->toString());
+}
+
+
+void ExpSimplifierTest::testSimplifySharedSubExp()
+{
+    // m[r25 + 4] twice, sharing the sub-expression r25 + 4
+    SharedExp shared = Binary::get(opPlus, Location::regOf(REG_PENT_ECX), Const::get(4));
+    SharedExp exp1   = Location::memOf(shared);
+    SharedExp exp2   = Location::memOf(shared);
+
+    exp1 = exp1->simplify();
+    exp2 = exp2->simplify();
+    QVERIFY(exp1->isSimplified());
+    QVERIFY(exp2->isSimplified());
+
+    // Simplifying the shared sub-expression via exp1 must not hide the change from exp2
+    shared->access<Const, 2>()->setInt(0);
+    exp1 = exp1->simplify();
+    QCOMPARE(exp1->toString(), Location::memOf(Location::regOf(REG_PENT_ECX))->toString());
+
+    QVERIFY(!exp2->isSimplified());
+    exp2 = exp2->simplify();
+    QCOMPARE(exp2->toString(), Location::memOf(Location::regOf(REG_PENT_ECX))->toString());
+}
+
+
 QTEST_GUILESS_MAIN(ExpSimplifierTest)
@@ -20,4 +20,6 @@ class ExpSimplifierTest : public BoomerangTest
 private slots:
     void testSimplify();
     void testSimplify_data();
+    void testSimplifyTwice();
+    void testSimplifySharedSubExp();
 };